@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "batch/cmaes.hpp"
+
+namespace {
+// eigendecomposition of a symmetric matrix with the cyclic Jacobi method. The matrix is overwritten
+void jacobi(std::vector<double>& matrix, unsigned n, std::vector<double>& eigenvectors,
+            std::vector<double>& eigenvalues) {
+    eigenvectors.assign(n * n, 0);
+    for (unsigned i = 0; i < n; i++) eigenvectors[i * n + i] = 1;
+    for (int sweep = 0; sweep < 50; sweep++) {
+        double offDiagonal = 0;
+        for (unsigned i = 0; i < n; i++) {
+            for (unsigned j = i + 1; j < n; j++) offDiagonal += matrix[i * n + j] * matrix[i * n + j];
+        }
+        if (offDiagonal < 1e-30) break;
+        for (unsigned p = 0; p < n; p++) {
+            for (unsigned q = p + 1; q < n; q++) {
+                const double apq = matrix[p * n + q];
+                if (std::fabs(apq) < 1e-300) continue;
+                // rotate rows and columns p and q so that the element at (p, q) becomes 0
+                const double theta = (matrix[q * n + q] - matrix[p * n + p]) / (2 * apq);
+                const double t = std::copysign(1.0, theta) / (std::fabs(theta) + std::sqrt(theta * theta + 1));
+                const double c = 1 / std::sqrt(t * t + 1);
+                const double s = t * c;
+                for (unsigned k = 0; k < n; k++) {
+                    const double akp = matrix[k * n + p], akq = matrix[k * n + q];
+                    matrix[k * n + p] = c * akp - s * akq;
+                    matrix[k * n + q] = s * akp + c * akq;
+                }
+                for (unsigned k = 0; k < n; k++) {
+                    const double apk = matrix[p * n + k], aqk = matrix[q * n + k];
+                    matrix[p * n + k] = c * apk - s * aqk;
+                    matrix[q * n + k] = s * apk + c * aqk;
+                }
+                for (unsigned k = 0; k < n; k++) {
+                    const double vkp = eigenvectors[k * n + p], vkq = eigenvectors[k * n + q];
+                    eigenvectors[k * n + p] = c * vkp - s * vkq;
+                    eigenvectors[k * n + q] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+    eigenvalues.resize(n);
+    for (unsigned i = 0; i < n; i++) eigenvalues[i] = matrix[i * n + i];
+}
+} // namespace
+
+namespace batch {
+CmaEs::CmaEs(std::vector<double> mean, double sigma, uint64_t seed, unsigned populationSize)
+    : dimensions(mean.size()),
+      mean(std::move(mean)),
+      sigma(sigma),
+      random(seed) {
+    const double n = dimensions;
+    this->populationSize = populationSize != 0 ? populationSize : 4 + static_cast<unsigned>(3 * std::log(n));
+    parents = this->populationSize / 2;
+    for (unsigned i = 0; i < parents; i++) weights.push_back(std::log(parents + 0.5) - std::log(i + 1));
+    const double sum = std::accumulate(weights.begin(), weights.end(), 0.0);
+    for (double& weight : weights) weight /= sum;
+    double squares = 0;
+    for (double weight : weights) squares += weight * weight;
+    parentsEffective = 1 / squares;
+
+    cumulationC = (4 + parentsEffective / n) / (n + 4 + 2 * parentsEffective / n);
+    cumulationSigma = (parentsEffective + 2) / (n + parentsEffective + 5);
+    rankOne = 2 / ((n + 1.3) * (n + 1.3) + parentsEffective);
+    rankMu = std::min(1 - rankOne,
+                      2 * (parentsEffective - 2 + 1 / parentsEffective) / ((n + 2) * (n + 2) + parentsEffective));
+    damping = 1 + 2 * std::max(0.0, std::sqrt((parentsEffective - 1) / (n + 1)) - 1) + cumulationSigma;
+    expectedNorm = std::sqrt(n) * (1 - 1 / (4 * n) + 1 / (21 * n * n));
+
+    covariance.assign(dimensions * dimensions, 0);
+    for (unsigned i = 0; i < dimensions; i++) covariance[i * dimensions + i] = 1;
+    pathC.assign(dimensions, 0);
+    pathSigma.assign(dimensions, 0);
+    decompose();
+}
+
+const std::vector<std::vector<double>>& CmaEs::ask() {
+    std::normal_distribution<double> normal;
+    candidates.assign(populationSize, std::vector<double>(dimensions));
+    std::vector<double> z(dimensions);
+    for (std::vector<double>& candidate : candidates) {
+        for (double& value : z) value = normal(random);
+        // mean + sigma * B * D * z
+        for (unsigned i = 0; i < dimensions; i++) {
+            double step = 0;
+            for (unsigned j = 0; j < dimensions; j++) step += basis[i * dimensions + j] * scales[j] * z[j];
+            candidate[i] = mean[i] + sigma * step;
+        }
+    }
+    return candidates;
+}
+
+void CmaEs::tell(const std::vector<double>& costs) {
+    std::vector<unsigned> order(populationSize);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](unsigned a, unsigned b) { return costs[a] < costs[b]; });
+
+    // move the mean towards the best candidates
+    const std::vector<double> oldMean = mean;
+    std::fill(mean.begin(), mean.end(), 0);
+    for (unsigned k = 0; k < parents; k++) {
+        for (unsigned i = 0; i < dimensions; i++) mean[i] += weights[k] * candidates[order[k]][i];
+    }
+    std::vector<double> step(dimensions);
+    for (unsigned i = 0; i < dimensions; i++) step[i] = (mean[i] - oldMean[i]) / sigma;
+
+    // evolution path of the step size, in the coordinates where the distribution is round: C^-1/2 * step
+    std::vector<double> rotated(dimensions, 0);
+    for (unsigned j = 0; j < dimensions; j++) {
+        for (unsigned i = 0; i < dimensions; i++) rotated[j] += basis[i * dimensions + j] * step[i];
+        rotated[j] /= scales[j];
+    }
+    const double sigmaRate = std::sqrt(cumulationSigma * (2 - cumulationSigma) * parentsEffective);
+    for (unsigned i = 0; i < dimensions; i++) {
+        double whitened = 0;
+        for (unsigned j = 0; j < dimensions; j++) whitened += basis[i * dimensions + j] * rotated[j];
+        pathSigma[i] = (1 - cumulationSigma) * pathSigma[i] + sigmaRate * whitened;
+    }
+    double pathSigmaNorm = 0;
+    for (double value : pathSigma) pathSigmaNorm += value * value;
+    pathSigmaNorm = std::sqrt(pathSigmaNorm);
+    generation++;
+
+    // evolution path of the covariance. It stalls while the step size is growing fast, so C doesn't grow too fast too
+    const bool stalled = pathSigmaNorm / std::sqrt(1 - std::pow(1 - cumulationSigma, 2 * generation)) / expectedNorm >=
+                         1.4 + 2 / (dimensions + 1.0);
+    const double cRate = std::sqrt(cumulationC * (2 - cumulationC) * parentsEffective);
+    for (unsigned i = 0; i < dimensions; i++) {
+        pathC[i] = (1 - cumulationC) * pathC[i] + (stalled ? 0 : cRate * step[i]);
+    }
+
+    // rank one update from the evolution path, and rank mu update from the best candidates
+    const double correction = stalled ? rankOne * cumulationC * (2 - cumulationC) : 0;
+    for (unsigned i = 0; i < dimensions; i++) {
+        for (unsigned j = 0; j < dimensions; j++) {
+            double rankMuUpdate = 0;
+            for (unsigned k = 0; k < parents; k++) {
+                const std::vector<double>& candidate = candidates[order[k]];
+                rankMuUpdate += weights[k] * (candidate[i] - oldMean[i]) * (candidate[j] - oldMean[j]);
+            }
+            double& c = covariance[i * dimensions + j];
+            c = (1 - rankOne - rankMu) * c + rankOne * pathC[i] * pathC[j] + correction * c +
+                rankMu * rankMuUpdate / (sigma * sigma);
+        }
+    }
+
+    sigma *= std::exp(cumulationSigma / damping * (pathSigmaNorm / expectedNorm - 1));
+    decompose();
+}
+
+const std::vector<double>& CmaEs::getMean() const { return mean; }
+
+double CmaEs::getSigma() const { return sigma; }
+
+unsigned CmaEs::getPopulationSize() const { return populationSize; }
+
+void CmaEs::decompose() {
+    std::vector<double> matrix = covariance;
+    std::vector<double> eigenvalues;
+    jacobi(matrix, dimensions, basis, eigenvalues);
+    scales.resize(dimensions);
+    // rounding can make tiny eigenvalues negative
+    for (unsigned i = 0; i < dimensions; i++) scales[i] = std::sqrt(std::max(eigenvalues[i], 1e-20));
+}
+} // namespace batch
@@ -0,0 +1,142 @@
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "batch/run.hpp"
+
+extern char** environ;
+
+namespace {
+// parse what printSettings() in host/runner.cpp printed
+std::vector<double> parseSettings(const char* text) {
+    std::vector<double> settings;
+    char* end;
+    for (double value = std::strtod(text, &end); end != text; value = std::strtod(text, &end)) {
+        settings.push_back(value);
+        text = *end == ',' ? end + 1 : end;
+    }
+    return settings;
+}
+
+// parse a line robot printed to stderr into the result
+void parseLine(const char* line, batch::RunResult& result) {
+    size_t index;
+    double start, settle;
+    if (std::strncmp(line, "User Auton ", 11) == 0) {
+        // "User Auton <finished|timed out|deadlocked> after <seconds> s of virtual time..."
+        result.finished = std::strncmp(line + 11, "finished", 8) == 0;
+        if (const char* after = std::strstr(line, " after ")) std::sscanf(after, " after %lf", &result.duration);
+        return;
+    }
+    sim::Pose& odometry = result.odometry;
+    if (std::sscanf(line, "final pose: x %lf, y %lf, theta %lf", &odometry.x, &odometry.y, &odometry.theta) == 3) {
+        return;
+    }
+    sim::Pose& actual = result.actual;
+    if (std::sscanf(line, "actual pose: x %lf, y %lf, theta %lf", &actual.x, &actual.y, &actual.theta) == 3) {
+        // the last thing robot prints
+        result.ok = true;
+        return;
+    }
+    if (std::sscanf(line, "motion %zu: started at %lf s, settled in %lf s", &index, &start, &settle) == 3) {
+        result.motions.push_back(settle);
+        return;
+    }
+    batch::StepResult step;
+    char kind[8];
+    if (std::sscanf(line, "step %zu: %7s %lf, took %lf s, settled in %lf s, overshoot %lf, error %lf", &index, kind,
+                    &step.amount, &step.duration, &step.settle, &step.overshoot, &step.error) == 7) {
+        step.turn = std::strcmp(kind, "turn") == 0;
+        step.settled = std::strstr(line, "not settled") == nullptr;
+        step.timedOut = std::strstr(line, "timed out") != nullptr;
+        result.steps.push_back(step);
+        return;
+    }
+    if (std::strncmp(line, "lateral settings: ", 18) == 0) result.lateralSettings = parseSettings(line + 18);
+    if (std::strncmp(line, "angular settings: ", 18) == 0) result.angularSettings = parseSettings(line + 18);
+}
+} // namespace
+
+namespace batch {
+std::string robotPath() {
+    return (std::filesystem::read_symlink("/proc/self/exe").parent_path() / "robot").string();
+}
+
+RunResult run(const std::vector<std::string>& arguments, int timeout) {
+    RunResult result;
+    const std::string program = robotPath();
+    std::vector<char*> argv = {const_cast<char*>(program.c_str())};
+    for (const std::string& argument : arguments) argv.push_back(const_cast<char*>(argument.c_str()));
+    argv.push_back(nullptr);
+
+    // stdout is the program's own output, which a batch doesn't need. The results come on stderr
+    int pipe[2];
+    if (::pipe2(pipe, O_CLOEXEC) != 0) return result;
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+    posix_spawn_file_actions_adddup2(&actions, pipe[1], STDERR_FILENO);
+    pid_t pid;
+    const int error = posix_spawn(&pid, program.c_str(), &actions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    close(pipe[1]);
+    if (error != 0) {
+        close(pipe[0]);
+        return result;
+    }
+
+    // read the lines robot prints until it exits, or until it runs out of time. A program that is stuck busy never
+    // gets to the end of its virtual time, so only the wall clock stops it
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(timeout);
+    bool killed = false;
+    char line[256];
+    size_t length = 0;
+    while (true) {
+        const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline -
+                                                                                std::chrono::steady_clock::now());
+        pollfd readable = {pipe[0], POLLIN, 0};
+        const int ready = left.count() > 0 ? ::poll(&readable, 1, left.count()) : 0;
+        if (ready < 0 && errno == EINTR) continue;
+        if (ready == 0) {
+            kill(pid, SIGKILL);
+            killed = true;
+            break;
+        }
+        const ssize_t count = read(pipe[0], line + length, sizeof(line) - 1 - length);
+        if (count < 0 && errno == EINTR) continue;
+        if (count <= 0) break;
+        length += count;
+        // parse every whole line, and keep the start of the next. A line too long for the buffer is cut, like fgets()
+        char* start = line;
+        for (char* end; (end = static_cast<char*>(std::memchr(start, '\n', line + length - start))) != nullptr;) {
+            *end = '\0';
+            parseLine(start, result);
+            start = end + 1;
+        }
+        length -= start - line;
+        std::memmove(line, start, length);
+        if (length == sizeof(line) - 1) {
+            line[length] = '\0';
+            parseLine(line, result);
+            length = 0;
+        }
+    }
+    if (length > 0 && !killed) {
+        line[length] = '\0';
+        parseLine(line, result);
+    }
+    close(pipe[0]);
+    int status;
+    waitpid(pid, &status, 0);
+    if (killed || !WIFEXITED(status) || WEXITSTATUS(status) != 0) result.ok = false;
+    return result;
+}
+} // namespace batch
@@ -0,0 +1,104 @@
+#include <algorithm>
+
+#include "batch/threadPool.hpp"
+
+namespace {
+// the worker the current thread is, or -1 if it isn't one
+thread_local int currentWorker = -1;
+// the pool the current thread works for
+thread_local const batch::ThreadPool* currentPool = nullptr;
+} // namespace
+
+namespace batch {
+ThreadPool::ThreadPool(unsigned threads) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned i = 0; i < threads; i++) queues.push_back(std::make_unique<Queue>());
+    for (unsigned i = 0; i < threads; i++) this->threads.emplace_back([this, i] { work(i); });
+}
+
+ThreadPool::~ThreadPool() {
+    wait();
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+    for (std::thread& thread : threads) thread.join();
+}
+
+void ThreadPool::submit(std::function<void()> job) {
+    const unsigned worker = currentPool == this ? currentWorker : next++ % queues.size();
+    unfinished++;
+    {
+        std::lock_guard lock(queues[worker]->mutex);
+        queues[worker]->jobs.push_back(std::move(job));
+    }
+    queued++;
+    // a worker counts itself as sleeping before it checks for jobs, so either it sees this job or this sees it. Taking
+    // the mutex makes sure it's waiting before it's woken
+    if (sleeping > 0) {
+        { std::lock_guard lock(mutex); }
+        available.notify_one();
+    }
+}
+
+void ThreadPool::wait() {
+    std::unique_lock lock(mutex);
+    finished.wait(lock, [this] { return unfinished == 0; });
+}
+
+unsigned ThreadPool::size() const { return queues.size(); }
+
+bool ThreadPool::claim() {
+    size_t count = queued;
+    while (count > 0 && !queued.compare_exchange_weak(count, count - 1)) {}
+    return count > 0;
+}
+
+bool ThreadPool::take(unsigned worker, std::function<void()>& job) {
+    {
+        Queue& own = *queues[worker];
+        std::lock_guard lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+            return true;
+        }
+    }
+    for (unsigned i = 1; i < queues.size(); i++) {
+        Queue& victim = *queues[(worker + i) % queues.size()];
+        std::lock_guard lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::work(unsigned worker) {
+    currentWorker = worker;
+    currentPool = this;
+    while (true) {
+        // claim a job before looking for it, so that workers don't race each other for the last one
+        if (!claim()) {
+            std::unique_lock lock(mutex);
+            sleeping++;
+            available.wait(lock, [this] { return queued > 0 || stopping; });
+            sleeping--;
+            if (stopping && queued == 0) return;
+            continue;
+        }
+        std::function<void()> job;
+        // a job is only counted once it's queued, but the job this worker finds may be taken by another one first,
+        // so keep looking until one shows up
+        while (!take(worker, job)) std::this_thread::yield();
+        job();
+        if (--unfinished == 0) {
+            { std::lock_guard lock(mutex); }
+            finished.notify_all();
+        }
+    }
+}
+} // namespace batch
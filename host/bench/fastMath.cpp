@@ -0,0 +1,262 @@
+#include <array>
+#include <cmath>
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "lemlib/math/fastMath.hpp"
+
+/**
+ * Accuracy and throughput of lemlib::fast's math, next to libm's.
+ *
+ * The accuracy benchmarks sweep each function's inputs, evenly spaced with random jitter, and report the largest error
+ * against double precision libm in the maxError counter, which is what fastMath.hpp documents. libm's own float
+ * versions are swept too, for scale. Their times are only the time the sweep took.
+ *
+ * The throughput benchmarks time single calls, with inputs cycling through a random table like primitives.cpp, and the
+ * batch versions on a whole table at once, where items per second is the number of values.
+ */
+namespace {
+constexpr size_t INPUTS = 1024;
+// number of inputs an accuracy benchmark sweeps
+constexpr size_t SWEEP = 1 << 22;
+
+/**
+ * @brief Random inputs for a benchmark: angles from -10 to 10 radians, and coordinates from -100 to 100 inches
+ */
+struct Inputs {
+        std::array<float, INPUTS> angles;
+        std::array<float, INPUTS> x;
+        std::array<float, INPUTS> y;
+
+        Inputs() {
+            std::mt19937 random(INPUTS);
+            std::uniform_real_distribution<float> angle(-10, 10);
+            std::uniform_real_distribution<float> coordinate(-100, 100);
+            for (size_t i = 0; i < INPUTS; i++) {
+                angles[i] = angle(random);
+                x[i] = coordinate(random);
+                y[i] = coordinate(random);
+            }
+        }
+};
+
+const Inputs inputs;
+
+float angle(size_t i) { return inputs.angles[i % INPUTS]; }
+
+float x(size_t i) { return inputs.x[i % INPUTS]; }
+
+float y(size_t i) { return inputs.y[i % INPUTS]; }
+
+// std::sin and the rest are overloaded, so these pick the float and double versions
+float libmSin(float x) { return std::sin(x); }
+
+float libmCos(float x) { return std::cos(x); }
+
+float libmAtan2(float y, float x) { return std::atan2(y, x); }
+
+float libmHypot(float x, float y) { return std::hypot(x, y); }
+
+float fastSin(float x) { return lemlib::fast::sin(x); }
+
+float fastCos(float x) { return lemlib::fast::cos(x); }
+
+float fastAtan2(float y, float x) { return lemlib::fast::atan2(y, x); }
+
+float fastHypot(float x, float y) { return lemlib::fast::hypot(x, y); }
+
+double referenceSin(double x) { return std::sin(x); }
+
+double referenceCos(double x) { return std::cos(x); }
+
+// the largest absolute error of a function of an angle from -limit to limit
+void angleAccuracy(benchmark::State& state, float (*function)(float), double (*reference)(double), float limit) {
+    std::mt19937 random(SWEEP);
+    std::uniform_real_distribution<double> jitter(0, 1);
+    double maxError = 0;
+    for (auto _ : state) {
+        for (size_t i = 0; i < SWEEP; i++) {
+            const float x = -limit + 2 * limit * (i + jitter(random)) / SWEEP;
+            maxError = std::max(maxError, std::fabs(function(x) - reference(x)));
+        }
+    }
+    state.counters["maxError"] = maxError;
+}
+BENCHMARK_CAPTURE(angleAccuracy, libmSin, libmSin, referenceSin, 8192)->Iterations(1);
+BENCHMARK_CAPTURE(angleAccuracy, fastSin, fastSin, referenceSin, 8192)->Iterations(1);
+BENCHMARK_CAPTURE(angleAccuracy, libmCos, libmCos, referenceCos, 8192)->Iterations(1);
+BENCHMARK_CAPTURE(angleAccuracy, fastCos, fastCos, referenceCos, 8192)->Iterations(1);
+
+// the largest absolute error of atan2, around the whole circle, at distances from 1e-3 to 1e3
+void atan2Accuracy(benchmark::State& state, float (*function)(float, float)) {
+    std::mt19937 random(SWEEP);
+    std::uniform_real_distribution<double> jitter(0, 1);
+    std::uniform_real_distribution<double> exponent(-3, 3);
+    double maxError = 0;
+    for (auto _ : state) {
+        for (size_t i = 0; i < SWEEP; i++) {
+            const double angle = -M_PI + 2 * M_PI * (i + jitter(random)) / SWEEP;
+            const double distance = std::pow(10, exponent(random));
+            const float x = distance * std::cos(angle);
+            const float y = distance * std::sin(angle);
+            // against the angle of the rounded coordinates, not the one they came from
+            maxError = std::max(maxError, std::fabs(function(y, x) - std::atan2(double(y), double(x))));
+        }
+    }
+    state.counters["maxError"] = maxError;
+}
+BENCHMARK_CAPTURE(atan2Accuracy, libmAtan2, libmAtan2)->Iterations(1);
+BENCHMARK_CAPTURE(atan2Accuracy, fastAtan2, fastAtan2)->Iterations(1);
+
+// the largest relative error of hypot, for sides from 1e-19 to 1e19
+void hypotAccuracy(benchmark::State& state, float (*function)(float, float)) {
+    std::mt19937 random(SWEEP);
+    std::uniform_real_distribution<double> exponent(-19, 19);
+    std::uniform_real_distribution<double> ratio(-1, 1);
+    double maxError = 0;
+    for (auto _ : state) {
+        for (size_t i = 0; i < SWEEP; i++) {
+            const float x = std::pow(10, exponent(random));
+            const float y = x * ratio(random);
+            const double length = std::hypot(double(x), double(y));
+            maxError = std::max(maxError, std::fabs(function(x, y) - length) / length);
+        }
+    }
+    state.counters["maxError"] = maxError;
+}
+BENCHMARK_CAPTURE(hypotAccuracy, libmHypot, libmHypot)->Iterations(1);
+BENCHMARK_CAPTURE(hypotAccuracy, fastHypot, fastHypot)->Iterations(1);
+
+// the batch versions must compute what the scalar ones do, to within NEON's estimates. maxError is the difference
+void batchAccuracy(benchmark::State& state) {
+    std::array<float, INPUTS> sines, cosines, angles, lengths;
+    for (auto _ : state) {
+        lemlib::fast::sincos(inputs.angles.data(), sines.data(), cosines.data(), INPUTS);
+        lemlib::fast::atan2(inputs.y.data(), inputs.x.data(), angles.data(), INPUTS);
+        lemlib::fast::hypot(inputs.x.data(), inputs.y.data(), lengths.data(), INPUTS);
+    }
+    double maxError = 0;
+    for (size_t i = 0; i < INPUTS; i++) {
+        maxError = std::max<double>(maxError, std::fabs(sines[i] - lemlib::fast::sin(angle(i))));
+        maxError = std::max<double>(maxError, std::fabs(cosines[i] - lemlib::fast::cos(angle(i))));
+        maxError = std::max<double>(maxError, std::fabs(angles[i] - lemlib::fast::atan2(y(i), x(i))));
+        maxError = std::max<double>(maxError,
+                                    std::fabs(lengths[i] - lemlib::fast::hypot(x(i), y(i))) / lengths[i]);
+    }
+    state.counters["maxError"] = maxError;
+}
+BENCHMARK(batchAccuracy)->Iterations(1);
+
+void angleThroughput(benchmark::State& state, float (*function)(float)) {
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(function(angle(i)));
+        i++;
+    }
+}
+BENCHMARK_CAPTURE(angleThroughput, libmSin, libmSin);
+BENCHMARK_CAPTURE(angleThroughput, fastSin, fastSin);
+BENCHMARK_CAPTURE(angleThroughput, libmCos, libmCos);
+BENCHMARK_CAPTURE(angleThroughput, fastCos, fastCos);
+
+void libmSincos(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::sin(angle(i)));
+        benchmark::DoNotOptimize(std::cos(angle(i)));
+        i++;
+    }
+}
+BENCHMARK(libmSincos);
+
+void fastSincos(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        float sin, cos;
+        lemlib::fast::sincos(angle(i), sin, cos);
+        benchmark::DoNotOptimize(sin);
+        benchmark::DoNotOptimize(cos);
+        i++;
+    }
+}
+BENCHMARK(fastSincos);
+
+void pointThroughput(benchmark::State& state, float (*function)(float, float)) {
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(function(x(i), y(i)));
+        i++;
+    }
+}
+BENCHMARK_CAPTURE(pointThroughput, libmAtan2, libmAtan2);
+BENCHMARK_CAPTURE(pointThroughput, fastAtan2, fastAtan2);
+BENCHMARK_CAPTURE(pointThroughput, libmHypot, libmHypot);
+BENCHMARK_CAPTURE(pointThroughput, fastHypot, fastHypot);
+
+// a whole table at once, with libm in a loop, and with the batch versions
+void libmSincosBatch(benchmark::State& state) {
+    std::array<float, INPUTS> sines, cosines;
+    for (auto _ : state) {
+        for (size_t i = 0; i < INPUTS; i++) {
+            sines[i] = std::sin(inputs.angles[i]);
+            cosines[i] = std::cos(inputs.angles[i]);
+        }
+        benchmark::DoNotOptimize(sines.data());
+        benchmark::DoNotOptimize(cosines.data());
+    }
+    state.SetItemsProcessed(state.iterations() * INPUTS);
+}
+BENCHMARK(libmSincosBatch);
+
+void fastSincosBatch(benchmark::State& state) {
+    std::array<float, INPUTS> sines, cosines;
+    for (auto _ : state) {
+        lemlib::fast::sincos(inputs.angles.data(), sines.data(), cosines.data(), INPUTS);
+        benchmark::DoNotOptimize(sines.data());
+        benchmark::DoNotOptimize(cosines.data());
+    }
+    state.SetItemsProcessed(state.iterations() * INPUTS);
+}
+BENCHMARK(fastSincosBatch);
+
+void libmAtan2Batch(benchmark::State& state) {
+    std::array<float, INPUTS> angles;
+    for (auto _ : state) {
+        for (size_t i = 0; i < INPUTS; i++) angles[i] = std::atan2(inputs.y[i], inputs.x[i]);
+        benchmark::DoNotOptimize(angles.data());
+    }
+    state.SetItemsProcessed(state.iterations() * INPUTS);
+}
+BENCHMARK(libmAtan2Batch);
+
+void fastAtan2Batch(benchmark::State& state) {
+    std::array<float, INPUTS> angles;
+    for (auto _ : state) {
+        lemlib::fast::atan2(inputs.y.data(), inputs.x.data(), angles.data(), INPUTS);
+        benchmark::DoNotOptimize(angles.data());
+    }
+    state.SetItemsProcessed(state.iterations() * INPUTS);
+}
+BENCHMARK(fastAtan2Batch);
+
+void libmHypotBatch(benchmark::State& state) {
+    std::array<float, INPUTS> lengths;
+    for (auto _ : state) {
+        for (size_t i = 0; i < INPUTS; i++) lengths[i] = std::hypot(inputs.x[i], inputs.y[i]);
+        benchmark::DoNotOptimize(lengths.data());
+    }
+    state.SetItemsProcessed(state.iterations() * INPUTS);
+}
+BENCHMARK(libmHypotBatch);
+
+void fastHypotBatch(benchmark::State& state) {
+    std::array<float, INPUTS> lengths;
+    for (auto _ : state) {
+        lemlib::fast::hypot(inputs.x.data(), inputs.y.data(), lengths.data(), INPUTS);
+        benchmark::DoNotOptimize(lengths.data());
+    }
+    state.SetItemsProcessed(state.iterations() * INPUTS);
+}
+BENCHMARK(fastHypotBatch);
+} // namespace
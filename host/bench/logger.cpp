@@ -0,0 +1,75 @@
+#include <limits>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "lemlib/logger/logFormat.hpp"
+#include "pros/rtos.hpp"
+#include "sim/kernel.hpp"
+
+/**
+ * The cost of logging a message through a FastSink, with a format that is parsed ahead of time and with one that has
+ * to be formatted with fmt::vformat, through the template's BaseSink for comparison, and of looking up the parsed
+ * format of a sink.
+ *
+ * A cache hit is what every message logged through a sink pays. A miss parses the format, which each format only does
+ * the first time it is used, since the cache never evicts. Sinks are measured from a task, since a FastSink only uses
+ * its per-task scratch buffers from one, so they report real time.
+ */
+namespace {
+// the format of lemlib::infoSink()
+const std::string FORMAT = "[LemLib] {level}: {message}";
+// a format spec needs fmt::vformat
+const std::string DYNAMIC_FORMAT = "[LemLib] {time:>8} {level}: {message}";
+
+/**
+ * @brief A sink that drops its messages, so only logging them is measured
+ */
+template <typename Base> class NullSink : public Base {
+    public:
+        explicit NullSink(const std::string& format) {
+            this->setFormat(format);
+            this->setLowestLevel(lemlib::Level::INFO);
+        }
+    protected:
+        void sendMessage(const lemlib::Message& message) override { benchmark::DoNotOptimize(message.message.data()); }
+};
+
+/**
+ * @brief Log through a sink from a task, the way the robot's code does
+ */
+template <typename Sink> void logFromTask(benchmark::State& state, const std::string& format) {
+    pros::Task task([&] {
+        Sink sink(format);
+        float x = 12.5f;
+        for (auto _ : state) {
+            sink.warn("pose: ({}, {}, {})", x, -36.25f, 90.0f);
+            x += 0.5f;
+        }
+    });
+    sim::run(pros::task_t(task), std::numeric_limits<uint32_t>::max());
+}
+
+void logFormatCacheHit(benchmark::State& state) {
+    lemlib::LogFormat::get(FORMAT);
+    for (auto _ : state) benchmark::DoNotOptimize(lemlib::LogFormat::get(FORMAT));
+}
+BENCHMARK(logFormatCacheHit);
+
+void logFormatCacheMiss(benchmark::State& state) {
+    for (auto _ : state) {
+        const lemlib::LogFormat format(FORMAT);
+        benchmark::DoNotOptimize(&format);
+    }
+}
+BENCHMARK(logFormatCacheMiss);
+
+void fastSinkLog(benchmark::State& state) { logFromTask<NullSink<lemlib::FastSink>>(state, FORMAT); }
+BENCHMARK(fastSinkLog)->UseRealTime();
+
+void fastSinkLogDynamic(benchmark::State& state) { logFromTask<NullSink<lemlib::FastSink>>(state, DYNAMIC_FORMAT); }
+BENCHMARK(fastSinkLogDynamic)->UseRealTime();
+
+void baseSinkLog(benchmark::State& state) { logFromTask<NullSink<lemlib::BaseSink>>(state, FORMAT); }
+BENCHMARK(baseSinkLog)->UseRealTime();
+} // namespace
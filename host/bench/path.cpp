@@ -0,0 +1,159 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "lemlib/chassis/purePursuit.hpp"
+#include "lemlib/path/compiledPath.hpp"
+#include "lemlib/path/pathSoA.hpp"
+#include "lemlib/path/spline.hpp"
+
+/**
+ * The per tick scans of Chassis::follow(), over a path stored as Poses (AoS) and as a PathSoA, for paths of 1k to 50k
+ * points.
+ *
+ * The closest point search always reads the whole path. The lookahead search starts at the start of the path, with the
+ * robot at its end, so it reads nearly all of it before it finds the segment that leaves the circle, which is the
+ * worst case, and what the first tick of a motion does.
+ *
+ * The spline cases time building a spline's arc length tables, sampling it by distance, and generating a path from it.
+ * The route cases compare generating the first leg of skillsAuton() on the brain with compiling it.
+ */
+namespace {
+constexpr size_t ROBOTS = 64;
+
+/**
+ * @brief A random, smoothly turning path, 0.5 inches between points, and robots near it
+ */
+struct Path {
+        std::vector<lemlib::Pose> points;
+        lemlib::PathSoA soa;
+        std::vector<lemlib::Pose> robots;
+        std::vector<lemlib::Pose> robotsAtEnd;
+
+        explicit Path(size_t size) {
+            std::mt19937 random(size);
+            std::uniform_real_distribution<float> turn(-0.05, 0.05);
+            std::uniform_real_distribution<float> offset(-3, 3);
+            float x = 0, y = 0, heading = 0;
+            for (size_t i = 0; i < size; i++) {
+                points.emplace_back(x, y, 100);
+                heading += turn(random);
+                x += 0.5f * std::cos(heading);
+                y += 0.5f * std::sin(heading);
+            }
+            soa = lemlib::PathSoA(points);
+            for (size_t i = 0; i < ROBOTS; i++) {
+                const lemlib::Pose& near = points[random() % size];
+                robots.emplace_back(near.x + offset(random), near.y + offset(random));
+                const lemlib::Pose& end = points[size - 1 - random() % 8];
+                robotsAtEnd.emplace_back(end.x + offset(random) / 10, end.y + offset(random) / 10);
+            }
+        }
+};
+
+const Path& path(size_t size) {
+    static std::vector<Path> paths;
+    for (const Path& path : paths) {
+        if (path.points.size() == size) return path;
+    }
+    return paths.emplace_back(size);
+}
+
+void aosClosest(benchmark::State& state) {
+    const Path& p = path(state.range(0));
+    size_t i = 0;
+    for (auto _ : state) benchmark::DoNotOptimize(lemlib::findClosest(p.robots[i++ % ROBOTS], p.points));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(aosClosest)->Arg(1000)->Arg(5000)->Arg(10000)->Arg(50000);
+
+void soaClosest(benchmark::State& state) {
+    const Path& p = path(state.range(0));
+    size_t i = 0;
+    for (auto _ : state) benchmark::DoNotOptimize(lemlib::findClosest(p.robots[i++ % ROBOTS], p.soa));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(soaClosest)->Arg(1000)->Arg(5000)->Arg(10000)->Arg(50000);
+
+void aosLookahead(benchmark::State& state) {
+    const Path& p = path(state.range(0));
+    const lemlib::Pose start(0, 0, 0);
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lemlib::lookaheadPoint(start, p.robotsAtEnd[i++ % ROBOTS], p.points, 0, 1));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(aosLookahead)->Arg(1000)->Arg(5000)->Arg(10000)->Arg(50000);
+
+void soaLookahead(benchmark::State& state) {
+    const Path& p = path(state.range(0));
+    const lemlib::Pose start(0, 0, 0);
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lemlib::lookaheadPoint(start, p.robotsAtEnd[i++ % ROBOTS], p.soa, 0, 1));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(soaLookahead)->Arg(1000)->Arg(5000)->Arg(10000)->Arg(50000);
+
+// a spline through this many waypoints, zigzagging 48 inches apart
+std::vector<lemlib::Pose> waypoints(size_t count) {
+    std::vector<lemlib::Pose> waypoints;
+    for (size_t i = 0; i < count; i++) waypoints.emplace_back(24 * (i % 2), 48 * i, i % 2 ? 45 : -45);
+    return waypoints;
+}
+
+// building the arc length tables, which is most of the cost of generating a path on the brain
+void splineBuild(benchmark::State& state) {
+    const std::vector<lemlib::Pose> points = waypoints(state.range(0));
+    for (auto _ : state) benchmark::DoNotOptimize(lemlib::QuinticHermite(points).length());
+}
+BENCHMARK(splineBuild)->Arg(2)->Arg(8)->Arg(32);
+
+// sampling by distance, which takes the same time however long the spline is
+void splineSample(benchmark::State& state) {
+    const lemlib::QuinticHermite spline(waypoints(state.range(0)));
+    const float step = spline.length() / 997;
+    float distance = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(spline.sample(distance));
+        benchmark::DoNotOptimize(spline.curvature(distance));
+        distance = distance + step > spline.length() ? 0 : distance + step;
+    }
+}
+BENCHMARK(splineSample)->Arg(2)->Arg(8)->Arg(32);
+
+void splineGenerate(benchmark::State& state) {
+    const lemlib::QuinticHermite spline(waypoints(state.range(0)));
+    for (auto _ : state) benchmark::DoNotOptimize(spline.generate());
+}
+BENCHMARK(splineGenerate)->Arg(2)->Arg(8)->Arg(32);
+
+// the first leg of skillsAuton(), from the starting pose to the match loader
+constexpr std::array<lemlib::Waypoint, 2> SKILLS_WAYPOINTS {{{-46.5, 0, 180}, {-54, -48, 270}}};
+constexpr lemlib::CompiledPath<64> SKILLS_ROUTE(lemlib::quinticHermiteSegments(SKILLS_WAYPOINTS));
+static_assert(SKILLS_ROUTE.maxCurvature < 1 / 6.0f, "the skills route turns tighter than a radius of 6 inches");
+static_assert(SKILLS_ROUTE.speed.back() == 0, "the skills route doesn't stop at the end");
+
+void runtimeRoute(benchmark::State& state) {
+    std::vector<lemlib::Pose> waypoints;
+    for (const lemlib::Waypoint& waypoint : SKILLS_WAYPOINTS) {
+        waypoints.emplace_back(waypoint.x, waypoint.y, waypoint.theta);
+    }
+    lemlib::PathSettings settings;
+    settings.spacing = SKILLS_ROUTE.spacing;
+    for (auto _ : state) {
+        const lemlib::PathAsset path(lemlib::QuinticHermite(waypoints).generate(settings));
+        benchmark::DoNotOptimize(static_cast<const asset&>(path).size);
+    }
+}
+BENCHMARK(runtimeRoute);
+
+void compiledRoute(benchmark::State& state) {
+    for (auto _ : state) benchmark::DoNotOptimize(SKILLS_ROUTE.file().size);
+}
+BENCHMARK(compiledRoute);
+} // namespace
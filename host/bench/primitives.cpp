@@ -0,0 +1,299 @@
+#include <array>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/odom.hpp"
+#include "lemlib/exitcondition.hpp"
+#include "lemlib/math/angle.hpp"
+#include "lemlib/math/se2.hpp"
+#include "lemlib/pid.hpp"
+#include "lemlib/pose.hpp"
+#include "lemlib/util.hpp"
+#include "sim/devices.hpp"
+
+/**
+ * Microbenchmarks of the math and control primitives the chassis runs each control loop tick, and of the odometry
+ * update.
+ *
+ * The inputs cycle through a table of random values, so that the compiler can't fold the work away, and so that
+ * branches aren't predicted any better than they would be on the robot. Run the bench target to write the results to
+ * bench.json, in Google Benchmark's JSON format, to compare them across commits.
+ */
+namespace {
+// a power of 2, so wrapping the index is cheap next to what is measured
+constexpr size_t INPUTS = 1024;
+
+/**
+ * @brief Random inputs for a benchmark
+ */
+struct Inputs {
+        std::array<float, INPUTS> values;
+        std::vector<lemlib::Pose> poses;
+
+        Inputs() {
+            std::mt19937 random(INPUTS);
+            std::uniform_real_distribution<float> distribution(-100, 100);
+            for (float& value : values) value = distribution(random);
+            for (size_t i = 0; i < INPUTS; i++) {
+                poses.emplace_back(distribution(random), distribution(random), distribution(random) / 10);
+            }
+        }
+};
+
+const Inputs inputs;
+
+float value(size_t i) { return inputs.values[i % INPUTS]; }
+
+const lemlib::Pose& pose(size_t i) { return inputs.poses[i % INPUTS]; }
+
+void poseAdd(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pose(i) + pose(i + 1));
+        i++;
+    }
+}
+BENCHMARK(poseAdd);
+
+void poseSubtract(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pose(i) - pose(i + 1));
+        i++;
+    }
+}
+BENCHMARK(poseSubtract);
+
+void poseDot(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pose(i) * pose(i + 1));
+        i++;
+    }
+}
+BENCHMARK(poseDot);
+
+void poseScale(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pose(i) * value(i));
+        i++;
+    }
+}
+BENCHMARK(poseScale);
+
+void poseDivide(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pose(i) / value(i));
+        i++;
+    }
+}
+BENCHMARK(poseDivide);
+
+void poseLerp(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pose(i).lerp(pose(i + 1), 0.5));
+        i++;
+    }
+}
+BENCHMARK(poseLerp);
+
+void poseDistance(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pose(i).distance(pose(i + 1)));
+        i++;
+    }
+}
+BENCHMARK(poseDistance);
+
+void poseAngle(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pose(i).angle(pose(i + 1)));
+        i++;
+    }
+}
+BENCHMARK(poseAngle);
+
+void poseRotate(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pose(i).rotate(value(i)));
+        i++;
+    }
+}
+BENCHMARK(poseRotate);
+
+// the poses as transforms, converted up front, since the conversion calls sin and cos
+const std::vector<lemlib::SE2f> transforms = [] {
+    std::vector<lemlib::SE2f> transforms;
+    for (const lemlib::Pose& pose : inputs.poses) transforms.emplace_back(pose);
+    return transforms;
+}();
+
+const lemlib::SE2f& transform(size_t i) { return transforms[i % INPUTS]; }
+
+void se2Compose(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(transform(i) * transform(i + 1));
+        i++;
+    }
+}
+BENCHMARK(se2Compose);
+
+void se2TransformPoint(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(transform(i) * lemlib::SE2f::Point {value(i), value(i + 1)});
+        i++;
+    }
+}
+BENCHMARK(se2TransformPoint);
+
+void se2Exp(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lemlib::SE2f::exp({value(i), value(i + 1), value(i + 2) / 100}));
+        i++;
+    }
+}
+BENCHMARK(se2Exp);
+
+void se2Log(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(transform(i).log());
+        i++;
+    }
+}
+BENCHMARK(se2Log);
+
+void angleError(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lemlib::angleError(value(i), value(i + 1), true));
+        i++;
+    }
+}
+BENCHMARK(angleError);
+
+void angleErrorDegrees(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lemlib::angleError(value(i) * 10, value(i + 1) * 10, false));
+        i++;
+    }
+}
+BENCHMARK(angleErrorDegrees);
+
+// lemlib::sanitizeAngle can only be called from util.cpp, so this measures lemlib::math's copy of it
+void sanitizeAngle(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lemlib::math::sanitizeAngle(value(i), true));
+        i++;
+    }
+}
+BENCHMARK(sanitizeAngle);
+
+void getCurvature(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lemlib::getCurvature(pose(i), pose(i + 1)));
+        i++;
+    }
+}
+BENCHMARK(getCurvature);
+
+void slew(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lemlib::slew(value(i), value(i + 1), 5));
+        i++;
+    }
+}
+BENCHMARK(slew);
+
+void ema(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lemlib::ema(value(i), value(i + 1), 0.2));
+        i++;
+    }
+}
+BENCHMARK(ema);
+
+// avg() takes its vector by value, so this includes the copy, like every call does
+void avg(benchmark::State& state) {
+    const std::vector<float> values(inputs.values.begin(), inputs.values.begin() + state.range(0));
+    for (auto _ : state) benchmark::DoNotOptimize(lemlib::avg(values));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(avg)->Arg(2)->Arg(6)->Arg(64);
+
+void pidUpdate(benchmark::State& state) {
+    lemlib::PID pid(8.5, 0.01, 43, 3, true);
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pid.update(value(i)));
+        i++;
+    }
+}
+BENCHMARK(pidUpdate);
+
+void exitConditionUpdate(benchmark::State& state) {
+    lemlib::ExitCondition exit(1, 100);
+    size_t i = 0;
+    for (auto _ : state) {
+        // mostly inside the range, so the timer runs
+        benchmark::DoNotOptimize(exit.update(value(i) / 90));
+        i++;
+        if (i % INPUTS == 0) exit.reset();
+    }
+}
+BENCHMARK(exitConditionUpdate);
+
+void expoDriveCurve(benchmark::State& state) {
+    lemlib::ExpoDriveCurve curve(3, 10, 1.019);
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(curve.curve(value(i) * 1.27f));
+        i++;
+    }
+}
+BENCHMARK(expoDriveCurve);
+
+// one odometry update with main.cpp's sensors: a vertical and a horizontal tracking wheel, and an IMU
+void odomUpdate(benchmark::State& state) {
+    pros::Rotation verticalEncoder(-6);
+    pros::Rotation horizontalEncoder(-15);
+    pros::Imu imu(4);
+    lemlib::TrackingWheel vertical(&verticalEncoder, lemlib::Omniwheel::NEW_2, -4.5);
+    lemlib::TrackingWheel horizontal(&horizontalEncoder, lemlib::Omniwheel::NEW_2, 0.5);
+    lemlib::setSensors(lemlib::OdomSensors(&vertical, nullptr, &horizontal, nullptr, &imu),
+                       lemlib::Drivetrain(nullptr, nullptr, 10.95, lemlib::Omniwheel::NEW_4, 450, 8));
+    sim::RotationDevice& verticalDevice = *sim::rotation(6);
+    sim::RotationDevice& horizontalDevice = *sim::rotation(15);
+    sim::ImuDevice& imuDevice = *sim::imu(4);
+    size_t i = 0;
+    for (auto _ : state) {
+        // the sensors move a little each tick, like they do while the robot drives
+        verticalDevice.position += static_cast<int32_t>(value(i) * 10);
+        horizontalDevice.position += static_cast<int32_t>(value(i + 1));
+        imuDevice.yaw += value(i + 2) / 100;
+        lemlib::update();
+        i++;
+    }
+    benchmark::DoNotOptimize(lemlib::getPose());
+}
+BENCHMARK(odomUpdate);
+} // namespace
+
+BENCHMARK_MAIN();
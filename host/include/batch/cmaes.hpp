@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace batch {
+/**
+ * @brief Covariance matrix adaptation evolution strategy, a black box minimizer
+ *
+ * Each generation samples candidates from a multivariate normal distribution, then moves the distribution's mean
+ * towards the best of them, and stretches its covariance along the directions that paid off. It needs nothing but the
+ * cost of each candidate, copes with noisy costs and parameters that interact, and a generation's candidates can be
+ * evaluated in parallel. This follows Hansen's "The CMA Evolution Strategy: A Tutorial" (2016).
+ *
+ * Use it by asking for a generation of candidates, evaluating them, and telling it their costs, until it converges.
+ */
+class CmaEs {
+    public:
+        /**
+         * @brief Construct a new CMA-ES
+         *
+         * @param mean where to start the search
+         * @param sigma initial step size, in the units of the parameters. About a third of the range the optimum might
+         * be in
+         * @param seed seed of the sampling
+         * @param populationSize candidates per generation. 0 for the default, 4 + 3 ln(dimensions)
+         */
+        CmaEs(std::vector<double> mean, double sigma, uint64_t seed, unsigned populationSize = 0);
+
+        /**
+         * @brief Sample the next generation's candidates
+         *
+         * @return const std::vector<std::vector<double>>& the candidates
+         */
+        const std::vector<std::vector<double>>& ask();
+
+        /**
+         * @brief Update the distribution with the costs of the candidates ask() returned
+         *
+         * @param costs cost of each candidate, in the same order. Lower is better
+         */
+        void tell(const std::vector<double>& costs);
+
+        /**
+         * @brief Get the mean of the distribution, the best guess at the optimum
+         *
+         * @return const std::vector<double>&
+         */
+        const std::vector<double>& getMean() const;
+
+        /**
+         * @brief Get the step size
+         *
+         * @return double
+         */
+        double getSigma() const;
+
+        /**
+         * @brief Get the number of candidates in a generation
+         *
+         * @return unsigned
+         */
+        unsigned getPopulationSize() const;
+    private:
+        /**
+         * @brief Decompose the covariance matrix into its eigenvectors and eigenvalues
+         */
+        void decompose();
+
+        unsigned dimensions;
+        unsigned populationSize;
+        /** how many of the best candidates the mean moves towards */
+        unsigned parents;
+        std::vector<double> weights;
+        double parentsEffective;
+        // learning rates, see the tutorial
+        double cumulationC, cumulationSigma, rankOne, rankMu, damping, expectedNorm;
+        std::vector<double> mean;
+        double sigma;
+        /** covariance matrix, row major */
+        std::vector<double> covariance;
+        /** eigenvectors of the covariance matrix, as columns */
+        std::vector<double> basis;
+        /** square roots of the eigenvalues of the covariance matrix */
+        std::vector<double> scales;
+        std::vector<double> pathC;
+        std::vector<double> pathSigma;
+        unsigned generation = 0;
+        std::vector<std::vector<double>> candidates;
+        std::mt19937_64 random;
+};
+} // namespace batch
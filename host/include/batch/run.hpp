@@ -0,0 +1,77 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "sim/robot.hpp"
+
+/**
+ * @brief Running the robot program in batches
+ *
+ * The host kernel and devices are global, so one process can only simulate one robot. Each run is its own process
+ * instead: robot (host/runner.cpp) is started with the run's options, and its results are read from what it prints.
+ * That also keeps a run that crashes or deadlocks from taking the batch down with it.
+ */
+namespace batch {
+/**
+ * @brief How the robot responded to a step, see robot --steps
+ */
+struct StepResult {
+        bool turn = false;
+        /** distance to drive, in inches, or angle to turn, in degrees */
+        double amount = 0;
+        /** how long the motion took, in seconds */
+        double duration = 0;
+        /** when the robot settled within the tolerance of the target for good, in seconds */
+        double settle = 0;
+        /** how far the robot went past the target, in inches or degrees */
+        double overshoot = 0;
+        /** how far from the target the robot ended up, in inches or degrees */
+        double error = 0;
+        /** false if the robot didn't settle before the step ended */
+        bool settled = true;
+        bool timedOut = false;
+};
+
+/**
+ * @brief What a run of autonomous, or of the step responses, did
+ */
+struct RunResult {
+        /** whether the run printed its results. False if the program crashed, deadlocked or ran out of time */
+        bool ok = false;
+        /** whether autonomous returned before its time ran out */
+        bool finished = false;
+        /** how long autonomous ran for, in seconds */
+        double duration = 0;
+        /** where odometry thinks the robot ended up */
+        sim::Pose odometry = {0, 0, 0};
+        /** where the robot actually ended up */
+        sim::Pose actual = {0, 0, 0};
+        /** how long each motion took to settle, in seconds, in the order they ran */
+        std::vector<double> motions;
+        /** the step responses, if the run was of them */
+        std::vector<StepResult> steps;
+        /** the arguments of the chassis' lemlib::ControllerSettings */
+        std::vector<double> lateralSettings;
+        std::vector<double> angularSettings;
+};
+
+/**
+ * @brief Get the path of the robot program, which is built next to the batch tools
+ *
+ * @return std::string
+ */
+std::string robotPath();
+
+/**
+ * @brief Run the robot program, and wait for it to finish
+ *
+ * Safe to call from several threads at once. A program still running after the timeout is killed, and its run
+ * isn't ok.
+ *
+ * @param arguments arguments to robot, see host/runner.cpp
+ * @param timeout how long to let it run for, in seconds of wall clock time
+ * @return RunResult
+ */
+RunResult run(const std::vector<std::string>& arguments, int timeout = 300);
+} // namespace batch
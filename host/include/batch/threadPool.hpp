@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace batch {
+/**
+ * @brief A work stealing thread pool
+ *
+ * Each worker has its own queue of jobs. Jobs are handed out to the queues in turn, and a job submitted from a worker
+ * goes on that worker's own queue. Workers take their newest job first, so the jobs a job submits run while their data
+ * is still in cache, and when a worker's queue is empty it steals the oldest job from another worker, so no core sits
+ * idle while there is work left. Batch runs vary a lot in length, since a run that times out takes far longer than
+ * one that doesn't, and stealing evens that out.
+ *
+ * Submitting and taking a job only lock the queues involved. The pool's own mutex is only taken to sleep when there
+ * are no jobs, to wake a worker that is asleep, and when the last job finishes.
+ */
+class ThreadPool {
+    public:
+        /**
+         * @brief Construct a new Thread Pool
+         *
+         * @param threads number of workers. 0 for one per core
+         */
+        explicit ThreadPool(unsigned threads = 0);
+
+        /**
+         * @brief Wait for the jobs to finish, then stop the workers
+         */
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * @brief Queue a job
+         *
+         * @param job the job. It must not throw
+         */
+        void submit(std::function<void()> job);
+
+        /**
+         * @brief Wait until every job submitted so far has finished
+         *
+         * Must not be called from a job.
+         */
+        void wait();
+
+        /**
+         * @brief Get the number of workers
+         *
+         * @return unsigned
+         */
+        unsigned size() const;
+    private:
+        /**
+         * @brief A worker's queue of jobs
+         */
+        struct Queue {
+                std::mutex mutex;
+                std::deque<std::function<void()>> jobs;
+        };
+
+        /**
+         * @brief Claim one of the queued jobs, if there is one
+         *
+         * @return whether a job was claimed
+         */
+        bool claim();
+
+        /**
+         * @brief Take a job, from a worker's own queue or stolen from another's
+         *
+         * @param worker the worker
+         * @param job set to the job
+         * @return whether there was a job
+         */
+        bool take(unsigned worker, std::function<void()>& job);
+
+        /**
+         * @brief Run jobs until the pool stops
+         *
+         * @param worker the worker
+         */
+        void work(unsigned worker);
+
+        std::vector<std::unique_ptr<Queue>> queues;
+        std::vector<std::thread> threads;
+        /** what the workers sleep on when there are no jobs, and wait() on until they finish */
+        std::mutex mutex;
+        std::condition_variable available;
+        std::condition_variable finished;
+        /** jobs that are queued and not yet claimed by a worker */
+        std::atomic<size_t> queued = 0;
+        /** jobs that are queued or running */
+        std::atomic<size_t> unfinished = 0;
+        /** workers that are asleep, or about to be */
+        std::atomic<unsigned> sleeping = 0;
+        /** queue the next job from outside the pool goes on */
+        std::atomic<unsigned> next = 0;
+        /** guarded by the mutex */
+        bool stopping = false;
+};
+} // namespace batch
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <vector>
+
+#include "lemlib/path/pathSoA.hpp"
+#include "lemlib/pose.hpp"
+
+/**
+ * @brief The geometry of one pure pursuit step, which Chassis::follow() runs each tick
+ *
+ * Not part of LemLib's API. The host build exposes it so that it can be benchmarked on its own.
+ */
+namespace lemlib {
+/**
+ * @brief Find the point on a path closest to the robot
+ *
+ * @param pose the robot
+ * @param path the points of the path
+ * @return int index of the closest point
+ */
+int findClosest(Pose pose, const std::vector<Pose>& path);
+
+/**
+ * @brief Find the point on a path closest to the robot, 4 points at a time
+ *
+ * Host and QEMU only, for the benchmarks and the QEMU harness. Chassis::follow() uses the std::vector<Pose> version,
+ * like the LemLib template.
+ *
+ * @param pose the robot
+ * @param path the path
+ * @return int index of the closest point
+ */
+int findClosest(Pose pose, const PathSoA& path);
+
+/**
+ * @brief Find where a segment of the path intersects the lookahead circle
+ *
+ * @param p1 start of the segment
+ * @param p2 end of the segment
+ * @param pose the robot, at the center of the circle
+ * @param lookaheadDist radius of the circle
+ * @return float how far along the segment the intersection is, from 0 to 1, or -1 if there isn't one. The one further
+ * along the path if there are two
+ */
+float circleIntersect(Pose p1, Pose p2, Pose pose, float lookaheadDist);
+
+/**
+ * @brief Find the lookahead point
+ *
+ * @param lastLookahead the last lookahead point. Its theta is the index of the segment it is on, so the robot never
+ * goes back along the path
+ * @param pose the robot
+ * @param path the points of the path
+ * @param closest index of the point on the path closest to the robot
+ * @param lookaheadDist radius of the lookahead circle
+ * @return Pose the lookahead point, with the index of its segment as its theta. The last lookahead point if the
+ * robot left the path
+ */
+Pose lookaheadPoint(Pose lastLookahead, Pose pose, const std::vector<Pose>& path, int closest, float lookaheadDist);
+
+/**
+ * @brief Find the lookahead point, testing 4 segments at a time
+ *
+ * Host and QEMU only, like findClosest(Pose, const PathSoA&).
+ *
+ * @param lastLookahead the last lookahead point, with the index of its segment as its theta
+ * @param pose the robot
+ * @param path the path
+ * @param closest index of the point on the path closest to the robot
+ * @param lookaheadDist radius of the lookahead circle
+ * @return Pose the lookahead point, with the index of its segment as its theta. The last lookahead point if the
+ * robot left the path
+ */
+Pose lookaheadPoint(Pose lastLookahead, Pose pose, const PathSoA& path, int closest, float lookaheadDist);
+} // namespace lemlib
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include "lemlib/pose.hpp"
+
+namespace lemlib {
+/**
+ * @brief A path, with each of its fields in its own array
+ *
+ * Pure pursuit scans the path every tick, for the point closest to the robot and for where the path leaves the
+ * lookahead circle. Stored as Poses, each scan strides over fields it doesn't read. Here x, y, velocity, curvature and
+ * arc length each have their own array, aligned for SIMD, so the scans read only x and y, 4 points at a time, with
+ * NEON on an ARM build and SSE on a computer.
+ *
+ * This is a host and QEMU only adaptation. The robot links the prebuilt LemLib template, whose Chassis::follow()
+ * scans a std::vector<Pose>, and so does host/lemlib's copy, so that the simulator predicts the robot. PathSoA is used
+ * by the benchmarks and the QEMU harness, to measure what the layout would save. It lives under host/, so it isn't
+ * compiled into the robot's image.
+ *
+ * The arrays are padded to a whole number of vectors, plus one more for the end of the last segment, with NaN
+ * coordinates, which are never the closest point and never intersect anything, so the scans need no scalar tail.
+ */
+class PathSoA {
+    public:
+        /**
+         * @brief The result of an intersection search
+         */
+        struct Intersection {
+                /** index of the segment's first point, or -1 if no segment intersects the circle */
+                int segment;
+                /** how far along the segment the intersection is, from 0 to 1 */
+                float t;
+        };
+
+        /**
+         * @brief Construct an empty path
+         */
+        PathSoA() = default;
+
+        /**
+         * @brief Construct a path from its points, as they are read from a path file
+         *
+         * @param points the points, with the velocity at each point as its theta
+         */
+        explicit PathSoA(const std::vector<Pose>& points);
+
+        /**
+         * @brief Get the number of points
+         */
+        size_t size() const { return count; }
+
+        /**
+         * @brief Check whether the path has no points
+         */
+        bool empty() const { return count == 0; }
+
+        /** x coordinates, padded as described above */
+        const float* x() const { return data.data(); }
+
+        /** y coordinates */
+        const float* y() const { return data.data() + stride; }
+
+        /** velocity at each point, from the path file */
+        const float* velocity() const { return data.data() + 2 * stride; }
+
+        /** signed curvature of the circle through each point and its neighbours, 0 at the ends. Positive turns left */
+        const float* curvature() const { return data.data() + 3 * stride; }
+
+        /** distance along the path from the first point */
+        const float* arcLength() const { return data.data() + 4 * stride; }
+
+        /**
+         * @brief Get a point as it was read from the path file
+         *
+         * @param index index of the point
+         * @return Pose the point, with its velocity as its theta
+         */
+        Pose point(size_t index) const { return Pose(x()[index], y()[index], velocity()[index]); }
+
+        /**
+         * @brief Find the point closest to a position
+         *
+         * @return size_t index of the closest point, the first one if several are as close. 0 if the path is empty
+         */
+        size_t closest(float x, float y) const;
+
+        /**
+         * @brief Find the first segment, from a point on, that leaves a circle
+         *
+         * Each segment is tested the way lemlib::circleIntersect() tests it, so the intersection is the one further
+         * along the segment if there are two.
+         *
+         * @param start index of the first segment to test
+         * @param x center of the circle
+         * @param y center of the circle
+         * @param radius radius of the circle
+         * @return Intersection the first segment that intersects the circle, or a segment of -1 if none do
+         */
+        Intersection intersect(size_t start, float x, float y, float radius) const;
+    private:
+        /**
+         * @brief Allocates memory aligned for SIMD loads
+         */
+        template <typename T> struct AlignedAllocator {
+                using value_type = T;
+                static constexpr std::align_val_t ALIGNMENT {16};
+
+                AlignedAllocator() = default;
+
+                template <typename U> AlignedAllocator(const AlignedAllocator<U>&) {}
+
+                T* allocate(size_t n) { return static_cast<T*>(::operator new(n * sizeof(T), ALIGNMENT)); }
+
+                void deallocate(T* pointer, size_t n) { ::operator delete(pointer, n * sizeof(T), ALIGNMENT); }
+
+                template <typename U> bool operator==(const AlignedAllocator<U>&) const { return true; }
+        };
+
+        /** number of points */
+        size_t count = 0;
+        /** length of each padded array */
+        size_t stride = 0;
+        /** the arrays, one after another */
+        std::vector<float, AlignedAllocator<float>> data;
+};
+} // namespace lemlib
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <cstdint>
+
+#include "pros/abstract_motor.hpp"
+#include "pros/imu.h"
+#include "pros/misc.h"
+
+/**
+ * @brief State of the devices the host build's PROS devices read and write
+ *
+ * The PROS device classes only read and write this state, like the brain only exchanges packets with its devices.
+ * Nothing moves on its own: code that simulates the robot reads the motors' commands and writes what the sensors
+ * measure. Positions and velocities are of the device itself, before any reversal the program sets up.
+ */
+namespace sim {
+/**
+ * @brief How a motor is commanded
+ */
+enum class MotorControl { VOLTAGE, VELOCITY, POSITION, BRAKE };
+
+/**
+ * @brief A V5 smart motor
+ */
+struct MotorDevice {
+        // set by the program
+        MotorControl control = MotorControl::VOLTAGE;
+        /** commanded voltage, in millivolts */
+        int32_t targetVoltage = 0;
+        /** commanded velocity, in rpm */
+        int32_t targetVelocity = 0;
+        /** commanded position, in degrees */
+        double targetPosition = 0;
+        pros::MotorGears gearing = pros::MotorGears::green;
+        pros::MotorBrake brakeMode = pros::MotorBrake::coast;
+        pros::MotorUnits encoderUnits = pros::MotorUnits::degrees;
+        /** current limit, in milliamps */
+        int32_t currentLimit = 2500;
+        /** voltage limit, in millivolts, or 0 for no limit */
+        int32_t voltageLimit = 0;
+        /** position the program set as 0, in degrees */
+        double zeroPosition = 0;
+
+        // measured
+        /** position of the output shaft, in degrees */
+        double position = 0;
+        /** velocity of the output shaft, in rpm */
+        double velocity = 0;
+        /** current draw, in milliamps */
+        int32_t current = 0;
+        /** voltage applied to the motor, in millivolts */
+        int32_t voltage = 0;
+        /** torque, in newton meters */
+        double torque = 0;
+        /** temperature, in degrees celsius */
+        double temperature = 25;
+};
+
+/**
+ * @brief A V5 inertial sensor
+ */
+struct ImuDevice {
+        // measured
+        /** heading, clockwise, in degrees. Not wrapped around */
+        double yaw = 0;
+        double pitch = 0;
+        double roll = 0;
+        pros::imu_gyro_s_t gyro = {0, 0, 0};
+        pros::imu_accel_s_t accel = {0, 0, 0};
+        /** calibration ends at this time, in microseconds */
+        uint64_t calibrationEnd = 0;
+
+        // offsets from the program taring or setting the angles
+        double rotationOffset = 0;
+        double headingOffset = 0;
+        double yawOffset = 0;
+        double pitchOffset = 0;
+        double rollOffset = 0;
+};
+
+/**
+ * @brief A V5 rotation sensor
+ */
+struct RotationDevice {
+        /** set by the program */
+        bool reversed = false;
+        /** position the program set as 0, in centidegrees */
+        int32_t zeroPosition = 0;
+
+        // measured
+        /** position, in centidegrees. Not wrapped around */
+        int32_t position = 0;
+        /** velocity, in centidegrees per second */
+        int32_t velocity = 0;
+};
+
+/**
+ * @brief A V5 controller
+ */
+struct ControllerDevice {
+        bool connected = true;
+        /** joystick positions, from -127 to 127, indexed by pros::controller_analog_e_t */
+        int8_t analog[4] = {};
+        /** buttons held, bit (button - E_CONTROLLER_DIGITAL_L1) */
+        uint16_t buttons = 0;
+};
+
+/**
+ * @brief The robot battery
+ */
+struct BatteryDevice {
+        /** charge, in percent */
+        double capacity = 100;
+        /** voltage, in millivolts */
+        int32_t voltage = 12800;
+        /** current draw, in milliamps */
+        int32_t current = 0;
+        /** temperature, in degrees celsius */
+        double temperature = 25;
+};
+
+/**
+ * @brief Get the motor on a smart port
+ *
+ * @param port the port, from 1 to 21. Reversed ports are negative
+ * @return MotorDevice*, or nullptr if the port doesn't exist
+ */
+MotorDevice* motor(int8_t port);
+
+/**
+ * @brief Get the inertial sensor on a smart port
+ *
+ * @param port the port, from 1 to 21
+ * @return ImuDevice*, or nullptr if the port doesn't exist
+ */
+ImuDevice* imu(uint8_t port);
+
+/**
+ * @brief Get the rotation sensor on a smart port
+ *
+ * @param port the port, from 1 to 21. Reversed ports are negative
+ * @return RotationDevice*, or nullptr if the port doesn't exist
+ */
+RotationDevice* rotation(int8_t port);
+
+/**
+ * @brief Get the value of an ADI port of the brain
+ *
+ * @param port the port, from 1 to 8, or from 'a' to 'h'
+ * @return int32_t*, or nullptr if the port doesn't exist
+ */
+int32_t* adi(uint8_t port);
+
+/**
+ * @brief Get a controller
+ *
+ * @param id the controller
+ * @return ControllerDevice&
+ */
+ControllerDevice& controller(pros::controller_id_e_t id);
+
+/**
+ * @brief Get the battery
+ *
+ * @return BatteryDevice&
+ */
+BatteryDevice& battery();
+
+/**
+ * @brief Get the competition status the program sees
+ *
+ * @return uint8_t& a mask of pros::competition_status bits
+ */
+uint8_t& competitionStatus();
+} // namespace sim
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+#include "pros/rtos.h"
+
+/**
+ * @brief Control of the host build's PROS kernel
+ *
+ * On the host, tasks are threads, but only one of them runs at a time, picked the way the brain's scheduler would:
+ * the highest priority ready task runs until it blocks, and tasks of the same priority take turns in the order they
+ * became ready. Time is virtual. It only moves forward when every task is blocked, straight to the next time a task
+ * wakes up, so code runs as if it took no time at all, and a 60 second autonomous run takes milliseconds. Runs are
+ * deterministic, since nothing depends on the host's scheduler or clock.
+ *
+ * The kernel starts paused. The thread that calls run() isn't a task: it creates the tasks to run, then waits while
+ * they run until the task it waits for returns or the time runs out.
+ */
+namespace sim {
+/**
+ * @brief Why run() returned
+ */
+enum class RunResult {
+    /** the task run() waited for returned, or was deleted */
+    FINISHED,
+    /** the time ran out */
+    TIMEOUT,
+    /** every task is blocked forever, for example waiting for a mutex that will never be given */
+    DEADLOCK
+};
+
+/**
+ * @brief Run the tasks until a task returns, or until a time limit
+ *
+ * Must not be called from a task. Tasks that are still running when it returns are paused, and continue on the next
+ * call.
+ *
+ * @param task the task to wait for, or nullptr to run until the time runs out
+ * @param timeout maximum amount of virtual time to run for, in milliseconds
+ * @return RunResult why it returned
+ */
+RunResult run(pros::task_t task, uint32_t timeout);
+
+/**
+ * @brief Get the virtual time
+ *
+ * @return uint64_t time since the kernel started, in microseconds
+ */
+uint64_t time();
+
+/**
+ * @brief Add a function that is called each time the virtual clock moves forward by a millisecond, before the tasks
+ * waiting for that millisecond are woken up
+ *
+ * Used to step simulated hardware. It runs on the thread that moves the clock forward, while no task is running, so it
+ * must not call the kernel.
+ *
+ * @param hook the function, called with the new time in microseconds
+ */
+void addTickHook(std::function<void(uint64_t)> hook);
+} // namespace sim
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Record of the chassis' motions
+ *
+ * The host build's LemLib reports when each motion starts moving and when it exits, so that runs can be scored by how
+ * long each motion took to settle. A motion's time includes waiting for its exit conditions, but not waiting in the
+ * queue behind the motion before it.
+ */
+namespace sim {
+/**
+ * @brief A motion of the chassis, in virtual time
+ */
+struct Motion {
+        /** when the motion started, in microseconds */
+        uint64_t start;
+        /** when the motion exited, in microseconds, or 0 if it's still running */
+        uint64_t end;
+};
+
+/**
+ * @brief Record that a motion started
+ */
+void motionStarted();
+
+/**
+ * @brief Record that the motion that started last exited
+ */
+void motionEnded();
+
+/**
+ * @brief Get the motions so far, in the order they started
+ *
+ * @return const std::vector<Motion>&
+ */
+const std::vector<Motion>& motions();
+} // namespace sim
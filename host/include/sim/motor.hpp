@@ -0,0 +1,74 @@
+#pragma once
+
+#include "sim/devices.hpp"
+
+namespace sim {
+/**
+ * @brief Electrical and thermal model of a V5 smart motor
+ *
+ * The motor is a DC motor behind the firmware's controller. The controller turns the command the program sent into a
+ * voltage, no higher than the battery's, and the current through the windings is limited to the motor's current
+ * limit. That limit is what flattens the torque–speed curve at low speeds: an 11 W motor at 12 V would draw about 5 A
+ * at stall, but only gets 2.5 A. Above 55 °C the firmware halves the limit every 5 °C, like the real motors do.
+ *
+ * Everything is in SI units, at the output shaft of the cartridge, in the direction of the motor itself (before any
+ * reversal the program sets up).
+ */
+class MotorModel {
+    public:
+        /**
+         * @brief Torque and current of the motor for a step
+         */
+        struct Output {
+                /** torque at the output shaft, in newton meters */
+                double torque;
+                /** current through the windings, in amps */
+                double current;
+                /** current drawn from the battery, in amps */
+                double batteryCurrent;
+                /** voltage across the windings, in volts */
+                double voltage;
+        };
+
+        /**
+         * @brief Compute the torque of the motor for the next step, from its commands and the speed of its shaft
+         *
+         * @param device the motor
+         * @param speed speed of the output shaft, in radians per second
+         * @param batteryVoltage voltage of the battery, in volts
+         * @return Output
+         */
+        Output update(MotorDevice& device, double speed, double batteryVoltage);
+
+        /**
+         * @brief Move the motor's shaft, and update what the motor measures
+         *
+         * @param device the motor
+         * @param output what update() returned for this step
+         * @param speed speed of the output shaft at the end of the step, in radians per second
+         * @param dt length of the step, in seconds
+         */
+        void step(MotorDevice& device, const Output& output, double speed, double dt);
+
+        /**
+         * @brief Get the stall torque of a cartridge, at the default current limit
+         *
+         * @param gearing the cartridge
+         * @return double torque, in newton meters
+         */
+        static double stallTorque(pros::MotorGears gearing);
+
+        /**
+         * @brief Get the free speed of a cartridge, at 12 V
+         *
+         * @param gearing the cartridge
+         * @return double speed, in radians per second
+         */
+        static double freeSpeed(pros::MotorGears gearing);
+    private:
+        /** whether the motor was braking in hold mode last step */
+        bool holding = false;
+        /** position to hold, in radians */
+        double holdPosition = 0;
+};
+} // namespace sim
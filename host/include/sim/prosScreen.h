@@ -0,0 +1,15 @@
+#pragma once
+
+/**
+ * Included before everything else in the files of the robot program, which include the kernel's pros/screen.h
+ * through main.h.
+ *
+ * screen.h defines _GNU_SOURCE around its include of stdio.h and undefines it after. g++ already defines it, so the
+ * header warns that it is redefined, and takes the compiler's definition away from the rest of the file. Including it
+ * here first, with the compiler's definition set aside and put back after, leaves the kernel's header as shipped; its
+ * include guard skips it when main.h includes it again.
+ */
+#pragma push_macro("_GNU_SOURCE")
+#undef _GNU_SOURCE
+#include "pros/screen.h"
+#pragma pop_macro("_GNU_SOURCE")
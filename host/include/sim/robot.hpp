@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "sim/motor.hpp"
+
+namespace sim {
+/**
+ * @brief Position and heading of the robot
+ *
+ * Like LemLib's: in inches, and the heading is in degrees, clockwise from the y axis.
+ */
+struct Pose {
+        double x;
+        double y;
+        double theta;
+};
+
+/**
+ * @brief A tracking wheel with a rotation sensor
+ */
+struct TrackingWheelConfig {
+        /** port of the rotation sensor. Negative if the sensor turns backwards when the wheel rolls forwards */
+        int8_t port;
+        /** diameter of the wheel, in inches */
+        double diameter;
+        /**
+         * offset from the tracking center, in inches. Like LemLib's: to the right for vertical wheels, and forwards for
+         * horizontal wheels
+         */
+        double offset;
+        /** rotations of the sensor per rotation of the wheel */
+        double gearRatio = 1;
+};
+
+/**
+ * @brief How noisy the sensors are
+ */
+struct NoiseConfig {
+        /** standard deviation of the distance the tracking wheels measure, relative to what they roll */
+        double trackingWheelSlip = 0.005;
+        /** standard deviation of the IMU's heading, in degrees */
+        double imuNoise = 0.01;
+        /** how fast the IMU's bias wanders: the standard deviation of its change over a second, in degrees */
+        double imuDrift = 0.002;
+        /** error in the IMU's scale, relative to the angle it turns */
+        double imuScale = 0;
+        /** standard deviation of each drivetrain motor's torque, relative to a typical motor's */
+        double motorVariation = 0;
+};
+
+/**
+ * @brief A robot with a differential drivetrain
+ */
+struct RobotConfig {
+        /** ports of the motors. Negative if the motor turns backwards when the robot drives forwards */
+        std::vector<int8_t> leftMotors;
+        std::vector<int8_t> rightMotors;
+        /** distance between the left and right wheels, in inches */
+        double trackWidth;
+        /** in inches */
+        double wheelDiameter;
+        /** rpm of the wheels when the motors turn at their cartridge's speed */
+        double rpm;
+        /** LemLib's horizontal drift: 2 for a drivetrain of omni wheels, 8 with traction wheels */
+        double horizontalDrift;
+        std::vector<TrackingWheelConfig> verticalWheels;
+        std::vector<TrackingWheelConfig> horizontalWheels;
+        /** port of the IMU, or 0 if there isn't one */
+        uint8_t imuPort = 0;
+        /** in kilograms */
+        double mass = 6.8;
+        /** about the tracking center, in kilogram square meters */
+        double momentOfInertia = 0.2;
+        /** force that resists rolling, relative to the robot's weight */
+        double rollingResistance = 0.02;
+        /** where the robot starts */
+        Pose start = {0, 0, 0};
+        NoiseConfig noise;
+        /** seed of the sensor noise. Runs with the same seed are identical */
+        uint64_t seed = 0;
+};
+
+/**
+ * @brief Physics of a robot with a differential drivetrain, driven through the simulated devices
+ *
+ * Each step, the drivetrain's motors turn their commands into torque (see MotorModel), and the robot accelerates
+ * under the force of its wheels, rolling resistance, and the friction of the wheels sliding sideways. The wheels grip
+ * the floor sideways as hard as LemLib's horizontal drift suggests: a drift of 8 grips like rubber on foam tiles, a
+ * drift of 2 a quarter as hard. That grip also scrubs the robot's turns. The robot then writes what its motors,
+ * tracking wheels, IMU and battery measure into the devices, with noise on the sensors.
+ *
+ * Motors that aren't part of the drivetrain are simulated with only a light load, so that they move and draw current
+ * when the program runs them.
+ */
+class Robot {
+    public:
+        /**
+         * @brief Construct a new Robot
+         *
+         * @param config the robot
+         */
+        explicit Robot(RobotConfig config);
+
+        /**
+         * @brief Step the robot each millisecond of virtual time, from now on
+         *
+         * The robot must outlive the kernel.
+         */
+        void attach();
+
+        /**
+         * @brief Step the robot forward in time
+         *
+         * @param dt length of the step, in seconds
+         */
+        void step(double dt);
+
+        /**
+         * @brief Get where the robot actually is
+         *
+         * @return Pose
+         */
+        Pose getPose() const;
+    private:
+        /**
+         * @brief A tracking wheel and the distance it has rolled
+         */
+        struct TrackingWheel {
+                TrackingWheelConfig config;
+                /** distance the wheel measured, in meters */
+                double distance = 0;
+        };
+
+        RobotConfig config;
+        /** one for each smart port */
+        MotorModel motors[21];
+        std::vector<TrackingWheel> verticalWheels;
+        std::vector<TrackingWheel> horizontalWheels;
+        // pose, in meters and radians, heading clockwise from the y axis
+        double x;
+        double y;
+        double heading;
+        // velocity, in meters per second, and angular velocity clockwise, in radians per second
+        double vx = 0;
+        double vy = 0;
+        double angularVelocity = 0;
+        // speeds of the motors that aren't part of the drivetrain, in radians per second
+        double freeSpeeds[21] = {};
+        /** torque of each motor, relative to a typical motor's */
+        double strengths[21];
+        /** bias of the IMU, in degrees */
+        double imuBias = 0;
+        /** current drawn from the battery last step, in amps */
+        double batteryCurrent = 0;
+        std::mt19937_64 random;
+};
+} // namespace sim
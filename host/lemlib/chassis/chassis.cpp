@@ -0,0 +1,160 @@
+#include <cmath>
+
+#include "pros/misc.hpp"
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/odom.hpp"
+#include "lemlib/logger/logger.hpp"
+#include "lemlib/util.hpp"
+
+namespace lemlib {
+ExpoDriveCurve defaultDriveCurve(0, 0, 1);
+
+Chassis::Chassis(Drivetrain drivetrain, ControllerSettings linearSettings, ControllerSettings angularSettings,
+                 OdomSensors sensors, DriveCurve* throttleCurve, DriveCurve* steerCurve)
+    : lateralPID(linearSettings.kP, linearSettings.kI, linearSettings.kD, linearSettings.windupRange, true),
+      angularPID(angularSettings.kP, angularSettings.kI, angularSettings.kD, angularSettings.windupRange, true),
+      lateralSettings(linearSettings),
+      angularSettings(angularSettings),
+      drivetrain(drivetrain),
+      sensors(sensors),
+      throttleCurve(throttleCurve),
+      steerCurve(steerCurve),
+      lateralLargeExit(linearSettings.largeError, linearSettings.largeErrorTimeout),
+      lateralSmallExit(linearSettings.smallError, linearSettings.smallErrorTimeout),
+      angularLargeExit(angularSettings.largeError, angularSettings.largeErrorTimeout),
+      angularSmallExit(angularSettings.smallError, angularSettings.smallErrorTimeout) {}
+
+void Chassis::calibrate(bool calibrateIMU) {
+    if (calibrateIMU && sensors.imu != nullptr) {
+        // calibrate the IMU, retrying up to 5 times if it fails
+        int attempt = 1;
+        for (; attempt <= 5; attempt++) {
+            sensors.imu->reset();
+            do pros::delay(10);
+            while (sensors.imu->get_status() != pros::ImuStatus::error && sensors.imu->is_calibrating());
+            const double heading = sensors.imu->get_heading();
+            if (!std::isnan(heading) && !std::isinf(heading)) break;
+            pros::c::controller_rumble(pros::E_CONTROLLER_MASTER, "---");
+            infoSink()->warn("IMU failed to calibrate! Attempt #{}", attempt);
+        }
+        if (attempt > 5) {
+            sensors.imu = nullptr;
+            infoSink()->error("IMU calibration failed, defaulting to tracking wheels / motor encoders");
+        }
+    }
+    // use the drivetrain motors as tracking wheels where there are none
+    if (sensors.vertical1 == nullptr) {
+        sensors.vertical1 = new TrackingWheel(drivetrain.leftMotors, drivetrain.wheelDiameter,
+                                              -(drivetrain.trackWidth / 2), drivetrain.rpm);
+    }
+    if (sensors.vertical2 == nullptr) {
+        sensors.vertical2 = new TrackingWheel(drivetrain.rightMotors, drivetrain.wheelDiameter,
+                                              drivetrain.trackWidth / 2, drivetrain.rpm);
+    }
+    sensors.vertical1->reset();
+    sensors.vertical2->reset();
+    if (sensors.horizontal1 != nullptr) sensors.horizontal1->reset();
+    if (sensors.horizontal2 != nullptr) sensors.horizontal2->reset();
+    setSensors(sensors, drivetrain);
+    init();
+    pros::c::controller_rumble(pros::E_CONTROLLER_MASTER, ".");
+}
+
+void Chassis::setPose(float x, float y, float theta, bool radians) { lemlib::setPose(Pose(x, y, theta), radians); }
+
+void Chassis::setPose(Pose pose, bool radians) { lemlib::setPose(pose, radians); }
+
+Pose Chassis::getPose(bool radians, bool standardPos) {
+    Pose pose = lemlib::getPose(true);
+    if (standardPos) pose.theta = M_PI_2 - pose.theta;
+    if (!radians) pose.theta = radToDeg(pose.theta);
+    return pose;
+}
+
+void Chassis::waitUntil(float dist) {
+    // give the motion time to start
+    pros::delay(10);
+    while (distTraveled <= dist && distTraveled != -1) pros::delay(10);
+}
+
+void Chassis::waitUntilDone() {
+    do pros::delay(10);
+    while (distTraveled != -1);
+}
+
+void Chassis::setBrakeMode(pros::motor_brake_mode_e mode) {
+    drivetrain.leftMotors->set_brake_mode_all(mode);
+    drivetrain.rightMotors->set_brake_mode_all(mode);
+}
+
+void Chassis::requestMotionStart() {
+    if (isInMotion()) motionQueued = true;
+    else motionRunning = true;
+    // wait until this motion is at the front of the queue
+    mutex.take(TIMEOUT_MAX);
+}
+
+void Chassis::endMotion() {
+    // move the queue forward
+    motionRunning = motionQueued;
+    motionQueued = false;
+    mutex.give();
+}
+
+void Chassis::cancelMotion() {
+    motionRunning = false;
+    // give the motion time to stop
+    pros::delay(10);
+}
+
+void Chassis::cancelAllMotions() {
+    motionRunning = false;
+    motionQueued = false;
+    pros::delay(10);
+}
+
+bool Chassis::isInMotion() const { return motionRunning; }
+
+void Chassis::resetLocalPosition() { lemlib::setPose(Pose(0, 0, getPose().theta), false); }
+
+void Chassis::tank(int left, int right, bool disableDriveCurve) {
+    if (!disableDriveCurve) {
+        left = throttleCurve->curve(left);
+        right = throttleCurve->curve(right);
+    }
+    drivetrain.leftMotors->move(left);
+    drivetrain.rightMotors->move(right);
+}
+
+void Chassis::arcade(int throttle, int turn, bool disableDriveCurve, float desaturateBias) {
+    if (!disableDriveCurve) {
+        throttle = throttleCurve->curve(throttle);
+        turn = steerCurve->curve(turn);
+    }
+    // desaturate, giving turning priority according to the bias
+    if (std::abs(throttle) + std::abs(turn) > 127) {
+        const int oldThrottle = throttle;
+        const int oldTurn = turn;
+        throttle *= 1 - desaturateBias * std::abs(oldTurn / 127.0);
+        turn *= 1 - (1 - desaturateBias) * std::abs(oldThrottle / 127.0);
+    }
+    drivetrain.leftMotors->move(throttle + turn);
+    drivetrain.rightMotors->move(throttle - turn);
+}
+
+void Chassis::curvature(int throttle, int turn, bool disableDriveCurve) {
+    // curvature drive can't turn in place
+    if (throttle == 0) {
+        arcade(throttle, turn, disableDriveCurve);
+        return;
+    }
+    float leftPower = throttle + std::abs(throttle) * turn / 127.0;
+    float rightPower = throttle - std::abs(throttle) * turn / 127.0;
+    if (!disableDriveCurve) {
+        leftPower = throttleCurve->curve(leftPower);
+        rightPower = throttleCurve->curve(rightPower);
+    }
+    drivetrain.leftMotors->move(leftPower);
+    drivetrain.rightMotors->move(rightPower);
+}
+} // namespace lemlib
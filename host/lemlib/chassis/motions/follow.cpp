@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "pros/misc.hpp"
+#include "pros/rtos.hpp"
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/purePursuit.hpp"
+#include "lemlib/logger/logger.hpp"
+#include "lemlib/profiling/deadlineMonitor.hpp"
+#include "lemlib/profiling/scopeTimer.hpp"
+#include "lemlib/util.hpp"
+#include "sim/motions.hpp"
+
+namespace {
+// split a string at each occurrence of a delimiter
+std::vector<std::string> split(const std::string& input, const std::string& delimiter) {
+    std::vector<std::string> output;
+    size_t start = 0;
+    size_t end;
+    while ((end = input.find(delimiter, start)) != std::string::npos) {
+        output.push_back(input.substr(start, end - start));
+        start = end + delimiter.size();
+    }
+    output.push_back(input.substr(start));
+    return output;
+}
+
+// parse a path file. Each line is "x, y, speed" until a line that says "endData". The speed is stored as the theta
+std::vector<lemlib::Pose> getData(const asset& path) {
+    std::vector<lemlib::Pose> points;
+    for (const std::string& line : split(std::string(reinterpret_cast<char*>(path.buf), path.size), "\n")) {
+        if (line == "endData" || line == "endData\r") break;
+        const std::vector<std::string> values = split(line, ", ");
+        if (values.size() < 3) continue;
+        points.emplace_back(std::stof(values[0]), std::stof(values[1]), std::stof(values[2]));
+    }
+    return points;
+}
+
+} // namespace
+
+namespace lemlib {
+void Chassis::follow(const asset& path, float lookahead, int timeout, bool forwards, bool async) {
+    requestMotionStart();
+    // were all motions cancelled?
+    if (!motionRunning) return;
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([=, this, &path]() { follow(path, lookahead, timeout, forwards, false); });
+        endMotion();
+        pros::delay(10); // give the task time to start
+        return;
+    }
+
+    const std::vector<Pose> pathPoints = getData(path);
+    if (pathPoints.empty()) {
+        infoSink()->error("No points in path! Do you have the right format? Skipping motion");
+        distTraveled = -1;
+        sim::motionEnded();
+        endMotion();
+        return;
+    }
+
+    Pose lastPose = getPose(true);
+    Pose lastLookahead = pathPoints[0];
+    lastLookahead.theta = 0;
+    float prevVel = 0;
+    const int compState = pros::competition::get_status();
+    distTraveled = 0;
+    sim::motionStarted();
+
+    Deadline* deadline = deadlineMonitor().add("Chassis::follow", 10, 2000);
+    for (int i = 0; i < timeout / 10 && pros::competition::get_status() == compState && motionRunning; i++) {
+        {
+            LEMLIB_PROFILE_SCOPE("Chassis::follow");
+            DeadlineCycle cycle(deadline);
+            Pose pose = getPose(true);
+            if (!forwards) pose.theta -= M_PI;
+            distTraveled += pose.distance(lastPose);
+            lastPose = pose;
+
+            // the path ends with a speed of 0
+            const int closestPoint = findClosest(pose, pathPoints);
+            if (pathPoints[closestPoint].theta == 0) break;
+
+            const Pose lookaheadPose = lookaheadPoint(lastLookahead, pose, pathPoints, closestPoint, lookahead);
+            lastLookahead = lookaheadPose;
+
+            // curvature of the arc from the robot to the lookahead point
+            const float curvature = getCurvature(Pose(pose.x, pose.y, M_PI_2 - pose.theta), lookaheadPose);
+            const float targetVel = slew(pathPoints[closestPoint].theta, prevVel, lateralSettings.slew);
+            prevVel = targetVel;
+
+            float targetLeftVel = targetVel * (2 + curvature * drivetrain.trackWidth) / 2;
+            float targetRightVel = targetVel * (2 - curvature * drivetrain.trackWidth) / 2;
+            const float ratio = std::max(std::fabs(targetLeftVel), std::fabs(targetRightVel)) / 127;
+            if (ratio > 1) {
+                targetLeftVel /= ratio;
+                targetRightVel /= ratio;
+            }
+
+            if (forwards) {
+                drivetrain.leftMotors->move(targetLeftVel);
+                drivetrain.rightMotors->move(targetRightVel);
+            } else {
+                drivetrain.leftMotors->move(-targetRightVel);
+                drivetrain.rightMotors->move(-targetLeftVel);
+            }
+        }
+
+        pros::delay(10);
+    }
+
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    // -1 tells waitUntil() the motion is done
+    distTraveled = -1;
+    sim::motionEnded();
+    endMotion();
+}
+} // namespace lemlib
@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <cmath>
+#include <optional>
+
+#include "pros/rtos.hpp"
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/profiling/deadlineMonitor.hpp"
+#include "lemlib/profiling/scopeTimer.hpp"
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+#include "sim/motions.hpp"
+
+namespace lemlib {
+void Chassis::moveToPoint(float x, float y, int timeout, MoveToPointParams params, bool async) {
+    params.earlyExitRange = std::fabs(params.earlyExitRange);
+    requestMotionStart();
+    // were all motions cancelled?
+    if (!motionRunning) return;
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([=, this]() { moveToPoint(x, y, timeout, params, false); });
+        endMotion();
+        pros::delay(10); // give the task time to start
+        return;
+    }
+
+    lateralPID.reset();
+    lateralLargeExit.reset();
+    lateralSmallExit.reset();
+    angularPID.reset();
+
+    Pose lastPose = getPose(true, true);
+    distTraveled = 0;
+    sim::motionStarted();
+    Timer timer(timeout);
+    bool close = false;
+    float prevLateralOut = 0;
+    float prevAngularOut = 0;
+    std::optional<bool> prevSide = std::nullopt;
+    Pose target(x, y);
+    target.theta = lastPose.angle(target);
+
+    Deadline* deadline = deadlineMonitor().add("Chassis::moveToPoint", 10, 2000);
+    while (!timer.isDone() && ((!lateralSmallExit.getExit() && !lateralLargeExit.getExit()) || !close) &&
+           motionRunning) {
+        {
+            LEMLIB_PROFILE_SCOPE("Chassis::moveToPoint");
+            DeadlineCycle cycle(deadline);
+            const Pose pose = getPose(true, true);
+            distTraveled += pose.distance(lastPose);
+            lastPose = pose;
+
+            // start settling when close to the target
+            const float distTarget = pose.distance(target);
+            if (distTarget < 7.5 && !close) {
+                close = true;
+                params.maxSpeed = std::fmax(std::fabs(prevLateralOut), 60);
+            }
+
+            // motion chaining: exit once the robot passes the line through the target perpendicular to its path
+            const bool side = (pose.y - target.y) * -std::sin(target.theta) <=
+                              (pose.x - target.x) * std::cos(target.theta) + params.earlyExitRange;
+            if (prevSide == std::nullopt) prevSide = side;
+            if (side != prevSide && params.minSpeed != 0) break;
+            prevSide = side;
+
+            const float adjustedRobotTheta = params.forwards ? pose.theta : pose.theta + M_PI;
+            const float angularError = angleError(adjustedRobotTheta, pose.angle(target));
+            const float lateralError = distTarget * std::cos(angleError(pose.theta, pose.angle(target)));
+
+            lateralSmallExit.update(lateralError);
+            lateralLargeExit.update(lateralError);
+
+            float lateralOut = lateralPID.update(lateralError);
+            float angularOut = angularPID.update(radToDeg(angularError));
+            if (close) angularOut = 0;
+
+            angularOut = std::clamp(angularOut, -params.maxSpeed, params.maxSpeed);
+            angularOut = slew(angularOut, prevAngularOut, angularSettings.slew);
+            lateralOut = std::clamp(lateralOut, -params.maxSpeed, params.maxSpeed);
+            // don't limit deceleration, since that would interfere with settling
+            if (!close) lateralOut = slew(lateralOut, prevLateralOut, lateralSettings.slew);
+            // prevent moving in the wrong direction
+            if (params.forwards && !close) lateralOut = std::fmax(lateralOut, 0);
+            else if (!params.forwards && !close) lateralOut = std::fmin(lateralOut, 0);
+            // respect the minimum speed
+            if (params.forwards && lateralOut > 0 && lateralOut < std::fabs(params.minSpeed)) {
+                lateralOut = std::fabs(params.minSpeed);
+            }
+            if (!params.forwards && lateralOut < 0 && -lateralOut < std::fabs(params.minSpeed)) {
+                lateralOut = -std::fabs(params.minSpeed);
+            }
+            prevAngularOut = angularOut;
+            prevLateralOut = lateralOut;
+
+            // scale the outputs down together to respect the max speed
+            float leftPower = lateralOut + angularOut;
+            float rightPower = lateralOut - angularOut;
+            const float ratio = std::max(std::fabs(leftPower), std::fabs(rightPower)) / params.maxSpeed;
+            if (ratio > 1) {
+                leftPower /= ratio;
+                rightPower /= ratio;
+            }
+            drivetrain.leftMotors->move(leftPower);
+            drivetrain.rightMotors->move(rightPower);
+        }
+
+        pros::delay(10);
+    }
+
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    // -1 tells waitUntil() the motion is done
+    distTraveled = -1;
+    sim::motionEnded();
+    endMotion();
+}
+} // namespace lemlib
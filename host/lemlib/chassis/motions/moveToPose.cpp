@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <cmath>
+
+#include "pros/rtos.hpp"
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/profiling/deadlineMonitor.hpp"
+#include "lemlib/profiling/scopeTimer.hpp"
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+#include "sim/motions.hpp"
+
+namespace lemlib {
+void Chassis::moveToPose(float x, float y, float theta, int timeout, MoveToPoseParams params, bool async) {
+    requestMotionStart();
+    // were all motions cancelled?
+    if (!motionRunning) return;
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([=, this]() { moveToPose(x, y, theta, timeout, params, false); });
+        endMotion();
+        pros::delay(10); // give the task time to start
+        return;
+    }
+
+    lateralPID.reset();
+    lateralLargeExit.reset();
+    lateralSmallExit.reset();
+    angularPID.reset();
+    angularLargeExit.reset();
+    angularSmallExit.reset();
+
+    // target pose, in standard form
+    Pose target(x, y, M_PI_2 - degToRad(theta));
+    if (!params.forwards) target.theta = std::fmod(target.theta + M_PI, 2 * M_PI);
+    if (params.horizontalDrift == 0) params.horizontalDrift = drivetrain.horizontalDrift;
+
+    Pose lastPose = getPose(true, true);
+    distTraveled = 0;
+    sim::motionStarted();
+    Timer timer(timeout);
+    bool close = false;
+    bool lateralSettled = false;
+    bool prevSameSide = false;
+    float prevLateralOut = 0;
+    float prevAngularOut = 0;
+
+    Deadline* deadline = deadlineMonitor().add("Chassis::moveToPose", 10, 2000);
+    while (!timer.isDone() &&
+           (!lateralSettled || (!angularLargeExit.getExit() && !angularSmallExit.getExit()) || !close) &&
+           motionRunning) {
+        {
+            LEMLIB_PROFILE_SCOPE("Chassis::moveToPose");
+            DeadlineCycle cycle(deadline);
+            const Pose pose = getPose(true, true);
+            distTraveled += pose.distance(lastPose);
+            lastPose = pose;
+
+            // start settling when close to the target
+            const float distTarget = pose.distance(target);
+            if (distTarget < 7.5 && !close) {
+                close = true;
+                params.maxSpeed = std::fmax(std::fabs(prevLateralOut), 60);
+            }
+            if (lateralLargeExit.getExit() && lateralSmallExit.getExit()) lateralSettled = true;
+
+            // the carrot point leads the robot into the target heading. While settling, drive to the target itself
+            Pose carrot = target - Pose(std::cos(target.theta), std::sin(target.theta)) * params.lead * distTarget;
+            if (close) carrot = target;
+
+            // motion chaining: exit once the robot passes the line through the target perpendicular to its heading
+            const bool robotSide = (pose.y - target.y) * -std::sin(target.theta) <=
+                                   (pose.x - target.x) * std::cos(target.theta) + params.earlyExitRange;
+            const bool carrotSide = (carrot.y - target.y) * -std::sin(target.theta) <=
+                                    (carrot.x - target.x) * std::cos(target.theta) + params.earlyExitRange;
+            const bool sameSide = robotSide == carrotSide;
+            if (!sameSide && prevSameSide && close && params.minSpeed != 0) break;
+            prevSameSide = sameSide;
+
+            const float adjustedRobotTheta = params.forwards ? pose.theta : pose.theta + M_PI;
+            const float angularError = close ? angleError(adjustedRobotTheta, target.theta)
+                                             : angleError(adjustedRobotTheta, pose.angle(carrot));
+            // only scale by the cosine while settling. Otherwise the max slip speed limits the lateral output
+            float lateralError = pose.distance(carrot);
+            if (close) lateralError *= std::cos(angleError(pose.theta, pose.angle(carrot)));
+            else lateralError *= sgn(std::cos(angleError(pose.theta, pose.angle(carrot))));
+
+            lateralSmallExit.update(lateralError);
+            lateralLargeExit.update(lateralError);
+            angularSmallExit.update(radToDeg(angularError));
+            angularLargeExit.update(radToDeg(angularError));
+
+            float lateralOut = lateralPID.update(lateralError);
+            float angularOut = angularPID.update(radToDeg(angularError));
+
+            angularOut = std::clamp(angularOut, -params.maxSpeed, params.maxSpeed);
+            angularOut = slew(angularOut, prevAngularOut, angularSettings.slew);
+            lateralOut = std::clamp(lateralOut, -params.maxSpeed, params.maxSpeed);
+            if (!close) lateralOut = slew(lateralOut, prevLateralOut, lateralSettings.slew);
+            // limit the lateral output to the max speed the robot can drive the curve at without slipping
+            const float radius = 1 / std::fabs(getCurvature(pose, carrot));
+            const float maxSlipSpeed = std::sqrt(params.horizontalDrift * radius * 9.8);
+            lateralOut = std::clamp(lateralOut, -maxSlipSpeed, maxSlipSpeed);
+            // prioritize turning over driving
+            const float overturn = std::fabs(angularOut) + std::fabs(lateralOut) - params.maxSpeed;
+            if (overturn > 0) lateralOut -= lateralOut > 0 ? overturn : -overturn;
+            // prevent moving in the wrong direction
+            if (params.forwards && !close) lateralOut = std::fmax(lateralOut, 0);
+            else if (!params.forwards && !close) lateralOut = std::fmin(lateralOut, 0);
+            // respect the minimum speed
+            if (params.forwards && lateralOut > 0 && lateralOut < std::fabs(params.minSpeed)) {
+                lateralOut = std::fabs(params.minSpeed);
+            }
+            if (!params.forwards && lateralOut < 0 && -lateralOut < std::fabs(params.minSpeed)) {
+                lateralOut = -std::fabs(params.minSpeed);
+            }
+            prevAngularOut = angularOut;
+            prevLateralOut = lateralOut;
+
+            // scale the outputs down together to respect the max speed
+            float leftPower = lateralOut + angularOut;
+            float rightPower = lateralOut - angularOut;
+            const float ratio = std::max(std::fabs(leftPower), std::fabs(rightPower)) / params.maxSpeed;
+            if (ratio > 1) {
+                leftPower /= ratio;
+                rightPower /= ratio;
+            }
+            drivetrain.leftMotors->move(leftPower);
+            drivetrain.rightMotors->move(rightPower);
+        }
+
+        pros::delay(10);
+    }
+
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    // -1 tells waitUntil() the motion is done
+    distTraveled = -1;
+    sim::motionEnded();
+    endMotion();
+}
+} // namespace lemlib
@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <cmath>
+#include <optional>
+
+#include "pros/rtos.hpp"
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/math/fastMath.hpp"
+#include "lemlib/profiling/deadlineMonitor.hpp"
+#include "lemlib/profiling/scopeTimer.hpp"
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+#include "sim/motions.hpp"
+
+namespace {
+// motor power for a swing, respecting the speed limits. Acceleration is limited until the robot gets close
+float swingPower(lemlib::PID& pid, float error, float prevPower, float maxSpeed, float minSpeed, float slew) {
+    float power = std::clamp(pid.update(error), -maxSpeed, maxSpeed);
+    if (std::fabs(error) > 20) power = lemlib::slew(power, prevPower, slew);
+    if (power < 0 && power > -minSpeed) power = -minSpeed;
+    else if (power > 0 && power < minSpeed) power = minSpeed;
+    return power;
+}
+} // namespace
+
+namespace lemlib {
+void Chassis::swingToHeading(float theta, DriveSide lockedSide, int timeout, SwingToHeadingParams params,
+                             bool async) {
+    requestMotionStart();
+    // were all motions cancelled?
+    if (!motionRunning) return;
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([=, this]() { swingToHeading(theta, lockedSide, timeout, params, false); });
+        endMotion();
+        pros::delay(10); // give the task time to start
+        return;
+    }
+
+    // hold the locked side in place
+    pros::MotorGroup* locked = lockedSide == DriveSide::LEFT ? drivetrain.leftMotors : drivetrain.rightMotors;
+    pros::MotorGroup* swinging = lockedSide == DriveSide::LEFT ? drivetrain.rightMotors : drivetrain.leftMotors;
+    const pros::MotorBrake brakeMode = locked->get_brake_mode();
+    locked->set_brake_mode_all(pros::MotorBrake::hold);
+
+    angularLargeExit.reset();
+    angularSmallExit.reset();
+    angularPID.reset();
+
+    const float startTheta = getPose().theta;
+    std::optional<float> prevDeltaTheta = std::nullopt;
+    float prevMotorPower = 0;
+    distTraveled = 0;
+    sim::motionStarted();
+    Timer timer(timeout);
+
+    Deadline* deadline = deadlineMonitor().add("Chassis::swingToHeading", 10, 2000);
+    while (!timer.isDone() && !angularLargeExit.getExit() && !angularSmallExit.getExit() && motionRunning) {
+        {
+            LEMLIB_PROFILE_SCOPE("Chassis::swingToHeading");
+            DeadlineCycle cycle(deadline);
+            const Pose pose = getPose();
+            distTraveled = std::fabs(angleError(pose.theta, startTheta, false));
+            // swing in the requested direction until close, then settle whichever way is shortest
+            if (std::fabs(angleError(theta, pose.theta, false)) < 20) params.direction = AngularDirection::AUTO;
+            const float deltaTheta = angleError(theta, pose.theta, false, params.direction);
+            if (prevDeltaTheta == std::nullopt) prevDeltaTheta = deltaTheta;
+
+            // motion chaining
+            if (params.minSpeed != 0 && std::fabs(deltaTheta) < params.earlyExitRange) break;
+            if (params.minSpeed != 0 && sgn(deltaTheta) != sgn(*prevDeltaTheta)) break;
+            prevDeltaTheta = deltaTheta;
+
+            angularLargeExit.update(deltaTheta);
+            angularSmallExit.update(deltaTheta);
+            const float motorPower = swingPower(angularPID, deltaTheta, prevMotorPower, params.maxSpeed,
+                                                params.minSpeed, angularSettings.slew);
+            prevMotorPower = motorPower;
+
+            // swinging the right side backwards and the left side forwards both turn clockwise
+            locked->brake();
+            swinging->move(lockedSide == DriveSide::LEFT ? -motorPower : motorPower);
+        }
+
+        pros::delay(10);
+    }
+
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    locked->set_brake_mode_all(brakeMode);
+    // -1 tells waitUntil() the motion is done
+    distTraveled = -1;
+    sim::motionEnded();
+    endMotion();
+}
+
+void Chassis::swingToPoint(float x, float y, DriveSide lockedSide, int timeout, SwingToPointParams params,
+                           bool async) {
+    requestMotionStart();
+    // were all motions cancelled?
+    if (!motionRunning) return;
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([=, this]() { swingToPoint(x, y, lockedSide, timeout, params, false); });
+        endMotion();
+        pros::delay(10); // give the task time to start
+        return;
+    }
+
+    // hold the locked side in place
+    pros::MotorGroup* locked = lockedSide == DriveSide::LEFT ? drivetrain.leftMotors : drivetrain.rightMotors;
+    pros::MotorGroup* swinging = lockedSide == DriveSide::LEFT ? drivetrain.rightMotors : drivetrain.leftMotors;
+    const pros::MotorBrake brakeMode = locked->get_brake_mode();
+    locked->set_brake_mode_all(pros::MotorBrake::hold);
+
+    angularLargeExit.reset();
+    angularSmallExit.reset();
+    angularPID.reset();
+
+    const float startTheta = getPose().theta;
+    std::optional<float> prevDeltaTheta = std::nullopt;
+    float prevMotorPower = 0;
+    distTraveled = 0;
+    sim::motionStarted();
+    Timer timer(timeout);
+
+    Deadline* deadline = deadlineMonitor().add("Chassis::swingToPoint", 10, 2000);
+    while (!timer.isDone() && !angularLargeExit.getExit() && !angularSmallExit.getExit() && motionRunning) {
+        {
+            LEMLIB_PROFILE_SCOPE("Chassis::swingToPoint");
+            DeadlineCycle cycle(deadline);
+            Pose pose = getPose();
+            distTraveled = std::fabs(angleError(pose.theta, startTheta, false));
+            if (!params.forwards) pose.theta += 180;
+            const float targetTheta = radToDeg(M_PI_2 - math::atan2(y - pose.y, x - pose.x));
+            // swing in the requested direction until close, then settle whichever way is shortest
+            if (std::fabs(angleError(targetTheta, pose.theta, false)) < 20) params.direction = AngularDirection::AUTO;
+            const float deltaTheta = angleError(targetTheta, pose.theta, false, params.direction);
+            if (prevDeltaTheta == std::nullopt) prevDeltaTheta = deltaTheta;
+
+            // motion chaining
+            if (params.minSpeed != 0 && std::fabs(deltaTheta) < params.earlyExitRange) break;
+            if (params.minSpeed != 0 && sgn(deltaTheta) != sgn(*prevDeltaTheta)) break;
+            prevDeltaTheta = deltaTheta;
+
+            angularLargeExit.update(deltaTheta);
+            angularSmallExit.update(deltaTheta);
+            const float motorPower = swingPower(angularPID, deltaTheta, prevMotorPower, params.maxSpeed,
+                                                params.minSpeed, angularSettings.slew);
+            prevMotorPower = motorPower;
+
+            // swinging the right side backwards and the left side forwards both turn clockwise
+            locked->brake();
+            swinging->move(lockedSide == DriveSide::LEFT ? -motorPower : motorPower);
+        }
+
+        pros::delay(10);
+    }
+
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    locked->set_brake_mode_all(brakeMode);
+    // -1 tells waitUntil() the motion is done
+    distTraveled = -1;
+    sim::motionEnded();
+    endMotion();
+}
+} // namespace lemlib
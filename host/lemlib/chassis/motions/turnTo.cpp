@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <cmath>
+#include <optional>
+
+#include "pros/rtos.hpp"
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/math/fastMath.hpp"
+#include "lemlib/profiling/deadlineMonitor.hpp"
+#include "lemlib/profiling/scopeTimer.hpp"
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+#include "sim/motions.hpp"
+
+namespace {
+// motor power for a turn, respecting the speed limits. Acceleration is limited until the robot gets close
+float turnPower(lemlib::PID& pid, float error, float prevPower, float maxSpeed, float minSpeed, float slew) {
+    float power = std::clamp(pid.update(error), -maxSpeed, maxSpeed);
+    if (std::fabs(error) > 20) power = lemlib::slew(power, prevPower, slew);
+    if (power < 0 && power > -minSpeed) power = -minSpeed;
+    else if (power > 0 && power < minSpeed) power = minSpeed;
+    return power;
+}
+} // namespace
+
+namespace lemlib {
+void Chassis::turnToPoint(float x, float y, int timeout, TurnToPointParams params, bool async) {
+    requestMotionStart();
+    // were all motions cancelled?
+    if (!motionRunning) return;
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([=, this]() { turnToPoint(x, y, timeout, params, false); });
+        endMotion();
+        pros::delay(10); // give the task time to start
+        return;
+    }
+
+    angularLargeExit.reset();
+    angularSmallExit.reset();
+    angularPID.reset();
+
+    const float startTheta = getPose().theta;
+    std::optional<float> prevDeltaTheta = std::nullopt;
+    float prevMotorPower = 0;
+    distTraveled = 0;
+    sim::motionStarted();
+    Timer timer(timeout);
+
+    Deadline* deadline = deadlineMonitor().add("Chassis::turnToPoint", 10, 2000);
+    while (!timer.isDone() && !angularLargeExit.getExit() && !angularSmallExit.getExit() && motionRunning) {
+        {
+            LEMLIB_PROFILE_SCOPE("Chassis::turnToPoint");
+            DeadlineCycle cycle(deadline);
+            Pose pose = getPose();
+            distTraveled = std::fabs(angleError(pose.theta, startTheta, false));
+            if (!params.forwards) pose.theta += 180;
+            const float targetTheta = radToDeg(M_PI_2 - math::atan2(y - pose.y, x - pose.x));
+            // turn in the requested direction until close, then settle whichever way is shortest
+            if (std::fabs(angleError(targetTheta, pose.theta, false)) < 20) params.direction = AngularDirection::AUTO;
+            const float deltaTheta = angleError(targetTheta, pose.theta, false, params.direction);
+            if (prevDeltaTheta == std::nullopt) prevDeltaTheta = deltaTheta;
+
+            // motion chaining
+            if (params.minSpeed != 0 && std::fabs(deltaTheta) < params.earlyExitRange) break;
+            if (params.minSpeed != 0 && sgn(deltaTheta) != sgn(*prevDeltaTheta)) break;
+            prevDeltaTheta = deltaTheta;
+
+            angularLargeExit.update(deltaTheta);
+            angularSmallExit.update(deltaTheta);
+            const float motorPower = turnPower(angularPID, deltaTheta, prevMotorPower, params.maxSpeed,
+                                               params.minSpeed, angularSettings.slew);
+            prevMotorPower = motorPower;
+
+            drivetrain.leftMotors->move(motorPower);
+            drivetrain.rightMotors->move(-motorPower);
+        }
+
+        pros::delay(10);
+    }
+
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    // -1 tells waitUntil() the motion is done
+    distTraveled = -1;
+    sim::motionEnded();
+    endMotion();
+}
+
+void Chassis::turnToHeading(float theta, int timeout, TurnToHeadingParams params, bool async) {
+    requestMotionStart();
+    // were all motions cancelled?
+    if (!motionRunning) return;
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([=, this]() { turnToHeading(theta, timeout, params, false); });
+        endMotion();
+        pros::delay(10); // give the task time to start
+        return;
+    }
+
+    angularLargeExit.reset();
+    angularSmallExit.reset();
+    angularPID.reset();
+
+    const float startTheta = getPose().theta;
+    std::optional<float> prevDeltaTheta = std::nullopt;
+    float prevMotorPower = 0;
+    distTraveled = 0;
+    sim::motionStarted();
+    Timer timer(timeout);
+
+    Deadline* deadline = deadlineMonitor().add("Chassis::turnToHeading", 10, 2000);
+    while (!timer.isDone() && !angularLargeExit.getExit() && !angularSmallExit.getExit() && motionRunning) {
+        {
+            LEMLIB_PROFILE_SCOPE("Chassis::turnToHeading");
+            DeadlineCycle cycle(deadline);
+            const Pose pose = getPose();
+            distTraveled = std::fabs(angleError(pose.theta, startTheta, false));
+            // turn in the requested direction until close, then settle whichever way is shortest
+            if (std::fabs(angleError(theta, pose.theta, false)) < 20) params.direction = AngularDirection::AUTO;
+            const float deltaTheta = angleError(theta, pose.theta, false, params.direction);
+            if (prevDeltaTheta == std::nullopt) prevDeltaTheta = deltaTheta;
+
+            // motion chaining
+            if (params.minSpeed != 0 && std::fabs(deltaTheta) < params.earlyExitRange) break;
+            if (params.minSpeed != 0 && sgn(deltaTheta) != sgn(*prevDeltaTheta)) break;
+            prevDeltaTheta = deltaTheta;
+
+            angularLargeExit.update(deltaTheta);
+            angularSmallExit.update(deltaTheta);
+            const float motorPower = turnPower(angularPID, deltaTheta, prevMotorPower, params.maxSpeed,
+                                               params.minSpeed, angularSettings.slew);
+            prevMotorPower = motorPower;
+
+            drivetrain.leftMotors->move(motorPower);
+            drivetrain.rightMotors->move(-motorPower);
+        }
+
+        pros::delay(10);
+    }
+
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    // -1 tells waitUntil() the motion is done
+    distTraveled = -1;
+    sim::motionEnded();
+    endMotion();
+}
+} // namespace lemlib
@@ -0,0 +1,160 @@
+#include <cmath>
+
+#include "pros/rtos.hpp"
+#include "lemlib/chassis/odom.hpp"
+#include "lemlib/math/fastMath.hpp"
+#include "lemlib/profiling/deadlineMonitor.hpp"
+#include "lemlib/profiling/scopeTimer.hpp"
+#include "lemlib/util.hpp"
+
+namespace {
+lemlib::OdomSensors odomSensors(nullptr, nullptr, nullptr, nullptr, nullptr);
+lemlib::Drivetrain drive(nullptr, nullptr, 0, 0, 0, 0);
+// poses are in radians, heading clockwise from the y axis
+lemlib::Pose odomPose(0, 0, 0);
+lemlib::Pose odomSpeed(0, 0, 0);
+lemlib::Pose odomLocalSpeed(0, 0, 0);
+pros::Task* trackingTask = nullptr;
+
+float prevVertical = 0;
+float prevVertical1 = 0;
+float prevVertical2 = 0;
+float prevHorizontal = 0;
+float prevHorizontal1 = 0;
+float prevHorizontal2 = 0;
+float prevImu = 0;
+
+float distanceOf(lemlib::TrackingWheel* wheel) { return wheel != nullptr ? wheel->getDistanceTraveled() : 0; }
+} // namespace
+
+namespace lemlib {
+void setSensors(OdomSensors sensors, Drivetrain drivetrain) {
+    odomSensors = sensors;
+    drive = drivetrain;
+}
+
+Pose getPose(bool radians) {
+    if (radians) return odomPose;
+    return Pose(odomPose.x, odomPose.y, radToDeg(odomPose.theta));
+}
+
+void setPose(Pose pose, bool radians) {
+    if (radians) odomPose = pose;
+    else odomPose = Pose(pose.x, pose.y, degToRad(pose.theta));
+}
+
+Pose getSpeed(bool radians) {
+    if (radians) return odomSpeed;
+    return Pose(odomSpeed.x, odomSpeed.y, radToDeg(odomSpeed.theta));
+}
+
+Pose getLocalSpeed(bool radians) {
+    if (radians) return odomLocalSpeed;
+    return Pose(odomLocalSpeed.x, odomLocalSpeed.y, radToDeg(odomLocalSpeed.theta));
+}
+
+Pose estimatePose(float time, bool radians) {
+    const Pose pose = getPose(true);
+    const Pose delta = getLocalSpeed(true) * time;
+    const float avgHeading = pose.theta + delta.theta / 2;
+    float sin, cos;
+    math::sincos(avgHeading, sin, cos);
+    Pose future = pose;
+    future.x += delta.y * sin - delta.x * cos;
+    future.y += delta.y * cos + delta.x * sin;
+    future.theta = pose.theta + delta.theta;
+    if (!radians) future.theta = radToDeg(future.theta);
+    return future;
+}
+
+void update() {
+    LEMLIB_PROFILE_SCOPE("odom.update");
+    const float vertical1Raw = distanceOf(odomSensors.vertical1);
+    const float vertical2Raw = distanceOf(odomSensors.vertical2);
+    const float horizontal1Raw = distanceOf(odomSensors.horizontal1);
+    const float horizontal2Raw = distanceOf(odomSensors.horizontal2);
+    const float imuRaw = odomSensors.imu != nullptr ? degToRad(odomSensors.imu->get_rotation()) : 0;
+
+    const float deltaVertical1 = vertical1Raw - prevVertical1;
+    const float deltaVertical2 = vertical2Raw - prevVertical2;
+    const float deltaHorizontal1 = horizontal1Raw - prevHorizontal1;
+    const float deltaHorizontal2 = horizontal2Raw - prevHorizontal2;
+    const float deltaImu = imuRaw - prevImu;
+    prevVertical1 = vertical1Raw;
+    prevVertical2 = vertical2Raw;
+    prevHorizontal1 = horizontal1Raw;
+    prevHorizontal2 = horizontal2Raw;
+    prevImu = imuRaw;
+
+    // heading, from the most accurate source there is
+    float heading = odomPose.theta;
+    TrackingWheel* vertical1 = odomSensors.vertical1;
+    TrackingWheel* vertical2 = odomSensors.vertical2;
+    TrackingWheel* horizontal1 = odomSensors.horizontal1;
+    TrackingWheel* horizontal2 = odomSensors.horizontal2;
+    if (horizontal1 != nullptr && horizontal2 != nullptr) {
+        heading -= (deltaHorizontal1 - deltaHorizontal2) / (horizontal1->getOffset() - horizontal2->getOffset());
+    } else if (vertical1 != nullptr && vertical2 != nullptr && !vertical1->getType() && !vertical2->getType()) {
+        heading -= (deltaVertical1 - deltaVertical2) / (vertical1->getOffset() - vertical2->getOffset());
+    } else if (odomSensors.imu != nullptr) {
+        heading += deltaImu;
+    } else if (vertical1 != nullptr && vertical2 != nullptr) {
+        heading -= (deltaVertical1 - deltaVertical2) / (vertical1->getOffset() - vertical2->getOffset());
+    }
+    const float deltaHeading = heading - odomPose.theta;
+    const float avgHeading = odomPose.theta + deltaHeading / 2;
+
+    // prefer tracking wheels over drivetrain motors
+    TrackingWheel* verticalWheel = nullptr;
+    if (vertical1 != nullptr && !vertical1->getType()) verticalWheel = vertical1;
+    else if (vertical2 != nullptr && !vertical2->getType()) verticalWheel = vertical2;
+    else verticalWheel = vertical1;
+    TrackingWheel* horizontalWheel = horizontal1 != nullptr ? horizontal1 : horizontal2;
+
+    const float rawVertical = distanceOf(verticalWheel);
+    const float rawHorizontal = distanceOf(horizontalWheel);
+    const float verticalOffset = verticalWheel != nullptr ? verticalWheel->getOffset() : 0;
+    const float horizontalOffset = horizontalWheel != nullptr ? horizontalWheel->getOffset() : 0;
+    const float deltaY = rawVertical - prevVertical;
+    const float deltaX = rawHorizontal - prevHorizontal;
+    prevVertical = rawVertical;
+    prevHorizontal = rawHorizontal;
+
+    // local movement, along the arc the robot drove
+    float localX = deltaX;
+    float localY = deltaY;
+    if (deltaHeading != 0) {
+        const float chord = 2 * math::sin(deltaHeading / 2);
+        localX = chord * (deltaX / deltaHeading + horizontalOffset);
+        localY = chord * (deltaY / deltaHeading + verticalOffset);
+    }
+
+    float sin, cos;
+    math::sincos(avgHeading, sin, cos);
+    const Pose lastPose = odomPose;
+    odomPose.x += localY * sin - localX * cos;
+    odomPose.y += localY * cos + localX * sin;
+    odomPose.theta = heading;
+
+    odomSpeed.x = ema((odomPose.x - lastPose.x) / 0.01, odomSpeed.x, 0.95);
+    odomSpeed.y = ema((odomPose.y - lastPose.y) / 0.01, odomSpeed.y, 0.95);
+    odomSpeed.theta = ema(deltaHeading / 0.01, odomSpeed.theta, 0.95);
+    odomLocalSpeed.x = ema(localX / 0.01, odomLocalSpeed.x, 0.95);
+    odomLocalSpeed.y = ema(localY / 0.01, odomLocalSpeed.y, 0.95);
+    odomLocalSpeed.theta = ema(deltaHeading / 0.01, odomLocalSpeed.theta, 0.95);
+}
+
+void init() {
+    if (trackingTask != nullptr) return;
+    trackingTask = new pros::Task([] {
+        Deadline* deadline = deadlineMonitor().add("odometry", 10, 2000);
+        while (true) {
+            {
+                DeadlineCycle cycle(deadline);
+                update();
+            }
+            pros::delay(10);
+        }
+    });
+}
+} // namespace lemlib
@@ -0,0 +1,63 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "lemlib/chassis/purePursuit.hpp"
+
+namespace lemlib {
+int findClosest(Pose pose, const std::vector<Pose>& path) {
+    int closest = 0;
+    float closestDist = std::numeric_limits<float>::infinity();
+    for (size_t i = 0; i < path.size(); i++) {
+        const float dist = pose.distance(path[i]);
+        if (dist < closestDist) {
+            closestDist = dist;
+            closest = i;
+        }
+    }
+    return closest;
+}
+
+int findClosest(Pose pose, const PathSoA& path) { return path.closest(pose.x, pose.y); }
+
+float circleIntersect(Pose p1, Pose p2, Pose pose, float lookaheadDist) {
+    const Pose d = p2 - p1;
+    const Pose f = p1 - pose;
+    const float a = d * d;
+    const float b = 2 * (f * d);
+    const float c = f * f - lookaheadDist * lookaheadDist;
+    float discriminant = b * b - 4 * a * c;
+    if (discriminant >= 0) {
+        discriminant = std::sqrt(discriminant);
+        const float t1 = (-b - discriminant) / (2 * a);
+        const float t2 = (-b + discriminant) / (2 * a);
+        // prefer the intersection further along the path
+        if (t2 >= 0 && t2 <= 1) return t2;
+        if (t1 >= 0 && t1 <= 1) return t1;
+    }
+    return -1;
+}
+
+Pose lookaheadPoint(Pose lastLookahead, Pose pose, const std::vector<Pose>& path, int closest, float lookaheadDist) {
+    const size_t start = std::max(closest, int(lastLookahead.theta));
+    for (size_t i = start; i + 1 < path.size(); i++) {
+        const float t = circleIntersect(path[i], path[i + 1], pose, lookaheadDist);
+        if (t != -1) {
+            Pose lookahead = path[i].lerp(path[i + 1], t);
+            lookahead.theta = i;
+            return lookahead;
+        }
+    }
+    // the robot left the path, so keep following the last lookahead point
+    return lastLookahead;
+}
+
+Pose lookaheadPoint(Pose lastLookahead, Pose pose, const PathSoA& path, int closest, float lookaheadDist) {
+    const size_t start = std::max(closest, int(lastLookahead.theta));
+    const PathSoA::Intersection intersection = path.intersect(start, pose.x, pose.y, lookaheadDist);
+    if (intersection.segment == -1) return lastLookahead;
+    Pose lookahead = path.point(intersection.segment).lerp(path.point(intersection.segment + 1), intersection.t);
+    lookahead.theta = intersection.segment;
+    return lookahead;
+}
+} // namespace lemlib
@@ -0,0 +1,60 @@
+#include <cmath>
+
+#include "lemlib/chassis/trackingWheel.hpp"
+#include "lemlib/util.hpp"
+
+namespace lemlib {
+TrackingWheel::TrackingWheel(pros::adi::Encoder* encoder, float wheelDiameter, float distance, float gearRatio)
+    : diameter(wheelDiameter),
+      distance(distance),
+      rpm(0),
+      encoder(encoder),
+      gearRatio(gearRatio) {}
+
+TrackingWheel::TrackingWheel(pros::Rotation* encoder, float wheelDiameter, float distance, float gearRatio)
+    : diameter(wheelDiameter),
+      distance(distance),
+      rpm(0),
+      rotation(encoder),
+      gearRatio(gearRatio) {}
+
+TrackingWheel::TrackingWheel(pros::MotorGroup* motors, float wheelDiameter, float distance, float rpm)
+    : diameter(wheelDiameter),
+      distance(distance),
+      rpm(rpm),
+      motors(motors) {
+    motors->set_encoder_units_all(pros::MotorUnits::rotations);
+}
+
+void TrackingWheel::reset() {
+    if (encoder != nullptr) encoder->reset();
+    if (rotation != nullptr) rotation->reset_position();
+    if (motors != nullptr) motors->tare_position_all();
+}
+
+float TrackingWheel::getDistanceTraveled() {
+    if (encoder != nullptr) return float(encoder->get_value()) * diameter * M_PI / 360 / gearRatio;
+    if (rotation != nullptr) return float(rotation->get_position()) * diameter * M_PI / 36000 / gearRatio;
+    if (motors != nullptr) {
+        // the motors' positions are of their cartridges, so scale them by the drivetrain's gear ratio
+        const std::vector<pros::MotorGears> gearsets = motors->get_gearing_all();
+        const std::vector<double> positions = motors->get_position_all();
+        std::vector<float> distances;
+        for (size_t i = 0; i < std::min(gearsets.size(), positions.size()); i++) {
+            float cartridgeRpm;
+            switch (gearsets[i]) {
+                case pros::MotorGears::red: cartridgeRpm = 100; break;
+                case pros::MotorGears::blue: cartridgeRpm = 600; break;
+                default: cartridgeRpm = 200; break;
+            }
+            distances.push_back(positions[i] * diameter * M_PI * rpm / cartridgeRpm);
+        }
+        return avg(distances);
+    }
+    return 0;
+}
+
+float TrackingWheel::getOffset() { return distance; }
+
+int TrackingWheel::getType() { return motors != nullptr ? 1 : 0; }
+} // namespace lemlib
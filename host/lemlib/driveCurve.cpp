@@ -0,0 +1,20 @@
+#include <cmath>
+
+#include "lemlib/util.hpp"
+
+namespace lemlib {
+ExpoDriveCurve::ExpoDriveCurve(float deadband, float minOutput, float curve)
+    : deadband(deadband),
+      minOutput(minOutput),
+      curveGain(curve) {}
+
+float ExpoDriveCurve::curve(float input) {
+    if (std::fabs(input) <= deadband) return 0;
+    // scale the input past the deadband so that full input still gives full output
+    const float g = std::fabs(input) - deadband;
+    const float g127 = 127 - deadband;
+    const float i = std::pow(curveGain, g - 127) * g * sgn(input);
+    const float i127 = std::pow(curveGain, g127 - 127) * g127;
+    return (127 - minOutput) / 127 * i * 127 / i127 + minOutput * sgn(input);
+}
+} // namespace lemlib
@@ -0,0 +1,17 @@
+#include "lemlib/logger/baseSink.hpp"
+
+namespace lemlib {
+BaseSink::BaseSink(std::initializer_list<std::shared_ptr<BaseSink>> sinks)
+    : sinks(sinks) {}
+
+void BaseSink::setLowestLevel(Level level) { lowestLevel = level; }
+
+void BaseSink::setFormat(const std::string& format) { logFormat = format; }
+
+void BaseSink::sendMessage(const Message& message) { (void)message; }
+
+fmt::dynamic_format_arg_store<fmt::format_context> BaseSink::getExtraFormattingArgs(const Message& messageInfo) {
+    (void)messageInfo;
+    return {};
+}
+} // namespace lemlib
@@ -0,0 +1,32 @@
+#include "lemlib/logger/buffer.hpp"
+
+namespace lemlib {
+Buffer::Buffer(std::function<void(const std::string&)> bufferFunc)
+    : bufferFunc(bufferFunc),
+      task([this]() { taskLoop(); }),
+      rate(50) {}
+
+Buffer::~Buffer() { task.remove(); }
+
+void Buffer::pushToBuffer(const std::string& bufferData) {
+    mutex.lock();
+    buffer.push_back(bufferData);
+    mutex.unlock();
+}
+
+void Buffer::taskLoop() {
+    while (true) {
+        mutex.lock();
+        if (!buffer.empty()) {
+            bufferFunc(buffer.front());
+            buffer.pop_front();
+        }
+        mutex.unlock();
+        pros::delay(rate);
+    }
+}
+
+void Buffer::setRate(uint32_t rate) { this->rate = rate; }
+
+bool Buffer::buffersEmpty() { return buffer.empty(); }
+} // namespace lemlib
@@ -0,0 +1,18 @@
+#include "lemlib/logger/infoSink.hpp"
+#include "lemlib/logger/stdout.hpp"
+
+namespace lemlib {
+InfoSink::InfoSink() { setFormat("[LemLib] {level}: {message}"); }
+
+void InfoSink::sendMessage(const Message& message) {
+    const char* color = "";
+    switch (message.level) {
+        case Level::DEBUG: color = "\033[0;36m"; break;
+        case Level::INFO: color = "\033[0;32m"; break;
+        case Level::WARN: color = "\033[0;33m"; break;
+        case Level::ERROR: color = "\033[0;31m"; break;
+        case Level::FATAL: color = "\033[0;31;2m"; break;
+    }
+    bufferedStdout().print("{}{}\033[0m\n", color, message.message);
+}
+} // namespace lemlib
@@ -0,0 +1,15 @@
+#include <cstdio>
+
+#include "lemlib/logger/stdout.hpp"
+
+namespace lemlib {
+BufferedStdout::BufferedStdout()
+    : Buffer([](const std::string& text) { std::fputs(text.c_str(), stdout); }) {
+    setRate(50);
+}
+
+BufferedStdout& bufferedStdout() {
+    static BufferedStdout bufferedStdout;
+    return bufferedStdout;
+}
+} // namespace lemlib
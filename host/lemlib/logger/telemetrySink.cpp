@@ -0,0 +1,14 @@
+#include "lemlib/logger/telemetrySink.hpp"
+#include "lemlib/logger/stdout.hpp"
+
+namespace lemlib {
+TelemetrySink::TelemetrySink() {
+    setLowestLevel(Level::DEBUG);
+    setFormat("TELE_{level}:{message}TELE_END");
+}
+
+// save the cursor, print, then restore the cursor and clear what was printed, so telemetry doesn't clutter the terminal
+void TelemetrySink::sendMessage(const Message& message) {
+    bufferedStdout().print("\033[s{}\033[u\033[0J", message.message);
+}
+} // namespace lemlib
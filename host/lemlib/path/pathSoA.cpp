@@ -0,0 +1,101 @@
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "lemlib/math/fastMath.hpp"
+#include "lemlib/path/pathSoA.hpp"
+
+namespace {
+// 4 floats, which GCC compiles to NEON on the brain and SSE on a computer
+using Floats = float __attribute__((vector_size(16)));
+using Ints = int32_t __attribute__((vector_size(16)));
+constexpr size_t LANES = sizeof(Floats) / sizeof(float);
+constexpr size_t FIELDS = 5;
+
+Floats load(const float* values) {
+    Floats vector;
+    std::memcpy(&vector, values, sizeof(vector));
+    return vector;
+}
+
+// signed curvature of the circle through 3 points: 4 times the area of their triangle over the product of its sides
+float mengerCurvature(const lemlib::Pose& a, const lemlib::Pose& b, const lemlib::Pose& c) {
+    const float cross = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    const float sides = a.distance(b) * b.distance(c) * a.distance(c);
+    return sides == 0 ? 0 : 2 * cross / sides;
+}
+} // namespace
+
+namespace lemlib {
+PathSoA::PathSoA(const std::vector<Pose>& points)
+    : count(points.size()),
+      stride((points.size() + LANES - 1) / LANES * LANES + LANES),
+      data(FIELDS * stride, std::numeric_limits<float>::quiet_NaN()) {
+    float* xs = data.data();
+    float* ys = xs + stride;
+    float* velocities = ys + stride;
+    float* curvatures = velocities + stride;
+    float* arcLengths = curvatures + stride;
+    for (size_t i = 0; i < count; i++) {
+        xs[i] = points[i].x;
+        ys[i] = points[i].y;
+        velocities[i] = points[i].theta;
+        curvatures[i] = i == 0 || i + 1 == count ? 0 : mengerCurvature(points[i - 1], points[i], points[i + 1]);
+        arcLengths[i] = i == 0 ? 0 : arcLengths[i - 1] + points[i - 1].distance(points[i]);
+    }
+}
+
+size_t PathSoA::closest(float x, float y) const {
+    if (count == 0) return 0;
+    // each lane keeps the closest of the points it sees, by squared distance, which orders them the same
+    Floats bestDistance = Floats {} + std::numeric_limits<float>::infinity();
+    Ints index = {0, 1, 2, 3};
+    Ints bestIndex = index;
+    for (size_t i = 0; i < count; i += LANES, index += int32_t(LANES)) {
+        const Floats dx = load(this->x() + i) - x;
+        const Floats dy = load(this->y() + i) - y;
+        const Floats distance = dx * dx + dy * dy;
+        const Ints closer = distance < bestDistance;
+        bestDistance = closer ? distance : bestDistance;
+        bestIndex = closer ? index : bestIndex;
+    }
+    // then the closest of the lanes, and the first point of those that are as close
+    size_t best = bestIndex[0];
+    float distance = bestDistance[0];
+    for (size_t lane = 1; lane < LANES; lane++) {
+        if (bestDistance[lane] < distance || (bestDistance[lane] == distance && size_t(bestIndex[lane]) < best)) {
+            distance = bestDistance[lane];
+            best = bestIndex[lane];
+        }
+    }
+    return best;
+}
+
+PathSoA::Intersection PathSoA::intersect(size_t start, float x, float y, float radius) const {
+    // the segment from the last point ends in the padding, so it never intersects
+    for (size_t i = start; i + 1 < count; i += LANES) {
+        const Floats x1 = load(this->x() + i);
+        const Floats y1 = load(this->y() + i);
+        const Floats dx = load(this->x() + i + 1) - x1;
+        const Floats dy = load(this->y() + i + 1) - y1;
+        const Floats fx = x1 - x;
+        const Floats fy = y1 - y;
+        // the roots of |p1 + t * d - center|^2 = radius^2, as in circleIntersect()
+        const Floats a = dx * dx + dy * dy;
+        const Floats b = 2 * (fx * dx + fy * dy);
+        const Floats c = fx * fx + fy * fy - radius * radius;
+        const Floats discriminant = b * b - 4 * a * c;
+        const Ints real = discriminant >= 0;
+        const Floats root = fast::kernel::squareRoot(real ? discriminant : Floats {});
+        const Floats t1 = fast::kernel::divide(-b - root, 2 * a);
+        const Floats t2 = fast::kernel::divide(-b + root, 2 * a);
+        const Ints onSegment1 = (t1 >= 0) & (t1 <= 1);
+        const Ints onSegment2 = (t2 >= 0) & (t2 <= 1);
+        const Ints hit = real & (onSegment1 | onSegment2);
+        for (size_t lane = 0; lane < LANES; lane++) {
+            if (hit[lane]) return {int(i + lane), onSegment2[lane] ? t2[lane] : t1[lane]};
+        }
+    }
+    return {-1, 0};
+}
+} // namespace lemlib
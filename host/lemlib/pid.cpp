@@ -0,0 +1,29 @@
+#include <cmath>
+
+#include "lemlib/pid.hpp"
+#include "lemlib/profiling/scopeTimer.hpp"
+#include "lemlib/util.hpp"
+
+namespace lemlib {
+PID::PID(float kP, float kI, float kD, float windupRange, bool signFlipReset)
+    : kP(kP),
+      kI(kI),
+      kD(kD),
+      windupRange(windupRange),
+      signFlipReset(signFlipReset) {}
+
+float PID::update(const float error) {
+    LEMLIB_PROFILE_SCOPE("PID::update");
+    integral += error;
+    if (signFlipReset && sgn(error) != sgn(prevError)) integral = 0;
+    if (windupRange != 0 && std::fabs(error) > windupRange) integral = 0;
+    const float derivative = error - prevError;
+    prevError = error;
+    return error * kP + integral * kI + derivative * kD;
+}
+
+void PID::reset() {
+    integral = 0;
+    prevError = 0;
+}
+} // namespace lemlib
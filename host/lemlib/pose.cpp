@@ -0,0 +1,40 @@
+#include <cmath>
+
+#define FMT_HEADER_ONLY
+#include "fmt/core.h"
+
+#include "lemlib/math/fastMath.hpp"
+#include "lemlib/pose.hpp"
+
+namespace lemlib {
+Pose::Pose(float x, float y, float theta)
+    : x(x),
+      y(y),
+      theta(theta) {}
+
+Pose Pose::operator+(const Pose& other) const { return Pose(x + other.x, y + other.y, theta); }
+
+Pose Pose::operator-(const Pose& other) const { return Pose(x - other.x, y - other.y, theta); }
+
+float Pose::operator*(const Pose& other) const { return x * other.x + y * other.y; }
+
+Pose Pose::operator*(const float& other) const { return Pose(x * other, y * other, theta); }
+
+Pose Pose::operator/(const float& other) const { return Pose(x / other, y / other, theta); }
+
+Pose Pose::lerp(Pose other, float t) const { return Pose(x + (other.x - x) * t, y + (other.y - y) * t, theta); }
+
+float Pose::distance(Pose other) const { return math::hypot(x - other.x, y - other.y); }
+
+float Pose::angle(Pose other) const { return math::atan2(other.y - y, other.x - x); }
+
+Pose Pose::rotate(float angle) const {
+    float sin, cos;
+    math::sincos(angle, sin, cos);
+    return Pose(x * cos - y * sin, x * sin + y * cos, theta);
+}
+
+std::string format_as(const Pose& pose) {
+    return fmt::format("lemlib::Pose {{ x: {}, y: {}, theta: {} }}", pose.x, pose.y, pose.theta);
+}
+} // namespace lemlib
@@ -0,0 +1,50 @@
+#include "pros/rtos.hpp"
+#include "lemlib/timer.hpp"
+
+namespace lemlib {
+Timer::Timer(uint32_t time)
+    : period(time),
+      lastTime(pros::millis()) {}
+
+uint32_t Timer::getTimeSet() { return period; }
+
+uint32_t Timer::getTimeLeft() {
+    const uint32_t passed = getTimePassed();
+    return passed < period ? period - passed : 0;
+}
+
+uint32_t Timer::getTimePassed() {
+    const uint32_t now = pros::millis();
+    if (!paused) timeWaited += now - lastTime;
+    lastTime = now;
+    return timeWaited;
+}
+
+bool Timer::isDone() { return getTimePassed() >= period; }
+
+bool Timer::isPaused() { return paused; }
+
+void Timer::set(uint32_t time) {
+    period = time;
+    reset();
+}
+
+void Timer::reset() {
+    timeWaited = 0;
+    lastTime = pros::millis();
+}
+
+void Timer::pause() {
+    getTimePassed();
+    paused = true;
+}
+
+void Timer::resume() {
+    getTimePassed();
+    paused = false;
+}
+
+void Timer::waitUntilDone() {
+    while (!isDone()) pros::delay(5);
+}
+} // namespace lemlib
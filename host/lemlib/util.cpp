@@ -0,0 +1,48 @@
+#include <algorithm>
+#include <cmath>
+
+#include "lemlib/math/fastMath.hpp"
+#include "lemlib/util.hpp"
+
+namespace lemlib {
+float slew(float target, float current, float maxChange) {
+    if (maxChange == 0) return target;
+    return current + std::clamp(target - current, -maxChange, maxChange);
+}
+
+constexpr float sanitizeAngle(float angle, bool radians) {
+    const float max = radians ? 2 * M_PI : 360;
+    return std::fmod(std::fmod(angle, max) + max, max);
+}
+
+float angleError(float target, float position, bool radians, AngularDirection direction) {
+    const float max = radians ? 2 * M_PI : 360;
+    const float rawError = sanitizeAngle(target, radians) - sanitizeAngle(position, radians);
+    switch (direction) {
+        case AngularDirection::CW_CLOCKWISE: return rawError < 0 ? rawError + max : rawError;
+        case AngularDirection::CCW_COUNTERCLOCKWISE: return rawError > 0 ? rawError - max : rawError;
+        default: return std::remainder(rawError, max);
+    }
+}
+
+float avg(std::vector<float> values) {
+    float sum = 0;
+    for (float value : values) sum += value;
+    return sum / values.size();
+}
+
+float ema(float current, float previous, float smooth) { return current * smooth + previous * (1 - smooth); }
+
+float getCurvature(Pose pose, Pose other) {
+    // which side of the robot the other pose is on
+    float sin, cos;
+    math::sincos(pose.theta, sin, cos);
+    const float side = sgn(sin * (other.x - pose.x) - cos * (other.y - pose.y));
+    // distance from the other pose to the line through the robot
+    const float a = -std::tan(pose.theta);
+    const float c = std::tan(pose.theta) * pose.x - pose.y;
+    const float x = std::fabs(a * other.x + other.y + c) / std::sqrt(a * a + 1);
+    const float d = math::hypot(other.x - pose.x, other.y - pose.y);
+    return side * (2 * x / (d * d));
+}
+} // namespace lemlib
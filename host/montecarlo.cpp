@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "batch/run.hpp"
+#include "batch/threadPool.hpp"
+
+/**
+ * Runs autonomous many times, with the robot randomized a little differently each time, and reports how much the
+ * results spread. One good run on the field says little about a skills run; the spread says how often it goes wrong.
+ *
+ * Usage: montecarlo [--runs <count>] [--jobs <threads>] [--seed <seed>] [--time <milliseconds>]
+ *                   [--start-error <inches>] [--heading-error <degrees>] [--battery <min>,<max>]
+ *                   [--motor-variation <fraction>] [--csv <file>]
+ *
+ * Each run has its own sensor noise, its own motors, each a little stronger or weaker than a typical motor (by the
+ * standard deviation --motor-variation), a start that is off by a normally distributed error (--start-error and
+ * --heading-error are standard deviations), and a battery charged uniformly between --battery's bounds. Runs are
+ * spread over all the cores, or --jobs threads, each in its own process. A run with the same --seed and index is the
+ * same run, so a bad run can be repeated with robot on its own: --csv writes each run's arguments and results.
+ *
+ * Final pose error is how far each run ended up from where a run without any noise or errors ends up. Odometry error
+ * is how far the robot ended up from where it thinks it is.
+ */
+namespace {
+struct Options {
+        unsigned runs = 1000;
+        unsigned jobs = 0;
+        uint64_t seed = 1;
+        std::string time = "60000";
+        double startError = 0.5;
+        double headingError = 1;
+        double minBattery = 50;
+        double maxBattery = 100;
+        double motorVariation = 0.05;
+        const char* csv = nullptr;
+};
+
+/**
+ * @brief A run's randomized robot, and what it did
+ */
+struct Run {
+        std::vector<std::string> arguments;
+        batch::RunResult result;
+};
+
+int usage(const char* program) {
+    std::fprintf(stderr,
+                 "usage: %s [--runs <count>] [--jobs <threads>] [--seed <seed>] [--time <milliseconds>] "
+                 "[--start-error <inches>] [--heading-error <degrees>] [--battery <min>,<max>] "
+                 "[--motor-variation <fraction>] [--csv <file>]\n",
+                 program);
+    return 2;
+}
+
+// arguments to robot for a run
+std::vector<std::string> randomize(const Options& options, unsigned index) {
+    std::mt19937_64 random(options.seed * 0x9e3779b97f4a7c15 + index);
+    std::normal_distribution<double> normal;
+    std::uniform_real_distribution<double> battery(options.minBattery, options.maxBattery);
+    const double x = options.startError * normal(random);
+    const double y = options.startError * normal(random);
+    const double theta = options.headingError * normal(random);
+    char startError[64];
+    std::snprintf(startError, sizeof(startError), "%.4f,%.4f,%.4f", x, y, theta);
+    return {"--time",
+            options.time,
+            "--seed",
+            std::to_string(random()),
+            "--start-error",
+            startError,
+            "--battery",
+            std::to_string(battery(random)),
+            "--motor-variation",
+            std::to_string(options.motorVariation)};
+}
+
+double distance(const sim::Pose& a, const sim::Pose& b) { return std::hypot(a.x - b.x, a.y - b.y); }
+
+// difference between two headings, in degrees, from 0 to 180
+double headingDifference(double a, double b) { return std::fabs(std::remainder(a - b, 360)); }
+
+// print a line of the table: the mean, standard deviation, and percentiles of a sample
+void printDistribution(const char* name, std::vector<double> sample) {
+    if (sample.empty()) return;
+    std::sort(sample.begin(), sample.end());
+    double sum = 0;
+    for (double value : sample) sum += value;
+    const double mean = sum / sample.size();
+    double squares = 0;
+    for (double value : sample) squares += (value - mean) * (value - mean);
+    const double deviation = sample.size() > 1 ? std::sqrt(squares / (sample.size() - 1)) : 0;
+    auto percentile = [&](double p) { return sample[std::lround(p * (sample.size() - 1))]; };
+    std::printf("%-24s %8zu %9.3f %9.3f %9.3f %9.3f %9.3f %9.3f %9.3f\n", name, sample.size(), mean, deviation,
+                sample.front(), percentile(0.05), percentile(0.5), percentile(0.95), sample.back());
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--runs") == 0 && hasValue) {
+            options.runs = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--jobs") == 0 && hasValue) {
+            options.jobs = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--time") == 0 && hasValue) {
+            options.time = argv[++i];
+        } else if (std::strcmp(argv[i], "--start-error") == 0 && hasValue) {
+            options.startError = std::strtod(argv[++i], nullptr);
+        } else if (std::strcmp(argv[i], "--heading-error") == 0 && hasValue) {
+            options.headingError = std::strtod(argv[++i], nullptr);
+        } else if (std::strcmp(argv[i], "--battery") == 0 && hasValue) {
+            if (std::sscanf(argv[++i], "%lf,%lf", &options.minBattery, &options.maxBattery) != 2) {
+                return usage(argv[0]);
+            }
+        } else if (std::strcmp(argv[i], "--motor-variation") == 0 && hasValue) {
+            options.motorVariation = std::strtod(argv[++i], nullptr);
+        } else if (std::strcmp(argv[i], "--csv") == 0 && hasValue) {
+            options.csv = argv[++i];
+        } else {
+            return usage(argv[0]);
+        }
+    }
+
+    const batch::RunResult nominal = batch::run({"--time", options.time, "--no-noise"});
+    if (!nominal.ok) {
+        std::fprintf(stderr, "the run without noise failed. Does %s run?\n", batch::robotPath().c_str());
+        return 1;
+    }
+
+    std::vector<Run> runs(options.runs);
+    {
+        batch::ThreadPool pool(options.jobs);
+        std::fprintf(stderr, "running %u runs on %u threads\n", options.runs, pool.size());
+        for (unsigned i = 0; i < options.runs; i++) {
+            pool.submit([&options, &runs, i] {
+                runs[i].arguments = randomize(options, i);
+                runs[i].result = batch::run(runs[i].arguments);
+            });
+        }
+    }
+
+    std::vector<double> positionErrors, headingErrors, odometryErrors, durations;
+    std::vector<std::vector<double>> motions(nominal.motions.size());
+    unsigned failed = 0, timedOut = 0;
+    for (const Run& run : runs) {
+        const batch::RunResult& result = run.result;
+        if (!result.ok) {
+            failed++;
+            continue;
+        }
+        if (!result.finished) timedOut++;
+        positionErrors.push_back(distance(result.actual, nominal.actual));
+        headingErrors.push_back(headingDifference(result.actual.theta, nominal.actual.theta));
+        odometryErrors.push_back(distance(result.odometry, result.actual));
+        durations.push_back(result.duration);
+        for (size_t i = 0; i < std::min(result.motions.size(), motions.size()); i++) {
+            motions[i].push_back(result.motions[i]);
+        }
+    }
+
+    std::printf("%u runs, %u failed, %u timed out\n", options.runs, failed, timedOut);
+    std::printf("nominal: duration %.3f s, pose x %.2f, y %.2f, theta %.2f\n\n", nominal.duration, nominal.actual.x,
+                nominal.actual.y, nominal.actual.theta);
+    std::printf("%-24s %8s %9s %9s %9s %9s %9s %9s %9s\n", "", "n", "mean", "stddev", "min", "p5", "median", "p95",
+                "max");
+    printDistribution("position error (in)", positionErrors);
+    printDistribution("heading error (deg)", headingErrors);
+    printDistribution("odometry error (in)", odometryErrors);
+    printDistribution("duration (s)", durations);
+    for (size_t i = 0; i < motions.size(); i++) {
+        const std::string name = "motion " + std::to_string(i) + " settle (s)";
+        printDistribution(name.c_str(), motions[i]);
+    }
+
+    if (options.csv != nullptr) {
+        FILE* csv = std::fopen(options.csv, "w");
+        if (csv == nullptr) {
+            std::perror(options.csv);
+            return 1;
+        }
+        std::fprintf(csv, "run,arguments,ok,finished,duration,x,y,theta,odometryX,odometryY,odometryTheta");
+        for (size_t i = 0; i < motions.size(); i++) std::fprintf(csv, ",motion%zu", i);
+        std::fprintf(csv, "\n");
+        for (size_t i = 0; i < runs.size(); i++) {
+            const batch::RunResult& result = runs[i].result;
+            std::string arguments;
+            for (const std::string& argument : runs[i].arguments) {
+                if (!arguments.empty()) arguments += ' ';
+                arguments += argument;
+            }
+            std::fprintf(csv, "%zu,%s,%d,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f", i, arguments.c_str(), result.ok,
+                         result.finished, result.duration, result.actual.x, result.actual.y, result.actual.theta,
+                         result.odometry.x, result.odometry.y, result.odometry.theta);
+            for (double motion : result.motions) std::fprintf(csv, ",%.3f", motion);
+            std::fprintf(csv, "\n");
+        }
+        std::fclose(csv);
+    }
+    return 0;
+}
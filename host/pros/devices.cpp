@@ -0,0 +1,569 @@
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+
+#include "pros/adi.hpp"
+#include "pros/device.hpp"
+#include "pros/error.h"
+#include "pros/imu.hpp"
+#include "pros/llemu.h"
+#include "pros/llemu.hpp"
+#include "pros/misc.hpp"
+#include "pros/rotation.hpp"
+#include "pros/rtos.h"
+#include "sim/devices.hpp"
+#include "sim/kernel.hpp"
+
+namespace {
+using sim::ControllerDevice;
+using sim::ImuDevice;
+using sim::RotationDevice;
+
+constexpr int SMART_PORTS = 21;
+
+sim::MotorDevice motors[SMART_PORTS];
+sim::ImuDevice imus[SMART_PORTS];
+sim::RotationDevice rotations[SMART_PORTS];
+int32_t adiValues[NUM_ADI_PORTS];
+pros::adi_port_config_e_t adiConfigs[NUM_ADI_PORTS];
+// encoders can't store this in the object, since the PROS class has no room for it
+bool encoderReversed[NUM_ADI_PORTS];
+int32_t encoderZero[NUM_ADI_PORTS];
+sim::ControllerDevice controllers[2];
+// buttons whose press was already returned by get_digital_new_press(), and likewise for releases
+uint16_t pressesSeen[2];
+uint16_t releasesSeen[2];
+sim::BatteryDevice batteryDevice;
+uint8_t competitionState = 0;
+
+int smartIndex(int port) {
+    port = std::abs(port);
+    return port >= 1 && port <= SMART_PORTS ? port - 1 : -1;
+}
+
+int adiIndex(uint8_t port) {
+    if (port >= 'a' && port <= 'h') return port - 'a';
+    if (port >= 'A' && port <= 'H') return port - 'A';
+    if (port >= 1 && port <= NUM_ADI_PORTS) return port - 1;
+    return -1;
+}
+
+// the IMU, or nullptr with errno set if it doesn't exist or is calibrating
+sim::ImuDevice* readyImu(uint8_t port) {
+    sim::ImuDevice* imu = sim::imu(port);
+    if (imu == nullptr) {
+        errno = ENXIO;
+    } else if (sim::time() < imu->calibrationEnd) {
+        errno = EAGAIN;
+        return nullptr;
+    }
+    return imu;
+}
+
+double wrap(double angle, double min) { return angle - 360 * std::floor((angle - min) / 360); }
+
+uint16_t buttonBit(pros::controller_digital_e_t button) { return 1 << (button - pros::E_CONTROLLER_DIGITAL_L1); }
+} // namespace
+
+namespace sim {
+MotorDevice* motor(int8_t port) {
+    const int index = smartIndex(port);
+    return index < 0 ? nullptr : &motors[index];
+}
+
+ImuDevice* imu(uint8_t port) {
+    const int index = smartIndex(port);
+    return index < 0 ? nullptr : &imus[index];
+}
+
+RotationDevice* rotation(int8_t port) {
+    const int index = smartIndex(port);
+    return index < 0 ? nullptr : &rotations[index];
+}
+
+int32_t* adi(uint8_t port) {
+    const int index = adiIndex(port);
+    return index < 0 ? nullptr : &adiValues[index];
+}
+
+ControllerDevice& controller(pros::controller_id_e_t id) {
+    return controllers[id == pros::E_CONTROLLER_PARTNER ? 1 : 0];
+}
+
+BatteryDevice& battery() { return batteryDevice; }
+
+uint8_t& competitionStatus() { return competitionState; }
+} // namespace sim
+
+namespace pros {
+inline namespace v5 {
+Device::Device(const std::uint8_t port)
+    : _port(port) {}
+
+std::uint8_t Device::get_port() const { return _port; }
+
+// every device the program uses is plugged in
+bool Device::is_installed() { return smartIndex(_port) >= 0; }
+
+pros::DeviceType Device::get_plugged_type() const { return _deviceType; }
+
+// the host build doesn't know what a device it wasn't told about is
+pros::DeviceType Device::get_plugged_type(std::uint8_t port) {
+    (void)port;
+    return DeviceType::undefined;
+}
+
+std::int32_t Imu::reset(bool blocking) const {
+    ImuDevice* imu = sim::imu(_port);
+    if (imu == nullptr) {
+        errno = ENXIO;
+        return PROS_ERR;
+    }
+    // calibration takes about 2 seconds, and zeroes every angle
+    imu->calibrationEnd = sim::time() + 2000000;
+    imu->rotationOffset = -imu->yaw;
+    imu->headingOffset = -imu->yaw;
+    imu->yawOffset = -imu->yaw;
+    imu->pitchOffset = -imu->pitch;
+    imu->rollOffset = -imu->roll;
+    if (blocking) {
+        while (sim::time() < imu->calibrationEnd) pros::c::delay(10);
+    }
+    return PROS_SUCCESS;
+}
+
+std::int32_t Imu::set_data_rate(std::uint32_t rate) const {
+    (void)rate;
+    return sim::imu(_port) == nullptr ? PROS_ERR : PROS_SUCCESS;
+}
+
+double Imu::get_rotation() const {
+    const ImuDevice* imu = readyImu(_port);
+    return imu == nullptr ? PROS_ERR_F : imu->yaw + imu->rotationOffset;
+}
+
+double Imu::get_heading() const {
+    const ImuDevice* imu = readyImu(_port);
+    return imu == nullptr ? PROS_ERR_F : wrap(imu->yaw + imu->headingOffset, 0);
+}
+
+pros::quaternion_s_t Imu::get_quaternion() const {
+    const pros::euler_s_t euler = get_euler();
+    if (std::isinf(euler.yaw)) return {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F, PROS_ERR_F};
+    // yaw, pitch and roll are applied about z, y and x
+    const double cy = std::cos(-euler.yaw * M_PI / 360), sy = std::sin(-euler.yaw * M_PI / 360);
+    const double cp = std::cos(euler.pitch * M_PI / 360), sp = std::sin(euler.pitch * M_PI / 360);
+    const double cr = std::cos(euler.roll * M_PI / 360), sr = std::sin(euler.roll * M_PI / 360);
+    return {sr * cp * cy - cr * sp * sy, cr * sp * cy + sr * cp * sy, cr * cp * sy - sr * sp * cy,
+            cr * cp * cy + sr * sp * sy};
+}
+
+pros::euler_s_t Imu::get_euler() const {
+    const ImuDevice* imu = readyImu(_port);
+    if (imu == nullptr) return {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F};
+    return {wrap(imu->pitch + imu->pitchOffset, -180), wrap(imu->roll + imu->rollOffset, -180),
+            wrap(imu->yaw + imu->yawOffset, -180)};
+}
+
+double Imu::get_pitch() const { return get_euler().pitch; }
+
+double Imu::get_roll() const { return get_euler().roll; }
+
+double Imu::get_yaw() const { return get_euler().yaw; }
+
+pros::imu_gyro_s_t Imu::get_gyro_rate() const {
+    const ImuDevice* imu = readyImu(_port);
+    return imu == nullptr ? pros::imu_gyro_s_t {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F} : imu->gyro;
+}
+
+pros::imu_accel_s_t Imu::get_accel() const {
+    const ImuDevice* imu = readyImu(_port);
+    return imu == nullptr ? pros::imu_accel_s_t {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F} : imu->accel;
+}
+
+std::int32_t Imu::tare_rotation() const { return set_rotation(0); }
+
+std::int32_t Imu::tare_heading() const { return set_heading(0); }
+
+std::int32_t Imu::tare_pitch() const { return set_pitch(0); }
+
+std::int32_t Imu::tare_yaw() const { return set_yaw(0); }
+
+std::int32_t Imu::tare_roll() const { return set_roll(0); }
+
+std::int32_t Imu::tare_euler() const { return set_euler({0, 0, 0}); }
+
+std::int32_t Imu::tare() const {
+    if (tare_euler() == PROS_ERR || tare_heading() == PROS_ERR) return PROS_ERR;
+    return tare_rotation();
+}
+
+std::int32_t Imu::set_heading(const double target) const {
+    ImuDevice* imu = readyImu(_port);
+    if (imu == nullptr) return PROS_ERR;
+    imu->headingOffset = target - imu->yaw;
+    return PROS_SUCCESS;
+}
+
+std::int32_t Imu::set_rotation(const double target) const {
+    ImuDevice* imu = readyImu(_port);
+    if (imu == nullptr) return PROS_ERR;
+    imu->rotationOffset = target - imu->yaw;
+    return PROS_SUCCESS;
+}
+
+std::int32_t Imu::set_yaw(const double target) const {
+    ImuDevice* imu = readyImu(_port);
+    if (imu == nullptr) return PROS_ERR;
+    imu->yawOffset = target - imu->yaw;
+    return PROS_SUCCESS;
+}
+
+std::int32_t Imu::set_pitch(const double target) const {
+    ImuDevice* imu = readyImu(_port);
+    if (imu == nullptr) return PROS_ERR;
+    imu->pitchOffset = target - imu->pitch;
+    return PROS_SUCCESS;
+}
+
+std::int32_t Imu::set_roll(const double target) const {
+    ImuDevice* imu = readyImu(_port);
+    if (imu == nullptr) return PROS_ERR;
+    imu->rollOffset = target - imu->roll;
+    return PROS_SUCCESS;
+}
+
+std::int32_t Imu::set_euler(const pros::euler_s_t target) const {
+    if (set_pitch(target.pitch) == PROS_ERR || set_roll(target.roll) == PROS_ERR) return PROS_ERR;
+    return set_yaw(target.yaw);
+}
+
+pros::ImuStatus Imu::get_status() const {
+    const ImuDevice* imu = sim::imu(_port);
+    if (imu == nullptr) return ImuStatus::error;
+    return sim::time() < imu->calibrationEnd ? ImuStatus::calibrating : ImuStatus::ready;
+}
+
+bool Imu::is_calibrating() const { return get_status() == ImuStatus::calibrating; }
+
+imu_orientation_e_t Imu::get_physical_orientation() const { return E_IMU_Z_UP; }
+
+Rotation::Rotation(const std::int8_t port)
+    : Device(std::abs(port), DeviceType::rotation) {
+    if (port < 0) set_reversed(true);
+}
+
+std::int32_t Rotation::reset() {
+    RotationDevice* rotation = sim::rotation(_port);
+    if (rotation == nullptr) return PROS_ERR;
+    // the position starts over from the angle
+    rotation->zeroPosition = 0;
+    return set_position(get_angle());
+}
+
+std::int32_t Rotation::set_data_rate(std::uint32_t rate) const {
+    (void)rate;
+    return sim::rotation(_port) == nullptr ? PROS_ERR : PROS_SUCCESS;
+}
+
+std::int32_t Rotation::set_position(std::int32_t position) const {
+    RotationDevice* rotation = sim::rotation(_port);
+    if (rotation == nullptr) return PROS_ERR;
+    rotation->zeroPosition = (rotation->reversed ? -rotation->position : rotation->position) - position;
+    return PROS_SUCCESS;
+}
+
+std::int32_t Rotation::reset_position() const { return set_position(0); }
+
+std::int32_t Rotation::get_position() const {
+    const RotationDevice* rotation = sim::rotation(_port);
+    if (rotation == nullptr) return PROS_ERR;
+    return (rotation->reversed ? -rotation->position : rotation->position) - rotation->zeroPosition;
+}
+
+std::int32_t Rotation::get_velocity() const {
+    const RotationDevice* rotation = sim::rotation(_port);
+    if (rotation == nullptr) return PROS_ERR;
+    return rotation->reversed ? -rotation->velocity : rotation->velocity;
+}
+
+std::int32_t Rotation::get_angle() const {
+    const RotationDevice* rotation = sim::rotation(_port);
+    if (rotation == nullptr) return PROS_ERR;
+    const int32_t position = rotation->reversed ? -rotation->position : rotation->position;
+    return (position % 36000 + 36000) % 36000;
+}
+
+std::int32_t Rotation::set_reversed(bool value) const {
+    RotationDevice* rotation = sim::rotation(_port);
+    if (rotation == nullptr) return PROS_ERR;
+    rotation->reversed = value;
+    return PROS_SUCCESS;
+}
+
+std::int32_t Rotation::reverse() const { return set_reversed(!get_reversed()); }
+
+std::int32_t Rotation::get_reversed() const {
+    const RotationDevice* rotation = sim::rotation(_port);
+    return rotation == nullptr ? PROS_ERR : rotation->reversed;
+}
+
+Controller::Controller(controller_id_e_t id)
+    : _id(id) {}
+
+std::int32_t Controller::is_connected() { return sim::controller(_id).connected; }
+
+std::int32_t Controller::get_analog(controller_analog_e_t channel) {
+    const ControllerDevice& controller = sim::controller(_id);
+    if (!controller.connected) return 0;
+    return channel >= 0 && channel < 4 ? controller.analog[channel] : 0;
+}
+
+std::int32_t Controller::get_battery_capacity() { return 100; }
+
+std::int32_t Controller::get_battery_level() { return 100; }
+
+std::int32_t Controller::get_digital(controller_digital_e_t button) {
+    const ControllerDevice& controller = sim::controller(_id);
+    return controller.connected && (controller.buttons & buttonBit(button)) != 0;
+}
+
+std::int32_t Controller::get_digital_new_press(controller_digital_e_t button) {
+    uint16_t& seen = pressesSeen[_id == E_CONTROLLER_PARTNER];
+    if (!get_digital(button)) {
+        seen &= ~buttonBit(button);
+        return 0;
+    }
+    if (seen & buttonBit(button)) return 0;
+    seen |= buttonBit(button);
+    return 1;
+}
+
+std::int32_t Controller::get_digital_new_release(controller_digital_e_t button) {
+    uint16_t& seen = releasesSeen[_id == E_CONTROLLER_PARTNER];
+    if (get_digital(button)) {
+        seen |= buttonBit(button);
+        return 0;
+    }
+    if (!(seen & buttonBit(button))) return 0;
+    seen &= ~buttonBit(button);
+    return 1;
+}
+
+// the controller screen and rumble motor aren't simulated
+std::int32_t Controller::set_text(std::uint8_t line, std::uint8_t col, const char* str) {
+    (void)line, (void)col, (void)str;
+    return PROS_SUCCESS;
+}
+
+std::int32_t Controller::set_text(std::uint8_t line, std::uint8_t col, const std::string& str) {
+    return set_text(line, col, str.c_str());
+}
+
+std::int32_t Controller::clear_line(std::uint8_t line) {
+    (void)line;
+    return PROS_SUCCESS;
+}
+
+std::int32_t Controller::rumble(const char* rumble_pattern) {
+    (void)rumble_pattern;
+    return PROS_SUCCESS;
+}
+
+std::int32_t Controller::clear() { return PROS_SUCCESS; }
+} // namespace v5
+
+namespace c {
+std::int32_t controller_rumble(controller_id_e_t id, const char* rumble_pattern) {
+    (void)id, (void)rumble_pattern;
+    return PROS_SUCCESS;
+}
+} // namespace c
+
+namespace battery {
+double get_capacity() { return batteryDevice.capacity; }
+
+int32_t get_current() { return batteryDevice.current; }
+
+double get_temperature() { return batteryDevice.temperature; }
+
+int32_t get_voltage() { return batteryDevice.voltage; }
+} // namespace battery
+
+namespace competition {
+std::uint8_t get_status() { return competitionState; }
+
+std::uint8_t is_autonomous() { return (competitionState & COMPETITION_AUTONOMOUS) != 0; }
+
+std::uint8_t is_connected() { return (competitionState & COMPETITION_CONNECTED) != 0; }
+
+std::uint8_t is_disabled() { return (competitionState & COMPETITION_DISABLED) != 0; }
+
+std::uint8_t is_field_control() { return (competitionState & COMPETITION_SYSTEM) != 0; }
+
+std::uint8_t is_competition_switch() { return is_connected() && !is_field_control(); }
+} // namespace competition
+
+namespace adi {
+Port::Port(std::uint8_t adi_port, adi_port_config_e_t type)
+    : _smart_port(INTERNAL_ADI_PORT),
+      _adi_port(adi_port) {
+    const int index = adiIndex(adi_port);
+    if (index >= 0) _adi_port = index + 1;
+    if (type != E_ADI_TYPE_UNDEFINED) set_config(type);
+}
+
+// only the brain's own ports are simulated, not those of ADI expanders
+Port::Port(ext_adi_port_pair_t port_pair, adi_port_config_e_t type)
+    : _smart_port(port_pair.first),
+      _adi_port(port_pair.second) {
+    (void)type;
+}
+
+std::int32_t Port::get_config() const {
+    const int index = _smart_port == INTERNAL_ADI_PORT ? adiIndex(_adi_port) : -1;
+    if (index < 0) {
+        errno = ENXIO;
+        return PROS_ERR;
+    }
+    return adiConfigs[index];
+}
+
+std::int32_t Port::get_value() const {
+    const int index = _smart_port == INTERNAL_ADI_PORT ? adiIndex(_adi_port) : -1;
+    if (index < 0) {
+        errno = ENXIO;
+        return PROS_ERR;
+    }
+    return adiValues[index];
+}
+
+std::int32_t Port::set_config(adi_port_config_e_t type) const {
+    const int index = _smart_port == INTERNAL_ADI_PORT ? adiIndex(_adi_port) : -1;
+    if (index < 0) {
+        errno = ENXIO;
+        return PROS_ERR;
+    }
+    adiConfigs[index] = type;
+    return PROS_SUCCESS;
+}
+
+std::int32_t Port::set_value(std::int32_t value) const {
+    const int index = _smart_port == INTERNAL_ADI_PORT ? adiIndex(_adi_port) : -1;
+    if (index < 0) {
+        errno = ENXIO;
+        return PROS_ERR;
+    }
+    adiValues[index] = value;
+    return PROS_SUCCESS;
+}
+
+ext_adi_port_tuple_t Port::get_port() const { return {_smart_port, _adi_port, PROS_ERR_BYTE}; }
+
+DigitalOut::DigitalOut(std::uint8_t adi_port, bool init_state)
+    : Port(adi_port, E_ADI_DIGITAL_OUT) {
+    set_value(init_state);
+}
+
+DigitalOut::DigitalOut(ext_adi_port_pair_t port_pair, bool init_state)
+    : Port(port_pair, E_ADI_DIGITAL_OUT) {
+    set_value(init_state);
+}
+
+Pneumatics::Pneumatics(std::uint8_t adi_port, bool start_extended, bool extended_is_low)
+    : DigitalOut(adi_port, start_extended != extended_is_low),
+      state(start_extended != extended_is_low),
+      extended_is_low(extended_is_low) {}
+
+Pneumatics::Pneumatics(ext_adi_port_pair_t port_pair, bool start_extended, bool extended_is_low)
+    : DigitalOut(port_pair, start_extended != extended_is_low),
+      state(start_extended != extended_is_low),
+      extended_is_low(extended_is_low) {}
+
+std::int32_t Pneumatics::extend() {
+    state = !extended_is_low;
+    return set_value(state);
+}
+
+std::int32_t Pneumatics::retract() {
+    state = extended_is_low;
+    return set_value(state);
+}
+
+std::int32_t Pneumatics::toggle() {
+    state = !state;
+    return set_value(state);
+}
+
+bool Pneumatics::is_extended() const { return state != extended_is_low; }
+
+Encoder::Encoder(std::uint8_t adi_port_top, std::uint8_t adi_port_bottom, bool reversed)
+    : Port(adi_port_top, E_ADI_LEGACY_ENCODER),
+      _port_pair(adi_port_top, adi_port_bottom) {
+    const int index = adiIndex(adi_port_top);
+    if (index >= 0) encoderReversed[index] = reversed;
+    reset();
+}
+
+Encoder::Encoder(ext_adi_port_tuple_t port_tuple, bool reversed)
+    : Encoder(std::get<1>(port_tuple), std::get<2>(port_tuple), reversed) {}
+
+std::int32_t Encoder::reset() const {
+    const int index = adiIndex(_adi_port);
+    if (index < 0) {
+        errno = ENXIO;
+        return PROS_ERR;
+    }
+    encoderZero[index] = adiValues[index];
+    return PROS_SUCCESS;
+}
+
+std::int32_t Encoder::get_value() const {
+    const int index = adiIndex(_adi_port);
+    if (index < 0) {
+        errno = ENXIO;
+        return PROS_ERR;
+    }
+    const int32_t value = adiValues[index] - encoderZero[index];
+    return encoderReversed[index] ? -value : value;
+}
+
+ext_adi_port_tuple_t Encoder::get_port() const {
+    return {_smart_port, _port_pair.first, _port_pair.second};
+}
+} // namespace adi
+
+// there is no screen, so the emulated LCD only keeps track of whether it was initialized
+namespace lcd {
+static bool initialized = false;
+
+bool is_initialized() { return initialized; }
+
+bool initialize() {
+    initialized = true;
+    return true;
+}
+
+bool shutdown() {
+    initialized = false;
+    return true;
+}
+
+bool set_text(std::int16_t line, std::string text) {
+    (void)text;
+    return initialized && line >= 0 && line <= 7;
+}
+
+bool clear() { return initialized; }
+
+bool clear_line(std::int16_t line) { return initialized && line >= 0 && line <= 7; }
+
+void register_btn0_cb(lcd_btn_cb_fn_t cb) { (void)cb; }
+
+void register_btn1_cb(lcd_btn_cb_fn_t cb) { (void)cb; }
+
+void register_btn2_cb(lcd_btn_cb_fn_t cb) { (void)cb; }
+
+std::uint8_t read_buttons() { return 0; }
+} // namespace lcd
+} // namespace pros
@@ -0,0 +1,643 @@
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+
+#include "pros/error.h"
+#include "pros/motor_group.hpp"
+#include "pros/motors.h"
+#include "sim/devices.hpp"
+#include "sim/kernel.hpp"
+
+namespace {
+using sim::MotorControl;
+using sim::MotorDevice;
+
+// the motor, or nullptr with errno set if the port doesn't exist
+MotorDevice* getMotor(int8_t port) {
+    MotorDevice* motor = sim::motor(port);
+    if (motor == nullptr) errno = ENXIO;
+    return motor;
+}
+
+double sign(int8_t port) { return port < 0 ? -1 : 1; }
+
+double maxRpm(pros::MotorGears gearing) {
+    switch (gearing) {
+        case pros::MotorGears::red: return 100;
+        case pros::MotorGears::blue: return 600;
+        default: return 200;
+    }
+}
+
+double ticksPerRev(pros::MotorGears gearing) {
+    switch (gearing) {
+        case pros::MotorGears::red: return 1800;
+        case pros::MotorGears::blue: return 300;
+        default: return 900;
+    }
+}
+
+// convert degrees to the motor's encoder units
+double toUnits(const MotorDevice& motor, double degrees) {
+    switch (motor.encoderUnits) {
+        case pros::MotorUnits::rotations: return degrees / 360;
+        case pros::MotorUnits::counts: return degrees / 360 * ticksPerRev(motor.gearing);
+        default: return degrees;
+    }
+}
+
+// convert the motor's encoder units to degrees
+double fromUnits(const MotorDevice& motor, double value) { return value / toUnits(motor, 1); }
+
+// move a motor to a position of the motor itself, in degrees
+int32_t moveTo(MotorDevice* motor, double position, int32_t velocity) {
+    motor->control = MotorControl::POSITION;
+    motor->targetPosition = position;
+    motor->targetVelocity = std::abs(velocity);
+    return PROS_SUCCESS;
+}
+} // namespace
+
+namespace pros::c {
+int32_t motor_move(int8_t port, int32_t voltage) { return motor_move_voltage(port, voltage * 12000 / 127); }
+
+int32_t motor_brake(int8_t port) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR;
+    motor->control = MotorControl::BRAKE;
+    return PROS_SUCCESS;
+}
+
+int32_t motor_move_absolute(int8_t port, double position, const int32_t velocity) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR;
+    return moveTo(motor, motor->zeroPosition + sign(port) * fromUnits(*motor, position), velocity);
+}
+
+// relative to the last target, like the brain does
+int32_t motor_move_relative(int8_t port, double position, const int32_t velocity) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR;
+    return moveTo(motor, motor->targetPosition + sign(port) * fromUnits(*motor, position), velocity);
+}
+
+int32_t motor_move_velocity(int8_t port, const int32_t velocity) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR;
+    motor->control = MotorControl::VELOCITY;
+    const int32_t max = static_cast<int32_t>(maxRpm(motor->gearing));
+    motor->targetVelocity = static_cast<int32_t>(sign(port)) * std::clamp(velocity, -max, max);
+    return PROS_SUCCESS;
+}
+
+int32_t motor_move_voltage(int8_t port, const int32_t voltage) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR;
+    motor->control = MotorControl::VOLTAGE;
+    motor->targetVoltage = static_cast<int32_t>(sign(port)) * std::clamp(voltage, -12000, 12000);
+    return PROS_SUCCESS;
+}
+
+int32_t motor_modify_profiled_velocity(int8_t port, const int32_t velocity) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR;
+    motor->targetVelocity = std::abs(velocity);
+    return PROS_SUCCESS;
+}
+
+double motor_get_target_position(int8_t port) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR_F;
+    return toUnits(*motor, sign(port) * (motor->targetPosition - motor->zeroPosition));
+}
+
+int32_t motor_get_target_velocity(int8_t port) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR;
+    return static_cast<int32_t>(sign(port)) * motor->targetVelocity;
+}
+
+double motor_get_actual_velocity(int8_t port) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR_F;
+    return sign(port) * motor->velocity;
+}
+
+int32_t motor_get_current_draw(int8_t port) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR;
+    return motor->current;
+}
+
+int32_t motor_get_direction(int8_t port) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR;
+    return sign(port) * motor->velocity < 0 ? -1 : 1;
+}
+
+double motor_get_efficiency(int8_t port) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR_F;
+    const double input = std::abs(motor->voltage * motor->current / 1e6);
+    if (input == 0) return 0;
+    const double output = std::abs(motor->torque * motor->velocity * 2 * M_PI / 60);
+    return std::min(100.0, 100 * output / input);
+}
+
+int32_t motor_is_over_current(int8_t port) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR;
+    return motor->current >= motor->currentLimit;
+}
+
+// V5 motors start limiting their current at 55 degrees celsius
+int32_t motor_is_over_temp(int8_t port) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR;
+    return motor->temperature >= 55;
+}
+
+uint32_t motor_get_faults(int8_t port) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR;
+    uint32_t faults = E_MOTOR_FAULT_NO_FAULTS;
+    if (motor_is_over_temp(port)) faults |= E_MOTOR_FAULT_MOTOR_OVER_TEMP;
+    if (motor_is_over_current(port)) faults |= E_MOTOR_FAULT_OVER_CURRENT;
+    return faults;
+}
+
+uint32_t motor_get_flags(int8_t port) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR;
+    return motor->velocity == 0 ? E_MOTOR_FLAGS_ZERO_VELOCITY : E_MOTOR_FLAGS_NONE;
+}
+
+int32_t motor_get_raw_position(int8_t port, uint32_t* const timestamp) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR;
+    if (timestamp != nullptr) *timestamp = static_cast<uint32_t>(sim::time() / 1000);
+    return static_cast<int32_t>(std::lround(sign(port) * motor->position / 360 * ticksPerRev(motor->gearing)));
+}
+
+double motor_get_position(int8_t port) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR_F;
+    return toUnits(*motor, sign(port) * (motor->position - motor->zeroPosition));
+}
+
+double motor_get_power(int8_t port) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR_F;
+    return std::abs(motor->voltage * motor->current / 1e6);
+}
+
+double motor_get_temperature(int8_t port) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR_F;
+    return motor->temperature;
+}
+
+double motor_get_torque(int8_t port) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR_F;
+    return sign(port) * motor->torque;
+}
+
+int32_t motor_get_voltage(int8_t port) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR;
+    return static_cast<int32_t>(sign(port)) * motor->voltage;
+}
+
+int32_t motor_set_zero_position(int8_t port, const double position) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR;
+    motor->zeroPosition = motor->position - sign(port) * fromUnits(*motor, position);
+    return PROS_SUCCESS;
+}
+
+int32_t motor_tare_position(int8_t port) { return motor_set_zero_position(port, 0); }
+
+int32_t motor_set_brake_mode(int8_t port, const motor_brake_mode_e_t mode) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR;
+    motor->brakeMode = static_cast<MotorBrake>(mode);
+    return PROS_SUCCESS;
+}
+
+int32_t motor_set_current_limit(int8_t port, const int32_t limit) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR;
+    motor->currentLimit = std::clamp(limit, 0, 2500);
+    return PROS_SUCCESS;
+}
+
+int32_t motor_set_encoder_units(int8_t port, const motor_encoder_units_e_t units) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR;
+    motor->encoderUnits = static_cast<MotorUnits>(units);
+    return PROS_SUCCESS;
+}
+
+int32_t motor_set_gearing(int8_t port, const motor_gearset_e_t gearset) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR;
+    motor->gearing = static_cast<MotorGears>(gearset);
+    return PROS_SUCCESS;
+}
+
+int32_t motor_set_voltage_limit(int8_t port, const int32_t limit) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR;
+    motor->voltageLimit = std::clamp(limit, 0, 12000);
+    return PROS_SUCCESS;
+}
+
+motor_brake_mode_e_t motor_get_brake_mode(int8_t port) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return E_MOTOR_BRAKE_INVALID;
+    return static_cast<motor_brake_mode_e_t>(motor->brakeMode);
+}
+
+int32_t motor_get_current_limit(int8_t port) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR;
+    return motor->currentLimit;
+}
+
+motor_encoder_units_e_t motor_get_encoder_units(int8_t port) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return E_MOTOR_ENCODER_INVALID;
+    return static_cast<motor_encoder_units_e_t>(motor->encoderUnits);
+}
+
+motor_gearset_e_t motor_get_gearing(int8_t port) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return E_MOTOR_GEARSET_INVALID;
+    return static_cast<motor_gearset_e_t>(motor->gearing);
+}
+
+int32_t motor_get_voltage_limit(int8_t port) {
+    MotorDevice* motor = getMotor(port);
+    if (motor == nullptr) return PROS_ERR;
+    return motor->voltageLimit;
+}
+
+motor_type_e_t motor_get_type(int8_t port) {
+    if (getMotor(port) == nullptr) return E_MOTOR_TYPE_INVALID;
+    return E_MOTOR_TYPE_V5;
+}
+} // namespace pros::c
+
+namespace {
+// get a value of the motor at an index of a group, or the error value with errno set if there isn't one
+template <typename T, typename F> T atIndex(const std::vector<int8_t>& ports, uint8_t index, T error, F get) {
+    if (index >= ports.size()) {
+        errno = ENXIO;
+        return error;
+    }
+    return get(ports[index]);
+}
+
+// get a value of every motor of a group
+template <typename F> auto forAll(const std::vector<int8_t>& ports, F get) {
+    std::vector<decltype(get(int8_t()))> values;
+    values.reserve(ports.size());
+    for (int8_t port : ports) values.push_back(get(port));
+    return values;
+}
+
+// apply a command to every motor of a group. Fails if it fails for any of them
+template <typename F> int32_t applyAll(const std::vector<int8_t>& ports, F apply) {
+    int32_t result = PROS_SUCCESS;
+    for (int8_t port : ports) {
+        if (apply(port) == PROS_ERR) result = PROS_ERR;
+    }
+    return result;
+}
+} // namespace
+
+namespace pros {
+inline namespace v5 {
+using namespace pros::c;
+
+MotorGroup::MotorGroup(const std::initializer_list<std::int8_t> ports, const MotorGears gearset,
+                       const MotorUnits encoder_units)
+    : MotorGroup(std::vector<std::int8_t>(ports), gearset, encoder_units) {}
+
+MotorGroup::MotorGroup(const std::vector<std::int8_t>& ports, const MotorGears gearset, const MotorUnits encoder_units)
+    : _ports(ports) {
+    if (gearset != MotorGears::invalid) set_gearing_all(gearset);
+    if (encoder_units != MotorUnits::invalid) set_encoder_units_all(encoder_units);
+}
+
+MotorGroup::MotorGroup(AbstractMotor& motor_group)
+    : _ports(motor_group.get_port_all()) {}
+
+std::int32_t MotorGroup::move(std::int32_t voltage) const {
+    return applyAll(_ports, [&](int8_t port) { return motor_move(port, voltage); });
+}
+
+std::int32_t MotorGroup::move_absolute(const double position, const std::int32_t velocity) const {
+    return applyAll(_ports, [&](int8_t port) { return motor_move_absolute(port, position, velocity); });
+}
+
+std::int32_t MotorGroup::move_relative(const double position, const std::int32_t velocity) const {
+    return applyAll(_ports, [&](int8_t port) { return motor_move_relative(port, position, velocity); });
+}
+
+std::int32_t MotorGroup::move_velocity(const std::int32_t velocity) const {
+    return applyAll(_ports, [&](int8_t port) { return motor_move_velocity(port, velocity); });
+}
+
+std::int32_t MotorGroup::move_voltage(const std::int32_t voltage) const {
+    return applyAll(_ports, [&](int8_t port) { return motor_move_voltage(port, voltage); });
+}
+
+std::int32_t MotorGroup::brake() const { return applyAll(_ports, motor_brake); }
+
+std::int32_t MotorGroup::modify_profiled_velocity(const std::int32_t velocity) const {
+    return applyAll(_ports, [&](int8_t port) { return motor_modify_profiled_velocity(port, velocity); });
+}
+
+double MotorGroup::get_target_position(const std::uint8_t index) const {
+    return atIndex(_ports, index, PROS_ERR_F, motor_get_target_position);
+}
+
+std::vector<double> MotorGroup::get_target_position_all() const { return forAll(_ports, motor_get_target_position); }
+
+std::int32_t MotorGroup::get_target_velocity(const std::uint8_t index) const {
+    return atIndex(_ports, index, PROS_ERR, motor_get_target_velocity);
+}
+
+std::vector<std::int32_t> MotorGroup::get_target_velocity_all() const {
+    return forAll(_ports, motor_get_target_velocity);
+}
+
+double MotorGroup::get_actual_velocity(const std::uint8_t index) const {
+    return atIndex(_ports, index, PROS_ERR_F, motor_get_actual_velocity);
+}
+
+std::vector<double> MotorGroup::get_actual_velocity_all() const { return forAll(_ports, motor_get_actual_velocity); }
+
+std::int32_t MotorGroup::get_current_draw(const std::uint8_t index) const {
+    return atIndex(_ports, index, PROS_ERR, motor_get_current_draw);
+}
+
+std::vector<std::int32_t> MotorGroup::get_current_draw_all() const { return forAll(_ports, motor_get_current_draw); }
+
+std::int32_t MotorGroup::get_direction(const std::uint8_t index) const {
+    return atIndex(_ports, index, PROS_ERR, motor_get_direction);
+}
+
+std::vector<std::int32_t> MotorGroup::get_direction_all() const { return forAll(_ports, motor_get_direction); }
+
+double MotorGroup::get_efficiency(const std::uint8_t index) const {
+    return atIndex(_ports, index, PROS_ERR_F, motor_get_efficiency);
+}
+
+std::vector<double> MotorGroup::get_efficiency_all() const { return forAll(_ports, motor_get_efficiency); }
+
+std::uint32_t MotorGroup::get_faults(const std::uint8_t index) const {
+    return atIndex(_ports, index, static_cast<uint32_t>(PROS_ERR), motor_get_faults);
+}
+
+std::vector<std::uint32_t> MotorGroup::get_faults_all() const { return forAll(_ports, motor_get_faults); }
+
+std::uint32_t MotorGroup::get_flags(const std::uint8_t index) const {
+    return atIndex(_ports, index, static_cast<uint32_t>(PROS_ERR), motor_get_flags);
+}
+
+std::vector<std::uint32_t> MotorGroup::get_flags_all() const { return forAll(_ports, motor_get_flags); }
+
+double MotorGroup::get_position(const std::uint8_t index) const {
+    return atIndex(_ports, index, PROS_ERR_F, motor_get_position);
+}
+
+std::vector<double> MotorGroup::get_position_all() const { return forAll(_ports, motor_get_position); }
+
+double MotorGroup::get_power(const std::uint8_t index) const {
+    return atIndex(_ports, index, PROS_ERR_F, motor_get_power);
+}
+
+std::vector<double> MotorGroup::get_power_all() const { return forAll(_ports, motor_get_power); }
+
+std::int32_t MotorGroup::get_raw_position(std::uint32_t* const timestamp, const std::uint8_t index) const {
+    return atIndex(_ports, index, PROS_ERR, [&](int8_t port) { return motor_get_raw_position(port, timestamp); });
+}
+
+std::vector<std::int32_t> MotorGroup::get_raw_position_all(std::uint32_t* const timestamp) const {
+    return forAll(_ports, [&](int8_t port) { return motor_get_raw_position(port, timestamp); });
+}
+
+double MotorGroup::get_temperature(const std::uint8_t index) const {
+    return atIndex(_ports, index, PROS_ERR_F, motor_get_temperature);
+}
+
+std::vector<double> MotorGroup::get_temperature_all() const { return forAll(_ports, motor_get_temperature); }
+
+double MotorGroup::get_torque(const std::uint8_t index) const {
+    return atIndex(_ports, index, PROS_ERR_F, motor_get_torque);
+}
+
+std::vector<double> MotorGroup::get_torque_all() const { return forAll(_ports, motor_get_torque); }
+
+std::int32_t MotorGroup::get_voltage(const std::uint8_t index) const {
+    return atIndex(_ports, index, PROS_ERR, motor_get_voltage);
+}
+
+std::vector<std::int32_t> MotorGroup::get_voltage_all() const { return forAll(_ports, motor_get_voltage); }
+
+std::int32_t MotorGroup::is_over_current(const std::uint8_t index) const {
+    return atIndex(_ports, index, PROS_ERR, motor_is_over_current);
+}
+
+std::vector<std::int32_t> MotorGroup::is_over_current_all() const { return forAll(_ports, motor_is_over_current); }
+
+std::int32_t MotorGroup::is_over_temp(const std::uint8_t index) const {
+    return atIndex(_ports, index, PROS_ERR, motor_is_over_temp);
+}
+
+std::vector<std::int32_t> MotorGroup::is_over_temp_all() const { return forAll(_ports, motor_is_over_temp); }
+
+MotorBrake MotorGroup::get_brake_mode(const std::uint8_t index) const {
+    return atIndex(_ports, index, MotorBrake::invalid,
+                   [](int8_t port) { return static_cast<MotorBrake>(motor_get_brake_mode(port)); });
+}
+
+std::vector<MotorBrake> MotorGroup::get_brake_mode_all() const {
+    return forAll(_ports, [](int8_t port) { return static_cast<MotorBrake>(motor_get_brake_mode(port)); });
+}
+
+std::int32_t MotorGroup::get_current_limit(const std::uint8_t index) const {
+    return atIndex(_ports, index, PROS_ERR, motor_get_current_limit);
+}
+
+std::vector<std::int32_t> MotorGroup::get_current_limit_all() const { return forAll(_ports, motor_get_current_limit); }
+
+MotorUnits MotorGroup::get_encoder_units(const std::uint8_t index) const {
+    return atIndex(_ports, index, MotorUnits::invalid,
+                   [](int8_t port) { return static_cast<MotorUnits>(motor_get_encoder_units(port)); });
+}
+
+std::vector<MotorUnits> MotorGroup::get_encoder_units_all() const {
+    return forAll(_ports, [](int8_t port) { return static_cast<MotorUnits>(motor_get_encoder_units(port)); });
+}
+
+MotorGears MotorGroup::get_gearing(const std::uint8_t index) const {
+    return atIndex(_ports, index, MotorGears::invalid,
+                   [](int8_t port) { return static_cast<MotorGears>(motor_get_gearing(port)); });
+}
+
+std::vector<MotorGears> MotorGroup::get_gearing_all() const {
+    return forAll(_ports, [](int8_t port) { return static_cast<MotorGears>(motor_get_gearing(port)); });
+}
+
+std::vector<std::int8_t> MotorGroup::get_port_all() const { return _ports; }
+
+std::int32_t MotorGroup::get_voltage_limit(const std::uint8_t index) const {
+    return atIndex(_ports, index, PROS_ERR, motor_get_voltage_limit);
+}
+
+std::vector<std::int32_t> MotorGroup::get_voltage_limit_all() const { return forAll(_ports, motor_get_voltage_limit); }
+
+std::int32_t MotorGroup::is_reversed(const std::uint8_t index) const {
+    return atIndex(_ports, index, PROS_ERR, [](int8_t port) -> int32_t { return port < 0; });
+}
+
+std::vector<std::int32_t> MotorGroup::is_reversed_all() const {
+    return forAll(_ports, [](int8_t port) -> int32_t { return port < 0; });
+}
+
+MotorType MotorGroup::get_type(const std::uint8_t index) const {
+    return atIndex(_ports, index, MotorType::invalid,
+                   [](int8_t port) { return static_cast<MotorType>(motor_get_type(port)); });
+}
+
+std::vector<MotorType> MotorGroup::get_type_all() const {
+    return forAll(_ports, [](int8_t port) { return static_cast<MotorType>(motor_get_type(port)); });
+}
+
+std::int32_t MotorGroup::set_brake_mode(const MotorBrake mode, const std::uint8_t index) const {
+    return set_brake_mode(static_cast<motor_brake_mode_e_t>(mode), index);
+}
+
+std::int32_t MotorGroup::set_brake_mode(const pros::motor_brake_mode_e_t mode, const std::uint8_t index) const {
+    return atIndex(_ports, index, PROS_ERR, [&](int8_t port) { return motor_set_brake_mode(port, mode); });
+}
+
+std::int32_t MotorGroup::set_brake_mode_all(const MotorBrake mode) const {
+    return set_brake_mode_all(static_cast<motor_brake_mode_e_t>(mode));
+}
+
+std::int32_t MotorGroup::set_brake_mode_all(const pros::motor_brake_mode_e_t mode) const {
+    return applyAll(_ports, [&](int8_t port) { return motor_set_brake_mode(port, mode); });
+}
+
+std::int32_t MotorGroup::set_current_limit(const std::int32_t limit, const std::uint8_t index) const {
+    return atIndex(_ports, index, PROS_ERR, [&](int8_t port) { return motor_set_current_limit(port, limit); });
+}
+
+std::int32_t MotorGroup::set_current_limit_all(const std::int32_t limit) const {
+    return applyAll(_ports, [&](int8_t port) { return motor_set_current_limit(port, limit); });
+}
+
+std::int32_t MotorGroup::set_encoder_units(const MotorUnits units, const std::uint8_t index) const {
+    return set_encoder_units(static_cast<motor_encoder_units_e_t>(units), index);
+}
+
+std::int32_t MotorGroup::set_encoder_units(const pros::motor_encoder_units_e_t units, const std::uint8_t index) const {
+    return atIndex(_ports, index, PROS_ERR, [&](int8_t port) { return motor_set_encoder_units(port, units); });
+}
+
+std::int32_t MotorGroup::set_encoder_units_all(const MotorUnits units) const {
+    return set_encoder_units_all(static_cast<motor_encoder_units_e_t>(units));
+}
+
+std::int32_t MotorGroup::set_encoder_units_all(const pros::motor_encoder_units_e_t units) const {
+    return applyAll(_ports, [&](int8_t port) { return motor_set_encoder_units(port, units); });
+}
+
+std::int32_t MotorGroup::set_gearing(std::vector<pros::motor_gearset_e_t> gearsets) const {
+    int32_t result = PROS_SUCCESS;
+    for (size_t i = 0; i < std::min(gearsets.size(), _ports.size()); i++) {
+        if (motor_set_gearing(_ports[i], gearsets[i]) == PROS_ERR) result = PROS_ERR;
+    }
+    return result;
+}
+
+std::int32_t MotorGroup::set_gearing(const pros::motor_gearset_e_t gearset, const std::uint8_t index) const {
+    return atIndex(_ports, index, PROS_ERR, [&](int8_t port) { return motor_set_gearing(port, gearset); });
+}
+
+std::int32_t MotorGroup::set_gearing(std::vector<MotorGears> gearsets) const {
+    std::vector<motor_gearset_e_t> converted;
+    for (MotorGears gearset : gearsets) converted.push_back(static_cast<motor_gearset_e_t>(gearset));
+    return set_gearing(converted);
+}
+
+std::int32_t MotorGroup::set_gearing(const MotorGears gearset, const std::uint8_t index) const {
+    return set_gearing(static_cast<motor_gearset_e_t>(gearset), index);
+}
+
+std::int32_t MotorGroup::set_gearing_all(const MotorGears gearset) const {
+    return set_gearing_all(static_cast<motor_gearset_e_t>(gearset));
+}
+
+std::int32_t MotorGroup::set_gearing_all(const pros::motor_gearset_e_t gearset) const {
+    return applyAll(_ports, [&](int8_t port) { return motor_set_gearing(port, gearset); });
+}
+
+std::int32_t MotorGroup::set_reversed(const bool reverse, const std::uint8_t index) {
+    if (index >= _ports.size()) {
+        errno = ENXIO;
+        return PROS_ERR;
+    }
+    _ports[index] = static_cast<int8_t>(reverse ? -std::abs(_ports[index]) : std::abs(_ports[index]));
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::set_reversed_all(const bool reverse) {
+    for (uint8_t i = 0; i < _ports.size(); i++) set_reversed(reverse, i);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::set_voltage_limit(const std::int32_t limit, const std::uint8_t index) const {
+    return atIndex(_ports, index, PROS_ERR, [&](int8_t port) { return motor_set_voltage_limit(port, limit); });
+}
+
+std::int32_t MotorGroup::set_voltage_limit_all(const std::int32_t limit) const {
+    return applyAll(_ports, [&](int8_t port) { return motor_set_voltage_limit(port, limit); });
+}
+
+std::int32_t MotorGroup::set_zero_position(const double position, const std::uint8_t index) const {
+    return atIndex(_ports, index, PROS_ERR, [&](int8_t port) { return motor_set_zero_position(port, position); });
+}
+
+std::int32_t MotorGroup::set_zero_position_all(const double position) const {
+    return applyAll(_ports, [&](int8_t port) { return motor_set_zero_position(port, position); });
+}
+
+std::int32_t MotorGroup::tare_position(const std::uint8_t index) const {
+    return atIndex(_ports, index, PROS_ERR, motor_tare_position);
+}
+
+std::int32_t MotorGroup::tare_position_all() const { return applyAll(_ports, motor_tare_position); }
+
+std::int8_t MotorGroup::size() const { return static_cast<int8_t>(_ports.size()); }
+
+std::int8_t MotorGroup::get_port(const std::uint8_t index) const {
+    return atIndex(_ports, index, static_cast<int8_t>(PROS_ERR_BYTE), [](int8_t port) { return port; });
+}
+
+void MotorGroup::operator+=(AbstractMotor& other) {
+    for (int8_t port : other.get_port_all()) _ports.push_back(port);
+}
+
+void MotorGroup::append(AbstractMotor& other) { *this += other; }
+
+void MotorGroup::erase_port(std::int8_t port) {
+    std::erase_if(_ports, [&](int8_t p) { return std::abs(p) == std::abs(port); });
+}
+} // namespace v5
+} // namespace pros
@@ -0,0 +1,660 @@
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+#include <time.h>
+
+#include "pros/rtos.hpp"
+#include "lemlib/rtos/staticTask.hpp"
+#include "lemlib/rtos/taskStatus.hpp"
+#include "sim/kernel.hpp"
+
+namespace {
+constexpr uint64_t NEVER = UINT64_MAX;
+
+enum class State { READY, BLOCKED, SUSPENDED, DELETED };
+
+struct KernelMutex;
+
+/**
+ * @brief Task control block
+ */
+struct Tcb {
+        char name[TASK_NAME_MAX_LEN] = {};
+        uint32_t priority = TASK_PRIORITY_DEFAULT;
+        State state = State::READY;
+        // tasks of the same priority run in the order they became ready
+        uint64_t order = 0;
+        // when a blocked task times out
+        uint64_t wakeTime = NEVER;
+        // what a blocked task is waiting for. A task blocked by a delay waits for nothing
+        KernelMutex* waitingForMutex = nullptr;
+        Tcb* waitingForTask = nullptr;
+        bool waitingForNotify = false;
+        uint32_t notifyValue = 0;
+        // the CPU time clock of the task's thread, once it has started
+        clockid_t cpuClock = 0;
+        bool started = false;
+        // the task's thread waits on this until the scheduler picks it
+        std::condition_variable resume;
+};
+
+struct KernelMutex {
+        // the owner when the mutex is taken by a thread that isn't a task
+        static Tcb outside;
+
+        Tcb* owner = nullptr;
+        uint32_t count = 0;
+        bool recursive = false;
+};
+
+Tcb KernelMutex::outside;
+
+struct Kernel {
+        std::mutex lock;
+        // never freed, so the handle of a deleted task stays valid
+        std::vector<Tcb*> tasks;
+        Tcb* running = nullptr;
+        // only written with the lock held, but read without it by millis() and micros()
+        std::atomic<uint64_t> time = 0;
+        uint64_t nextOrder = 0;
+
+        bool paused = true;
+        Tcb* awaited = nullptr;
+        uint64_t stopTime = 0;
+        sim::RunResult result = sim::RunResult::FINISHED;
+        std::condition_variable pausedChanged;
+
+        std::vector<std::function<void(uint64_t)>> tickHooks;
+        // run times are measured on the host's clock, since tasks take no virtual time
+        std::chrono::steady_clock::time_point created = std::chrono::steady_clock::now();
+};
+
+Kernel& getKernel() {
+    // never destroyed, since the threads of paused tasks still use it when the program exits
+    static Kernel* kernel = new Kernel;
+    return *kernel;
+}
+
+// the task the calling thread runs, or nullptr if it isn't a task
+thread_local Tcb* self = nullptr;
+
+uint64_t wakeAfter(const Kernel& kernel, uint32_t timeout) {
+    return timeout == TIMEOUT_MAX ? NEVER : kernel.time + uint64_t(timeout) * 1000;
+}
+
+void makeReady(Kernel& kernel, Tcb* tcb) {
+    tcb->state = State::READY;
+    tcb->wakeTime = NEVER;
+    tcb->waitingForMutex = nullptr;
+    tcb->waitingForTask = nullptr;
+    tcb->waitingForNotify = false;
+    tcb->order = kernel.nextOrder++;
+}
+
+void block(const Kernel& kernel, Tcb* tcb, uint32_t timeout) {
+    tcb->state = State::BLOCKED;
+    tcb->wakeTime = wakeAfter(kernel, timeout);
+}
+
+uint32_t effectivePriority(const Kernel& kernel, const Tcb* tcb) {
+    uint32_t priority = tcb->priority;
+    // priority inheritance: a task that holds a mutex runs at the priority of the tasks waiting for it
+    for (const Tcb* waiting : kernel.tasks) {
+        if (waiting->state == State::BLOCKED && waiting->waitingForMutex != nullptr &&
+            waiting->waitingForMutex->owner == tcb) {
+            priority = std::max(priority, waiting->priority);
+        }
+    }
+    return priority;
+}
+
+Tcb* highestReady(const Kernel& kernel) {
+    Tcb* best = nullptr;
+    uint32_t bestPriority = 0;
+    for (Tcb* tcb : kernel.tasks) {
+        if (tcb->state != State::READY) continue;
+        const uint32_t priority = effectivePriority(kernel, tcb);
+        if (best == nullptr || priority > bestPriority || (priority == bestPriority && tcb->order < best->order)) {
+            best = tcb;
+            bestPriority = priority;
+        }
+    }
+    return best;
+}
+
+void pause(Kernel& kernel, sim::RunResult result) {
+    kernel.paused = true;
+    kernel.result = result;
+    kernel.running = nullptr;
+    kernel.pausedChanged.notify_all();
+}
+
+void advanceTo(Kernel& kernel, uint64_t time) {
+    while (kernel.time < time) {
+        kernel.time += 1000;
+        for (const auto& hook : kernel.tickHooks) hook(kernel.time);
+    }
+}
+
+/**
+ * @brief Pick the task that runs next, moving the clock forward while no task is ready, or pause the kernel
+ *
+ * @param yield whether the running task lets other ready tasks of the same priority run first
+ */
+void dispatch(Kernel& kernel, bool yield) {
+    Tcb* const current = kernel.running;
+    while (true) {
+        if (kernel.awaited != nullptr && kernel.awaited->state == State::DELETED) {
+            return pause(kernel, sim::RunResult::FINISHED);
+        }
+        Tcb* next = highestReady(kernel);
+        if (next != nullptr) {
+            // there is no time slicing, so the running task keeps running unless a higher priority task is ready
+            if (!yield && current != nullptr && current->state == State::READY &&
+                effectivePriority(kernel, current) >= effectivePriority(kernel, next)) {
+                next = current;
+            }
+            kernel.running = next;
+            return;
+        }
+        // nothing can run, so skip to the next time a task wakes up
+        uint64_t wakeTime = NEVER;
+        for (const Tcb* tcb : kernel.tasks) {
+            if (tcb->state == State::BLOCKED) wakeTime = std::min(wakeTime, tcb->wakeTime);
+        }
+        if (wakeTime == NEVER) return pause(kernel, sim::RunResult::DEADLOCK);
+        if (wakeTime > kernel.stopTime) {
+            advanceTo(kernel, kernel.stopTime);
+            return pause(kernel, sim::RunResult::TIMEOUT);
+        }
+        advanceTo(kernel, wakeTime);
+        for (Tcb* tcb : kernel.tasks) {
+            if (tcb->state == State::BLOCKED && tcb->wakeTime <= kernel.time) makeReady(kernel, tcb);
+        }
+    }
+}
+
+/**
+ * @brief Let the scheduler pick the task that runs next, after the calling task changed the state of a task
+ *
+ * Returns once the calling task is picked again, which is never for a deleted task. Does nothing when called from a
+ * thread that isn't a task, since those only run while the kernel is paused.
+ */
+void reschedule(std::unique_lock<std::mutex>& lock, bool yield = false) {
+    Kernel& kernel = getKernel();
+    Tcb* const tcb = self;
+    if (tcb == nullptr) return;
+    dispatch(kernel, yield);
+    if (kernel.running == tcb) return;
+    if (kernel.running != nullptr) kernel.running->resume.notify_one();
+    tcb->resume.wait(lock, [&] { return kernel.running == tcb; });
+}
+
+void deleteTask(Kernel& kernel, Tcb* tcb) {
+    tcb->state = State::DELETED;
+    tcb->wakeTime = NEVER;
+    tcb->waitingForMutex = nullptr;
+    tcb->waitingForTask = nullptr;
+    tcb->waitingForNotify = false;
+    for (Tcb* joining : kernel.tasks) {
+        if (joining->state == State::BLOCKED && joining->waitingForTask == tcb) makeReady(kernel, joining);
+    }
+}
+
+Tcb* toTcb(pros::task_t task) { return task == nullptr ? self : static_cast<Tcb*>(task); }
+
+pros::task_state_e_t stateOf(const Kernel& kernel, const Tcb* tcb) {
+    if (tcb == kernel.running) return pros::E_TASK_STATE_RUNNING;
+    switch (tcb->state) {
+        case State::READY: return pros::E_TASK_STATE_READY;
+        case State::BLOCKED: return pros::E_TASK_STATE_BLOCKED;
+        case State::SUSPENDED: return pros::E_TASK_STATE_SUSPENDED;
+        default: return pros::E_TASK_STATE_DELETED;
+    }
+}
+} // namespace
+
+namespace sim {
+RunResult run(pros::task_t task, uint32_t timeout) {
+    Kernel& kernel = getKernel();
+    std::unique_lock lock(kernel.lock);
+    kernel.awaited = static_cast<Tcb*>(task);
+    kernel.stopTime = kernel.time + uint64_t(timeout) * 1000;
+    kernel.paused = false;
+    dispatch(kernel, false);
+    if (kernel.running != nullptr) kernel.running->resume.notify_one();
+    kernel.pausedChanged.wait(lock, [&] { return kernel.paused; });
+    kernel.awaited = nullptr;
+    return kernel.result;
+}
+
+uint64_t time() { return getKernel().time; }
+
+void addTickHook(std::function<void(uint64_t)> hook) {
+    Kernel& kernel = getKernel();
+    std::lock_guard lock(kernel.lock);
+    kernel.tickHooks.push_back(std::move(hook));
+}
+} // namespace sim
+
+namespace pros::c {
+uint32_t millis() { return getKernel().time / 1000; }
+
+uint64_t micros() { return getKernel().time; }
+
+task_t task_create(task_fn_t function, void* const parameters, uint32_t prio, const uint16_t stack_depth,
+                   const char* const name) {
+    (void)stack_depth;
+    Kernel& kernel = getKernel();
+    std::unique_lock lock(kernel.lock);
+    Tcb* tcb = new Tcb;
+    std::strncpy(tcb->name, name == nullptr ? "" : name, sizeof(tcb->name) - 1);
+    tcb->priority = std::clamp<uint32_t>(prio, TASK_PRIORITY_MIN, TASK_PRIORITY_MAX);
+    tcb->order = kernel.nextOrder++;
+    kernel.tasks.push_back(tcb);
+    std::thread([tcb, function, parameters] {
+        Kernel& kernel = getKernel();
+        {
+            std::unique_lock lock(kernel.lock);
+            tcb->started = pthread_getcpuclockid(pthread_self(), &tcb->cpuClock) == 0;
+            tcb->resume.wait(lock, [&] { return kernel.running == tcb; });
+        }
+        self = tcb;
+        function(parameters);
+        // the task returned, so its thread can end once another task is picked
+        std::unique_lock lock(kernel.lock);
+        deleteTask(kernel, tcb);
+        dispatch(kernel, false);
+        if (kernel.running != nullptr) kernel.running->resume.notify_one();
+    }).detach();
+    // a task with a higher priority than the running task starts right away
+    reschedule(lock);
+    return tcb;
+}
+
+void task_delete(task_t task) {
+    Kernel& kernel = getKernel();
+    std::unique_lock lock(kernel.lock);
+    Tcb* tcb = toTcb(task);
+    if (tcb == nullptr || tcb->state == State::DELETED) return;
+    // the thread of a deleted task is left blocked, since it can't be stopped from outside
+    deleteTask(kernel, tcb);
+    reschedule(lock);
+}
+
+void task_delay(const uint32_t milliseconds) {
+    Kernel& kernel = getKernel();
+    std::unique_lock lock(kernel.lock);
+    if (self == nullptr) return;
+    if (milliseconds == 0) {
+        self->order = kernel.nextOrder++;
+        return reschedule(lock, true);
+    }
+    block(kernel, self, milliseconds);
+    reschedule(lock);
+}
+
+void delay(const uint32_t milliseconds) { task_delay(milliseconds); }
+
+void task_delay_until(uint32_t* const prev_time, const uint32_t delta) {
+    Kernel& kernel = getKernel();
+    std::unique_lock lock(kernel.lock);
+    const uint32_t target = *prev_time + delta;
+    const uint32_t now = kernel.time / 1000;
+    *prev_time = target;
+    if (self == nullptr) return;
+    if (static_cast<int32_t>(target - now) > 0) {
+        block(kernel, self, target - now);
+        return reschedule(lock);
+    }
+    self->order = kernel.nextOrder++;
+    reschedule(lock, true);
+}
+
+uint32_t task_get_priority(task_t task) {
+    std::lock_guard lock(getKernel().lock);
+    const Tcb* tcb = toTcb(task);
+    return tcb == nullptr ? 0 : tcb->priority;
+}
+
+void task_set_priority(task_t task, uint32_t prio) {
+    Kernel& kernel = getKernel();
+    std::unique_lock lock(kernel.lock);
+    Tcb* tcb = toTcb(task);
+    if (tcb == nullptr) return;
+    tcb->priority = std::clamp<uint32_t>(prio, TASK_PRIORITY_MIN, TASK_PRIORITY_MAX);
+    reschedule(lock);
+}
+
+task_state_e_t task_get_state(task_t task) {
+    Kernel& kernel = getKernel();
+    std::lock_guard lock(kernel.lock);
+    const Tcb* tcb = toTcb(task);
+    if (tcb == nullptr) return E_TASK_STATE_INVALID;
+    return stateOf(kernel, tcb);
+}
+
+void task_suspend(task_t task) {
+    Kernel& kernel = getKernel();
+    std::unique_lock lock(kernel.lock);
+    Tcb* tcb = toTcb(task);
+    if (tcb == nullptr || tcb->state == State::DELETED) return;
+    tcb->state = State::SUSPENDED;
+    tcb->wakeTime = NEVER;
+    tcb->waitingForMutex = nullptr;
+    tcb->waitingForTask = nullptr;
+    tcb->waitingForNotify = false;
+    reschedule(lock);
+}
+
+void task_resume(task_t task) {
+    Kernel& kernel = getKernel();
+    std::unique_lock lock(kernel.lock);
+    Tcb* tcb = toTcb(task);
+    if (tcb == nullptr || tcb->state != State::SUSPENDED) return;
+    makeReady(kernel, tcb);
+    reschedule(lock);
+}
+
+uint32_t task_get_count() {
+    Kernel& kernel = getKernel();
+    std::lock_guard lock(kernel.lock);
+    return std::count_if(kernel.tasks.begin(), kernel.tasks.end(),
+                         [](const Tcb* tcb) { return tcb->state != State::DELETED; });
+}
+
+char* task_get_name(task_t task) {
+    Tcb* tcb = toTcb(task);
+    return tcb == nullptr ? nullptr : tcb->name;
+}
+
+task_t task_get_by_name(const char* name) {
+    Kernel& kernel = getKernel();
+    std::lock_guard lock(kernel.lock);
+    for (Tcb* tcb : kernel.tasks) {
+        if (tcb->state != State::DELETED && std::strcmp(tcb->name, name) == 0) return tcb;
+    }
+    return nullptr;
+}
+
+task_t task_get_current() { return self; }
+
+uint32_t task_notify_ext(task_t task, uint32_t value, notify_action_e_t action, uint32_t* prev_value) {
+    Kernel& kernel = getKernel();
+    std::unique_lock lock(kernel.lock);
+    Tcb* tcb = toTcb(task);
+    if (tcb == nullptr) return 0;
+    if (prev_value != nullptr) *prev_value = tcb->notifyValue;
+    switch (action) {
+        case E_NOTIFY_ACTION_BITS: tcb->notifyValue |= value; break;
+        case E_NOTIFY_ACTION_INCR: tcb->notifyValue++; break;
+        case E_NOTIFY_ACTION_OWRITE: tcb->notifyValue = value; break;
+        case E_NOTIFY_ACTION_NO_OWRITE:
+            if (tcb->notifyValue != 0) return 0;
+            tcb->notifyValue = value;
+            break;
+        default: break;
+    }
+    if (tcb->state == State::BLOCKED && tcb->waitingForNotify) makeReady(kernel, tcb);
+    reschedule(lock);
+    return 1;
+}
+
+uint32_t task_notify(task_t task) { return task_notify_ext(task, 0, E_NOTIFY_ACTION_INCR, nullptr); }
+
+uint32_t task_notify_take(bool clear_on_exit, uint32_t timeout) {
+    Kernel& kernel = getKernel();
+    std::unique_lock lock(kernel.lock);
+    Tcb* tcb = self;
+    if (tcb == nullptr) return 0;
+    if (tcb->notifyValue == 0 && timeout != 0) {
+        block(kernel, tcb, timeout);
+        tcb->waitingForNotify = true;
+        reschedule(lock);
+    }
+    const uint32_t value = tcb->notifyValue;
+    if (value != 0) tcb->notifyValue = clear_on_exit ? 0 : value - 1;
+    return value;
+}
+
+bool task_notify_clear(task_t task) {
+    std::lock_guard lock(getKernel().lock);
+    Tcb* tcb = toTcb(task);
+    if (tcb == nullptr) return false;
+    const bool pending = tcb->notifyValue != 0;
+    tcb->notifyValue = 0;
+    return pending;
+}
+
+void task_join(task_t task) {
+    Kernel& kernel = getKernel();
+    std::unique_lock lock(kernel.lock);
+    Tcb* tcb = static_cast<Tcb*>(task);
+    if (self == nullptr || tcb == nullptr || tcb == self || tcb->state == State::DELETED) return;
+    block(kernel, self, TIMEOUT_MAX);
+    self->waitingForTask = tcb;
+    reschedule(lock);
+}
+
+mutex_t mutex_create() { return new KernelMutex; }
+
+mutex_t mutex_recursive_create() {
+    KernelMutex* mutex = new KernelMutex;
+    mutex->recursive = true;
+    return mutex;
+}
+
+bool mutex_take(mutex_t mutex, uint32_t timeout) {
+    Kernel& kernel = getKernel();
+    std::unique_lock lock(kernel.lock);
+    KernelMutex* kernelMutex = static_cast<KernelMutex*>(mutex);
+    if (kernelMutex == nullptr) {
+        errno = EINVAL;
+        return false;
+    }
+    Tcb* const caller = self == nullptr ? &KernelMutex::outside : self;
+    if (kernelMutex->count == 0) {
+        kernelMutex->owner = caller;
+        kernelMutex->count = 1;
+        return true;
+    }
+    if (kernelMutex->recursive && kernelMutex->owner == caller) {
+        kernelMutex->count++;
+        return true;
+    }
+    // threads that aren't tasks can't wait, since no task runs until they return
+    if (timeout == 0 || self == nullptr) return false;
+    block(kernel, self, timeout);
+    self->waitingForMutex = kernelMutex;
+    reschedule(lock);
+    // given to this task by mutex_give(), unless it timed out
+    return kernelMutex->owner == self;
+}
+
+bool mutex_give(mutex_t mutex) {
+    Kernel& kernel = getKernel();
+    std::unique_lock lock(kernel.lock);
+    KernelMutex* kernelMutex = static_cast<KernelMutex*>(mutex);
+    Tcb* const caller = self == nullptr ? &KernelMutex::outside : self;
+    if (kernelMutex == nullptr || kernelMutex->count == 0 || kernelMutex->owner != caller) {
+        errno = EINVAL;
+        return false;
+    }
+    if (--kernelMutex->count != 0) return true;
+    // hand the mutex to the highest priority task waiting for it, so a task that takes it again right away can't
+    // starve the others
+    Tcb* next = nullptr;
+    for (Tcb* tcb : kernel.tasks) {
+        if (tcb->state != State::BLOCKED || tcb->waitingForMutex != kernelMutex) continue;
+        if (next == nullptr || tcb->priority > next->priority ||
+            (tcb->priority == next->priority && tcb->order < next->order)) {
+            next = tcb;
+        }
+    }
+    kernelMutex->owner = next;
+    if (next != nullptr) {
+        kernelMutex->count = 1;
+        makeReady(kernel, next);
+    }
+    reschedule(lock);
+    return true;
+}
+
+bool mutex_recursive_take(mutex_t mutex, uint32_t timeout) { return mutex_take(mutex, timeout); }
+
+bool mutex_recursive_give(mutex_t mutex) { return mutex_give(mutex); }
+
+void mutex_delete(mutex_t mutex) { delete static_cast<KernelMutex*>(mutex); }
+} // namespace pros::c
+
+namespace pros {
+inline namespace rtos {
+Task::Task(task_fn_t function, void* parameters, std::uint32_t prio, std::uint16_t stack_depth, const char* name)
+    : task(c::task_create(function, parameters, prio, stack_depth, name)) {}
+
+Task::Task(task_fn_t function, void* parameters, const char* name)
+    : Task(function, parameters, TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT, name) {}
+
+Task::Task(task_t task)
+    : task(task) {}
+
+Task Task::current() { return Task(c::task_get_current()); }
+
+Task& Task::operator=(task_t in) {
+    task = in;
+    return *this;
+}
+
+void Task::remove() { c::task_delete(task); }
+
+std::uint32_t Task::get_priority() { return c::task_get_priority(task); }
+
+void Task::set_priority(std::uint32_t prio) { c::task_set_priority(task, prio); }
+
+std::uint32_t Task::get_state() { return c::task_get_state(task); }
+
+void Task::suspend() { c::task_suspend(task); }
+
+void Task::resume() { c::task_resume(task); }
+
+const char* Task::get_name() { return c::task_get_name(task); }
+
+std::uint32_t Task::notify() { return c::task_notify(task); }
+
+void Task::join() { c::task_join(task); }
+
+std::uint32_t Task::notify_ext(std::uint32_t value, notify_action_e_t action, std::uint32_t* prev_value) {
+    return c::task_notify_ext(task, value, action, prev_value);
+}
+
+std::uint32_t Task::notify_take(bool clear_on_exit, std::uint32_t timeout) {
+    return c::task_notify_take(clear_on_exit, timeout);
+}
+
+bool Task::notify_clear() { return c::task_notify_clear(task); }
+
+void Task::delay(const std::uint32_t milliseconds) { c::task_delay(milliseconds); }
+
+void Task::delay_until(std::uint32_t* const prev_time, const std::uint32_t delta) {
+    c::task_delay_until(prev_time, delta);
+}
+
+std::uint32_t Task::get_count() { return c::task_get_count(); }
+
+Clock::time_point Clock::now() { return time_point(duration(c::millis())); }
+
+mutex_t Mutex::lazy_init() {
+    mutex_t current = mutex.load();
+    if (current != nullptr) return current;
+    mutex_t created = c::mutex_create();
+    if (mutex.compare_exchange_strong(current, created)) return created;
+    // created by another thread first
+    c::mutex_delete(created);
+    return current;
+}
+
+bool Mutex::take() { return take(TIMEOUT_MAX); }
+
+bool Mutex::take(std::uint32_t timeout) { return c::mutex_take(lazy_init(), timeout); }
+
+bool Mutex::give() { return c::mutex_give(lazy_init()); }
+
+void Mutex::lock() { take(TIMEOUT_MAX); }
+
+void Mutex::unlock() { give(); }
+
+bool Mutex::try_lock() { return take(0); }
+
+Mutex::~Mutex() { c::mutex_delete(mutex.exchange(nullptr)); }
+
+mutex_t RecursiveMutex::lazy_init() {
+    mutex_t current = mutex.load();
+    if (current != nullptr) return current;
+    mutex_t created = c::mutex_recursive_create();
+    if (mutex.compare_exchange_strong(current, created)) return created;
+    c::mutex_delete(created);
+    return current;
+}
+
+bool RecursiveMutex::take() { return take(TIMEOUT_MAX); }
+
+bool RecursiveMutex::take(std::uint32_t timeout) { return c::mutex_recursive_take(lazy_init(), timeout); }
+
+bool RecursiveMutex::give() { return c::mutex_recursive_give(lazy_init()); }
+
+void RecursiveMutex::lock() { take(TIMEOUT_MAX); }
+
+void RecursiveMutex::unlock() { give(); }
+
+bool RecursiveMutex::try_lock() { return take(0); }
+
+RecursiveMutex::~RecursiveMutex() { c::mutex_delete(mutex.exchange(nullptr)); }
+} // namespace rtos
+} // namespace pros
+
+// tasks are threads on the host, so the stack and control block the caller provides go unused
+pros::task_t task_create_static(pros::task_fn_t function, void* parameters, uint32_t priority, size_t stackDepth,
+                                const char* name, uint32_t* stack, void* controlBlock) {
+    (void)stack;
+    (void)controlBlock;
+    return pros::c::task_create(function, parameters, priority, static_cast<uint16_t>(stackDepth), name);
+}
+
+// run times are the CPU time of each task's thread and the host's time since the kernel started, in microseconds, so
+// a task's share of the CPU is the share of the host's time its thread ran for
+unsigned long uxTaskGetSystemState(lemlib::TaskStatus* statuses, unsigned long size, uint32_t* totalRunTime) {
+    Kernel& kernel = getKernel();
+    std::lock_guard lock(kernel.lock);
+    const auto sinceCreated = std::chrono::steady_clock::now() - kernel.created;
+    if (totalRunTime != nullptr) {
+        *totalRunTime = std::chrono::duration_cast<std::chrono::microseconds>(sinceCreated).count();
+    }
+    unsigned long count = 0;
+    for (Tcb* tcb : kernel.tasks) count += tcb->state != State::DELETED;
+    if (count > size) return 0;
+    unsigned long filled = 0;
+    for (size_t i = 0; i < kernel.tasks.size(); i++) {
+        Tcb* tcb = kernel.tasks[i];
+        if (tcb->state == State::DELETED) continue;
+        timespec cpuTime {};
+        if (tcb->started) clock_gettime(tcb->cpuClock, &cpuTime);
+        statuses[filled++] = {.handle = tcb,
+                              .name = tcb->name,
+                              .number = i + 1,
+                              .state = stateOf(kernel, tcb),
+                              .currentPriority = tcb->priority,
+                              .basePriority = tcb->priority,
+                              .runTime = uint32_t(cpuTime.tv_sec * 1000000 + cpuTime.tv_nsec / 1000),
+                              .stackBase = nullptr,
+                              .stackHighWaterMark = 0};
+    }
+    return filled;
+}
@@ -0,0 +1,43 @@
+#!/bin/sh
+# Counts the instructions each of lemlib-count's benchmarks takes per call on a Cortex-A9, under qemu-arm, and prints
+# them as JSON.
+#
+# Usage: count.sh <lemlib-count>
+#
+# QEMU is the qemu-arm to run, and QEMU_PLUGIN is the path to QEMU's insn plugin (libinsn.so), which is built with
+# QEMU's tests/plugin directory. Each benchmark runs with FEW and then MANY calls, and the difference in instructions
+# between the two runs is divided by the difference in calls, so that setup and startup cancel out.
+set -eu
+
+QEMU=${QEMU:-qemu-arm}
+QEMU_PLUGIN=${QEMU_PLUGIN:-libinsn.so}
+FEW=1000
+MANY=11000
+
+if [ $# -ne 1 ]; then
+    echo "usage: $0 <lemlib-count>" >&2
+    exit 2
+fi
+program=$1
+
+# instructions one run executes. The plugin reports them on stderr, when the program exits
+count() {
+    "$QEMU" -cpu cortex-a9 -plugin "$QEMU_PLUGIN,inline=on" -d plugin "$program" "$1" "$2" 2>&1 >/dev/null |
+        sed -n 's/^insns: //p'
+}
+
+printf '{\n  "cpu": "cortex-a9",\n  "benchmarks": [\n'
+separator=""
+for benchmark in $("$QEMU" -cpu cortex-a9 "$program" --list); do
+    few=$(count "$benchmark" $FEW)
+    many=$(count "$benchmark" $MANY)
+    if [ -z "$few" ] || [ -z "$many" ]; then
+        echo "$0: no instruction count for $benchmark. Is $QEMU_PLUGIN QEMU's insn plugin?" >&2
+        exit 1
+    fi
+    perCall=$(awk "BEGIN { printf \"%.1f\", ($many - $few) / ($MANY - $FEW) }")
+    printf '%s    {"name": "%s", "instructions_per_call": %s}' "$separator" "$benchmark" "$perCall"
+    separator=",
+"
+done
+printf '\n  ]\n}\n'
@@ -0,0 +1,215 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/odom.hpp"
+#include "lemlib/chassis/purePursuit.hpp"
+#include "lemlib/exitcondition.hpp"
+#include "lemlib/math/fastMath.hpp"
+#include "lemlib/path/pathSoA.hpp"
+#include "lemlib/pid.hpp"
+#include "lemlib/util.hpp"
+#include "sim/devices.hpp"
+
+/**
+ * Runs one of LemLib's hot paths a number of times, so that count.sh can count the instructions it takes on a
+ * Cortex-A9 under QEMU.
+ *
+ * Usage: lemlib-count <benchmark> <calls>
+ *
+ * Setup is the same however many calls there are, so count.sh runs each benchmark twice, with different numbers of
+ * calls, and divides the difference in instructions by the difference in calls. What's left is the cost of a call,
+ * plus the few instructions of the loop and of fetching its inputs.
+ */
+namespace {
+constexpr size_t INPUTS = 256;
+
+// the result of each call goes here, so the compiler can't skip the call
+volatile float sink;
+
+// random inputs from -100 to 100, the same on every run
+float value(size_t i) {
+    static const std::vector<float> values = [] {
+        std::vector<float> values(INPUTS);
+        uint32_t state = 1;
+        for (float& value : values) {
+            state = state * 1664525 + 1013904223;
+            value = (state >> 8) / 16777216.0f * 200 - 100;
+        }
+        return values;
+    }();
+    return values[i % INPUTS];
+}
+
+void pidUpdate(size_t calls) {
+    lemlib::PID pid(8.5, 0.01, 43, 3, true);
+    for (size_t i = 0; i < calls; i++) sink = pid.update(value(i));
+}
+
+void exitConditionUpdate(size_t calls) {
+    lemlib::ExitCondition exit(1, 100);
+    for (size_t i = 0; i < calls; i++) sink = exit.update(value(i) / 90);
+}
+
+void angleError(size_t calls) {
+    for (size_t i = 0; i < calls; i++) sink = lemlib::angleError(value(i), value(i + 1), true);
+}
+
+void getCurvature(size_t calls) {
+    for (size_t i = 0; i < calls; i++) {
+        sink = lemlib::getCurvature({value(i), value(i + 1), value(i + 2) / 10}, {value(i + 3), value(i + 4)});
+    }
+}
+
+// one odometry update with main.cpp's sensors: a vertical and a horizontal tracking wheel, and an IMU
+void odomUpdate(size_t calls) {
+    pros::Rotation verticalEncoder(-6);
+    pros::Rotation horizontalEncoder(-15);
+    pros::Imu imu(4);
+    lemlib::TrackingWheel vertical(&verticalEncoder, lemlib::Omniwheel::NEW_2, -4.5);
+    lemlib::TrackingWheel horizontal(&horizontalEncoder, lemlib::Omniwheel::NEW_2, 0.5);
+    lemlib::setSensors(lemlib::OdomSensors(&vertical, nullptr, &horizontal, nullptr, &imu),
+                       lemlib::Drivetrain(nullptr, nullptr, 10.95, lemlib::Omniwheel::NEW_4, 450, 8));
+    for (size_t i = 0; i < calls; i++) {
+        sim::rotation(6)->position += static_cast<int32_t>(value(i) * 10);
+        sim::rotation(15)->position += static_cast<int32_t>(value(i + 1));
+        sim::imu(4)->yaw += value(i + 2) / 100;
+        lemlib::update();
+    }
+    sink = lemlib::getPose().x;
+}
+
+// what Chassis::follow() computes each tick, on a 100 point path, with the robot driving along it
+void purePursuitStep(size_t calls) {
+    std::vector<lemlib::Pose> path;
+    for (int i = 0; i < 100; i++) path.emplace_back(i, 10 * std::sin(i / 10.0f), 100 - i);
+    lemlib::Pose lastLookahead = path[0];
+    lastLookahead.theta = 0;
+    float previousSpeed = 0;
+    for (size_t i = 0; i < calls; i++) {
+        const float along = i % 90;
+        const lemlib::Pose pose(along + value(i) / 100, 10 * std::sin(along / 10) + value(i + 1) / 100, 0.5);
+        const int closest = lemlib::findClosest(pose, path);
+        // start over at the start of the path
+        if (closest == 0) lastLookahead.theta = 0;
+        lastLookahead = lemlib::lookaheadPoint(lastLookahead, pose, path, closest, 15);
+        const float curvature = lemlib::getCurvature(lemlib::Pose(pose.x, pose.y, M_PI_2 - pose.theta), lastLookahead);
+        previousSpeed = lemlib::slew(path[closest].theta, previousSpeed, 110);
+        sink = curvature + previousSpeed;
+    }
+}
+
+// the same, with the path as a PathSoA, the way follow() runs it
+void purePursuitStepSoA(size_t calls) {
+    std::vector<lemlib::Pose> points;
+    for (int i = 0; i < 100; i++) points.emplace_back(i, 10 * std::sin(i / 10.0f), 100 - i);
+    const lemlib::PathSoA path(points);
+    lemlib::Pose lastLookahead = path.point(0);
+    lastLookahead.theta = 0;
+    float previousSpeed = 0;
+    for (size_t i = 0; i < calls; i++) {
+        const float along = i % 90;
+        const lemlib::Pose pose(along + value(i) / 100, 10 * std::sin(along / 10) + value(i + 1) / 100, 0.5);
+        const int closest = lemlib::findClosest(pose, path);
+        // start over at the start of the path
+        if (closest == 0) lastLookahead.theta = 0;
+        lastLookahead = lemlib::lookaheadPoint(lastLookahead, pose, path, closest, 15);
+        const float curvature = lemlib::getCurvature(lemlib::Pose(pose.x, pose.y, M_PI_2 - pose.theta), lastLookahead);
+        previousSpeed = lemlib::slew(path.velocity()[closest], previousSpeed, 110);
+        sink = curvature + previousSpeed;
+    }
+}
+
+// libm's float sin and cos, and lemlib::fast's, one angle per call
+void libmSincos(size_t calls) {
+    for (size_t i = 0; i < calls; i++) sink = std::sin(value(i) / 10) + std::cos(value(i) / 10);
+}
+
+void fastSincos(size_t calls) {
+    for (size_t i = 0; i < calls; i++) {
+        float sin, cos;
+        lemlib::fast::sincos(value(i) / 10, sin, cos);
+        sink = sin + cos;
+    }
+}
+
+void libmAtan2(size_t calls) {
+    for (size_t i = 0; i < calls; i++) sink = std::atan2(value(i), value(i + 1));
+}
+
+void fastAtan2(size_t calls) {
+    for (size_t i = 0; i < calls; i++) sink = lemlib::fast::atan2(value(i), value(i + 1));
+}
+
+void libmHypot(size_t calls) {
+    for (size_t i = 0; i < calls; i++) sink = std::hypot(value(i), value(i + 1));
+}
+
+void fastHypot(size_t calls) {
+    for (size_t i = 0; i < calls; i++) sink = lemlib::fast::hypot(value(i), value(i + 1));
+}
+
+// the batch versions, 4 values per call, so the counts compare with the scalar ones
+void fastSincosBatch(size_t calls) {
+    float angles[INPUTS], sines[INPUTS], cosines[INPUTS];
+    for (size_t i = 0; i < INPUTS; i++) angles[i] = value(i) / 10;
+    for (size_t i = 0; i < calls; i++) {
+        const size_t start = i * 4 % INPUTS;
+        lemlib::fast::sincos(angles + start, sines + start, cosines + start, 4);
+    }
+    sink = sines[0] + cosines[0];
+}
+
+void fastAtan2Batch(size_t calls) {
+    float y[INPUTS], x[INPUTS], angles[INPUTS];
+    for (size_t i = 0; i < INPUTS; i++) {
+        y[i] = value(i);
+        x[i] = value(i + 1);
+    }
+    for (size_t i = 0; i < calls; i++) {
+        const size_t start = i * 4 % INPUTS;
+        lemlib::fast::atan2(y + start, x + start, angles + start, 4);
+    }
+    sink = angles[0];
+}
+
+struct Benchmark {
+        const char* name;
+        void (*run)(size_t calls);
+};
+
+constexpr Benchmark BENCHMARKS[] = {{"pidUpdate", pidUpdate},
+                                    {"exitConditionUpdate", exitConditionUpdate},
+                                    {"angleError", angleError},
+                                    {"getCurvature", getCurvature},
+                                    {"odomUpdate", odomUpdate},
+                                    {"purePursuitStep", purePursuitStep},
+                                    {"purePursuitStepSoA", purePursuitStepSoA},
+                                    {"libmSincos", libmSincos},
+                                    {"fastSincos", fastSincos},
+                                    {"libmAtan2", libmAtan2},
+                                    {"fastAtan2", fastAtan2},
+                                    {"libmHypot", libmHypot},
+                                    {"fastHypot", fastHypot},
+                                    {"fastSincosBatch", fastSincosBatch},
+                                    {"fastAtan2Batch", fastAtan2Batch}};
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 2 && std::strcmp(argv[1], "--list") == 0) {
+        for (const Benchmark& benchmark : BENCHMARKS) std::printf("%s\n", benchmark.name);
+        return 0;
+    }
+    if (argc == 3) {
+        for (const Benchmark& benchmark : BENCHMARKS) {
+            if (std::strcmp(argv[1], benchmark.name) != 0) continue;
+            benchmark.run(std::strtoul(argv[2], nullptr, 10));
+            return 0;
+        }
+    }
+    std::fprintf(stderr, "usage: %s <benchmark> <calls>, or %s --list\n", argv[0], argv[0]);
+    return 2;
+}
@@ -0,0 +1,40 @@
+#include <cstdlib>
+
+#include "pros/rtos.hpp"
+#include "lemlib/profiling/deadlineMonitor.hpp"
+#include "sim/kernel.hpp"
+
+/**
+ * The parts of the host kernel the benchmarks link against, without tasks. Time only moves when something waits.
+ */
+namespace {
+uint64_t now = 0;
+} // namespace
+
+namespace sim {
+uint64_t time() { return now; }
+} // namespace sim
+
+namespace pros::c {
+uint32_t millis() { return now / 1000; }
+
+uint64_t micros() { return now; }
+
+void delay(const uint32_t milliseconds) { now += milliseconds * 1000; }
+} // namespace pros::c
+
+namespace pros::rtos {
+// odometry's task is never started, since the benchmarks call update() themselves
+Task::Task(task_fn_t, void*, std::uint32_t, std::uint16_t, const char*) : task(nullptr) { std::abort(); }
+} // namespace pros::rtos
+
+namespace lemlib {
+// nor is the deadline it registers used
+DeadlineMonitor& deadlineMonitor() { std::abort(); }
+
+Deadline* DeadlineMonitor::add(const char*, uint32_t, uint32_t) { std::abort(); }
+
+void Deadline::beginCycle() { std::abort(); }
+
+void Deadline::endCycle() { std::abort(); }
+} // namespace lemlib
@@ -0,0 +1,286 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+#include "main.h"
+#include "lemlib/chassis/odom.hpp"
+#include "sim/devices.hpp"
+#include "sim/kernel.hpp"
+#include "sim/motions.hpp"
+#include "sim/robot.hpp"
+
+/**
+ * Runs the robot program on the host, the way the brain would at a match: initialize(), then autonomous().
+ *
+ * Usage: robot [--time <milliseconds>] [--seed <seed>] [--start <x>,<y>,<theta>] [--start-error <x>,<y>,<theta>]
+ *              [--battery <percent>] [--motor-variation <fraction>] [--no-noise] [--steps]
+ *              [--lateral <settings>] [--angular <settings>]
+ *
+ * Autonomous runs for 60 seconds of virtual time by default, the length of a skills run. The robot is simulated from
+ * the drivetrain and sensors in main.cpp, starting where the skills auton expects it to, with sensor noise from the
+ * seed. --start-error moves where the robot actually starts, without the program knowing. --motor-variation makes
+ * each drivetrain motor stronger or weaker, by that standard deviation, and --no-noise turns off all the noise. Exits
+ * with 1 if the program deadlocks. What the program prints goes to stdout, like the brain's serial port, and the
+ * results go to stderr, including how long each motion took.
+ *
+ * --steps runs step responses instead of autonomous: drives forwards and backwards, and turns both ways, each on its
+ * own from rest. For each step it prints how long the motion took, when the robot actually settled within a tolerance
+ * of the target for good, how far it overshot, and how far off it ended up, all measured on the simulated robot rather
+ * than odometry. A robot that is still outside the tolerance at the end of the step didn't settle. --lateral and
+ * --angular replace the chassis' controller settings, as the 9 comma separated arguments of
+ * lemlib::ControllerSettings' constructor.
+ */
+// the robot, from main.cpp
+extern pros::MotorGroup leftMotors;
+extern pros::MotorGroup rightMotors;
+extern pros::Imu imu;
+extern pros::Rotation verticalEnc;
+extern pros::Rotation horizontalEnc;
+extern lemlib::TrackingWheel vertical;
+extern lemlib::TrackingWheel horizontal;
+extern lemlib::Drivetrain drivetrain;
+extern lemlib::ControllerSettings linearController;
+extern lemlib::ControllerSettings angularController;
+extern lemlib::OdomSensors sensors;
+extern lemlib::ExpoDriveCurve throttleCurve;
+extern lemlib::ExpoDriveCurve steerCurve;
+extern lemlib::Chassis chassis;
+
+namespace {
+// how long initialize() may run for, in milliseconds
+constexpr uint32_t INITIALIZE_TIMEOUT = 30000;
+// how long the robot rests after each step, in milliseconds, to see whether it stays settled
+constexpr uint32_t STEP_REST = 500;
+// how close to the target a step must be to count as settled, in inches and degrees
+constexpr double DRIVE_TOLERANCE = 1;
+constexpr double TURN_TOLERANCE = 1;
+
+/**
+ * @brief A step response
+ */
+struct Step {
+        bool turn;
+        /** distance to drive, in inches, or angle to turn clockwise, in degrees. Negative to go backwards */
+        double amount;
+        /** in milliseconds */
+        int timeout;
+};
+
+// each step starts where the last one ended, so they come in pairs that bring the robot back
+constexpr Step STEPS[] = {{false, 24, 3000}, {false, -24, 3000}, {false, 48, 4000}, {false, -48, 4000},
+                          {true, 45, 2000},  {true, -45, 2000},  {true, 135, 3000}, {true, -135, 3000}};
+
+/**
+ * @brief How the simulated robot responds to the step that is running
+ *
+ * Written by the step task and the tick hook, which never run at the same time.
+ */
+struct StepResponse {
+        const Step* step = nullptr;
+        /** where the robot actually was when the step started */
+        sim::Pose start;
+        /** in microseconds */
+        uint64_t startTime;
+        /** how far the robot went past the target, in inches or degrees */
+        double overshoot;
+        /** how far the robot is past the target. Negative if it hasn't reached it yet */
+        double error;
+        /** last time the robot was outside the tolerance, in microseconds */
+        uint64_t lastOutside;
+};
+
+sim::Robot* simulatedRobot = nullptr;
+StepResponse response;
+
+const char* resultName(sim::RunResult result) {
+    switch (result) {
+        case sim::RunResult::FINISHED: return "finished";
+        case sim::RunResult::TIMEOUT: return "timed out";
+        case sim::RunResult::DEADLOCK: return "deadlocked";
+    }
+    return "unknown";
+}
+
+int usage(const char* program) {
+    std::fprintf(stderr,
+                 "usage: %s [--time <milliseconds>] [--seed <seed>] [--start <x>,<y>,<theta>] "
+                 "[--start-error <x>,<y>,<theta>] [--battery <percent>] [--motor-variation <fraction>] [--no-noise] "
+                 "[--steps] [--lateral <settings>] [--angular <settings>]\n",
+                 program);
+    return 2;
+}
+
+sim::TrackingWheelConfig trackingWheel(const pros::Rotation& encoder, lemlib::TrackingWheel& wheel) {
+    const int8_t port = static_cast<int8_t>(encoder.get_port());
+    return {static_cast<int8_t>(encoder.get_reversed() ? -port : port), lemlib::Omniwheel::NEW_2, wheel.getOffset()};
+}
+
+sim::RobotConfig robotConfig() {
+    sim::RobotConfig config;
+    config.leftMotors = leftMotors.get_port_all();
+    config.rightMotors = rightMotors.get_port_all();
+    config.trackWidth = drivetrain.trackWidth;
+    config.wheelDiameter = drivetrain.wheelDiameter;
+    config.rpm = drivetrain.rpm;
+    config.horizontalDrift = drivetrain.horizontalDrift;
+    config.verticalWheels = {trackingWheel(verticalEnc, vertical)};
+    config.horizontalWheels = {trackingWheel(horizontalEnc, horizontal)};
+    config.imuPort = imu.get_port();
+    // where skillsAuton() sets the pose to
+    config.start = {-46.5, 0, 180};
+    return config;
+}
+
+// parse the arguments of a lemlib::ControllerSettings
+bool parseSettings(const char* text, lemlib::ControllerSettings& settings) {
+    return std::sscanf(text, "%f,%f,%f,%f,%f,%f,%f,%f,%f", &settings.kP, &settings.kI, &settings.kD,
+                       &settings.windupRange, &settings.smallError, &settings.smallErrorTimeout, &settings.largeError,
+                       &settings.largeErrorTimeout, &settings.slew) == 9;
+}
+
+void printSettings(const char* name, const lemlib::ControllerSettings& settings) {
+    std::fprintf(stderr, "%s settings: %g,%g,%g,%g,%g,%g,%g,%g,%g\n", name, settings.kP, settings.kI, settings.kD,
+                 settings.windupRange, settings.smallError, settings.smallErrorTimeout, settings.largeError,
+                 settings.largeErrorTimeout, settings.slew);
+}
+
+// track the step that is running, each millisecond
+void measureStep(uint64_t time) {
+    if (response.step == nullptr) return;
+    const sim::Pose pose = simulatedRobot->getPose();
+    const sim::Pose& start = response.start;
+    const double direction = std::copysign(1, response.step->amount);
+    double progress;
+    if (response.step->turn) {
+        progress = (pose.theta - start.theta) * direction;
+    } else {
+        const double heading = start.theta * M_PI / 180;
+        progress = ((pose.x - start.x) * std::sin(heading) + (pose.y - start.y) * std::cos(heading)) * direction;
+    }
+    response.error = progress - std::fabs(response.step->amount);
+    response.overshoot = std::max(response.overshoot, response.error);
+    const double tolerance = response.step->turn ? TURN_TOLERANCE : DRIVE_TOLERANCE;
+    if (std::fabs(response.error) > tolerance) response.lastOutside = time;
+}
+
+void runSteps() {
+    for (size_t i = 0; i < std::size(STEPS); i++) {
+        const Step& step = STEPS[i];
+        const lemlib::Pose pose = chassis.getPose();
+        response = {&step, simulatedRobot->getPose(), sim::time(), 0, -std::fabs(step.amount), sim::time()};
+        if (step.turn) {
+            chassis.turnToHeading(pose.theta + step.amount, step.timeout, {}, false);
+        } else {
+            const double heading = pose.theta * M_PI / 180;
+            chassis.moveToPoint(pose.x + step.amount * std::sin(heading), pose.y + step.amount * std::cos(heading),
+                                step.timeout, {.forwards = step.amount > 0}, false);
+        }
+        const double duration = (sim::time() - response.startTime) / 1e6;
+        pros::delay(STEP_REST);
+        // the robot isn't settled until the motion ends, since the next motion can't start until then
+        const double settle = std::max(duration, (response.lastOutside - response.startTime) / 1e6);
+        // motions only check their timeout every 10 ms
+        const bool timedOut = duration * 1000 >= step.timeout - 10;
+        const bool settled = response.lastOutside < sim::time();
+        std::fprintf(stderr, "step %zu: %s %g, took %.3f s, settled in %.3f s, overshoot %.3f, error %.3f%s%s\n", i,
+                     step.turn ? "turn" : "drive", step.amount, duration, settle, response.overshoot,
+                     std::fabs(response.error), settled ? "" : ", not settled", timedOut ? ", timed out" : "");
+        response.step = nullptr;
+    }
+}
+
+// run a competition mode in its own task, like the PROS kernel does
+sim::RunResult runMode(const char* name, void (*mode)(), uint32_t timeout) {
+    const pros::task_t task = pros::c::task_create([](void* mode) { reinterpret_cast<void (*)()>(mode)(); },
+                                                   reinterpret_cast<void*>(mode), TASK_PRIORITY_DEFAULT,
+                                                   TASK_STACK_DEPTH_DEFAULT, name);
+    const uint64_t start = sim::time();
+    const auto wallStart = std::chrono::steady_clock::now();
+    const sim::RunResult result = sim::run(task, timeout);
+    const auto wallTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wallStart);
+    std::fprintf(stderr, "%s %s after %.3f s of virtual time, in %.1f ms\n", name, resultName(result),
+                (sim::time() - start) / 1e6, wallTime.count());
+    return result;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    uint32_t autonomousTime = 60000;
+    sim::RobotConfig config = robotConfig();
+    sim::Pose startError = {0, 0, 0};
+    bool steps = false;
+    lemlib::ControllerSettings lateral = linearController;
+    lemlib::ControllerSettings angular = angularController;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--time") == 0 && i + 1 < argc) {
+            autonomousTime = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            config.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--start") == 0 && i + 1 < argc) {
+            sim::Pose& start = config.start;
+            if (std::sscanf(argv[++i], "%lf,%lf,%lf", &start.x, &start.y, &start.theta) != 3) return usage(argv[0]);
+        } else if (std::strcmp(argv[i], "--start-error") == 0 && i + 1 < argc) {
+            if (std::sscanf(argv[++i], "%lf,%lf,%lf", &startError.x, &startError.y, &startError.theta) != 3) {
+                return usage(argv[0]);
+            }
+        } else if (std::strcmp(argv[i], "--battery") == 0 && i + 1 < argc) {
+            sim::battery().capacity = std::strtod(argv[++i], nullptr);
+        } else if (std::strcmp(argv[i], "--motor-variation") == 0 && i + 1 < argc) {
+            config.noise.motorVariation = std::strtod(argv[++i], nullptr);
+        } else if (std::strcmp(argv[i], "--no-noise") == 0) {
+            config.noise = {0, 0, 0, 0, 0};
+        } else if (std::strcmp(argv[i], "--steps") == 0) {
+            steps = true;
+        } else if (std::strcmp(argv[i], "--lateral") == 0 && i + 1 < argc) {
+            if (!parseSettings(argv[++i], lateral)) return usage(argv[0]);
+        } else if (std::strcmp(argv[i], "--angular") == 0 && i + 1 < argc) {
+            if (!parseSettings(argv[++i], angular)) return usage(argv[0]);
+        } else {
+            return usage(argv[0]);
+        }
+    }
+
+    config.start.x += startError.x;
+    config.start.y += startError.y;
+    config.start.theta += startError.theta;
+    // outlives the kernel, since the process exits without destroying it
+    static sim::Robot robot(config);
+    robot.attach();
+    simulatedRobot = &robot;
+    sim::addTickHook(measureStep);
+
+    // the chassis copies its settings when it's constructed, so it has to be constructed again with the new ones
+    std::destroy_at(&chassis);
+    std::construct_at(&chassis, drivetrain, lateral, angular, sensors, &throttleCurve, &steerCurve);
+    printSettings("lateral", lateral);
+    printSettings("angular", angular);
+
+    int status = 0;
+    sim::competitionStatus() = COMPETITION_CONNECTED | COMPETITION_DISABLED;
+    sim::RunResult result = runMode("User Initialize", initialize, INITIALIZE_TIMEOUT);
+    if (result == sim::RunResult::DEADLOCK) status = 1;
+    if (result == sim::RunResult::FINISHED) {
+        sim::competitionStatus() = COMPETITION_CONNECTED | COMPETITION_AUTONOMOUS;
+        if (steps) result = runMode("Steps", runSteps, autonomousTime);
+        else result = runMode("User Auton", autonomous, autonomousTime);
+        if (result == sim::RunResult::DEADLOCK) status = 1;
+    }
+
+    const lemlib::Pose pose = lemlib::getPose();
+    const std::vector<sim::Motion>& motions = sim::motions();
+    for (size_t i = 0; i < motions.size(); i++) {
+        if (motions[i].end == 0) continue;
+        std::fprintf(stderr, "motion %zu: started at %.3f s, settled in %.3f s\n", i, motions[i].start / 1e6,
+                     (motions[i].end - motions[i].start) / 1e6);
+    }
+    const sim::Pose truth = robot.getPose();
+    std::fprintf(stderr, "final pose: x %.2f, y %.2f, theta %.2f\n", pose.x, pose.y, pose.theta);
+    std::fprintf(stderr, "actual pose: x %.2f, y %.2f, theta %.2f\n", truth.x, truth.y, truth.theta);
+    // tasks are still blocked on their threads, so skip the destructors of the objects they use. stdout is where the
+    // program prints, so it needs flushing first
+    std::fflush(stdout);
+    std::_Exit(status);
+}
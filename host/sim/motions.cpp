@@ -0,0 +1,18 @@
+#include "sim/kernel.hpp"
+#include "sim/motions.hpp"
+
+namespace {
+// only one task runs at a time, so this doesn't need a lock
+std::vector<sim::Motion> recorded;
+} // namespace
+
+namespace sim {
+void motionStarted() { recorded.push_back({time(), 0}); }
+
+void motionEnded() {
+    // motions that are skipped before they start don't count
+    if (!recorded.empty() && recorded.back().end == 0) recorded.back().end = time();
+}
+
+const std::vector<Motion>& motions() { return recorded; }
+} // namespace sim
@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <cmath>
+
+#include "sim/motor.hpp"
+
+namespace {
+constexpr double NOMINAL_VOLTAGE = 12;
+// current the motor would draw at stall at 12 V, without a current limit
+constexpr double UNLIMITED_STALL_CURRENT = 5;
+constexpr double RESISTANCE = NOMINAL_VOLTAGE / UNLIMITED_STALL_CURRENT;
+constexpr double DEFAULT_CURRENT_LIMIT = 2.5;
+// friction of the gears at free speed, as a fraction of the stall torque
+constexpr double FRICTION = 0.02;
+// heat capacity of the motor, in joules per kelvin, and thermal resistance to the air, in kelvin per watt
+constexpr double HEAT_CAPACITY = 30;
+constexpr double THERMAL_RESISTANCE = 3;
+constexpr double AMBIENT_TEMPERATURE = 25;
+// gains of the firmware's controllers: extra voltage per unit of velocity error, relative to the feedforward, and
+// target speed per radian of position error
+constexpr double VELOCITY_GAIN = 2;
+constexpr double POSITION_GAIN = 10;
+
+double rpmToRadians(double rpm) { return rpm * 2 * M_PI / 60; }
+
+// the current limit, after the firmware derates it for temperature
+double currentLimit(const sim::MotorDevice& device) {
+    if (device.temperature >= 70) return 0;
+    double limit = device.currentLimit / 1000.0;
+    if (device.temperature >= 55) limit /= std::pow(2, 1 + std::floor((device.temperature - 55) / 5));
+    return limit;
+}
+
+// voltage the firmware applies to reach a speed
+double velocityControl(double target, double speed, double backEmf) {
+    return backEmf * (target + VELOCITY_GAIN * (target - speed));
+}
+
+// voltage the firmware applies to reach a position, no faster than a speed
+double positionControl(double target, double position, double maxSpeed, double speed, double backEmf) {
+    return velocityControl(std::clamp(POSITION_GAIN * (target - position), -maxSpeed, maxSpeed), speed, backEmf);
+}
+} // namespace
+
+namespace sim {
+double MotorModel::stallTorque(pros::MotorGears gearing) {
+    switch (gearing) {
+        case pros::MotorGears::red: return 2.1;
+        case pros::MotorGears::blue: return 0.35;
+        default: return 1.05;
+    }
+}
+
+double MotorModel::freeSpeed(pros::MotorGears gearing) {
+    switch (gearing) {
+        case pros::MotorGears::red: return rpmToRadians(100);
+        case pros::MotorGears::blue: return rpmToRadians(600);
+        default: return rpmToRadians(200);
+    }
+}
+
+MotorModel::Output MotorModel::update(MotorDevice& device, double speed, double batteryVoltage) {
+    const double maxSpeed = freeSpeed(device.gearing);
+    const double backEmf = NOMINAL_VOLTAGE / maxSpeed;
+    const double torqueConstant = stallTorque(device.gearing) / DEFAULT_CURRENT_LIMIT;
+    const double friction = FRICTION * stallTorque(device.gearing) * speed / maxSpeed;
+    const double position = device.position * M_PI / 180;
+
+    // commanding 0 stops the motor the way its brake mode says
+    MotorControl control = device.control;
+    if ((control == MotorControl::VOLTAGE && device.targetVoltage == 0) ||
+        (control == MotorControl::VELOCITY && device.targetVelocity == 0)) {
+        control = MotorControl::BRAKE;
+    }
+    if (control != MotorControl::BRAKE || device.brakeMode != pros::MotorBrake::hold) holding = false;
+
+    double voltage = 0;
+    switch (control) {
+        case MotorControl::VOLTAGE: voltage = device.targetVoltage / 1000.0; break;
+        case MotorControl::VELOCITY:
+            voltage = velocityControl(rpmToRadians(device.targetVelocity), speed, backEmf);
+            break;
+        case MotorControl::POSITION:
+            voltage = positionControl(device.targetPosition * M_PI / 180, position,
+                                      rpmToRadians(device.targetVelocity), speed, backEmf);
+            break;
+        case MotorControl::BRAKE:
+            if (device.brakeMode == pros::MotorBrake::coast) {
+                // the windings are disconnected, so only friction slows the motor down
+                return {-friction, 0, 0, 0};
+            }
+            if (device.brakeMode == pros::MotorBrake::hold) {
+                if (!holding) holdPosition = position;
+                holding = true;
+                voltage = positionControl(holdPosition, position, maxSpeed, speed, backEmf);
+            }
+            // otherwise the windings are shorted, and the back EMF brakes the motor
+            break;
+    }
+    if (device.voltageLimit != 0) {
+        voltage = std::clamp(voltage, -device.voltageLimit / 1000.0, device.voltageLimit / 1000.0);
+    }
+    voltage = std::clamp(voltage, -batteryVoltage, batteryVoltage);
+
+    // the firmware lowers the voltage to keep the current under the limit
+    const double limit = currentLimit(device);
+    const double current = std::clamp((voltage - backEmf * speed) / RESISTANCE, -limit, limit);
+    voltage = backEmf * speed + current * RESISTANCE;
+    // braking feeds power back into the motor's own windings rather than the battery
+    const double batteryCurrent = std::max(0.0, voltage * current / batteryVoltage);
+    return {torqueConstant * current - friction, current, batteryCurrent, voltage};
+}
+
+void MotorModel::step(MotorDevice& device, const Output& output, double speed, double dt) {
+    device.position += speed * dt * 180 / M_PI;
+    device.velocity = speed * 60 / (2 * M_PI);
+    device.current = static_cast<int32_t>(std::lround(std::fabs(output.current) * 1000));
+    device.voltage = static_cast<int32_t>(std::lround(output.voltage * 1000));
+    device.torque = output.torque;
+    const double heat = output.current * output.current * RESISTANCE;
+    const double cooling = (device.temperature - AMBIENT_TEMPERATURE) / THERMAL_RESISTANCE;
+    device.temperature += (heat - cooling) / HEAT_CAPACITY * dt;
+}
+} // namespace sim
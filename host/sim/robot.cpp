@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <cmath>
+
+#include "sim/kernel.hpp"
+#include "sim/robot.hpp"
+
+namespace {
+constexpr int SMART_PORTS = 21;
+constexpr double METERS_PER_INCH = 0.0254;
+constexpr double GRAVITY = 9.81;
+// the battery: open circuit voltage when full and when empty, in volts, internal resistance, in ohms, and capacity,
+// in amp hours
+constexpr double FULL_VOLTAGE = 12.8;
+constexpr double EMPTY_VOLTAGE = 11.6;
+constexpr double BATTERY_RESISTANCE = 0.1;
+constexpr double BATTERY_CAPACITY = 1.1;
+// below these speeds, in meters and radians per second, friction fades out, so that a stopped robot doesn't jitter
+constexpr double STICTION_SPEED = 0.01;
+constexpr double STICTION_ANGULAR_SPEED = 0.05;
+// how quickly the wheels' grip stops the robot sliding sideways, in seconds
+constexpr double GRIP_TIME = 0.01;
+// how quickly a motor that isn't part of the drivetrain reaches its speed, in seconds
+constexpr double FREE_LOAD_TIME = 0.05;
+
+double sign(int8_t port) { return port < 0 ? -1 : 1; }
+
+bool inDrivetrain(const sim::RobotConfig& config, int port) {
+    auto matches = [&](int8_t other) { return std::abs(other) == port; };
+    return std::any_of(config.leftMotors.begin(), config.leftMotors.end(), matches) ||
+           std::any_of(config.rightMotors.begin(), config.rightMotors.end(), matches);
+}
+
+// wheel rotations per rotation of a drivetrain motor
+double gearRatio(const sim::RobotConfig& config, const sim::MotorDevice& motor) {
+    return config.rpm / (sim::MotorModel::freeSpeed(motor.gearing) * 60 / (2 * M_PI));
+}
+} // namespace
+
+namespace sim {
+Robot::Robot(RobotConfig config)
+    : config(std::move(config)),
+      x(this->config.start.x * METERS_PER_INCH),
+      y(this->config.start.y * METERS_PER_INCH),
+      heading(this->config.start.theta * M_PI / 180),
+      random(this->config.seed) {
+    for (const TrackingWheelConfig& wheel : this->config.verticalWheels) verticalWheels.push_back({wheel});
+    for (const TrackingWheelConfig& wheel : this->config.horizontalWheels) horizontalWheels.push_back({wheel});
+    std::normal_distribution<double> normal;
+    for (double& strength : strengths) strength = std::max(0.0, 1 + this->config.noise.motorVariation * normal(random));
+}
+
+void Robot::attach() {
+    addTickHook([this](uint64_t) { step(0.001); });
+}
+
+Pose Robot::getPose() const { return {x / METERS_PER_INCH, y / METERS_PER_INCH, heading * 180 / M_PI}; }
+
+void Robot::step(double dt) {
+    BatteryDevice& battery = sim::battery();
+    const double batteryVoltage = EMPTY_VOLTAGE + (FULL_VOLTAGE - EMPTY_VOLTAGE) * battery.capacity / 100 -
+                                  BATTERY_RESISTANCE * batteryCurrent;
+    const double wheelRadius = config.wheelDiameter / 2 * METERS_PER_INCH;
+    const double trackWidth = config.trackWidth * METERS_PER_INCH;
+    // unit vectors pointing forwards and to the left of the robot
+    const double forwardX = std::sin(heading);
+    const double forwardY = std::cos(heading);
+    const double leftX = -forwardY;
+    const double leftY = forwardX;
+
+    // force of each side of the drivetrain. The left side is faster when the robot turns clockwise
+    MotorModel::Output outputs[SMART_PORTS] = {};
+    auto sideForce = [&](const std::vector<int8_t>& ports, double speed) {
+        double force = 0;
+        for (int8_t port : ports) {
+            MotorDevice* device = sim::motor(port);
+            if (device == nullptr) continue;
+            const double ratio = gearRatio(config, *device);
+            MotorModel::Output& output = outputs[std::abs(port) - 1];
+            output = motors[std::abs(port) - 1].update(*device, sign(port) * speed / wheelRadius / ratio,
+                                                       batteryVoltage);
+            output.torque *= strengths[std::abs(port) - 1];
+            force += sign(port) * output.torque / ratio / wheelRadius;
+        }
+        return force;
+    };
+    const double forwardSpeed = vx * forwardX + vy * forwardY;
+    const double leftSpeed = vx * leftX + vy * leftY;
+    const double leftForce = sideForce(config.leftMotors, forwardSpeed + angularVelocity * trackWidth / 2);
+    const double rightForce = sideForce(config.rightMotors, forwardSpeed - angularVelocity * trackWidth / 2);
+
+    // the wheels grip the floor sideways, and scrub when the robot turns, as hard as the horizontal drift says
+    const double weight = config.mass * GRAVITY;
+    const double grip = config.horizontalDrift / 8 * weight;
+    const double rolling = config.rollingResistance * weight * std::tanh(forwardSpeed / STICTION_SPEED);
+    const double longitudinal = leftForce + rightForce - rolling;
+    const double lateral = std::clamp(-config.mass * leftSpeed / GRIP_TIME, -grip, grip);
+    const double scrub = grip * trackWidth / 8 * std::tanh(angularVelocity / STICTION_ANGULAR_SPEED);
+    const double torque = (leftForce - rightForce) * trackWidth / 2 - scrub;
+
+    // accelerate, then move at the new velocity
+    vx += (longitudinal * forwardX + lateral * leftX) / config.mass * dt;
+    vy += (longitudinal * forwardY + lateral * leftY) / config.mass * dt;
+    angularVelocity += torque / config.momentOfInertia * dt;
+    x += vx * dt;
+    y += vy * dt;
+    heading += angularVelocity * dt;
+
+    // the motors turn with the wheels
+    const double newForwardSpeed = vx * std::sin(heading) + vy * std::cos(heading);
+    const double newLeftSpeed = -vx * std::cos(heading) + vy * std::sin(heading);
+    double totalCurrent = 0;
+    auto moveSide = [&](const std::vector<int8_t>& ports, double speed) {
+        for (int8_t port : ports) {
+            MotorDevice* device = sim::motor(port);
+            if (device == nullptr) continue;
+            const MotorModel::Output& output = outputs[std::abs(port) - 1];
+            const double motorSpeed = sign(port) * speed / wheelRadius / gearRatio(config, *device);
+            motors[std::abs(port) - 1].step(*device, output, motorSpeed, dt);
+            totalCurrent += output.batteryCurrent;
+        }
+    };
+    moveSide(config.leftMotors, newForwardSpeed + angularVelocity * trackWidth / 2);
+    moveSide(config.rightMotors, newForwardSpeed - angularVelocity * trackWidth / 2);
+
+    // the other motors only turn a light load
+    for (int port = 1; port <= SMART_PORTS; port++) {
+        if (inDrivetrain(config, port)) continue;
+        MotorDevice& device = *sim::motor(port);
+        const MotorModel::Output output = motors[port - 1].update(device, freeSpeeds[port - 1], batteryVoltage);
+        const double inertia = MotorModel::stallTorque(device.gearing) / MotorModel::freeSpeed(device.gearing) *
+                               FREE_LOAD_TIME;
+        freeSpeeds[port - 1] += output.torque / inertia * dt;
+        motors[port - 1].step(device, output, freeSpeeds[port - 1], dt);
+        totalCurrent += output.batteryCurrent;
+    }
+
+    // tracking wheels measure how far the point they touch the floor rolls. Points right of and in front of the
+    // tracking center move backwards and to the right when the robot turns clockwise
+    std::normal_distribution<double> normal;
+    auto roll = [&](TrackingWheel& wheel, double speed) {
+        const double pointSpeed = speed - angularVelocity * wheel.config.offset * METERS_PER_INCH;
+        wheel.distance += pointSpeed * dt * (1 + config.noise.trackingWheelSlip * normal(random));
+        RotationDevice* device = sim::rotation(wheel.config.port);
+        if (device == nullptr) return;
+        // centidegrees per meter
+        const double scale = sign(wheel.config.port) * 36000 * wheel.config.gearRatio /
+                             (M_PI * wheel.config.diameter * METERS_PER_INCH);
+        device->position = static_cast<int32_t>(std::lround(wheel.distance * scale));
+        device->velocity = static_cast<int32_t>(std::lround(pointSpeed * scale));
+    };
+    for (TrackingWheel& wheel : verticalWheels) roll(wheel, newForwardSpeed);
+    for (TrackingWheel& wheel : horizontalWheels) roll(wheel, newLeftSpeed);
+
+    if (ImuDevice* imu = sim::imu(config.imuPort); config.imuPort != 0 && imu != nullptr) {
+        imuBias += config.noise.imuDrift * std::sqrt(dt) * normal(random);
+        const double turned = (heading * 180 / M_PI - config.start.theta) * (1 + config.noise.imuScale);
+        imu->yaw = turned + imuBias + config.noise.imuNoise * normal(random);
+        // clockwise, like the heading
+        imu->gyro.z = angularVelocity * 180 / M_PI;
+    }
+
+    battery.voltage = static_cast<int32_t>(std::lround(batteryVoltage * 1000));
+    battery.current = static_cast<int32_t>(std::lround(totalCurrent * 1000));
+    battery.capacity = std::max(0.0, battery.capacity - totalCurrent * dt / 3600 / BATTERY_CAPACITY * 100);
+    batteryCurrent = totalCurrent;
+}
+} // namespace sim
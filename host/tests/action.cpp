@@ -0,0 +1,123 @@
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "pros/rtos.hpp"
+#include "lemlib/auton/action.hpp"
+#include "sim/kernel.hpp"
+
+/**
+ * Test of autonomous actions on the host's PROS kernel, whose virtual clock makes the times the actions resume at
+ * exact.
+ *
+ * Checks that whenAll() waits for every action and whenAny() for the first one, cancelling the others, that sleeps
+ * and conditions resume in the order of their times, and that the same time resumes actions in the order they started
+ * waiting. Moved from actions have to finish immediately, whether they are awaited, started by whenAll() or
+ * whenAny(), or run by the scheduler. Exits with 1 if a check failed.
+ */
+namespace {
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    if (condition) return;
+    std::printf("FAILED: %s\n", what);
+    failures++;
+}
+
+/**
+ * @brief Something an action did, and when
+ */
+struct Event {
+        std::string name;
+        uint32_t time;
+
+        bool operator==(const Event&) const = default;
+};
+
+std::vector<Event> events;
+uint32_t start = 0;
+
+void record(const std::string& name) { events.push_back({name, pros::millis() - start}); }
+
+void expect(const std::vector<Event>& expected, const char* what) {
+    if (events != expected) {
+        for (const Event& event : events) std::printf("  %s at %u ms\n", event.name.c_str(), unsigned(event.time));
+    }
+    check(events == expected, what);
+    events.clear();
+}
+
+lemlib::Action mark(uint32_t delay, std::string name) {
+    co_await lemlib::sleep(delay);
+    record(name);
+}
+
+/**
+ * @brief Run an action with the scheduler in a task, and wait for it to finish
+ */
+void run(lemlib::Action (*routine)(), const char* what) {
+    pros::Task task([routine] {
+        start = pros::millis();
+        lemlib::scheduler().run(routine());
+    });
+    check(sim::run(pros::task_t(task), 10000) == sim::RunResult::FINISHED, what);
+}
+} // namespace
+
+int main() {
+    run(
+        []() -> lemlib::Action {
+            co_await lemlib::whenAll(mark(30, "slow"), mark(10, "fast"), mark(20, "middle"));
+            record("all");
+        },
+        "whenAll finishes");
+    expect({{"fast", 10}, {"middle", 20}, {"slow", 30}, {"all", 30}}, "whenAll waits for every action");
+
+    run(
+        []() -> lemlib::Action {
+            co_await lemlib::whenAny(mark(50, "slow"), mark(20, "fast"));
+            record("any");
+            // the slow action was cancelled, so it never records anything
+            co_await lemlib::sleep(50);
+        },
+        "whenAny finishes");
+    expect({{"fast", 20}, {"any", 20}}, "whenAny waits for the first action and cancels the others");
+
+    run(
+        []() -> lemlib::Action {
+            co_await lemlib::whenAll(mark(20, "first"), mark(20, "second"),
+                                     lemlib::waitUntil([] { return !events.empty(); }), mark(10, "earlier"));
+            record("all");
+        },
+        "equal timers finish");
+    expect({{"earlier", 10}, {"first", 20}, {"second", 20}, {"all", 20}},
+           "actions waiting for the same time resume in the order they started waiting");
+
+    run(
+        []() -> lemlib::Action {
+            lemlib::Action moved = mark(10, "moved");
+            lemlib::Action owner = std::move(moved);
+            co_await moved;
+            record("awaited");
+            co_await lemlib::whenAll(std::move(moved), mark(10, "all"));
+            co_await lemlib::whenAny(std::move(moved), mark(10, "any"));
+            record("whenAny");
+            co_await std::move(owner);
+        },
+        "moved from actions finish");
+    expect({{"awaited", 0}, {"all", 10}, {"whenAny", 10}, {"moved", 20}},
+           "moved from actions finish immediately, and the action they were moved to still runs");
+
+    run(
+        []() -> lemlib::Action {
+            lemlib::Action moved = mark(10, "moved");
+            lemlib::Action owner = std::move(moved);
+            return moved;
+        },
+        "the scheduler runs a moved from action");
+    expect({}, "the scheduler finishes a moved from action without running anything");
+
+    return failures == 0 ? 0 : 1;
+}
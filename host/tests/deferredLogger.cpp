@@ -0,0 +1,103 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "lemlib/logger/deferredLogger.hpp"
+#include "sim/kernel.hpp"
+
+/**
+ * Round trip test of LEMLIB_DEFERRED_LOG and tools/telemetryDecode.cpp.
+ *
+ * Logs messages with every type of argument, captures the frames the deferred logger sends on stdout to a file, then
+ * decodes the capture with the telemetry-decode tool, passed as the first argument, using the format strings in this
+ * program's own ELF file. Checks that every decoded line matches the message formatted with fmt on the host, that
+ * messages below the lowest level aren't sent, and that a message too large to pack is dropped and counted. Exits
+ * with 1 if a check failed.
+ */
+namespace {
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    if (condition) return;
+    // stdout is the capture
+    std::fprintf(stderr, "FAILED: %s\n", what);
+    failures++;
+}
+
+std::vector<std::string> expected;
+
+/**
+ * @brief Log a message, and remember the line the decoder should print for it
+ */
+#define LOG_AND_EXPECT(level, levelName, text, ...)                                                                   \
+    do {                                                                                                               \
+        expected.push_back(fmt::format("[{}] {}: " text, pros::millis(), levelName __VA_OPT__(, ) __VA_ARGS__));      \
+        LEMLIB_DEFERRED_LOG(level, text __VA_OPT__(, ) __VA_ARGS__);                                                   \
+    } while (0)
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <telemetry-decode>\n", argv[0]);
+        return 1;
+    }
+    char directory[] = "/tmp/deferredLogger-test-XXXXXX";
+    if (mkdtemp(directory) == nullptr) {
+        std::perror("mkdtemp");
+        return 1;
+    }
+    const std::string capture = std::string(directory) + "/capture.bin";
+    // binary telemetry is written to stdout, so send it to the capture file
+    if (std::freopen(capture.c_str(), "wb", stdout) == nullptr) {
+        std::perror(capture.c_str());
+        return 1;
+    }
+
+    LOG_AND_EXPECT(lemlib::Level::INFO, "INFO", "no arguments");
+    LOG_AND_EXPECT(lemlib::Level::WARN, "WARN", "ints: {} {} {} {}", -7, 42u, -(int64_t(1) << 40),
+                   uint64_t(1) << 63);
+    LOG_AND_EXPECT(lemlib::Level::ERROR, "ERROR", "floats: {:.2f} {} {:.4f}", 3.14159f, 0.5, -2.0f / 3);
+    LOG_AND_EXPECT(lemlib::Level::FATAL, "FATAL", "bool {} {} char {}", true, false, 'x');
+    LOG_AND_EXPECT(lemlib::Level::WARN, "WARN", "strings: '{}' '{}' '{}'", "literal", std::string("owned"), "");
+    sim::run(nullptr, 50);
+    LOG_AND_EXPECT(lemlib::Level::INFO, "INFO", "after the logger's task ran: {}", pros::millis());
+    // messages below the lowest level aren't sent
+    lemlib::deferredLogger().setLowestLevel(lemlib::Level::WARN);
+    LEMLIB_DEFERRED_LOG(lemlib::Level::INFO, "filtered: {}", 1);
+    // a message that doesn't fit in MAX_MESSAGE is dropped
+    const uint32_t dropped = lemlib::deferredLogger().getDropped();
+    LEMLIB_DEFERRED_LOG(lemlib::Level::WARN, "too large: {} {}", std::string(100, 'a'), std::string(100, 'b'));
+    check(lemlib::deferredLogger().getDropped() == dropped + 1, "a message too large to pack is counted as dropped");
+    sim::run(nullptr, 50);
+    std::fflush(stdout);
+
+    char self[4096];
+    const ssize_t length = readlink("/proc/self/exe", self, sizeof(self) - 1);
+    if (length < 0) {
+        std::perror("readlink");
+        return 1;
+    }
+    self[length] = '\0';
+    const std::string command = std::string(argv[1]) + " -e " + self + " " + capture + " " + directory + " >/dev/null";
+    check(std::system(command.c_str()) == 0, "telemetry-decode succeeds");
+
+    std::ifstream log(std::string(directory) + "/log.txt");
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(log, line);) lines.push_back(line);
+    check(lines.size() == expected.size(), "every message that was logged is decoded");
+    for (size_t i = 0; i < lines.size() && i < expected.size(); i++) {
+        if (lines[i] == expected[i]) continue;
+        std::fprintf(stderr, "decoded:  %s\nexpected: %s\n", lines[i].c_str(), expected[i].c_str());
+        check(false, "decoded messages match the messages formatted on the host");
+    }
+
+    std::filesystem::remove_all(directory);
+    std::fprintf(stderr, "%zu messages decoded\n", lines.size());
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "pros/rtos.hpp"
+#include "lemlib/logger/lockFreeBuffer.hpp"
+#include "lemlib/logger/ringBuffer.hpp"
+#include "sim/kernel.hpp"
+
+/**
+ * Stress test of RingBuffer and LockFreeBuffer with several producers pushing at once.
+ *
+ * RingBuffer is pushed to from host threads, which really do run at the same time, with the policies that drop
+ * messages. BLOCK waits with pros::delay(), which only blocks tasks, so it's left out. A consumer thread checks that
+ * no message is lost or corrupted, and that the messages of each producer come out in the order they were pushed.
+ * LockFreeBuffer is pushed to from tasks on the host's PROS kernel, faster than its task can send them on, so it
+ * overflows. Both print the latency percentiles, from push to pop, of the messages that got through. Exits with 1 if
+ * a check failed. A livelock hangs it, so ctest's timeout fails it.
+ */
+namespace {
+constexpr int PRODUCERS = 4;
+
+/**
+ * @brief What each message holds
+ */
+struct Message {
+        uint32_t producer;
+        uint32_t sequence;
+        /** when it was pushed, in nanoseconds for threads and microseconds for tasks */
+        int64_t time;
+};
+
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    if (condition) return;
+    std::printf("FAILED: %s\n", what);
+    failures++;
+}
+
+/**
+ * @brief Checks the messages popped from a buffer
+ */
+struct Receiver {
+        uint32_t received = 0;
+        bool ordered = true;
+        bool intact = true;
+        std::vector<int64_t> latencies;
+        std::vector<int64_t> next = std::vector<int64_t>(PRODUCERS, 0);
+
+        void receive(const char* data, size_t size, int64_t now) {
+            Message message;
+            if (size != sizeof(message)) {
+                intact = false;
+                return;
+            }
+            std::memcpy(&message, data, sizeof(message));
+            if (message.producer >= PRODUCERS) {
+                intact = false;
+                return;
+            }
+            // messages can be dropped, but never reordered
+            if (message.sequence < next[message.producer]) ordered = false;
+            next[message.producer] = int64_t(message.sequence) + 1;
+            latencies.push_back(now - message.time);
+            received++;
+        }
+
+        void print(const char* name, const char* unit, double scale) {
+            std::sort(latencies.begin(), latencies.end());
+            auto percentile = [&](double p) {
+                return latencies.empty() ? 0 : latencies[size_t(p * (latencies.size() - 1))] * scale;
+            };
+            std::printf("%-26s received %7u  latency %s: p50 %8.1f  p99 %8.1f  p99.9 %8.1f  max %8.1f\n", name,
+                        received, unit, percentile(0.5), percentile(0.99), percentile(0.999), percentile(1));
+        }
+};
+
+int64_t nanoseconds() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/**
+ * @brief Push from threads to a RingBuffer while a thread pops from it
+ */
+void stressRingBuffer(const char* name, lemlib::OverflowPolicy policy) {
+    constexpr uint32_t COUNT = 50000;
+    lemlib::RingBuffer buffer(64, sizeof(Message), policy);
+    std::atomic<int> running = PRODUCERS;
+    std::vector<std::thread> producers;
+    for (int i = 0; i < PRODUCERS; i++) {
+        producers.emplace_back([&, i] {
+            for (uint32_t sequence = 0; sequence < COUNT; sequence++) {
+                const Message message {uint32_t(i), sequence, nanoseconds()};
+                buffer.push(std::string_view(reinterpret_cast<const char*>(&message), sizeof(message)));
+                // let the other threads run between bursts, even on a single core
+                if (sequence % 16 == 15) std::this_thread::yield();
+            }
+            running--;
+        });
+    }
+
+    Receiver receiver;
+    char data[sizeof(Message)];
+    size_t size;
+    while (running > 0 || !buffer.empty()) {
+        if (buffer.pop(data, &size)) receiver.receive(data, size, nanoseconds());
+    }
+    for (std::thread& producer : producers) producer.join();
+    while (buffer.pop(data, &size)) receiver.receive(data, size, nanoseconds());
+
+    receiver.print(name, "us", 1e-3);
+    check(receiver.intact, "messages are intact");
+    check(receiver.ordered, "each producer's messages are in order");
+    check(receiver.received + buffer.getDropped() == PRODUCERS * COUNT, "every message is received or dropped");
+}
+
+/**
+ * @brief Push from tasks to a LockFreeBuffer faster than it sends them on
+ */
+void stressLockFreeBuffer() {
+    constexpr uint32_t COUNT = 2000;
+    constexpr size_t SLOTS = 64;
+    constexpr uint32_t RATE = 1;
+    Receiver receiver;
+    lemlib::LockFreeBuffer buffer(
+        [&](std::string_view message) { receiver.receive(message.data(), message.size(), pros::micros()); }, SLOTS,
+        sizeof(Message));
+    buffer.setRate(RATE);
+
+    // tasks of different priorities, each pushing two messages a millisecond
+    std::vector<pros::Task> producers;
+    for (int i = 0; i < PRODUCERS; i++) {
+        producers.emplace_back([&buffer, i] {
+            for (uint32_t sequence = 0; sequence < COUNT; sequence++) {
+                const Message message {uint32_t(i), sequence, int64_t(pros::micros())};
+                buffer.pushToBuffer(std::string_view(reinterpret_cast<const char*>(&message), sizeof(message)));
+                if (sequence % 2 == 1) pros::delay(1);
+            }
+        }, TASK_PRIORITY_DEFAULT + i);
+    }
+    for (pros::Task& producer : producers) sim::run(pros::task_t(producer), COUNT * 2);
+    // let it send what is left
+    sim::run(nullptr, SLOTS * RATE * 2);
+
+    receiver.print("LockFreeBuffer DROP_OLDEST", "ms", 1e-3);
+    check(receiver.intact, "messages are intact");
+    check(receiver.ordered, "each producer's messages are in order");
+    check(buffer.buffersEmpty(), "the buffer is sent in full");
+    check(receiver.received + buffer.getDropped() == PRODUCERS * COUNT, "every message is received or dropped");
+    // a message waits at most for the messages ahead of it
+    check(receiver.latencies.back() <= int64_t(SLOTS * RATE * 1000), "no message waits for more than a full buffer");
+}
+} // namespace
+
+int main() {
+    stressRingBuffer("RingBuffer DROP_OLDEST", lemlib::OverflowPolicy::DROP_OLDEST);
+    stressRingBuffer("RingBuffer DROP_NEWEST", lemlib::OverflowPolicy::DROP_NEWEST);
+    stressLockFreeBuffer();
+    return failures == 0 ? 0 : 1;
+}
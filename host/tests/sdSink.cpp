@@ -0,0 +1,113 @@
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "lemlib/logger/sdSink.hpp"
+#include "sim/kernel.hpp"
+
+/**
+ * Test of SdSink with several host threads logging at once, which really do run at the same time, to a temporary
+ * directory.
+ *
+ * The buffers are small, so producers keep racing to reserve space in the current buffer and to switch to the next
+ * one, and the files are small, so the sink starts new ones. Checks that every line in the files is whole, that the
+ * files hold exactly the bytes the sink says it wrote, that every message was either written or counted as dropped,
+ * and that the messages of each producer are in the order they were logged. Exits with 1 if a check failed.
+ */
+namespace {
+constexpr int PRODUCERS = 4;
+constexpr uint32_t COUNT = 20000;
+
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    if (condition) return;
+    std::printf("FAILED: %s\n", what);
+    failures++;
+}
+
+/**
+ * @brief Padding of a message, so messages have different lengths and reservations don't line up with the ends of
+ * buffers
+ */
+std::string padding(int producer, uint32_t sequence) { return std::string(sequence % (producer * 7 + 3), '.'); }
+} // namespace
+
+int main() {
+    char directory[] = "/tmp/sdSink-test-XXXXXX";
+    if (mkdtemp(directory) == nullptr) {
+        std::perror("mkdtemp");
+        return 1;
+    }
+
+    auto sink = std::make_unique<lemlib::SdSink>(std::string(directory) + "/log", lemlib::SdSink::BLOCK_SIZE, 4,
+                                                 64 * 1024);
+    std::atomic<int> running = PRODUCERS;
+    std::vector<std::thread> producers;
+    for (int i = 0; i < PRODUCERS; i++) {
+        producers.emplace_back([&, i] {
+            for (uint32_t sequence = 0; sequence < COUNT; sequence++) {
+                sink->warn("producer {} message {} {}", i, sequence, padding(i, sequence));
+                // let the writer run between bursts, even on a single core
+                if (sequence % 16 == 15) std::this_thread::yield();
+            }
+            running--;
+        });
+    }
+    // the writer task only runs while the kernel does
+    while (running > 0) sim::run(nullptr, 10);
+    for (std::thread& producer : producers) producer.join();
+    sink->flush();
+    sim::run(nullptr, 100);
+    const uint32_t bytesWritten = sink->getBytesWritten();
+    const uint32_t dropped = sink->getDropped();
+    check(sink->getBuffersDropped() == 0, "no buffer fails to be written");
+    sink.reset();
+
+    // read the files back in order
+    uint32_t bytesRead = 0;
+    uint32_t received = 0;
+    int files = 0;
+    bool whole = true;
+    bool ordered = true;
+    std::vector<int64_t> next(PRODUCERS, 0);
+    for (;; files++) {
+        char path[256];
+        std::snprintf(path, sizeof(path), "%s/log_%03d.txt", directory, files);
+        std::ifstream file(path, std::ios::binary);
+        if (!file) break;
+        bytesRead += std::filesystem::file_size(path);
+        std::string line;
+        while (std::getline(file, line)) {
+            int producer;
+            unsigned sequence;
+            int end = 0;
+            if (std::sscanf(line.c_str(), "[%*d] WARN: producer %d message %u %n", &producer, &sequence, &end) != 2 ||
+                producer < 0 || producer >= PRODUCERS || line.substr(end) != padding(producer, sequence)) {
+                whole = false;
+                continue;
+            }
+            // messages can be dropped, but never reordered
+            if (sequence < next[producer]) ordered = false;
+            next[producer] = int64_t(sequence) + 1;
+            received++;
+        }
+    }
+    std::filesystem::remove_all(directory);
+
+    std::printf("%d files, %u bytes, %u messages written, %u dropped\n", files, bytesRead, received, dropped);
+    check(files > 1, "the sink starts new files");
+    check(whole, "every line is whole");
+    check(bytesRead == bytesWritten, "the files hold every byte the sink wrote");
+    check(ordered, "each producer's messages are in order");
+    check(received + dropped == PRODUCERS * COUNT, "every message is written or dropped");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,242 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "batch/cmaes.hpp"
+#include "batch/run.hpp"
+#include "batch/threadPool.hpp"
+
+/**
+ * Tunes the chassis' lateral and angular lemlib::ControllerSettings, every field of them, against simulated step
+ * responses (robot --steps), and prints the best settings as constructors to paste into main.cpp.
+ *
+ * Usage: tune [--generations <count>] [--population <count>] [--jobs <threads>] [--seed <seed>] [--sigma <fraction>]
+ *
+ * The search is CMA-ES, over each field scaled to the range it might sensibly be in, starting from the settings in
+ * main.cpp. A generation's candidates run in parallel, each in its own process. Every candidate runs with the same
+ * sensor noise, from --seed, so that their costs differ only because of their settings.
+ *
+ * The cost of a run is the sum over the steps of the time the robot took to settle, plus a penalty for how far it
+ * overshot, and penalties for not settling and for motions that time out. Loose exit conditions end motions early, but
+ * leave the robot outside the tolerance, and tight ones make the motions wait, so the cost tunes those too.
+ */
+namespace {
+// penalty for overshooting, in seconds per inch and per degree
+constexpr double DRIVE_OVERSHOOT_COST = 0.2;
+constexpr double TURN_OVERSHOOT_COST = 0.05;
+// penalty for a step that doesn't settle, and for a motion that times out, in seconds
+constexpr double UNSETTLED_COST = 1;
+constexpr double TIMEOUT_COST = 2;
+// cost of a run that failed
+constexpr double FAILED_COST = 1e6;
+// penalty for a candidate outside the bounds, per unit of its squared distance from them
+constexpr double BOUNDS_COST = 100;
+
+/**
+ * @brief A field of lemlib::ControllerSettings
+ */
+struct Field {
+        /** the comment main.cpp puts next to it */
+        const char* comment;
+        /** range the search covers. A negative upper bound is relative to the field's value in main.cpp */
+        double lower;
+        double upper;
+        /** whether the field is a time, which is printed as a whole number of milliseconds */
+        bool milliseconds;
+};
+
+// in the order of the constructor's parameters
+constexpr Field FIELDS[] = {{"proportional gain (kP)", 0, -4, false},
+                            {"integral gain (kI)", 0, -4, false},
+                            {"derivative gain (kD)", 0, -4, false},
+                            {"anti windup", 0, 10, false},
+                            {"small error range", 0.1, 5, false},
+                            {"small error range timeout, in milliseconds", 0, 500, true},
+                            {"large error range", 0.5, 10, false},
+                            {"large error range timeout, in milliseconds", 0, 1500, true},
+                            {"maximum acceleration (slew)", 0, 127, false}};
+constexpr size_t FIELD_COUNT = std::size(FIELDS);
+
+struct Options {
+        unsigned generations = 60;
+        unsigned population = 0;
+        unsigned jobs = 0;
+        uint64_t seed = 1;
+        double sigma = 0.15;
+};
+
+/**
+ * @brief Range of each parameter the search covers, for the lateral then the angular settings
+ */
+struct Bounds {
+        std::vector<double> lower;
+        std::vector<double> upper;
+};
+
+int usage(const char* program) {
+    std::fprintf(stderr,
+                 "usage: %s [--generations <count>] [--population <count>] [--jobs <threads>] [--seed <seed>] "
+                 "[--sigma <fraction>]\n",
+                 program);
+    return 2;
+}
+
+Bounds bounds(const std::vector<double>& initial) {
+    Bounds bounds;
+    for (size_t i = 0; i < initial.size(); i++) {
+        const Field& field = FIELDS[i % FIELD_COUNT];
+        bounds.lower.push_back(field.lower);
+        // gains are searched up to a few times what they are now, or up to 1 if they're 0
+        bounds.upper.push_back(field.upper >= 0 ? field.upper : std::max(-field.upper * initial[i], 1.0));
+    }
+    return bounds;
+}
+
+// settings from a point in the search, which has each parameter scaled to 0 to 1 over its bounds
+std::vector<double> settings(const Bounds& bounds, const std::vector<double>& point) {
+    std::vector<double> settings;
+    for (size_t i = 0; i < point.size(); i++) {
+        double value = bounds.lower[i] + std::clamp(point[i], 0.0, 1.0) * (bounds.upper[i] - bounds.lower[i]);
+        if (FIELDS[i % FIELD_COUNT].milliseconds) value = std::round(value);
+        settings.push_back(value);
+    }
+    return settings;
+}
+
+std::string join(const double* values) {
+    std::string text;
+    for (size_t i = 0; i < FIELD_COUNT; i++) {
+        char value[32];
+        std::snprintf(value, sizeof(value), "%s%.6g", i == 0 ? "" : ",", values[i]);
+        text += value;
+    }
+    return text;
+}
+
+std::vector<std::string> arguments(const Options& options, const std::vector<double>& settings) {
+    return {"--steps",   "--seed", std::to_string(options.seed), "--lateral", join(settings.data()),
+            "--angular", join(settings.data() + FIELD_COUNT)};
+}
+
+double cost(const batch::RunResult& result) {
+    if (!result.ok || result.steps.empty()) return FAILED_COST;
+    double cost = 0;
+    for (const batch::StepResult& step : result.steps) {
+        cost += step.settle + step.overshoot * (step.turn ? TURN_OVERSHOOT_COST : DRIVE_OVERSHOOT_COST);
+        if (!step.settled) cost += UNSETTLED_COST;
+        if (step.timedOut) cost += TIMEOUT_COST;
+    }
+    return cost;
+}
+
+// cost of a candidate, with a penalty for how far outside the bounds it is
+double boundsCost(const std::vector<double>& point) {
+    double cost = 0;
+    for (double value : point) {
+        const double outside = value - std::clamp(value, 0.0, 1.0);
+        cost += BOUNDS_COST * outside * outside;
+    }
+    return cost;
+}
+
+void printSteps(const batch::RunResult& result) {
+    for (const batch::StepResult& step : result.steps) {
+        std::printf("    %-5s %6g: settled in %.3f s, overshoot %.3f, error %.3f%s%s\n", step.turn ? "turn" : "drive",
+                    step.amount, step.settle, step.overshoot, step.error, step.settled ? "" : ", not settled",
+                    step.timedOut ? ", timed out" : "");
+    }
+}
+
+// print settings the way main.cpp constructs them
+void printConstructor(const char* comment, const char* name, const double* values) {
+    std::printf("// %s\n", comment);
+    const std::string start = "lemlib::ControllerSettings " + std::string(name) + "(";
+    for (size_t i = 0; i < FIELD_COUNT; i++) {
+        char value[32];
+        if (FIELDS[i].milliseconds) std::snprintf(value, sizeof(value), "%.0f", values[i]);
+        else std::snprintf(value, sizeof(value), "%.4g", values[i]);
+        std::printf("%*s%s%s // %s\n", i == 0 ? 0 : static_cast<int>(start.size()), i == 0 ? start.c_str() : "",
+                    value, i + 1 < FIELD_COUNT ? "," : "", FIELDS[i].comment);
+    }
+    std::printf(");\n");
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--generations") == 0 && hasValue) {
+            options.generations = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--population") == 0 && hasValue) {
+            options.population = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--jobs") == 0 && hasValue) {
+            options.jobs = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--sigma") == 0 && hasValue) {
+            options.sigma = std::strtod(argv[++i], nullptr);
+        } else {
+            return usage(argv[0]);
+        }
+    }
+
+    // the settings in main.cpp
+    const batch::RunResult baseline = batch::run({"--steps", "--seed", std::to_string(options.seed)});
+    if (!baseline.ok || baseline.lateralSettings.size() != FIELD_COUNT ||
+        baseline.angularSettings.size() != FIELD_COUNT) {
+        std::fprintf(stderr, "the run with the current settings failed. Does %s run?\n", batch::robotPath().c_str());
+        return 1;
+    }
+    std::vector<double> initial = baseline.lateralSettings;
+    initial.insert(initial.end(), baseline.angularSettings.begin(), baseline.angularSettings.end());
+    const Bounds range = bounds(initial);
+    std::vector<double> start;
+    for (size_t i = 0; i < initial.size(); i++) {
+        start.push_back(std::clamp((initial[i] - range.lower[i]) / (range.upper[i] - range.lower[i]), 0.0, 1.0));
+    }
+
+    batch::CmaEs search(start, options.sigma, options.seed, options.population);
+    batch::ThreadPool pool(options.jobs);
+    std::fprintf(stderr, "current settings cost %.3f. Searching with %u candidates per generation, on %u threads\n",
+                 cost(baseline), search.getPopulationSize(), pool.size());
+    std::vector<double> best = initial;
+    batch::RunResult bestResult = baseline;
+    double bestCost = cost(baseline);
+    for (unsigned generation = 0; generation < options.generations; generation++) {
+        const std::vector<std::vector<double>>& candidates = search.ask();
+        std::vector<batch::RunResult> results(candidates.size());
+        std::vector<double> costs(candidates.size());
+        for (size_t i = 0; i < candidates.size(); i++) {
+            pool.submit([&, i] {
+                results[i] = batch::run(arguments(options, settings(range, candidates[i])));
+                costs[i] = cost(results[i]) + boundsCost(candidates[i]);
+            });
+        }
+        pool.wait();
+        const size_t winner = std::min_element(costs.begin(), costs.end()) - costs.begin();
+        // only candidates inside the bounds are actually what was run
+        if (costs[winner] < bestCost && boundsCost(candidates[winner]) == 0) {
+            bestCost = costs[winner];
+            best = settings(range, candidates[winner]);
+            bestResult = results[winner];
+        }
+        search.tell(costs);
+        std::fprintf(stderr, "generation %u: best %.3f this generation, %.3f overall, step size %.4f\n", generation,
+                     costs[winner], bestCost, search.getSigma());
+    }
+
+    std::printf("current settings: cost %.3f\n", cost(baseline));
+    printSteps(baseline);
+    std::printf("tuned settings: cost %.3f\n", bestCost);
+    printSteps(bestResult);
+    std::printf("\n");
+    printConstructor("lateral motion controller", "linearController", best.data());
+    std::printf("\n");
+    printConstructor("angular motion controller", "angularController", best.data() + FIELD_COUNT);
+    return 0;
+}
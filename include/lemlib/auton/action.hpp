@@ -0,0 +1,358 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <utility>
+
+#include "pros/rtos.hpp"
+#include "lemlib/chassis/chassis.hpp"
+
+namespace lemlib {
+/**
+ * @brief A step of an autonomous routine, written as a coroutine
+ *
+ * An action is any function that returns Action and uses co_await. It can wait for time to pass, for a condition, for
+ * a chassis motion, or for other actions, and other actions keep running while it waits. Actions don't start until
+ * they are awaited or run by the Scheduler, and destroying an action cancels it.
+ *
+ * @b Example
+ * @code {.cpp}
+ * lemlib::Action scoreBlocks() {
+ *     intake.move(127);
+ *     co_await lemlib::sleep(1000);
+ *     intake.move(0);
+ * }
+ *
+ * lemlib::Action skills() {
+ *     // drive to the goal while scoring
+ *     co_await lemlib::whenAll(lemlib::motion(chassis, [] { chassis.moveToPoint(0, 48, 2000, {}, true); }),
+ *                              scoreBlocks());
+ *     // wait for the distance sensor to see a block, for at most 2 seconds
+ *     co_await lemlib::whenAny(lemlib::waitUntil([] { return distance.get() < 50; }), lemlib::sleep(2000));
+ * }
+ *
+ * void autonomous() { lemlib::scheduler().run(skills()); }
+ * @endcode
+ */
+class Action {
+    public:
+        struct promise_type;
+        using Handle = std::coroutine_handle<promise_type>;
+
+        /**
+         * @brief Tracks the children of whenAll() and whenAny()
+         */
+        struct Join {
+                /** children that have to finish, plus 1 while the children are being started */
+                size_t remaining;
+                /** the coroutine waiting for the children */
+                std::coroutine_handle<> parent = nullptr;
+
+                /**
+                 * @brief Record that a child finished
+                 *
+                 * @return true if the parent should be resumed
+                 */
+                bool finish() { return remaining > 0 && --remaining == 0; }
+
+                // awaited by the parent once every child is started
+                bool await_ready() { return finish(); }
+
+                void await_suspend(std::coroutine_handle<> awaiting) { parent = awaiting; }
+
+                void await_resume() const {}
+        };
+
+        /**
+         * @brief Resumes whatever is waiting for the action when it finishes
+         */
+        struct FinalAwaiter {
+                bool await_ready() const noexcept { return false; }
+
+                std::coroutine_handle<> await_suspend(Handle handle) noexcept {
+                    promise_type& promise = handle.promise();
+                    promise.finished = true;
+                    if (promise.continuation) return promise.continuation;
+                    if (promise.join != nullptr && promise.join->finish() && promise.join->parent) {
+                        return promise.join->parent;
+                    }
+                    return std::noop_coroutine();
+                }
+
+                void await_resume() const noexcept {}
+        };
+
+        struct promise_type {
+                std::coroutine_handle<> continuation = nullptr;
+                Join* join = nullptr;
+                bool finished = false;
+
+                Action get_return_object() { return Action(Handle::from_promise(*this)); }
+
+                std::suspend_always initial_suspend() noexcept { return {}; }
+
+                FinalAwaiter final_suspend() noexcept { return {}; }
+
+                void return_void() {}
+
+                void unhandled_exception() { std::terminate(); }
+        };
+
+        Action(Action&& other) noexcept
+            : handle(std::exchange(other.handle, nullptr)) {}
+
+        Action& operator=(Action&& other) noexcept {
+            if (this != &other) {
+                if (handle) handle.destroy();
+                handle = std::exchange(other.handle, nullptr);
+            }
+            return *this;
+        }
+
+        Action(const Action&) = delete;
+        Action& operator=(const Action&) = delete;
+
+        /**
+         * @brief Destroy the action, cancelling it if it is still running
+         */
+        ~Action() {
+            if (handle) handle.destroy();
+        }
+
+        /**
+         * @brief Whether the action has finished
+         *
+         * @return true if it finished
+         */
+        bool done() const { return !handle || handle.promise().finished; }
+
+        /**
+         * @brief Start the action without waiting for it
+         *
+         * An action that was moved from, or has already finished, finishes immediately.
+         *
+         * @param join the join to notify when the action finishes
+         */
+        void start(Join* join) {
+            if (done()) {
+                if (join != nullptr && join->finish() && join->parent) join->parent.resume();
+                return;
+            }
+            handle.promise().join = join;
+            handle.resume();
+        }
+
+        bool await_ready() const { return done(); }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) {
+            // a moved from action has nothing to run, so the awaiting coroutine continues
+            if (!handle) return awaiting;
+            handle.promise().continuation = awaiting;
+            return handle;
+        }
+
+        void await_resume() const {}
+    private:
+        explicit Action(Handle handle)
+            : handle(handle) {}
+
+        Handle handle;
+};
+
+/**
+ * @brief Base of everything an action can wait for that the scheduler has to check
+ *
+ * While an action waits, its awaiter is in the scheduler's list of waiting awaiters. The awaiter is part of the
+ * action's coroutine frame, so waiting does not allocate. If the action is cancelled while it waits, the awaiter
+ * removes itself from the list.
+ */
+class ScheduledAwaiter {
+    public:
+        ScheduledAwaiter() = default;
+        ScheduledAwaiter(const ScheduledAwaiter&) = delete;
+        ScheduledAwaiter& operator=(const ScheduledAwaiter&) = delete;
+
+        /**
+         * @brief Remove the awaiter from the scheduler if it is still waiting
+         */
+        virtual ~ScheduledAwaiter();
+
+        /**
+         * @brief Whether the action can continue
+         *
+         * @return true if it can continue
+         */
+        virtual bool ready() = 0;
+
+        bool await_ready() { return ready(); }
+
+        void await_suspend(std::coroutine_handle<> awaiting);
+
+        void await_resume() const {}
+    private:
+        friend class Scheduler;
+
+        std::coroutine_handle<> handle = nullptr;
+        ScheduledAwaiter* previous = nullptr;
+        ScheduledAwaiter* next = nullptr;
+        bool waiting = false;
+};
+
+/**
+ * @brief Runs actions
+ *
+ * The scheduler runs in the task that calls run(), normally the autonomous task, so actions don't need any tasks of
+ * their own. Every tick it resumes the actions whose awaiters are ready, one after the other.
+ */
+class Scheduler {
+    public:
+        /**
+         * @brief Construct a new Scheduler
+         *
+         * @param tickPeriod how often waiting actions are checked, in milliseconds
+         */
+        Scheduler(uint32_t tickPeriod = 10);
+
+        /**
+         * @brief Run an action until it finishes. Blocks the calling task
+         *
+         * Actions left waiting by a run that never finished, like one in an autonomous task that was stopped by the
+         * competition switch, are dropped first.
+         *
+         * @param action the action to run
+         */
+        void run(Action action);
+
+        /**
+         * @brief Resume every waiting action that can continue
+         */
+        void update();
+    private:
+        friend class ScheduledAwaiter;
+
+        /**
+         * @brief Add an awaiter to the end of the waiting list
+         */
+        void add(ScheduledAwaiter* awaiter);
+
+        /**
+         * @brief Remove an awaiter from the waiting list
+         */
+        void remove(ScheduledAwaiter* awaiter);
+
+        const uint32_t tickPeriod;
+        ScheduledAwaiter* head = nullptr;
+        ScheduledAwaiter* tail = nullptr;
+};
+
+/**
+ * @brief Get the scheduler
+ *
+ * @return Scheduler&
+ */
+Scheduler& scheduler();
+
+/**
+ * @brief Waits until a point in time
+ */
+class SleepAwaiter : public ScheduledAwaiter {
+    public:
+        /**
+         * @param duration time to wait, in milliseconds
+         */
+        explicit SleepAwaiter(uint32_t duration)
+            : end(pros::millis() + duration) {}
+
+        bool ready() override { return int32_t(pros::millis() - end) >= 0; }
+    private:
+        const uint32_t end;
+};
+
+/**
+ * @brief Waits until a predicate returns true
+ */
+template <typename Predicate> class ConditionAwaiter : public ScheduledAwaiter {
+    public:
+        explicit ConditionAwaiter(Predicate predicate)
+            : predicate(std::move(predicate)) {}
+
+        bool ready() override { return predicate(); }
+    private:
+        Predicate predicate;
+};
+
+/**
+ * @brief Wait for some time without blocking other actions
+ *
+ * @param duration time to wait, in milliseconds
+ * @return Action
+ */
+inline Action sleep(uint32_t duration) { co_await SleepAwaiter(duration); }
+
+/**
+ * @brief Wait until a condition is true without blocking other actions
+ *
+ * The condition is checked once per scheduler tick.
+ *
+ * @param predicate function returning true once the action should continue
+ * @return Action
+ */
+template <typename Predicate> Action waitUntil(Predicate predicate) {
+    co_await ConditionAwaiter<Predicate>(std::move(predicate));
+}
+
+/**
+ * @brief Run a chassis motion
+ *
+ * Waits until the chassis is free so starting the motion doesn't block the scheduler, starts the motion, and finishes
+ * when the motion does. Cancelling the action cancels the motion.
+ *
+ * @param chassis the chassis to move
+ * @param start function that starts the motion. It must use async = true
+ * @return Action
+ */
+template <typename Start> Action motion(Chassis& chassis, Start start) {
+    co_await ConditionAwaiter([&chassis] { return !chassis.isInMotion(); });
+    start();
+    // cancels the motion if the action is destroyed before it finishes
+    struct MotionGuard {
+            Chassis& chassis;
+            bool finished = false;
+
+            ~MotionGuard() {
+                if (!finished) chassis.cancelMotion();
+            }
+    } guard {chassis};
+    co_await ConditionAwaiter([&chassis] { return !chassis.isInMotion(); });
+    guard.finished = true;
+}
+
+/**
+ * @brief Run actions at the same time and wait for all of them to finish
+ *
+ * @param actions the actions to run
+ * @return Action
+ */
+template <typename... Actions> Action whenAll(Actions... actions) {
+    Action::Join join {sizeof...(Actions) + 1};
+    (actions.start(&join), ...);
+    co_await join;
+}
+
+/**
+ * @brief Run actions at the same time and wait for the first one to finish
+ *
+ * The other actions are cancelled. Actions after one that finishes immediately are not started.
+ *
+ * @param actions the actions to run
+ * @return Action
+ */
+template <typename... Actions> Action whenAny(Actions... actions) {
+    Action::Join join {2};
+    ((join.remaining == 2 ? actions.start(&join) : void()), ...);
+    co_await join;
+    // the actions that are still running are cancelled when this action is destroyed, along with its parameters
+}
+} // namespace lemlib
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "pros/misc.hpp"
+#include "pros/rtos.hpp"
+#include "lemlib/profiling/scopeTimer.hpp"
+
+namespace lemlib {
+/**
+ * @brief The state of a controller, published each time it changes
+ */
+struct ControllerFrame {
+        int8_t leftX = 0;
+        int8_t leftY = 0;
+        int8_t rightX = 0;
+        int8_t rightY = 0;
+        /** held buttons, bit (button - E_CONTROLLER_DIGITAL_L1) for each button */
+        uint16_t buttons = 0;
+        /** buttons pressed since the subscriber's previous frame, same layout as buttons */
+        uint16_t newPresses = 0;
+        /** when the change was detected, in microseconds */
+        uint32_t time = 0;
+        /** number of the frame, starting from 1 */
+        uint32_t sequence = 0;
+
+        /**
+         * @brief Whether a button is held
+         *
+         * @param button the button
+         * @return true if it is held
+         */
+        bool held(pros::controller_digital_e_t button) const { return buttons & bit(button); }
+
+        /**
+         * @brief Whether a button was pressed since the previous frame the subscriber received
+         *
+         * Unlike pros::Controller::get_digital_new_press(), presses are never lost if the subscriber is slow.
+         *
+         * @param button the button
+         * @return true if it was pressed
+         */
+        bool newPress(pros::controller_digital_e_t button) const { return newPresses & bit(button); }
+
+        /**
+         * @brief Get the bit of a button
+         */
+        static constexpr uint16_t bit(pros::controller_digital_e_t button) {
+            return 1 << (button - pros::E_CONTROLLER_DIGITAL_L1);
+        }
+};
+
+/**
+ * @brief Publishes controller frames to the tasks waiting for them
+ *
+ * A high priority task reads the controller every poll period and publishes a new frame only if a stick or button
+ * changed. Subscribed tasks block in waitForFrame() and are woken with a task notification when a frame is published,
+ * so they run right after a change instead of on their own fixed period, and don't run at all while the driver
+ * doesn't touch the controller.
+ *
+ * The brain receives controller data less often than it is polled, so the time of a frame is at most one poll period
+ * after the data arrived. Subscribers call markApplied() once they have sent motor commands for a frame, which records
+ * the latency from the change being detected to the motors being commanded.
+ *
+ * @b Example
+ * @code {.cpp}
+ * while (true) {
+ *     const lemlib::ControllerFrame frame = lemlib::controllerInput().waitForFrame();
+ *     chassis.arcade(frame.leftY, frame.rightX);
+ *     lemlib::controllerInput().markApplied(frame);
+ * }
+ * @endcode
+ */
+class ControllerInput {
+    public:
+        /** maximum number of subscribed tasks */
+        static constexpr size_t MAX_SUBSCRIBERS = 4;
+
+        /**
+         * @brief Construct a new Controller Input
+         *
+         * It must have static storage duration, like the one returned by controllerInput(), because its latency
+         * histogram does.
+         *
+         * @param id the controller to read
+         * @param pollPeriod how often the controller is read, in milliseconds
+         */
+        ControllerInput(pros::controller_id_e_t id = pros::E_CONTROLLER_MASTER, uint32_t pollPeriod = 2);
+
+        /**
+         * @brief Destroy the Controller Input object
+         *
+         */
+        ~ControllerInput();
+
+        ControllerInput(const ControllerInput&) = delete;
+        ControllerInput& operator=(const ControllerInput&) = delete;
+
+        /**
+         * @brief Wait for a frame the current task hasn't received yet
+         *
+         * Subscribes the current task on its first call, which returns the latest frame immediately. Tasks that are
+         * deleted, like opcontrol when the robot is disabled, are unsubscribed automatically.
+         *
+         * @param timeout maximum time to wait, in milliseconds
+         * @return ControllerFrame the frame, or the latest frame if the timeout expired or there are too many
+         * subscribers
+         */
+        ControllerFrame waitForFrame(uint32_t timeout = TIMEOUT_MAX);
+
+        /**
+         * @brief Get the latest frame without waiting or subscribing
+         *
+         * newPresses holds the buttons pressed in this frame.
+         *
+         * @return ControllerFrame
+         */
+        ControllerFrame latest();
+
+        /**
+         * @brief Record that motor commands for a frame were sent
+         *
+         * @param frame the frame
+         */
+        void markApplied(const ControllerFrame& frame);
+
+        /**
+         * @brief Get the latency from frames being detected to them being applied
+         *
+         * @return const LatencyHistogram& histogram of latencies, in microseconds
+         */
+        const LatencyHistogram& getLatency() const { return latency; }
+    private:
+        /**
+         * @brief A task waiting for frames
+         */
+        struct Subscriber {
+                pros::task_t task = nullptr;
+                /** copy of the task's name, used to check that the task still exists */
+                char name[32] = {};
+                uint32_t lastSequence = 0;
+                uint16_t newPresses = 0;
+        };
+
+        /**
+         * @brief Read the controller
+         */
+        ControllerFrame read();
+
+        /**
+         * @brief Find or add the current task's subscription. Must be called with the mutex locked
+         *
+         * @param added set to true if the task wasn't subscribed
+         * @return Subscriber* the subscription, or nullptr if there are too many subscribers
+         */
+        Subscriber* subscribe(bool& added);
+
+        /**
+         * @brief Whether a subscribed task still exists
+         */
+        static bool alive(const Subscriber& subscriber);
+
+        /**
+         * @brief The function that will be run inside of the input task.
+         *
+         */
+        void taskLoop();
+
+        pros::Controller controller;
+        const uint32_t pollPeriod;
+        ControllerFrame frame;
+        std::array<Subscriber, MAX_SUBSCRIBERS> subscribers {};
+        LatencyHistogram latency {"input.latency"};
+
+        pros::Mutex mutex;
+        pros::Task task;
+};
+
+/**
+ * @brief Get the controller input service of the master controller
+ *
+ * @return ControllerInput&
+ */
+ControllerInput& controllerInput();
+} // namespace lemlib
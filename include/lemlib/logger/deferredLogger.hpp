@@ -0,0 +1,197 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#define FMT_HEADER_ONLY
+#include "fmt/core.h"
+
+#include "pros/rtos.hpp"
+#include "lemlib/logger/logFormat.hpp"
+#include "lemlib/logger/message.hpp"
+#include "lemlib/logger/ringBuffer.hpp"
+#include "lemlib/profiling/scopeTimer.hpp"
+#include "lemlib/telemetry/binaryTelemetry.hpp"
+
+/**
+ * @brief Anchor for the ids of deferred log format strings
+ *
+ * A format string's id is its address relative to this symbol. Both are read-only data in the same program, so the
+ * id is fixed when the program is linked, and the decoder can compute it from the ELF file's symbol table.
+ */
+extern "C" const char lemlib_deferred_format_anchor[];
+
+/**
+ * @brief Log a message without formatting it on the brain
+ *
+ * The format string is stored in a static variable named lemlibDeferredFormat, and only its id is sent along with the
+ * raw values of the arguments. The format string is checked against the arguments at compile time, like fmt::format.
+ * tools/telemetryDecode.cpp formats the message on the computer, using the format strings it finds in the symbol table
+ * of the program's ELF file (bin/hot.package.elf).
+ *
+ * Arguments can be integers, floating point numbers, bools, chars and strings. Strings longer than 255 characters are
+ * truncated.
+ *
+ * @b Example
+ * @code {.cpp}
+ * LEMLIB_DEFERRED_LOG(lemlib::Level::INFO, "lateral error: {:.2f} output: {}", error, output);
+ * @endcode
+ */
+#define LEMLIB_DEFERRED_LOG(level, format, ...)                                                                        \
+    do {                                                                                                               \
+        static constexpr char lemlibDeferredFormat[] = format;                                                         \
+        ::lemlib::deferredLogger().log(level, lemlibDeferredFormat __VA_OPT__(, ) __VA_ARGS__);                        \
+    } while (0)
+
+namespace lemlib {
+/**
+ * @brief Logger that defers formatting to the computer
+ *
+ * Logging a message only copies the id of its format string, the time, and the raw bytes of each argument into a
+ * lock-free RingBuffer. A low priority task sends the buffered messages as binary telemetry frames, so they share the
+ * link with telemetry records. Messages are usually several times smaller than the formatted text, and the brain never
+ * runs fmt.
+ *
+ * Use the LEMLIB_DEFERRED_LOG macro instead of calling log directly, so the format string is placed where the decoder
+ * can find it.
+ */
+class DeferredLogger {
+    public:
+        /** maximum size of a single message, in bytes */
+        static constexpr size_t MAX_MESSAGE = 128;
+
+        /**
+         * @brief Construct a new Deferred Logger
+         *
+         * @param slotCount maximum number of messages waiting to be sent
+         * @param telemetry the channel to send messages on
+         */
+        DeferredLogger(size_t slotCount = 128, BinaryTelemetry& telemetry = binaryTelemetry());
+
+        /**
+         * @brief Destroy the Deferred Logger object
+         *
+         */
+        ~DeferredLogger();
+
+        DeferredLogger(const DeferredLogger&) = delete;
+        DeferredLogger& operator=(const DeferredLogger&) = delete;
+
+        /**
+         * @brief Log a message
+         *
+         * @param level the level of the message
+         * @param format the format string. Must be a static variable named lemlibDeferredFormat
+         * @param args the values that will be substituted into the format on the computer
+         * @return true the message was queued
+         * @return false the message was dropped
+         */
+        template <typename... T> bool log(Level level, fmt::format_string<T...> format, const T&... args) {
+            if (level < compiledLowestLevel || level < lowestLevel) return false;
+            LEMLIB_PROFILE_SCOPE("DeferredLogger::log");
+
+            // time, level, format id, argument count, then a type tag and the value of each argument
+            uint8_t message[MAX_MESSAGE];
+            const uint32_t time = pros::millis();
+            std::memcpy(message, &time, sizeof(time));
+            message[4] = uint8_t(level);
+            const uintptr_t anchor = reinterpret_cast<uintptr_t>(lemlib_deferred_format_anchor);
+            const uint32_t id = reinterpret_cast<uintptr_t>(format.get().data()) - anchor;
+            std::memcpy(message + 5, &id, sizeof(id));
+            message[9] = sizeof...(T);
+            size_t size = 10;
+            bool fits = true;
+            ((fits = fits && packArg(message, size, args)), ...);
+            if (!fits) {
+                // any task can log, so this is counted without a lock
+                overflowed.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            return buffer.push(std::string_view(reinterpret_cast<const char*>(message), size));
+        }
+
+        /**
+         * @brief Set the lowest level
+         *
+         * @param level messages below this level are ignored
+         */
+        void setLowestLevel(Level level);
+
+        /**
+         * @brief Get the number of messages dropped because the buffer was full or the message was too large
+         *
+         * @return uint32_t
+         */
+        uint32_t getDropped() const;
+    private:
+        /**
+         * @brief Append a type tag and a value to a message
+         *
+         * @return true the argument fit in the message
+         */
+        template <typename T> static bool packArg(uint8_t* message, size_t& size, const T& value) {
+            using U = std::decay_t<T>;
+            if constexpr (std::is_same_v<U, bool>) return packValue(message, size, FieldType::BOOL, value);
+            else if constexpr (std::is_same_v<U, char>) return packValue(message, size, FieldType::CHAR, value);
+            else if constexpr (std::is_floating_point_v<U>) {
+                if constexpr (sizeof(U) == sizeof(float)) return packValue(message, size, FieldType::F32, value);
+                else return packValue(message, size, FieldType::F64, double(value));
+            } else if constexpr (std::is_integral_v<U> || std::is_enum_v<U>) {
+                // widen integers, so the decoder only has to handle 32 and 64 bit values
+                if constexpr (sizeof(U) <= sizeof(int32_t)) {
+                    if constexpr (std::is_signed_v<U>) return packValue(message, size, FieldType::I32, int32_t(value));
+                    else return packValue(message, size, FieldType::U32, uint32_t(value));
+                } else {
+                    if constexpr (std::is_signed_v<U>) return packValue(message, size, FieldType::I64, int64_t(value));
+                    else return packValue(message, size, FieldType::U64, uint64_t(value));
+                }
+            } else if constexpr (std::is_convertible_v<const U&, std::string_view>) {
+                const std::string_view string = value;
+                const size_t length = string.size() > 255 ? 255 : string.size();
+                if (size + 2 + length > MAX_MESSAGE) return false;
+                message[size++] = uint8_t(FieldType::STRING);
+                message[size++] = uint8_t(length);
+                std::memcpy(message + size, string.data(), length);
+                size += length;
+                return true;
+            } else {
+                static_assert(!sizeof(U), "deferred log arguments must be numbers, bools, chars or strings");
+            }
+        }
+
+        /**
+         * @brief Append a type tag and a fixed size value to a message
+         */
+        template <typename T> static bool packValue(uint8_t* message, size_t& size, FieldType type, const T& value) {
+            if (size + 1 + sizeof(T) > MAX_MESSAGE) return false;
+            message[size++] = uint8_t(type);
+            std::memcpy(message + size, &value, sizeof(T));
+            size += sizeof(T);
+            return true;
+        }
+
+        /**
+         * @brief The function that will be run inside of the logger's task.
+         *
+         */
+        void taskLoop();
+
+        BinaryTelemetry& telemetry;
+        RingBuffer buffer;
+        Level lowestLevel = Level::INFO;
+        std::atomic<uint32_t> overflowed = 0;
+
+        pros::Task task;
+};
+
+/**
+ * @brief Get the deferred logger
+ *
+ * @return DeferredLogger&
+ */
+DeferredLogger& deferredLogger();
+} // namespace lemlib
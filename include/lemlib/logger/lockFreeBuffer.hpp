@@ -0,0 +1,131 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string_view>
+
+#define FMT_HEADER_ONLY
+#include "fmt/core.h"
+
+#include "pros/rtos.hpp"
+#include "lemlib/logger/ringBuffer.hpp"
+
+namespace lemlib {
+/**
+ * @brief A buffer backed by a lock-free ring buffer
+ *
+ * Works like Buffer, but pending messages are stored in a fixed capacity RingBuffer instead of a mutex protected
+ * std::deque<std::string>. Pushing never blocks on a mutex or allocates (unless the overflow policy is BLOCK), so it
+ * can be used from control loops. Messages are processed in the order they were pushed, one every rate milliseconds.
+ */
+class LockFreeBuffer {
+    public:
+        /**
+         * @brief Construct a new Lock Free Buffer
+         *
+         * @param bufferFunc the function that will be applied to each message when it is removed
+         * @param slotCount maximum number of pending messages
+         * @param slotSize maximum size of a single message, in bytes. Longer messages are truncated
+         * @param policy what to do when a message is pushed while the buffer is full
+         */
+        LockFreeBuffer(std::function<void(std::string_view)> bufferFunc, size_t slotCount = 64, size_t slotSize = 256,
+                       OverflowPolicy policy = OverflowPolicy::DROP_OLDEST);
+
+        /**
+         * @brief Destroy the Lock Free Buffer object
+         *
+         */
+        ~LockFreeBuffer();
+
+        LockFreeBuffer(const LockFreeBuffer&) = delete;
+        LockFreeBuffer& operator=(const LockFreeBuffer&) = delete;
+
+        /**
+         * @brief Push to the buffer
+         *
+         * @param bufferData
+         * @return true the message was pushed
+         * @return false the message was dropped because the buffer is full
+         */
+        bool pushToBuffer(std::string_view bufferData);
+
+        /**
+         * @brief Set the rate of the buffer
+         *
+         * @param rate time between processing messages, in milliseconds
+         */
+        void setRate(uint32_t rate);
+
+        /**
+         * @brief Set what happens when a message is pushed while the buffer is full
+         *
+         * @param policy
+         */
+        void setPolicy(OverflowPolicy policy);
+
+        /**
+         * @brief Check to see if the internal buffer is empty
+         *
+         */
+        bool buffersEmpty();
+
+        /**
+         * @brief Get the number of messages dropped because the buffer was full
+         *
+         * @return uint32_t
+         */
+        uint32_t getDropped() const;
+
+        /**
+         * @brief Get the number of messages truncated because they were too long
+         *
+         * @return uint32_t
+         */
+        uint32_t getTruncated() const;
+    private:
+        /**
+         * @brief The function that will be run inside of the buffer's task.
+         *
+         */
+        void taskLoop();
+
+        std::function<void(std::string_view)> bufferFunc;
+
+        RingBuffer buffer;
+        std::unique_ptr<char[]> message;
+
+        std::atomic<uint32_t> rate = 50;
+
+        pros::Task task;
+};
+
+/**
+ * @brief Lock-free buffered printing to stdout.
+ *
+ * Same as BufferedStdout, but formats into a fixed size buffer on the stack and pushes to a LockFreeBuffer, so
+ * printing does not allocate or wait for other tasks.
+ */
+class RingBufferedStdout : public LockFreeBuffer {
+    public:
+        RingBufferedStdout();
+
+        /**
+         * @brief Print a string (thread-safe).
+         *
+         * @return true the string was queued
+         * @return false the string was dropped because the buffer is full
+         */
+        template <typename... T> bool print(fmt::format_string<T...> format, T&&... args) {
+            char string[256];
+            const auto result = fmt::format_to_n(string, sizeof(string), format, std::forward<T>(args)...);
+            return pushToBuffer(std::string_view(string, result.out - string));
+        }
+};
+
+/**
+ * @brief Get the lock-free buffered stdout.
+ *
+ */
+RingBufferedStdout& ringBufferedStdout();
+} // namespace lemlib
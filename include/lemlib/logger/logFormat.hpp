@@ -0,0 +1,227 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#include "pros/rtos.hpp"
+#include "lemlib/logger/baseSink.hpp"
+#include "lemlib/logger/message.hpp"
+#include "lemlib/profiling/scopeTimer.hpp"
+
+namespace lemlib {
+/**
+ * @brief Lowest level of messages that are compiled in
+ *
+ * Define LEMLIB_LOG_LEVEL as the name of a level (for example, add -DLEMLIB_LOG_LEVEL=WARN to EXTRA_CXXFLAGS in the
+ * Makefile) to remove calls to FastSink's debug(), info() etc. below that level at compile time. The arguments of
+ * removed calls are still evaluated, so avoid arguments with side effects.
+ */
+#ifndef LEMLIB_LOG_LEVEL
+#define LEMLIB_LOG_LEVEL INFO
+#endif
+constexpr Level compiledLowestLevel = Level::LEMLIB_LOG_LEVEL;
+
+/**
+ * @brief A sink format that has been parsed ahead of time
+ *
+ * Splits a format like "[LemLib] {level}: {message}" into literal text and {time}, {level} and {message}
+ * placeholders once, so each logged message only has to copy the literals and format the placeholders. Formats that
+ * use anything else (format specs, or extra arguments from getExtraFormattingArgs) are marked as dynamic, and have to
+ * be formatted with fmt::vformat instead.
+ */
+class LogFormat {
+    public:
+        /** maximum length of a format that can be parsed */
+        static constexpr size_t MAX_LENGTH = 96;
+        /** maximum number of literals and placeholders in a format */
+        static constexpr size_t MAX_SEGMENTS = 16;
+
+        /**
+         * @brief Parse a format
+         *
+         * @param format the format to parse
+         */
+        explicit LogFormat(std::string_view format);
+
+        /**
+         * @brief Get the parsed version of a format
+         *
+         * Parsed formats are cached, so a format is only parsed the first time it is used.
+         *
+         * @param format the format
+         * @return const LogFormat* the parsed format, or nullptr if it can't be parsed ahead of time
+         */
+        static const LogFormat* get(const std::string& format);
+
+        /**
+         * @brief Whether the format can only be formatted with fmt::vformat
+         */
+        bool isDynamic() const;
+
+        /**
+         * @brief Append a formatted message to a string
+         *
+         * @param out the string to append to. Does not allocate if it has enough capacity
+         * @param time the time the message was logged, in milliseconds
+         * @param level the level of the message
+         * @param message the user's message
+         */
+        void formatTo(std::string& out, uint32_t time, Level level, std::string_view message) const;
+    private:
+        enum class Field : uint8_t { LITERAL, TIME, LEVEL, MESSAGE };
+
+        struct Segment {
+                Field field;
+                uint8_t start;
+                uint8_t length;
+        };
+
+        char format[MAX_LENGTH];
+        size_t length = 0;
+        Segment segments[MAX_SEGMENTS];
+        size_t segmentCount = 0;
+        bool dynamic = false;
+};
+
+/**
+ * @brief Buffers that are reused by every message logged from the same task
+ *
+ * Each task that logs claims one of a fixed number of scratch buffers the first time it logs a message. The strings
+ * keep their capacity between messages, so once a task has logged its longest message, logging no longer allocates.
+ */
+struct LogScratch {
+        /** the task that owns the buffers */
+        std::atomic<pros::task_t> owner = nullptr;
+        /** whether the buffers are being used. Guards against sinks that log from sendMessage */
+        bool inUse = false;
+        /** the user's message, before the sink format is applied */
+        std::string body;
+        /** the formatted message */
+        Message message;
+
+        /**
+         * @brief Get the scratch buffers of the current task
+         *
+         * @return LogScratch* the buffers, or nullptr if every buffer has been claimed by other tasks, the buffers
+         * of this task are already in use, or this isn't a task
+         */
+        static LogScratch* get();
+};
+
+/**
+ * @brief A sink whose low levels are compiled out, and whose format is parsed ahead of time
+ *
+ * BaseSink is part of the prebuilt LemLib template, so its log() is left as it is, and a sink that derives from this
+ * class instead gets the faster version. Messages below LEMLIB_LOG_LEVEL are discarded at compile time by debug(),
+ * info() etc. If the sink's format only uses {time}, {level} and {message}, the message is formatted in a single pass
+ * into buffers that are reused by the calling task, so logging doesn't allocate once the buffers are large enough.
+ * Other formats, and messages logged from outside a task, go through BaseSink::log().
+ *
+ * The level and format are kept here too, since BaseSink's are private, so set them through this class rather than
+ * through a BaseSink pointer.
+ *
+ * <h3> Example Usage </h3>
+ * @code
+ * class ScreenSink : public lemlib::FastSink {
+ *     public:
+ *         ScreenSink() { setFormat("[{time}] {message}"); }
+ *     protected:
+ *         void sendMessage(const lemlib::Message& message) override { pros::lcd::print(7, message.message.c_str()); }
+ * };
+ * @endcode
+ */
+class FastSink : public BaseSink {
+    public:
+        /**
+         * @brief Set the lowest level, like BaseSink::setLowestLevel()
+         *
+         * @param level
+         */
+        void setLowestLevel(Level level) {
+            lowestLevel = level;
+            BaseSink::setLowestLevel(level);
+        }
+
+        /**
+         * @brief Log a message at the given level, like BaseSink::log()
+         *
+         * @param level The level at which to send the message.
+         * @param format The format that the message will use. Use "{}" as placeholders.
+         * @param args The values that will be substituted into the placeholders in the format.
+         */
+        template <typename... T> void log(Level level, fmt::format_string<T...> format, T&&... args) {
+            if (level < compiledLowestLevel || level < lowestLevel) return;
+            LEMLIB_PROFILE_SCOPE("FastSink::log");
+
+            // apply the pre-parsed sink format, reusing this task's buffers
+            LogScratch* scratch = parsedFormat != nullptr ? LogScratch::get() : nullptr;
+            if (scratch == nullptr) {
+                BaseSink::log(level, format, std::forward<T>(args)...);
+                return;
+            }
+            scratch->inUse = true;
+            scratch->body.clear();
+            fmt::format_to(std::back_inserter(scratch->body), format, std::forward<T>(args)...);
+
+            Message& message = scratch->message;
+            message.level = level;
+            message.time = pros::millis();
+            message.message.clear();
+            parsedFormat->formatTo(message.message, message.time, level, scratch->body);
+            sendMessage(message);
+            scratch->inUse = false;
+        }
+
+        /**
+         * @brief Log a message at the DEBUG level, unless it is below LEMLIB_LOG_LEVEL
+         */
+        template <typename... T> void debug(fmt::format_string<T...> format, T&&... args) {
+            if constexpr (Level::DEBUG >= compiledLowestLevel) log(Level::DEBUG, format, std::forward<T>(args)...);
+        }
+
+        /**
+         * @brief Log a message at the INFO level, unless it is below LEMLIB_LOG_LEVEL
+         */
+        template <typename... T> void info(fmt::format_string<T...> format, T&&... args) {
+            if constexpr (Level::INFO >= compiledLowestLevel) log(Level::INFO, format, std::forward<T>(args)...);
+        }
+
+        /**
+         * @brief Log a message at the WARN level, unless it is below LEMLIB_LOG_LEVEL
+         */
+        template <typename... T> void warn(fmt::format_string<T...> format, T&&... args) {
+            if constexpr (Level::WARN >= compiledLowestLevel) log(Level::WARN, format, std::forward<T>(args)...);
+        }
+
+        /**
+         * @brief Log a message at the ERROR level, unless it is below LEMLIB_LOG_LEVEL
+         */
+        template <typename... T> void error(fmt::format_string<T...> format, T&&... args) {
+            if constexpr (Level::ERROR >= compiledLowestLevel) log(Level::ERROR, format, std::forward<T>(args)...);
+        }
+
+        /**
+         * @brief Log a message at the FATAL level, unless it is below LEMLIB_LOG_LEVEL
+         */
+        template <typename... T> void fatal(fmt::format_string<T...> format, T&&... args) {
+            if constexpr (Level::FATAL >= compiledLowestLevel) log(Level::FATAL, format, std::forward<T>(args)...);
+        }
+    protected:
+        /**
+         * @brief Set the format of messages, like BaseSink::setFormat(), and parse it
+         *
+         * @param format
+         */
+        void setFormat(const std::string& format) {
+            parsedFormat = LogFormat::get(format);
+            BaseSink::setFormat(format);
+        }
+    private:
+        Level lowestLevel = Level::WARN;
+        /** the parsed format, or nullptr if it has to be formatted by BaseSink::log() */
+        const LogFormat* parsedFormat = nullptr;
+};
+} // namespace lemlib
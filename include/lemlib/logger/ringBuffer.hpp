@@ -0,0 +1,137 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace lemlib {
+/**
+ * @brief What a ring buffer does when a message is pushed while it is full
+ */
+enum class OverflowPolicy {
+    DROP_OLDEST, /**< discard the oldest pending message to make room, or the message being pushed if the oldest is
+                    still being written */
+    DROP_NEWEST, /**< discard the message being pushed */
+    BLOCK /**< wait until the consumer makes room */
+};
+
+/**
+ * @brief Fixed capacity, lock-free message queue
+ *
+ * Messages are copied into a fixed number of fixed size slots that are allocated once, when the buffer is
+ * constructed. Pushing and popping never lock a mutex or allocate, so it is safe to push from control loops. Any
+ * number of tasks can push and pop at the same time.
+ *
+ * Each slot has a sequence number that tells producers and consumers whose turn it is to use the slot, so a message
+ * is only visible to consumers once it has been completely copied in.
+ */
+class RingBuffer {
+    public:
+        /**
+         * @brief Construct a new Ring Buffer
+         *
+         * @param slotCount maximum number of pending messages. Rounded up to a power of 2
+         * @param slotSize maximum size of a single message, in bytes. Longer messages are truncated
+         * @param policy what to do when the buffer is full
+         *
+         * @b Example
+         * @code {.cpp}
+         * // 64 messages of up to 128 bytes. When full, the oldest message is discarded
+         * lemlib::RingBuffer buffer(64, 128, lemlib::OverflowPolicy::DROP_OLDEST);
+         * @endcode
+         */
+        RingBuffer(size_t slotCount, size_t slotSize, OverflowPolicy policy = OverflowPolicy::DROP_OLDEST);
+
+        RingBuffer(const RingBuffer&) = delete;
+        RingBuffer& operator=(const RingBuffer&) = delete;
+
+        /**
+         * @brief Push a message to the buffer
+         *
+         * @param message the message to push
+         * @return true the message was pushed
+         * @return false the message was dropped because the buffer is full
+         */
+        bool push(std::string_view message);
+
+        /**
+         * @brief Pop the oldest message from the buffer
+         *
+         * @param out where to copy the message to. Must be at least getSlotSize() bytes long. If nullptr, the message
+         * is discarded
+         * @param size where to store the size of the message, in bytes. Ignored if nullptr
+         * @return true a message was popped
+         * @return false the buffer is empty
+         */
+        bool pop(char* out, size_t* size = nullptr);
+
+        /**
+         * @brief Check whether the buffer has no pending messages
+         *
+         * @return true the buffer is empty
+         */
+        bool empty() const;
+
+        /**
+         * @brief Get the maximum size of a message
+         *
+         * @return size_t size in bytes
+         */
+        size_t getSlotSize() const;
+
+        /**
+         * @brief Set the overflow policy
+         *
+         * @param policy the new policy
+         */
+        void setPolicy(OverflowPolicy policy);
+
+        /**
+         * @brief Get the number of messages that were dropped because the buffer was full
+         *
+         * @return uint32_t
+         */
+        uint32_t getDropped() const;
+
+        /**
+         * @brief Get the number of messages that were truncated because they were longer than a slot
+         *
+         * @return uint32_t
+         */
+        uint32_t getTruncated() const;
+
+        /**
+         * @brief Get the number of pushes that had to wait for the consumer with the BLOCK policy
+         *
+         * @return uint32_t
+         */
+        uint32_t getBlocked() const;
+    private:
+        struct Slot {
+                std::atomic<uint32_t> sequence;
+                uint16_t size;
+        };
+
+        /**
+         * @brief Get the data of a slot
+         */
+        char* slotData(uint32_t index) const;
+
+        const size_t slotCount;
+        const uint32_t mask;
+        const size_t slotSize;
+        std::atomic<OverflowPolicy> policy;
+
+        std::unique_ptr<Slot[]> slots;
+        std::unique_ptr<char[]> data;
+
+        std::atomic<uint32_t> enqueuePos = 0;
+        std::atomic<uint32_t> dequeuePos = 0;
+
+        std::atomic<uint32_t> dropped = 0;
+        std::atomic<uint32_t> truncated = 0;
+        std::atomic<uint32_t> blocked = 0;
+};
+} // namespace lemlib
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "pros/rtos.hpp"
+#include "lemlib/logger/logFormat.hpp"
+
+namespace lemlib {
+/**
+ * @brief Sink for writing messages to log files on the micro SD card
+ *
+ * Messages are appended to one of several buffers in RAM. When a buffer is full it is handed to a low priority writer
+ * task, which writes it to the card in a single call while the next buffer is filled. Buffers are aligned to the card's
+ * 4 KB blocks and their size is a multiple of it, so full buffers are written as whole blocks without going through
+ * stdio's buffer.
+ *
+ * Logging never waits for the card. Producers reserve space in the current buffer with an atomic compare and swap, and
+ * if every buffer is waiting to be written the message is dropped and counted instead.
+ *
+ * Files are named after the path prefix and numbered, and a new file is started when the current one would grow past
+ * the maximum file size. The prefix can point anywhere that fopen can write to, so host builds can log to a regular
+ * directory.
+ *
+ * <h3> Example Usage </h3>
+ * @code
+ * // logs to /usd/auton_000.txt, /usd/auton_001.txt, ...
+ * std::shared_ptr<lemlib::SdSink> sdSink = std::make_shared<lemlib::SdSink>("/usd/auton");
+ * sdSink->setLowestLevel(lemlib::Level::INFO);
+ * sdSink->info("lateral error: {:.2f}", error);
+ * @endcode
+ */
+class SdSink : public FastSink {
+    public:
+        /** size of a block on the SD card, in bytes. Buffers are aligned to and a multiple of this size */
+        static constexpr size_t BLOCK_SIZE = 4096;
+
+        /**
+         * @brief Construct a new SD Sink
+         *
+         * @param prefix path prefix of the log files. "_NNN.txt" is appended to it
+         * @param bufferSize size of each buffer, in bytes. Rounded up to a multiple of BLOCK_SIZE
+         * @param bufferCount number of buffers. At least 2, so one can be filled while another is written
+         * @param maxFileSize size at which a new file is started, in bytes
+         */
+        SdSink(std::string prefix = "/usd/lemlib", size_t bufferSize = 2 * BLOCK_SIZE, size_t bufferCount = 2,
+               size_t maxFileSize = 4 * 1024 * 1024);
+
+        /**
+         * @brief Destroy the SD Sink object
+         *
+         * Writes whatever is buffered and closes the current file
+         */
+        ~SdSink();
+
+        SdSink(const SdSink&) = delete;
+        SdSink& operator=(const SdSink&) = delete;
+
+        /**
+         * @brief Write the partially filled buffer at the next opportunity
+         *
+         * The writer task also does this on its own when nothing has been written for a second.
+         */
+        void flush();
+
+        /**
+         * @brief Get the number of bytes written to the card
+         *
+         * @return uint32_t
+         */
+        uint32_t getBytesWritten() const;
+
+        /**
+         * @brief Get the average write throughput of the card
+         *
+         * Only the time spent writing is counted, so this is how fast the card accepts data, not how fast it is
+         * logged.
+         *
+         * @return float throughput in bytes per second
+         */
+        float getThroughput() const;
+
+        /**
+         * @brief Get the number of messages dropped because every buffer was waiting to be written
+         *
+         * @return uint32_t
+         */
+        uint32_t getDropped() const;
+
+        /**
+         * @brief Get the number of buffers that could not be written, because no file could be opened or the card
+         * failed
+         *
+         * @return uint32_t
+         */
+        uint32_t getBuffersDropped() const;
+    private:
+        enum class BufferState : uint8_t { FREE, FILLING, WRITING };
+
+        static constexpr uint32_t UNSEALED = UINT32_MAX;
+
+        struct Buffer {
+                char* data = nullptr;
+                std::atomic<BufferState> state = BufferState::FREE;
+                /** bytes copied in by producers */
+                std::atomic<uint32_t> committed = 0;
+                /** final size of the buffer once it has been sealed, or UNSEALED */
+                std::atomic<uint32_t> length = UNSEALED;
+                /** the buffer that was filled after this one */
+                uint8_t next = 0;
+        };
+
+        /**
+         * @brief Append a message to the current buffer
+         *
+         * @param message
+         */
+        void sendMessage(const Message& message) override;
+
+        /**
+         * @brief Reserve space for a message and copy it in
+         *
+         * @return true the message was buffered
+         * @return false every buffer is waiting to be written
+         */
+        bool append(const char* data, uint32_t size);
+
+        /**
+         * @brief Seal the current buffer if it is not empty, and start filling a free one
+         *
+         * @return true the buffer was sealed
+         */
+        bool seal();
+
+        /**
+         * @brief Claim a free buffer for filling
+         *
+         * @return int the index of the buffer, or -1 if there is none
+         */
+        int claimFreeBuffer();
+
+        /**
+         * @brief Write a sealed buffer to the current file, opening a new file if needed
+         */
+        void writeBuffer(Buffer& buffer, uint32_t length);
+
+        /**
+         * @brief Write every sealed buffer, in the order they were filled
+         *
+         * @return true at least one buffer was written
+         */
+        bool writeSealed();
+
+        /**
+         * @brief The function that will be run inside of the writer task.
+         *
+         */
+        void taskLoop();
+
+        const std::string prefix;
+        const uint32_t bufferSize;
+        const size_t maxFileSize;
+
+        std::unique_ptr<char[]> storage;
+        std::unique_ptr<Buffer[]> buffers;
+        const size_t bufferCount;
+
+        /** index of the buffer being filled (high 8 bits) and its fill offset (low 24 bits) */
+        std::atomic<uint32_t> current;
+        /** next buffer to write */
+        uint8_t writeIndex = 0;
+
+        FILE* file = nullptr;
+        uint32_t fileNumber = 0;
+        size_t fileSize = 0;
+
+        std::atomic<bool> flushRequested = false;
+        std::atomic<uint32_t> bytesWritten = 0;
+        std::atomic<uint32_t> writeTime = 0;
+        std::atomic<uint32_t> dropped = 0;
+        std::atomic<uint32_t> buffersDropped = 0;
+
+        /** held while buffers are written, so the destructor doesn't interrupt a write */
+        pros::Mutex writeMutex;
+        pros::Task task;
+};
+} // namespace lemlib
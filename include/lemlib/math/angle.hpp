@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cmath>
+
+namespace lemlib::math {
+/**
+ * @brief Sanitize an angle so it is positive and within the range of 0 to 2pi or 0 to 360
+ *
+ * The same as lemlib::sanitizeAngle, which util.hpp only declares: the template defines it in util.cpp, so nothing
+ * else can call it, in a constant expression or otherwise.
+ *
+ * @param angle the angle to sanitize
+ * @param radians whether the angle is in radians or degrees. true by default
+ * @return constexpr float the sanitized angle
+ */
+constexpr float sanitizeAngle(float angle, bool radians = true) {
+    const float max = radians ? 2 * M_PI : 360;
+    return std::fmod(std::fmod(angle, max) + max, max);
+}
+} // namespace lemlib::math
@@ -0,0 +1,284 @@
+#pragma once
+
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/**
+ * @brief Whether the host's LemLib, in host/lemlib, uses lemlib::fast's math instead of libm's
+ *
+ * Set to 1 with -DLEMLIB_FAST_MATH=1, or the LEMLIB_FAST_MATH CMake option. Only the host and QEMU builds call
+ * lemlib::math, from host/lemlib. The robot links the prebuilt LemLib template, which this doesn't change.
+ */
+#ifndef LEMLIB_FAST_MATH
+#define LEMLIB_FAST_MATH 0
+#endif
+
+/**
+ * @brief Single precision sin, cos, atan2 and hypot, faster than libm's and with a known error
+ *
+ * Each function has a scalar version, inlined, and a batch version, which works on 4 values at a time with NEON on the
+ * brain. Both versions compute the same thing the same way, so they agree exactly, except that NEON has no divide or
+ * square root, so batch atan2 and hypot use refined estimates, which add a few ulp. None of them branch on their
+ * inputs.
+ *
+ * The maximum errors, measured against double precision libm by the fastMath benchmarks, are:
+ * - sin, cos and sincos: 9.3e-8 absolute, for |x| up to 8192. Past that, the error grows with |x|
+ * - atan2: 2.7e-7 radians, about an ulp of pi, for any finite inputs. atan2(±0, ±0) is ±0 or ±pi, like libm's
+ * - hypot: 1.2e-7 relative, for inputs whose squares are normal floats: from 1e-19 to 1e19 in size, or 0
+ *
+ * For scale, glibc's float versions measure 3.3e-8, 2.5e-7 and 6e-8. Infinities and NaNs aren't handled.
+ */
+namespace lemlib::fast {
+/**
+ * @brief The kernels, shared by the scalar and batch versions. T is float, or a GCC vector of floats
+ */
+namespace kernel {
+// same sized integer: int32_t for float, and the integer vector comparisons return for vectors
+template <typename T> using Bits = std::conditional_t<std::is_same_v<T, float>, int32_t, decltype(T {} < T {})>;
+
+// pi / 2, split so that k * PI_2_HIGH and k * PI_2_MID are exact, or nearly, for |x| up to 8192
+constexpr float PI_2_HIGH = 1.5703125f;
+constexpr float PI_2_MID = 4.837512969970703125e-4f;
+constexpr float PI_2_LOW = 7.54978995489188216e-8f;
+constexpr float TWO_OVER_PI = 0.636619772367581343f;
+// adding 1.5 * 2^23 rounds a float to an integer, which is then in the low bits of the sum
+constexpr float ROUNDER = 12582912.0f;
+constexpr float PI = 3.14159265358979323846f;
+constexpr float PI_2 = 1.57079632679489661923f;
+constexpr float PI_4 = 0.785398163397448309616f;
+constexpr float TAN_PI_8 = 0.414213562373095048802f;
+
+template <typename T> T abs(T x) { return std::bit_cast<T>(std::bit_cast<Bits<T>>(x) & 0x7fffffff); }
+
+// whether the sign bit is set, so -0 is negative
+template <typename T> auto isNegative(T x) { return std::bit_cast<Bits<T>>(x) < 0; }
+
+template <typename T> T divide(T numerator, T denominator) {
+#if defined(__ARM_NEON)
+    if constexpr (!std::is_same_v<T, float>) {
+        // NEON has no divide. 2 Newton-Raphson steps refine the reciprocal estimate to within about an ulp
+        float32x4_t reciprocal = vrecpeq_f32((float32x4_t)denominator);
+        reciprocal = vmulq_f32(vrecpsq_f32((float32x4_t)denominator, reciprocal), reciprocal);
+        reciprocal = vmulq_f32(vrecpsq_f32((float32x4_t)denominator, reciprocal), reciprocal);
+        return numerator * (T)reciprocal;
+    }
+#endif
+    return numerator / denominator;
+}
+
+template <typename T> T squareRoot(T x) {
+    if constexpr (std::is_same_v<T, float>) {
+        return std::sqrt(x);
+    } else {
+#if defined(__ARM_NEON)
+        // x / sqrt(x), with the reciprocal square root estimate refined by 2 Newton-Raphson steps
+        float32x4_t estimate = vrsqrteq_f32((float32x4_t)x);
+        estimate = vmulq_f32(vrsqrtsq_f32(vmulq_f32((float32x4_t)x, estimate), estimate), estimate);
+        estimate = vmulq_f32(vrsqrtsq_f32(vmulq_f32((float32x4_t)x, estimate), estimate), estimate);
+        // the estimate of 1 / sqrt(0) is infinite
+        return x == 0 ? x : x * (T)estimate;
+#else
+        for (size_t i = 0; i < sizeof(T) / sizeof(float); i++) x[i] = std::sqrt(x[i]);
+        return x;
+#endif
+    }
+}
+
+/**
+ * @brief sin and cos of x
+ *
+ * x is reduced to r in [-pi/4, pi/4], where x = r + k * pi/2, and the quadrant k picks which of sin(r) and cos(r) is
+ * which and their signs. The polynomials are Cephes' minimax ones
+ */
+template <typename T> void sincos(T x, T& sin, T& cos) {
+    const T shifted = x * TWO_OVER_PI + ROUNDER;
+    const T k = shifted - ROUNDER;
+    const Bits<T> quadrant = std::bit_cast<Bits<T>>(shifted);
+    const T r = ((x - k * PI_2_HIGH) - k * PI_2_MID) - k * PI_2_LOW;
+    const T z = r * r;
+    const T sinR = r + r * z * ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f);
+    const T cosR = 1.0f - 0.5f * z + z * z * ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z +
+                                           4.166664568298827e-2f);
+    // in odd quadrants, sin(x) is ±cos(r) and cos(x) is ±sin(r)
+    const auto odd = (quadrant & 1) != 0;
+    const T s = odd ? cosR : sinR;
+    const T c = odd ? sinR : cosR;
+    sin = (quadrant & 2) != 0 ? -s : s;
+    cos = ((quadrant + 1) & 2) != 0 ? -c : c;
+}
+
+/**
+ * @brief atan2 of y and x
+ *
+ * The octant is taken out first, leaving atan(lo / hi) for the smaller and larger of |x| and |y|. Past tan(pi/8), that
+ * is pi/4 + atan((lo - hi) / (lo + hi)), so the polynomial, Cephes' minimax one, only covers [-tan(pi/8), tan(pi/8)]
+ */
+template <typename T> T atan2(T y, T x) {
+    const T absX = abs(x);
+    const T absY = abs(y);
+    const auto steep = absY > absX;
+    const T high = steep ? absY : absX;
+    const T low = steep ? absX : absY;
+    const auto upper = low > TAN_PI_8 * high;
+    const T numerator = upper ? low - high : low;
+    // 0 / 0 when x and y are both 0, which is atan2(0, 0) = 0 once the denominator is 1
+    const T denominator = high == 0 ? high + 1.0f : upper ? low + high : high;
+    const T t = divide(numerator, denominator);
+    const T z = t * t;
+    T angle = t + t * z * (((8.05374449538e-2f * z - 1.38776856032e-1f) * z + 1.99777106478e-1f) * z -
+                           3.33329491539e-1f);
+    angle = upper ? angle + PI_4 : angle;
+    angle = steep ? PI_2 - angle : angle;
+    angle = isNegative(x) ? PI - angle : angle;
+    return isNegative(y) ? -angle : angle;
+}
+
+template <typename T> T hypot(T x, T y) { return squareRoot(x * x + y * y); }
+} // namespace kernel
+
+/**
+ * @brief sin, with an error of at most 9.3e-8 for |x| up to 8192
+ *
+ * @param x angle in radians
+ * @return float sin(x)
+ */
+inline float sin(float x) {
+    float sin, cos;
+    kernel::sincos(x, sin, cos);
+    return sin;
+}
+
+/**
+ * @brief cos, with an error of at most 9.3e-8 for |x| up to 8192
+ *
+ * @param x angle in radians
+ * @return float cos(x)
+ */
+inline float cos(float x) {
+    float sin, cos;
+    kernel::sincos(x, sin, cos);
+    return cos;
+}
+
+/**
+ * @brief sin and cos of the same angle, for about the cost of one of them
+ *
+ * @param x angle in radians
+ * @param sin set to sin(x)
+ * @param cos set to cos(x)
+ *
+ * @b Example
+ * @code {.cpp}
+ * float sin, cos;
+ * lemlib::fast::sincos(pose.theta, sin, cos);
+ * @endcode
+ */
+inline void sincos(float x, float& sin, float& cos) { kernel::sincos(x, sin, cos); }
+
+/**
+ * @brief atan2, with an error of at most 2.7e-7 radians
+ *
+ * @param y y coordinate
+ * @param x x coordinate
+ * @return float angle of (x, y) from the x axis, from -pi to pi
+ */
+inline float atan2(float y, float x) { return kernel::atan2(y, x); }
+
+/**
+ * @brief hypot, without libm's handling of overflow, so x and y must be from 1e-19 to 1e19 in size, or 0
+ *
+ * @param x first side
+ * @param y second side
+ * @return float sqrt(x * x + y * y)
+ */
+inline float hypot(float x, float y) { return kernel::hypot(x, y); }
+
+/**
+ * @brief sin of each of an array of angles
+ *
+ * @param angles angles in radians
+ * @param sines where to write their sines. May be angles
+ * @param count number of angles
+ */
+void sin(const float* angles, float* sines, size_t count);
+
+/**
+ * @brief cos of each of an array of angles
+ *
+ * @param angles angles in radians
+ * @param cosines where to write their cosines. May be angles
+ * @param count number of angles
+ */
+void cos(const float* angles, float* cosines, size_t count);
+
+/**
+ * @brief sin and cos of each of an array of angles
+ *
+ * @param angles angles in radians
+ * @param sines where to write their sines
+ * @param cosines where to write their cosines
+ * @param count number of angles
+ */
+void sincos(const float* angles, float* sines, float* cosines, size_t count);
+
+/**
+ * @brief atan2 of each pair of an array of y and an array of x coordinates
+ *
+ * @param y y coordinates
+ * @param x x coordinates
+ * @param angles where to write the angles. May be y or x
+ * @param count number of coordinates
+ */
+void atan2(const float* y, const float* x, float* angles, size_t count);
+
+/**
+ * @brief hypot of each pair of two arrays of sides
+ *
+ * @param x first sides
+ * @param y second sides
+ * @param lengths where to write the lengths. May be x or y
+ * @param count number of sides
+ */
+void hypot(const float* x, const float* y, float* lengths, size_t count);
+} // namespace lemlib::fast
+
+/**
+ * @brief The math the host's LemLib uses: lemlib::fast's with -DLEMLIB_FAST_MATH=1, libm's otherwise
+ */
+namespace lemlib::math {
+inline float sin(float x) {
+    if constexpr (LEMLIB_FAST_MATH) return fast::sin(x);
+    else return std::sin(x);
+}
+
+inline float cos(float x) {
+    if constexpr (LEMLIB_FAST_MATH) return fast::cos(x);
+    else return std::cos(x);
+}
+
+inline void sincos(float x, float& sin, float& cos) {
+    if constexpr (LEMLIB_FAST_MATH) {
+        fast::sincos(x, sin, cos);
+    } else {
+        sin = std::sin(x);
+        cos = std::cos(x);
+    }
+}
+
+inline float atan2(float y, float x) {
+    if constexpr (LEMLIB_FAST_MATH) return fast::atan2(y, x);
+    else return std::atan2(y, x);
+}
+
+inline float hypot(float x, float y) {
+    if constexpr (LEMLIB_FAST_MATH) return fast::hypot(x, y);
+    else return std::hypot(x, y);
+}
+} // namespace lemlib::math
@@ -0,0 +1,329 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#include "lemlib/pose.hpp"
+
+namespace lemlib {
+/**
+ * @brief A rigid transform in 2D: a rotation followed by a translation, as an element of the Lie group SE(2)
+ *
+ * Unlike Pose, whose operators ignore the heading, SE2 composes, inverts and transforms points the way frames do. The
+ * rotation is stored as its cos and sin, so composing, inverting and transforming points are a few multiplies and adds,
+ * without trig. Angles are in radians, counterclockwise from the x axis.
+ *
+ * Tangent vectors (x, y, theta) are in the Lie algebra se(2), with the rotation last. Perturbations are on the right:
+ * X ⊕ τ = X * exp(τ), so Jacobians are of the change in the result's local frame, per change in the inputs' local
+ * frames, as in Solà et al., "A micro Lie theory for state estimation in robotics".
+ *
+ * Everything is constexpr. Construction from an angle, exp and log call std::sin, std::cos and std::atan2, which GCC
+ * evaluates at compile time.
+ *
+ * @tparam T float or double
+ *
+ * @b Example
+ * @code {.cpp}
+ * // the robot, and a point 10 inches in front of it
+ * const lemlib::SE2f robot(chassis.getPose(true));
+ * const lemlib::SE2f::Point ahead = robot.transformPoint({10, 0});
+ * // a target relative to the robot
+ * const lemlib::SE2f relative = robot.inverse() * lemlib::SE2f(target);
+ * @endcode
+ */
+template <typename T> class SE2 {
+        static_assert(std::is_floating_point_v<T>, "SE2 is of float or double");
+    public:
+        /**
+         * @brief A point, or a vector, in the plane
+         */
+        struct Point {
+                T x;
+                T y;
+        };
+
+        /**
+         * @brief An element of se(2): a velocity, or a small change, in the local frame, integrated over a unit of time
+         */
+        struct Tangent {
+                T x;
+                T y;
+                T theta;
+        };
+
+        template <size_t Rows, size_t Columns> using Matrix = std::array<std::array<T, Columns>, Rows>;
+        /** Jacobian of a transform, or tangent, per transform, or tangent */
+        using Jacobian = Matrix<3, 3>;
+
+        T x;
+        T y;
+        /** the rotation, as the cos and sin of its angle */
+        T cos;
+        T sin;
+
+        /**
+         * @brief Construct the identity transform
+         */
+        constexpr SE2()
+            : x(0),
+              y(0),
+              cos(1),
+              sin(0) {}
+
+        /**
+         * @brief Construct a transform from a translation and an angle
+         *
+         * @param x translation along the x axis
+         * @param y translation along the y axis
+         * @param theta rotation, counterclockwise from the x axis, in radians
+         */
+        constexpr SE2(T x, T y, T theta)
+            : x(x),
+              y(y),
+              cos(std::cos(theta)),
+              sin(std::sin(theta)) {}
+
+        /**
+         * @brief Construct a transform from a translation and a rotation's cos and sin
+         *
+         * @param x translation along the x axis
+         * @param y translation along the y axis
+         * @param cos cos of the rotation
+         * @param sin sin of the rotation. cos and sin must be a unit vector
+         */
+        static constexpr SE2 fromRotation(T x, T y, T cos, T sin) {
+            SE2 transform;
+            transform.x = x;
+            transform.y = y;
+            transform.cos = cos;
+            transform.sin = sin;
+            return transform;
+        }
+
+        /**
+         * @brief Convert a pose, as odometry reports it in radians
+         *
+         * Pose's theta is a heading: clockwise from the y axis, in radians. A heading of h is a rotation of pi/2 - h,
+         * so its cos is sin(h) and its sin is cos(h). The transform's x axis points the way the robot faces, and its y
+         * axis to the robot's left.
+         *
+         * @param pose the pose, with its heading in radians
+         */
+        explicit SE2(const Pose& pose)
+            : x(pose.x),
+              y(pose.y),
+              cos(std::sin(T(pose.theta))),
+              sin(std::cos(T(pose.theta))) {}
+
+        /**
+         * @brief Convert to a pose, with its heading in radians, clockwise from the y axis, from -pi to pi
+         */
+        explicit operator Pose() const { return Pose(x, y, std::atan2(cos, sin)); }
+
+        /**
+         * @brief Get the angle of the rotation
+         *
+         * @return T counterclockwise from the x axis, in radians, from -pi to pi
+         */
+        constexpr T angle() const { return std::atan2(sin, cos); }
+
+        /**
+         * @brief Get the translation
+         */
+        constexpr Point translation() const { return {x, y}; }
+
+        /**
+         * @brief Compose this transform with another: the other transform, then this one
+         *
+         * The rotation isn't renormalized, so after many thousands of compositions, call normalized()
+         *
+         * @param other the transform to apply first
+         * @param jacobianThis set to the Jacobian of the result per this transform, if not null
+         * @param jacobianOther set to the Jacobian of the result per the other transform, if not null
+         * @return SE2 this * other
+         */
+        constexpr SE2 compose(const SE2& other, Jacobian* jacobianThis = nullptr,
+                              Jacobian* jacobianOther = nullptr) const {
+            if (jacobianThis != nullptr) *jacobianThis = other.inverse().adjoint();
+            if (jacobianOther != nullptr) *jacobianOther = identityJacobian();
+            return fromRotation(x + cos * other.x - sin * other.y, y + sin * other.x + cos * other.y,
+                                cos * other.cos - sin * other.sin, sin * other.cos + cos * other.sin);
+        }
+
+        /**
+         * @brief Compose this transform with another: the other transform, then this one
+         */
+        constexpr SE2 operator*(const SE2& other) const { return compose(other); }
+
+        /**
+         * @brief Get the inverse transform, which undoes this one
+         *
+         * @param jacobian set to the Jacobian of the inverse per this transform, if not null
+         */
+        constexpr SE2 inverse(Jacobian* jacobian = nullptr) const {
+            if (jacobian != nullptr) {
+                *jacobian = adjoint();
+                for (auto& row : *jacobian) {
+                    for (T& value : row) value = -value;
+                }
+            }
+            return fromRotation(-cos * x - sin * y, sin * x - cos * y, cos, -sin);
+        }
+
+        /**
+         * @brief Transform a point from this transform's frame into the frame it's in
+         *
+         * @param point the point
+         * @param jacobianThis set to the Jacobian of the result per this transform, if not null
+         * @param jacobianPoint set to the Jacobian of the result per the point, if not null
+         */
+        constexpr Point transformPoint(Point point, Matrix<2, 3>* jacobianThis = nullptr,
+                                       Matrix<2, 2>* jacobianPoint = nullptr) const {
+            if (jacobianThis != nullptr) {
+                *jacobianThis = {{{cos, -sin, -sin * point.x - cos * point.y},
+                                  {sin, cos, cos * point.x - sin * point.y}}};
+            }
+            if (jacobianPoint != nullptr) *jacobianPoint = {{{cos, -sin}, {sin, cos}}};
+            return {x + cos * point.x - sin * point.y, y + sin * point.x + cos * point.y};
+        }
+
+        /**
+         * @brief Transform a point from this transform's frame into the frame it's in
+         */
+        constexpr Point operator*(Point point) const { return transformPoint(point); }
+
+        /**
+         * @brief Get the adjoint, which moves tangents from this transform's frame into the frame it's in
+         *
+         * @return Jacobian Ad such that this * exp(τ) = exp(Ad τ) * this
+         */
+        constexpr Jacobian adjoint() const { return {{{cos, -sin, y}, {sin, cos, -x}, {0, 0, 1}}}; }
+
+        /**
+         * @brief The exponential map: the transform reached by moving along a tangent for a unit of time
+         *
+         * The robot drives an arc, or a line when theta is 0, which is the same arc odometry assumes between updates.
+         *
+         * @param tangent the tangent
+         * @param jacobian set to the Jacobian of the result per the tangent, the right Jacobian, if not null
+         */
+        static constexpr SE2 exp(Tangent tangent, Jacobian* jacobian = nullptr) {
+            const T cos = std::cos(tangent.theta);
+            const T sin = std::sin(tangent.theta);
+            const Series series = Series::of(tangent.theta, cos, sin);
+            if (jacobian != nullptr) *jacobian = rightJacobian(tangent, series);
+            return fromRotation(series.a * tangent.x - series.b * tangent.y,
+                                series.b * tangent.x + series.a * tangent.y, cos, sin);
+        }
+
+        /**
+         * @brief The logarithmic map, which inverts exp: the tangent that moves from the identity to this transform
+         *
+         * @param jacobian set to the Jacobian of the tangent per this transform, the inverse right Jacobian, if not
+         * null
+         */
+        constexpr Tangent log(Jacobian* jacobian = nullptr) const {
+            const T theta = angle();
+            const Series series = Series::of(theta, cos, sin);
+            // the translation is V * (x, y) of the tangent, where V = [a, -b; b, a]
+            const T scale = 1 / (series.a * series.a + series.b * series.b);
+            const Tangent tangent {scale * (series.a * x + series.b * y), scale * (series.a * y - series.b * x), theta};
+            if (jacobian != nullptr) *jacobian = invert(rightJacobian(tangent, series));
+            return tangent;
+        }
+
+        /**
+         * @brief Get the right Jacobian of exp, which maps a change in a tangent to a change in the local frame of
+         * its exp
+         */
+        static constexpr Jacobian rightJacobian(Tangent tangent) {
+            return rightJacobian(tangent, Series::of(tangent.theta, std::cos(tangent.theta), std::sin(tangent.theta)));
+        }
+
+        /**
+         * @brief Get the left Jacobian of exp, which maps a change in a tangent to a change in the global frame of
+         * its exp
+         */
+        static constexpr Jacobian leftJacobian(Tangent tangent) {
+            return rightJacobian({-tangent.x, -tangent.y, -tangent.theta});
+        }
+
+        /**
+         * @brief Interpolate between this transform and another, along the arc between them
+         *
+         * @param other the transform at t = 1
+         * @param t from 0, at this transform, to 1, at the other
+         */
+        constexpr SE2 interpolate(const SE2& other, T t) const {
+            const Tangent delta = inverse().compose(other).log();
+            return compose(exp({delta.x * t, delta.y * t, delta.theta * t}));
+        }
+
+        /**
+         * @brief Get this transform with its rotation scaled back to a unit vector, after rounding errors
+         */
+        constexpr SE2 normalized() const {
+            const T norm = std::sqrt(cos * cos + sin * sin);
+            return fromRotation(x, y, cos / norm, sin / norm);
+        }
+
+        /**
+         * @brief Get the 3x3 identity matrix
+         */
+        static constexpr Jacobian identityJacobian() { return {{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}}; }
+    private:
+        /**
+         * @brief sin(theta) / theta, (1 - cos(theta)) / theta, and (theta - sin(theta)) / theta^2
+         *
+         * These all have a removable singularity at 0, and the last cancels catastrophically near it, so it comes from
+         * its Taylor series up to where the series is as accurate as T
+         */
+        struct Series {
+                T a;
+                T b;
+                T c;
+
+                static constexpr Series of(T theta, T cos, T sin) {
+                    constexpr T SERIES_LIMIT = std::is_same_v<T, float> ? 1.5 : 0.2;
+                    const T theta2 = theta * theta;
+                    Series series {1, theta / 2, theta / 6};
+                    if (theta != 0) {
+                        series.a = sin / theta;
+                        // 1 - cos(theta) is sin^2(theta) / (1 + cos(theta)), which doesn't cancel near 0
+                        series.b = (cos > 0 ? sin * sin / (1 + cos) : 1 - cos) / theta;
+                    }
+                    if (std::fabs(theta) < SERIES_LIMIT) {
+                        series.c = theta / 6 *
+                                   (1 - theta2 / 20 * (1 - theta2 / 42 * (1 - theta2 / 72 * (1 - theta2 / 110))));
+                    } else {
+                        series.c = (theta - sin) / theta2;
+                    }
+                    return series;
+                }
+        };
+
+        static constexpr Jacobian rightJacobian(Tangent tangent, const Series& series) {
+            // (1 - cos(theta)) / theta^2, the derivative of b
+            const T d = tangent.theta != 0 ? series.b / tangent.theta : T(0.5);
+            return {{{series.a, series.b, tangent.x * series.c - tangent.y * d},
+                     {-series.b, series.a, tangent.x * d + tangent.y * series.c},
+                     {0, 0, 1}}};
+        }
+
+        // invert a Jacobian of exp: [A, v; 0, 1], with A = [a, b; -b, a]
+        static constexpr Jacobian invert(const Jacobian& jacobian) {
+            const T a = jacobian[0][0];
+            const T b = jacobian[0][1];
+            const T scale = 1 / (a * a + b * b);
+            const Matrix<2, 2> inverse = {{{scale * a, -scale * b}, {scale * b, scale * a}}};
+            return {{{inverse[0][0], inverse[0][1], -(inverse[0][0] * jacobian[0][2] + inverse[0][1] * jacobian[1][2])},
+                     {inverse[1][0], inverse[1][1], -(inverse[1][0] * jacobian[0][2] + inverse[1][1] * jacobian[1][2])},
+                     {0, 0, 1}}};
+        }
+};
+
+using SE2f = SE2<float>;
+using SE2d = SE2<double>;
+} // namespace lemlib
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "lemlib/asset.hpp"
+#include "lemlib/path/spline.hpp"
+
+namespace lemlib {
+/**
+ * @brief A waypoint that can be used at compile time, which Pose can't
+ */
+struct Waypoint {
+        float x;
+        float y;
+        /** heading in degrees, like Chassis::moveToPose() */
+        float theta = 0;
+};
+
+/**
+ * @brief Get the segments of a spline through waypoints, like CubicHermite, at compile time
+ */
+template <size_t W>
+constexpr std::array<SplineSegment, W - 1> cubicHermiteSegments(const std::array<Waypoint, W>& waypoints,
+                                                                float tension = 1) {
+    static_assert(W >= 2, "a spline needs a start and an end");
+    std::array<SplineSegment, W - 1> segments;
+    spline::hermite(waypoints, tension, false, segments.begin());
+    return segments;
+}
+
+/**
+ * @brief Get the segments of a spline through waypoints, like QuinticHermite, at compile time
+ */
+template <size_t W>
+constexpr std::array<SplineSegment, W - 1> quinticHermiteSegments(const std::array<Waypoint, W>& waypoints,
+                                                                  float tension = 1) {
+    static_assert(W >= 2, "a spline needs a start and an end");
+    std::array<SplineSegment, W - 1> segments;
+    spline::hermite(waypoints, tension, true, segments.begin());
+    return segments;
+}
+
+/**
+ * @brief Get the segments of a spline from control points, like CubicBezier, at compile time
+ */
+template <size_t W>
+constexpr std::array<SplineSegment, (W - 1) / 3> cubicBezierSegments(const std::array<Waypoint, W>& controlPoints) {
+    static_assert(W >= 4, "a segment needs 4 control points");
+    std::array<SplineSegment, (W - 1) / 3> segments;
+    spline::bezier(controlPoints, segments.begin());
+    return segments;
+}
+
+/**
+ * @brief A path generated from a spline by the compiler
+ *
+ * Declared static constexpr, the whole path, its speeds and its path file are computed at compile time and stored in
+ * flash, in .rodata, so there is no parsing, heap or initialization before it's used. Properties of the path, like
+ * its largest curvature, can be checked with static_assert.
+ *
+ * The points are spaced evenly along the spline, and their speeds are found as Spline::generate() finds them.
+ *
+ * @tparam N number of points, which sets their spacing
+ *
+ * @b Example
+ * @code {.cpp}
+ * constexpr std::array<lemlib::Waypoint, 2> waypoints {{{-46.5, 0, 180}, {-54, -48, 270}}};
+ * static constexpr lemlib::CompiledPath<64> route(lemlib::quinticHermiteSegments(waypoints));
+ * static_assert(route.maxCurvature < 1 / 6.0f, "the route turns tighter than a radius of 6 inches");
+ * // an asset pointing to the path file in flash, like ASSET(), so follow() can follow it. constinit makes sure it's
+ * // set at compile time
+ * static constinit asset route_txt = route.file();
+ *
+ * void autonomous() { chassis.follow(route_txt, 10, 4000); }
+ * @endcode
+ */
+template <size_t N> struct CompiledPath {
+        static_assert(N >= 2, "a path needs a start and an end");
+
+        /** x coordinate of each point */
+        std::array<float, N> x {};
+        /** y coordinate of each point */
+        std::array<float, N> y {};
+        /** speed at each point, from 0 to 127 */
+        std::array<float, N> speed {};
+        /** curvature at each point. Positive turns left */
+        std::array<float, N> curvature {};
+        /** length of the path. Units in inches */
+        float length = 0;
+        /** distance between points. Units in inches */
+        float spacing = 0;
+        /** the largest curvature, turning either way */
+        float maxCurvature = 0;
+        /** the points in the path file format: "x, y, speed" lines, then "endData". There's room for coordinates
+         * up to 10000 in size, and a path that doesn't fit fails to compile */
+        std::array<uint8_t, N * 32 + 8> text {};
+        /** length of the path file */
+        size_t textSize = 0;
+
+        /**
+         * @brief Generate a path from the segments of a spline
+         *
+         * @param segments the segments, in order, like those from quinticHermiteSegments()
+         * @param settings the speeds of the points. The spacing is ignored, since N sets it
+         */
+        template <typename Segments>
+        constexpr explicit CompiledPath(const Segments& segments, const PathSettings& settings = {}) {
+            // the table is freed before compilation ends, so it doesn't make it into the program
+            std::vector<float> lengths(std::size(segments) * spline::SUBDIVISIONS + 1);
+            spline::tabulate(segments, lengths);
+            length = lengths.back();
+            spacing = length / (N - 1);
+            size_t entry = 0;
+            for (size_t i = 0; i < N; i++) {
+                float t;
+                const SplineSegment& segment =
+                    spline::locate(segments, spline::parameter(segments, lengths, i * spacing, entry), t);
+                const SplineSegment::Vector position = segment.position(t);
+                x[i] = position.x;
+                y[i] = position.y;
+                curvature[i] = segment.curvature(t);
+                maxCurvature = std::max(maxCurvature, std::fabs(curvature[i]));
+            }
+            spline::profile(curvature, speed, spacing, settings);
+            for (size_t i = 0; i < N; i++) {
+                write(x[i]);
+                write(", ");
+                write(y[i]);
+                write(", ");
+                write(speed[i]);
+                write("\n");
+            }
+            write("endData\n");
+        }
+
+        /**
+         * @brief Get an asset for the path file, which Chassis::follow() can follow
+         *
+         * Stored in a static constinit asset, it's set at compile time too. follow() only reads the path file.
+         */
+        constexpr asset file() const { return {const_cast<uint8_t*>(text.data()), textSize}; }
+    private:
+        constexpr void write(const char* string) {
+            while (*string != '\0') text[textSize++] = *string++;
+        }
+
+        // a number with 3 decimal places, like "%.3f"
+        constexpr void write(float value) {
+            const int64_t thousandths = int64_t(std::fabs(value) * 1000 + 0.5f);
+            if (value < 0 && thousandths != 0) write("-");
+            char digits[24] = {};
+            int count = 0;
+            for (int64_t rest = thousandths; rest > 0 || count < 4; rest /= 10) digits[count++] = char('0' + rest % 10);
+            while (count > 3) text[textSize++] = digits[--count];
+            text[textSize++] = '.';
+            while (count > 0) text[textSize++] = digits[--count];
+        }
+};
+} // namespace lemlib
@@ -0,0 +1,475 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "lemlib/asset.hpp"
+#include "lemlib/math/angle.hpp"
+#include "lemlib/pose.hpp"
+#include "lemlib/util.hpp"
+
+namespace lemlib {
+/**
+ * @brief One piece of a spline: a polynomial of degree 5 or less in each axis, of t from 0 to 1
+ *
+ * Cubic Hermite, quintic Hermite and cubic Bézier pieces are all converted to this form, so they are evaluated the
+ * same way.
+ */
+struct SplineSegment {
+        /**
+         * @brief A position or derivative
+         */
+        struct Vector {
+                float x;
+                float y;
+        };
+
+        /** coefficients of t^0 to t^5 in x */
+        std::array<float, 6> x {};
+        /** coefficients of t^0 to t^5 in y */
+        std::array<float, 6> y {};
+
+        /**
+         * @brief Get the position at t
+         */
+        constexpr Vector position(float t) const { return {evaluate(x, t), evaluate(y, t)}; }
+
+        /**
+         * @brief Get the first derivative at t, which points along the spline
+         */
+        constexpr Vector derivative(float t) const { return {evaluate(derive(x), t), evaluate(derive(y), t)}; }
+
+        /**
+         * @brief Get the second derivative at t
+         */
+        constexpr Vector secondDerivative(float t) const {
+            return {evaluate(derive(derive(x)), t), evaluate(derive(derive(y)), t)};
+        }
+
+        /**
+         * @brief Get how fast the position moves along the spline at t, the length of the first derivative
+         */
+        constexpr float rate(float t) const {
+            const Vector d = derivative(t);
+            return std::sqrt(d.x * d.x + d.y * d.y);
+        }
+
+        /**
+         * @brief Get the curvature at t: 1 over the radius of the turn. Positive turns left
+         */
+        constexpr float curvature(float t) const {
+            const Vector d1 = derivative(t);
+            const Vector d2 = secondDerivative(t);
+            const float speed = std::sqrt(d1.x * d1.x + d1.y * d1.y);
+            return speed == 0 ? 0 : (d1.x * d2.y - d1.y * d2.x) / (speed * speed * speed);
+        }
+
+        /**
+         * @brief Get the heading at t in degrees, where 0 is along the y axis and 90 along the x axis
+         */
+        constexpr float heading(float t) const {
+            const Vector d = derivative(t);
+            return math::sanitizeAngle(radToDeg(std::atan2(d.x, d.y)), false);
+        }
+
+        /**
+         * @brief Create a cubic Hermite segment, from its end points and the derivatives there
+         */
+        static constexpr SplineSegment cubicHermite(Vector p0, Vector v0, Vector p1, Vector v1) {
+            SplineSegment segment;
+            cubic(segment.x, p0.x, v0.x, p1.x, v1.x);
+            cubic(segment.y, p0.y, v0.y, p1.y, v1.y);
+            return segment;
+        }
+
+        /**
+         * @brief Create a quintic Hermite segment, from its end points and the first and second derivatives there
+         */
+        static constexpr SplineSegment quinticHermite(Vector p0, Vector v0, Vector a0, Vector p1, Vector v1,
+                                                      Vector a1) {
+            SplineSegment segment;
+            quintic(segment.x, p0.x, v0.x, a0.x, p1.x, v1.x, a1.x);
+            quintic(segment.y, p0.y, v0.y, a0.y, p1.y, v1.y, a1.y);
+            return segment;
+        }
+
+        /**
+         * @brief Create a cubic Bézier segment, from its 4 control points
+         */
+        static constexpr SplineSegment cubicBezier(Vector p0, Vector p1, Vector p2, Vector p3) {
+            SplineSegment segment;
+            bezier(segment.x, p0.x, p1.x, p2.x, p3.x);
+            bezier(segment.y, p0.y, p1.y, p2.y, p3.y);
+            return segment;
+        }
+    private:
+        // Horner's method
+        static constexpr float evaluate(const std::array<float, 6>& c, float t) {
+            return c[0] + t * (c[1] + t * (c[2] + t * (c[3] + t * (c[4] + t * c[5]))));
+        }
+
+        static constexpr std::array<float, 6> derive(const std::array<float, 6>& c) {
+            return {c[1], 2 * c[2], 3 * c[3], 4 * c[4], 5 * c[5], 0};
+        }
+
+        // the Hermite bases, multiplied out
+        static constexpr void cubic(std::array<float, 6>& c, float p0, float v0, float p1, float v1) {
+            c = {p0, v0, 3 * (p1 - p0) - 2 * v0 - v1, 2 * (p0 - p1) + v0 + v1, 0, 0};
+        }
+
+        static constexpr void quintic(std::array<float, 6>& c, float p0, float v0, float a0, float p1, float v1,
+                                      float a1) {
+            c = {p0,
+                 v0,
+                 a0 / 2,
+                 10 * (p1 - p0) - 6 * v0 - 4 * v1 - 1.5f * a0 + a1 / 2,
+                 15 * (p0 - p1) + 8 * v0 + 7 * v1 + 1.5f * a0 - a1,
+                 6 * (p1 - p0) - 3 * v0 - 3 * v1 - a0 / 2 + a1 / 2};
+        }
+
+        // the Bernstein basis, multiplied out
+        static constexpr void bezier(std::array<float, 6>& c, float p0, float p1, float p2, float p3) {
+            c = {p0, 3 * (p1 - p0), 3 * (p0 - 2 * p1 + p2), p3 - p0 + 3 * (p1 - p2), 0, 0};
+        }
+};
+
+/**
+ * @brief Settings for turning a spline into a path that Chassis::follow() can follow
+ */
+struct PathSettings {
+        /** distance between points. Units in inches */
+        float spacing = 1;
+        /** the fastest the robot goes, from 0 to 127 */
+        float maxSpeed = 127;
+        /** the slowest the robot goes, except at the end, from 0 to 127 */
+        float minSpeed = 20;
+        /** how fast the robot goes around a turn with a radius of 1 inch. It goes this many times faster around a turn
+         * that many times wider */
+        float turnSpeed = 8;
+        /** how much the speed drops per inch as the robot comes to a stop at the end */
+        float deceleration = 4;
+};
+
+/**
+ * @brief The steps of building and sampling splines, shared by Spline, at run time, and CompiledPath, at compile time
+ *
+ * Segments, waypoints and tables can be any containers that can be indexed, like std::vector and std::array.
+ */
+namespace spline {
+// the arc length table has this many entries per segment, each integrated with Gauss–Legendre quadrature
+constexpr int SUBDIVISIONS = 16;
+// the 5 point rule, which is exact for polynomials of degree 9, on [-1, 1]
+constexpr float NODES[] = {0, -0.538469310105683f, 0.538469310105683f, -0.906179845938664f, 0.906179845938664f};
+constexpr float WEIGHTS[] = {0.568888888888889f, 0.478628670499366f, 0.478628670499366f, 0.236926885056189f,
+                             0.236926885056189f};
+// Newton-Raphson steps to refine each parameter found from the table
+constexpr int REFINEMENTS = 3;
+
+// the direction of a heading in degrees, where 0 is along the y axis, scaled to a length
+constexpr SplineSegment::Vector direction(float heading, float length) {
+    const float radians = degToRad(heading);
+    return {std::sin(radians) * length, std::cos(radians) * length};
+}
+
+/**
+ * @brief Write a Hermite segment between each pair of waypoints, leaving and arriving along their headings
+ *
+ * @param waypoints anything with an x, a y, and a heading in degrees as a theta, like Pose
+ * @param tension how long the tangents are, as a fraction of the distance to the next waypoint
+ * @param quintic whether the segments are quintic, with no curvature at the waypoints, or cubic
+ * @param out where to write the segments
+ */
+template <typename Waypoints, typename Output>
+constexpr void hermite(const Waypoints& waypoints, float tension, bool quintic, Output out) {
+    for (size_t i = 0; i + 1 < std::size(waypoints); i++) {
+        const auto& from = waypoints[i];
+        const auto& to = waypoints[i + 1];
+        const float length = tension * std::sqrt((to.x - from.x) * (to.x - from.x) + (to.y - from.y) * (to.y - from.y));
+        const SplineSegment::Vector start = direction(from.theta, length);
+        const SplineSegment::Vector end = direction(to.theta, length);
+        *out++ = quintic ? SplineSegment::quinticHermite({from.x, from.y}, start, {0, 0}, {to.x, to.y}, end, {0, 0})
+                         : SplineSegment::cubicHermite({from.x, from.y}, start, {to.x, to.y}, end);
+    }
+}
+
+/**
+ * @brief Write a cubic Bézier segment for each 3 control points after the first
+ *
+ * @param controlPoints anything with an x and a y, like Pose
+ * @param out where to write the segments
+ */
+template <typename Points, typename Output> constexpr void bezier(const Points& controlPoints, Output out) {
+    for (size_t i = 0; i + 3 < std::size(controlPoints); i += 3) {
+        const auto& p = controlPoints;
+        *out++ = SplineSegment::cubicBezier({p[i].x, p[i].y}, {p[i + 1].x, p[i + 1].y}, {p[i + 2].x, p[i + 2].y},
+                                            {p[i + 3].x, p[i + 3].y});
+    }
+}
+
+/**
+ * @brief Find the segment a parameter is in, and its t in that segment
+ *
+ * @param u the segment's index plus the segment's t
+ */
+template <typename Segments> constexpr const SplineSegment& locate(const Segments& segments, float u, float& t) {
+    const size_t i = std::min(size_t(std::max(u, 0.0f)), std::size(segments) - 1);
+    t = u - i;
+    return segments[i];
+}
+
+/**
+ * @brief Integrate the arc length between 2 parameters in the same segment
+ */
+template <typename Segments> constexpr float integrate(const Segments& segments, float from, float to) {
+    const float middle = (from + to) / 2;
+    const float half = (to - from) / 2;
+    float sum = 0;
+    for (int i = 0; i < 5; i++) {
+        float t;
+        const SplineSegment& segment = locate(segments, middle + half * NODES[i], t);
+        sum += WEIGHTS[i] * segment.rate(t);
+    }
+    return sum * half;
+}
+
+/**
+ * @brief Fill the arc length table: the arc length at each subdivision of each segment
+ *
+ * @param lengths the table, which must have SUBDIVISIONS entries per segment, plus 1
+ */
+template <typename Segments, typename Lengths> constexpr void tabulate(const Segments& segments, Lengths& lengths) {
+    constexpr float WIDTH = 1.0f / SUBDIVISIONS;
+    lengths[0] = 0;
+    for (size_t i = 0; i + 1 < std::size(lengths); i++) {
+        lengths[i + 1] = lengths[i] + integrate(segments, i * WIDTH, (i + 1) * WIDTH);
+    }
+}
+
+/**
+ * @brief Find the parameter at a distance along the spline, from the arc length table
+ *
+ * The table is interpolated, then refined with Newton-Raphson steps, since within an entry, the arc length is 1
+ * integral away.
+ *
+ * @param entry the entry to start looking from. It's left where the distance was found, so finding increasing
+ * distances takes 1 pass over the table
+ * @return float the segment's index plus the segment's t
+ */
+template <typename Segments, typename Lengths>
+constexpr float parameter(const Segments& segments, const Lengths& lengths, float distance, size_t& entry) {
+    constexpr float WIDTH = 1.0f / SUBDIVISIONS;
+    while (entry + 2 < std::size(lengths) && lengths[entry + 1] < distance) entry++;
+    const float from = entry * WIDTH;
+    const float span = lengths[entry + 1] - lengths[entry];
+    if (span <= 0) return from;
+    float u = from + (distance - lengths[entry]) / span * WIDTH;
+    for (int i = 0; i < REFINEMENTS; i++) {
+        float t;
+        const float rate = locate(segments, u, t).rate(t);
+        if (rate == 0) break;
+        const float error = lengths[entry] + integrate(segments, from, u) - distance;
+        u = std::clamp(u - error / rate, from, from + WIDTH);
+    }
+    return u;
+}
+
+/**
+ * @brief Find the speed at each point of a path
+ *
+ * The speed is limited by the curvature, then lowered so the robot slows down steadily to a stop at the end, where it
+ * is 0.
+ *
+ * @param curvatures the curvature at each point
+ * @param speeds where to write the speeds, with as many entries as curvatures
+ * @param spacing distance between points
+ */
+template <typename Curvatures, typename Speeds>
+constexpr void profile(const Curvatures& curvatures, Speeds& speeds, float spacing, const PathSettings& settings) {
+    const size_t count = std::size(curvatures);
+    if (count == 0) return;
+    for (size_t i = 0; i < count; i++) {
+        const float bend = std::fabs(curvatures[i]);
+        speeds[i] = bend > 0 ? std::min(settings.maxSpeed, settings.turnSpeed / bend) : settings.maxSpeed;
+    }
+    // from the end back
+    speeds[count - 1] = 0;
+    for (size_t i = count - 1; i-- > 0;) {
+        speeds[i] = std::max(std::min(speeds[i], speeds[i + 1] + settings.deceleration * spacing), settings.minSpeed);
+    }
+}
+} // namespace spline
+
+/**
+ * @brief A path made of polynomial segments, which can be sampled by distance along it
+ *
+ * A spline's parameter doesn't move along it at a constant rate, so when it is built, its arc length is integrated with
+ * Gauss–Legendre quadrature, and inverted into a table of the parameter at each multiple of a resolution. Sampling at
+ * a distance then looks up and interpolates the table, and evaluates one polynomial, whatever the length of the spline.
+ *
+ * CubicHermite, QuinticHermite and CubicBezier build splines from waypoints or control points.
+ */
+class Spline {
+    public:
+        /**
+         * @brief Construct a spline from its segments, in order
+         *
+         * @param segments the segments. Each should start where the last one ends. With none, the spline is a point at
+         * the origin
+         * @param resolution distance between entries of the arc length table. Units in inches
+         */
+        explicit Spline(std::vector<SplineSegment> segments, float resolution = 0.25);
+
+        /**
+         * @brief Get the length of the spline. Units in inches
+         */
+        float length() const { return totalLength; }
+
+        /**
+         * @brief Get the position and heading at a distance along the spline
+         *
+         * @param distance distance from the start, clamped to the spline. Units in inches
+         * @return Pose the position, and the heading in degrees, where 0 is along the y axis and 90 along the x axis,
+         * like Chassis::moveToPose()
+         */
+        Pose sample(float distance) const;
+
+        /**
+         * @brief Get the curvature at a distance along the spline
+         *
+         * @param distance distance from the start, clamped to the spline. Units in inches
+         * @return float 1 over the radius of the turn. Positive turns left
+         */
+        float curvature(float distance) const;
+
+        /**
+         * @brief Get the heading at a distance along the spline
+         *
+         * @param distance distance from the start, clamped to the spline. Units in inches
+         * @return float heading in degrees, like Chassis::moveToPose()
+         */
+        float heading(float distance) const;
+
+        /**
+         * @brief Sample the spline into points that Chassis::follow() can follow
+         *
+         * The speed at each point is limited by the curvature there, then lowered so the robot slows down steadily to
+         * a stop at the end, where it is 0.
+         *
+         * @param settings spacing and speeds of the points
+         * @return std::vector<Pose> the points, with the speed at each as its theta, like a path file
+         */
+        std::vector<Pose> generate(const PathSettings& settings = {}) const;
+    private:
+        /**
+         * @brief Find the parameter at a distance along the spline, from the inverse table
+         *
+         * @return float the segment's index plus the segment's t
+         */
+        float parameter(float distance) const;
+
+        std::vector<SplineSegment> segments;
+        /** arc length at each subdivision of each segment */
+        std::vector<float> lengths;
+        /** parameter at each multiple of step along the spline */
+        std::vector<float> parameters;
+        float step = 0;
+        float totalLength = 0;
+};
+
+/**
+ * @brief A spline through waypoints, with a cubic Hermite segment between each pair
+ *
+ * The spline leaves each waypoint along its heading. The curvature can jump at a waypoint.
+ */
+class CubicHermite : public Spline {
+    public:
+        /**
+         * @brief Construct a spline through waypoints
+         *
+         * @param waypoints the waypoints, with the heading there in degrees as the theta
+         * @param tension how long the tangents are, as a fraction of the distance to the next waypoint. Larger values
+         * make the spline go straighter through waypoints, and swing wider between them
+         * @param resolution distance between entries of the arc length table. Units in inches
+         *
+         * @b Example
+         * @code {.cpp}
+         * // an S from (0, 0), facing up, to (24, 48), also facing up
+         * lemlib::CubicHermite spline({{0, 0, 0}, {24, 48, 0}});
+         * @endcode
+         */
+        explicit CubicHermite(const std::vector<Pose>& waypoints, float tension = 1, float resolution = 0.25);
+};
+
+/**
+ * @brief A spline through waypoints, with a quintic Hermite segment between each pair
+ *
+ * Like CubicHermite, except the spline goes straight through each waypoint, with a curvature of 0, so the curvature
+ * is continuous.
+ */
+class QuinticHermite : public Spline {
+    public:
+        /**
+         * @brief Construct a spline through waypoints
+         *
+         * @param waypoints the waypoints, with the heading there in degrees as the theta
+         * @param tension how long the tangents are, as a fraction of the distance to the next waypoint
+         * @param resolution distance between entries of the arc length table. Units in inches
+         */
+        explicit QuinticHermite(const std::vector<Pose>& waypoints, float tension = 1, float resolution = 0.25);
+};
+
+/**
+ * @brief A spline of cubic Bézier segments
+ */
+class CubicBezier : public Spline {
+    public:
+        /**
+         * @brief Construct a spline from control points
+         *
+         * @param controlPoints the start, then 3 points for each segment: 2 that it bends towards, then its end. Their
+         * thetas are ignored. Extra points that don't make a whole segment are ignored
+         * @param resolution distance between entries of the arc length table. Units in inches
+         *
+         * @b Example
+         * @code {.cpp}
+         * // a quarter of a circle of radius 24, almost
+         * lemlib::CubicBezier spline({{0, 0}, {0, 13.25}, {10.75, 24}, {24, 24}});
+         * @endcode
+         */
+        explicit CubicBezier(const std::vector<Pose>& controlPoints, float resolution = 0.25);
+};
+
+/**
+ * @brief Points in the format of a path file, so Chassis::follow() can follow them
+ *
+ * @b Example
+ * @code {.cpp}
+ * const lemlib::PathAsset path(lemlib::QuinticHermite({{0, 0, 0}, {24, 48, 90}}).generate());
+ * chassis.follow(path, 10, 4000);
+ * @endcode
+ *
+ * @note follow() reads the path while it runs, so the PathAsset must last until the motion ends
+ */
+class PathAsset {
+    public:
+        /**
+         * @brief Format points as a path file
+         *
+         * @param points the points, with the speed at each as its theta
+         */
+        explicit PathAsset(const std::vector<Pose>& points);
+
+        // file points into text, which a copy would leave behind
+        PathAsset(const PathAsset&) = delete;
+        PathAsset& operator=(const PathAsset&) = delete;
+
+        operator const asset&() const { return file; }
+    private:
+        std::vector<char> text;
+        asset file;
+};
+} // namespace lemlib
@@ -0,0 +1,285 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "pros/rtos.hpp"
+
+namespace lemlib {
+/**
+ * @brief How a periodic task missed its deadline
+ */
+enum class DeadlineMissType : uint8_t {
+    /** the cycle started later than its period allows */
+    LATE,
+    /** the cycle took longer than its budget */
+    OVER_BUDGET
+};
+
+/**
+ * @brief A missed deadline
+ */
+struct DeadlineMiss {
+        /** the name of the deadline */
+        const char* name = nullptr;
+        /** when the deadline was missed, in milliseconds */
+        uint32_t time = 0;
+        /** by how much the deadline was missed, in microseconds */
+        uint32_t amount = 0;
+        DeadlineMissType type = DeadlineMissType::LATE;
+};
+
+/**
+ * @brief The deadline of a periodic task
+ *
+ * The task marks each cycle with beginCycle() and endCycle(). A cycle misses its deadline if it starts more than half a
+ * period late, or if it runs for longer than its budget. Loops that wait with pros::delay() instead of
+ * pros::Task::delay_until() also count the time they run as part of their period, so their budget should be at most
+ * half of their period.
+ */
+class Deadline {
+    public:
+        /**
+         * @brief Mark the start of a cycle. Must be called from the monitored task
+         */
+        void beginCycle();
+
+        /**
+         * @brief Mark the end of a cycle. Must be called from the monitored task
+         */
+        void endCycle();
+
+        /**
+         * @brief Mark the end of a cycle with a budget of its own. Must be called from the monitored task
+         *
+         * For work that isn't periodic and whose budget depends on what it does, like a motion with a timeout.
+         *
+         * @param cycleBudget how long the cycle could take, in microseconds
+         */
+        void endCycle(uint32_t cycleBudget);
+
+        /**
+         * @brief Get the name of the deadline
+         *
+         * @return const char*
+         */
+        const char* getName() const { return name; }
+
+        /**
+         * @brief Get the number of cycles that started late
+         *
+         * @return uint32_t
+         */
+        uint32_t getLateCount() const { return late.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Get the number of cycles that took longer than their budget
+         *
+         * @return uint32_t
+         */
+        uint32_t getOverBudgetCount() const { return overBudget.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Get the time of the last missed deadline
+         *
+         * @return uint32_t time in milliseconds, or 0 if it was never missed
+         */
+        uint32_t getLastMissTime() const { return lastMiss.load(std::memory_order_relaxed); }
+    private:
+        friend class DeadlineMonitor;
+
+        /**
+         * @brief Count and record a missed deadline
+         */
+        void miss(DeadlineMissType type, uint32_t amount);
+
+        const char* name = nullptr;
+        uint32_t period = 0;
+        uint32_t budget = 0;
+
+        uint32_t cycleStart = 0;
+        bool started = false;
+        std::atomic<uint32_t> late = 0;
+        std::atomic<uint32_t> overBudget = 0;
+        std::atomic<uint32_t> lastMiss = 0;
+};
+
+/**
+ * @brief Marks one cycle of a deadline for as long as it is in scope
+ *
+ * @b Example
+ * @code {.cpp}
+ * lemlib::Deadline* deadline = lemlib::deadlineMonitor().add("intake", 10, 2000);
+ * while (true) {
+ *     {
+ *         lemlib::DeadlineCycle cycle(deadline);
+ *         // control the intake
+ *     }
+ *     pros::delay(10);
+ * }
+ * @endcode
+ */
+class DeadlineCycle {
+    public:
+        /**
+         * @brief Begin a cycle
+         *
+         * @param deadline the deadline of the current task. Nothing is measured if nullptr
+         */
+        explicit DeadlineCycle(Deadline* deadline)
+            : deadline(deadline) {
+            if (deadline != nullptr) deadline->beginCycle();
+        }
+
+        /**
+         * @brief End the cycle
+         */
+        ~DeadlineCycle() {
+            if (deadline != nullptr) deadline->endCycle();
+        }
+
+        DeadlineCycle(const DeadlineCycle&) = delete;
+        DeadlineCycle& operator=(const DeadlineCycle&) = delete;
+    private:
+        Deadline* deadline;
+};
+
+/**
+ * @brief Watches the deadlines of periodic tasks and switches to degraded mode when they keep being missed
+ *
+ * A high priority watchdog task counts missed deadlines. Once a number of them are missed within a window, degraded
+ * mode starts: inDegradedMode() returns true, and work that can wait, like telemetry deltas and brain screen updates,
+ * is skipped so the tasks that control the robot keep their rate. Degraded mode ends once no deadline has been missed
+ * for the recovery time. Misses, and degraded mode starting and ending, are logged with LEMLIB_DEFERRED_LOG.
+ *
+ * @b Example
+ * @code {.cpp}
+ * lemlib::Deadline* deadline = lemlib::deadlineMonitor().add("intake", 10, 2000);
+ * uint32_t now = pros::millis();
+ * while (true) {
+ *     deadline->beginCycle();
+ *     // control the intake
+ *     deadline->endCycle();
+ *     pros::Task::delay_until(&now, 10);
+ * }
+ * @endcode
+ */
+class DeadlineMonitor {
+    public:
+        /** maximum number of deadlines */
+        static constexpr size_t MAX_DEADLINES = 24;
+        /** number of missed deadlines kept by getRecentMisses() */
+        static constexpr size_t RECENT_MISSES = 16;
+
+        /**
+         * @brief Construct a new Deadline Monitor
+         *
+         * @param checkInterval how often the watchdog checks for missed deadlines, in milliseconds
+         */
+        DeadlineMonitor(uint32_t checkInterval = 50);
+
+        /**
+         * @brief Destroy the Deadline Monitor object
+         *
+         */
+        ~DeadlineMonitor();
+
+        DeadlineMonitor(const DeadlineMonitor&) = delete;
+        DeadlineMonitor& operator=(const DeadlineMonitor&) = delete;
+
+        /**
+         * @brief Add a deadline
+         *
+         * Adding a deadline with the same name as an existing one returns the existing one, so tasks that are created
+         * again, like opcontrol, can add their deadline every time they start.
+         *
+         * @param name name of the deadline. Must outlive the monitor
+         * @param period time between the start of cycles, in milliseconds, or 0 for tasks that aren't periodic
+         * @param budget maximum time a cycle can run for, in microseconds
+         * @return Deadline* the deadline, or nullptr if there are too many deadlines
+         */
+        Deadline* add(const char* name, uint32_t period, uint32_t budget);
+
+        /**
+         * @brief Set when degraded mode starts and ends
+         *
+         * @param misses number of missed deadlines that start degraded mode
+         * @param window time the misses have to happen within, in milliseconds
+         * @param recovery time without misses that ends degraded mode, in milliseconds
+         */
+        void setDegradePolicy(uint32_t misses, uint32_t window, uint32_t recovery);
+
+        /**
+         * @brief Get the total number of missed deadlines
+         *
+         * @return uint32_t
+         */
+        uint32_t getMissCount() const { return missCount.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Get the number of times degraded mode started
+         *
+         * @return uint32_t
+         */
+        uint32_t getDegradedCount() const { return degradedCount.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Copy the most recent missed deadlines, newest first
+         *
+         * @param misses array to copy the misses to
+         * @param size size of the array
+         * @return size_t number of misses copied
+         */
+        size_t getRecentMisses(DeadlineMiss* misses, size_t size) const;
+
+        /**
+         * @brief Print every deadline and the most recent misses to stdout
+         */
+        void printReport() const;
+    private:
+        friend class Deadline;
+
+        /**
+         * @brief Record a missed deadline
+         */
+        void record(const DeadlineMiss& miss);
+
+        /**
+         * @brief The function that will be run inside of the watchdog's task.
+         *
+         */
+        void taskLoop();
+
+        const uint32_t checkInterval;
+        std::array<Deadline, MAX_DEADLINES> deadlines {};
+        std::atomic<size_t> deadlineCount = 0;
+
+        std::array<DeadlineMiss, RECENT_MISSES> recent {};
+        std::atomic<uint32_t> missCount = 0;
+        std::atomic<uint32_t> degradedCount = 0;
+
+        std::atomic<uint32_t> degradeMisses = 3;
+        std::atomic<uint32_t> degradeWindow = 1000;
+        std::atomic<uint32_t> recoveryTime = 2000;
+
+        pros::Mutex mutex;
+        pros::Task task;
+};
+
+/**
+ * @brief Get the deadline monitor
+ *
+ * @return DeadlineMonitor&
+ */
+DeadlineMonitor& deadlineMonitor();
+
+/**
+ * @brief Whether work that can wait should be skipped, because deadlines keep being missed
+ *
+ * Doesn't create the deadline monitor, so it can be checked by code that doesn't use it.
+ *
+ * @return true if in degraded mode
+ */
+bool inDegradedMode();
+} // namespace lemlib
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Whether the global operator new and operator delete are replaced with counting versions
+ *
+ * Set to 1 with -DLEMLIB_HEAP_TRACKING=1. When it is 0, the standard allocator is used, HeapTag and NoAllocZone do
+ * nothing, and every statistic is 0.
+ *
+ * Only code linked into the same image uses the replacements, so the Makefile refuses to build it with hot/cold
+ * linking (USE_PACKAGE:=1), where the kernel and LemLib are in the cold image. Blocks that were allocated without
+ * them anyway are recognized when they are freed, and freed as they are, without being counted.
+ */
+#ifndef LEMLIB_HEAP_TRACKING
+#define LEMLIB_HEAP_TRACKING 0
+#endif
+
+namespace lemlib {
+/**
+ * @brief Allocation statistics of the whole program or of a single tag
+ */
+struct HeapStats {
+        /** number of allocations */
+        uint32_t allocations = 0;
+        /** number of frees */
+        uint32_t frees = 0;
+        /** total bytes allocated */
+        uint32_t totalBytes = 0;
+        /** bytes currently allocated */
+        uint32_t liveBytes = 0;
+        /** largest number of bytes allocated at the same time */
+        uint32_t peakBytes = 0;
+};
+
+/**
+ * @brief Attributes allocations made by the current task to a subsystem, for as long as it is in scope
+ *
+ * Tags can be nested, the innermost one is used. Memory is attributed to the tag it was allocated under, even if it is
+ * freed somewhere else. Only tasks can be tagged, so on the host, threads that aren't tasks allocate untagged.
+ *
+ * @b Example
+ * @code {.cpp}
+ * void loadPath() {
+ *     lemlib::HeapTag tag("paths");
+ *     // every allocation until the end of the function counts towards "paths"
+ * }
+ * @endcode
+ */
+class HeapTag {
+    public:
+        /**
+         * @brief Start attributing allocations to a tag
+         *
+         * @param name name of the tag. Must outlive the program
+         */
+        explicit HeapTag(const char* name);
+
+        /**
+         * @brief Go back to the previous tag
+         */
+        ~HeapTag();
+
+        HeapTag(const HeapTag&) = delete;
+        HeapTag& operator=(const HeapTag&) = delete;
+    private:
+        uint8_t previous = 0;
+};
+
+/**
+ * @brief Marks code that must not allocate, like the body of a control loop
+ *
+ * Allocating in the current task while a zone is in scope counts as a violation. Zones have no effect in threads that
+ * aren't tasks. By default violations are only counted, see setNoAllocAbort() to stop the program at the first one
+ * instead.
+ *
+ * @b Example
+ * @code {.cpp}
+ * while (true) {
+ *     {
+ *         lemlib::NoAllocZone zone("opcontrol");
+ *         chassis.arcade(leftY, rightX);
+ *     }
+ *     pros::delay(10);
+ * }
+ * @endcode
+ */
+class NoAllocZone {
+    public:
+        /**
+         * @brief Enter the zone
+         *
+         * @param name name of the zone, reported with violations. Must outlive the program
+         */
+        explicit NoAllocZone(const char* name);
+
+        /**
+         * @brief Leave the zone
+         */
+        ~NoAllocZone();
+
+        NoAllocZone(const NoAllocZone&) = delete;
+        NoAllocZone& operator=(const NoAllocZone&) = delete;
+    private:
+        const char* previous = nullptr;
+};
+
+/**
+ * @brief Get the allocation statistics of the whole program
+ *
+ * @return HeapStats
+ */
+HeapStats heapStats();
+
+/**
+ * @brief Get the allocation statistics of a tag
+ *
+ * @param name the name of the tag, or nullptr for untagged allocations
+ * @return HeapStats
+ */
+HeapStats heapStats(const char* name);
+
+/**
+ * @brief Get the number of allocations made inside a NoAllocZone
+ *
+ * @return uint32_t
+ */
+uint32_t noAllocViolations();
+
+/**
+ * @brief Get the name of the zone the last violation happened in
+ *
+ * @return const char* the name, or nullptr if there has not been a violation
+ */
+const char* lastNoAllocViolation();
+
+/**
+ * @brief Set whether to print the zone and abort the program when a NoAllocZone allocates
+ *
+ * @param abort true to abort, false to only count violations
+ */
+void setNoAllocAbort(bool abort);
+
+/**
+ * @brief Print the statistics of the whole program and of every tag to stdout
+ */
+void printHeapReport();
+} // namespace lemlib
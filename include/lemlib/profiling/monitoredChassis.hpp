@@ -0,0 +1,52 @@
+#pragma once
+
+#include "lemlib/chassis/chassis.hpp"
+
+namespace lemlib {
+/**
+ * @brief A Chassis whose blocking motions are watched by the deadline monitor
+ *
+ * The robot links LemLib's prebuilt template, so the 10 ms loops of its motions and odometry can't mark their own
+ * cycles the way the host's copy of LemLib does. Each blocking motion is a cycle of a deadline named after it instead,
+ * with the motion's timeout plus two loop periods as its budget: the template checks the timeout once per iteration,
+ * so a motion that runs longer than that had its loop starved. Async motions return right away, so they are started
+ * as they are, without a deadline.
+ *
+ * A drop-in replacement for Chassis: the motions hide Chassis's, with the same parameters.
+ *
+ * @b Example
+ * @code {.cpp}
+ * lemlib::MonitoredChassis chassis(drivetrain, linearController, angularController, sensors);
+ * @endcode
+ */
+class MonitoredChassis : public Chassis {
+    public:
+        using Chassis::Chassis;
+
+        void turnToPoint(float x, float y, int timeout, TurnToPointParams params = {}, bool async = true);
+
+        void turnToHeading(float theta, int timeout, TurnToHeadingParams params = {}, bool async = true);
+
+        void swingToHeading(float theta, DriveSide lockedSide, int timeout, SwingToHeadingParams params = {},
+                            bool async = true);
+
+        void swingToPoint(float x, float y, DriveSide lockedSide, int timeout, SwingToPointParams params = {},
+                          bool async = true);
+
+        void moveToPose(float x, float y, float theta, int timeout, MoveToPoseParams params = {}, bool async = true);
+
+        void moveToPoint(float x, float y, int timeout, MoveToPointParams params = {}, bool async = true);
+
+        void follow(const asset& path, float lookahead, int timeout, bool forwards = true, bool async = true);
+    private:
+        /**
+         * @brief Run a motion, as a cycle of its deadline if it blocks
+         *
+         * @param name the name of the motion's deadline
+         * @param timeout the motion's timeout, in milliseconds
+         * @param async whether the motion returns right away
+         * @param motion function that runs the motion
+         */
+        template <typename Motion> void monitor(const char* name, int timeout, bool async, Motion motion);
+};
+} // namespace lemlib
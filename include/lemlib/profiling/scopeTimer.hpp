@@ -0,0 +1,243 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__arm__)
+#include "pros/rtos.hpp"
+#else
+#include <chrono>
+#endif
+
+/**
+ * @brief Whether LEMLIB_PROFILE_SCOPE measures anything
+ *
+ * Set to 1 with -DLEMLIB_PROFILE=1 to enable scope timers. When it is 0, LEMLIB_PROFILE_SCOPE expands to nothing, so
+ * instrumented code is exactly the same as uninstrumented code.
+ */
+#ifndef LEMLIB_PROFILE
+#define LEMLIB_PROFILE 0
+#endif
+
+#define LEMLIB_PROFILE_CONCAT_INNER(a, b) a##b
+#define LEMLIB_PROFILE_CONCAT(a, b) LEMLIB_PROFILE_CONCAT_INNER(a, b)
+
+/**
+ * @brief Record how long the rest of the enclosing scope takes
+ *
+ * Each use has its own static histogram, named by the string literal passed to it. Recording an elapsed time reads
+ * the microsecond clock twice and does a few relaxed atomic operations, without locking or allocating.
+ *
+ * @b Example
+ * @code {.cpp}
+ * void update() {
+ *     LEMLIB_PROFILE_SCOPE("odom.update");
+ *     // ...
+ * }
+ * @endcode
+ */
+#if LEMLIB_PROFILE
+#define LEMLIB_PROFILE_SCOPE(name)                                                                                     \
+    static ::lemlib::LatencyHistogram LEMLIB_PROFILE_CONCAT(lemlibHistogram, __LINE__)(name);                          \
+    const ::lemlib::ScopeTimer LEMLIB_PROFILE_CONCAT(lemlibScopeTimer, __LINE__)(                                      \
+        LEMLIB_PROFILE_CONCAT(lemlibHistogram, __LINE__))
+#else
+#define LEMLIB_PROFILE_SCOPE(name) static_cast<void>(0)
+#endif
+
+namespace lemlib {
+/**
+ * @brief Get the time used by scope timers
+ *
+ * Uses pros::micros() on the brain and std::chrono::steady_clock in host builds.
+ *
+ * @return uint32_t time in microseconds
+ */
+inline uint32_t profileMicros() {
+#if defined(__arm__)
+    return pros::micros();
+#else
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+/**
+ * @brief Latency histogram with fixed, logarithmic buckets
+ *
+ * Values below 4 microseconds have their own bucket, and every power of 2 above that is split into 4 buckets, so the
+ * relative error of a percentile is at most 25%. Values from about 3.7 seconds up share the last bucket, but the
+ * maximum is tracked exactly.
+ *
+ * Histograms register themselves in a global list when they are constructed, so they can be dumped without knowing
+ * where they are. They must have static storage duration. Histograms with the same name are merged when dumped.
+ */
+class LatencyHistogram {
+    public:
+        /** number of buckets */
+        static constexpr size_t BUCKETS = 84;
+
+        /**
+         * @brief Construct a new Latency Histogram and add it to the global list
+         *
+         * @param name name of the histogram. Must outlive the histogram
+         */
+        explicit LatencyHistogram(const char* name);
+
+        LatencyHistogram(const LatencyHistogram&) = delete;
+        LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+        /**
+         * @brief Record a value
+         *
+         * @param value elapsed time in microseconds
+         */
+        void record(uint32_t value) {
+            buckets[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+            count.fetch_add(1, std::memory_order_relaxed);
+            uint32_t previous = max.load(std::memory_order_relaxed);
+            while (value > previous && !max.compare_exchange_weak(previous, value, std::memory_order_relaxed)) {}
+        }
+
+        /**
+         * @brief Get the value below which a fraction of the recorded values are
+         *
+         * @param fraction fraction from 0 to 1, like 0.99 for the 99th percentile
+         * @return uint32_t the upper bound of the bucket the percentile is in, in microseconds. 0 if nothing was
+         * recorded
+         */
+        uint32_t percentile(float fraction) const;
+
+        /**
+         * @brief Add the count of each bucket to an array
+         *
+         * Used to merge histograms, like the ones of every instantiation of an instrumented template.
+         *
+         * @param counts array of BUCKETS counts
+         */
+        void addCounts(uint32_t* counts) const;
+
+        /**
+         * @brief Get a percentile of bucket counts
+         *
+         * @param counts array of BUCKETS counts
+         * @param max the largest recorded value
+         * @param fraction fraction from 0 to 1, like 0.99 for the 99th percentile
+         * @return uint32_t the upper bound of the bucket the percentile is in, in microseconds
+         */
+        static uint32_t percentile(const uint32_t* counts, uint32_t max, float fraction);
+
+        /**
+         * @brief Get the largest recorded value
+         *
+         * @return uint32_t time in microseconds
+         */
+        uint32_t getMax() const { return max.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Get the number of recorded values
+         *
+         * @return uint32_t
+         */
+        uint32_t getCount() const { return count.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Get the name of the histogram
+         *
+         * @return const char*
+         */
+        const char* getName() const { return name; }
+
+        /**
+         * @brief Clear the histogram
+         *
+         * Values recorded while it is cleared may be partially kept.
+         */
+        void reset();
+
+        /**
+         * @brief Get the first histogram in the global list
+         *
+         * @return LatencyHistogram*
+         */
+        static LatencyHistogram* first() { return head.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Get the next histogram in the global list
+         *
+         * @return LatencyHistogram*
+         */
+        LatencyHistogram* getNext() const { return next; }
+
+        /**
+         * @brief Get the bucket a value belongs to
+         */
+        static constexpr size_t bucketOf(uint32_t value) {
+            if (value < 4) return value;
+            const int msb = 31 - __builtin_clz(value);
+            const size_t bucket = (msb - 1) * 4 + ((value >> (msb - 2)) & 3);
+            return bucket < BUCKETS ? bucket : BUCKETS - 1;
+        }
+
+        /**
+         * @brief Get the largest value in a bucket
+         */
+        static constexpr uint32_t bucketUpperBound(size_t bucket) {
+            if (bucket < 4) return bucket;
+            const size_t msb = bucket / 4 + 1;
+            return ((uint32_t(4 + bucket % 4) + 1) << (msb - 2)) - 1;
+        }
+    private:
+        static inline std::atomic<LatencyHistogram*> head = nullptr;
+
+        const char* name;
+        LatencyHistogram* next = nullptr;
+        std::atomic<uint32_t> buckets[BUCKETS] = {};
+        std::atomic<uint32_t> count = 0;
+        std::atomic<uint32_t> max = 0;
+};
+
+/**
+ * @brief Records the time between its construction and destruction in a histogram
+ */
+class ScopeTimer {
+    public:
+        /**
+         * @brief Start timing
+         *
+         * @param histogram the histogram to record the elapsed time in
+         */
+        explicit ScopeTimer(LatencyHistogram& histogram)
+            : histogram(histogram),
+              start(profileMicros()) {}
+
+        /**
+         * @brief Stop timing and record the elapsed time
+         */
+        ~ScopeTimer() { histogram.record(profileMicros() - start); }
+
+        ScopeTimer(const ScopeTimer&) = delete;
+        ScopeTimer& operator=(const ScopeTimer&) = delete;
+    private:
+        LatencyHistogram& histogram;
+        const uint32_t start;
+};
+
+/**
+ * @brief Print the count, p50, p99 and max of every histogram to stdout
+ *
+ * @param reset whether to clear the histograms after printing them
+ */
+void dumpHistograms(bool reset = false);
+
+/**
+ * @brief Start a task that dumps every histogram periodically
+ *
+ * Does nothing if scope timers are compiled out, or if the task is already running.
+ *
+ * @param interval time between dumps, in milliseconds
+ * @param reset whether to clear the histograms after each dump, so each dump only covers its interval
+ */
+void startHistogramDumps(uint32_t interval = 5000, bool reset = true);
+} // namespace lemlib
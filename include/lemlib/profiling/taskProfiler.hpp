@@ -0,0 +1,260 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "pros/rtos.hpp"
+
+namespace lemlib {
+/**
+ * @brief Profile of a single task
+ *
+ * The share of the CPU a task uses comes from the kernel's run time counters, so it is measured for every tracked task,
+ * including ones that aren't instrumented. A task can also mark each iteration of its loop with beginIteration() and
+ * endIteration(), or with a ProfiledIteration, to measure its run count and its worst case iteration time. Each mark
+ * reads the microsecond timer once and updates a few counters, so instrumenting a loop costs about a microsecond per
+ * iteration.
+ */
+class TaskProfile {
+    public:
+        /**
+         * @brief Mark the start of an iteration. Must be called from the profiled task
+         */
+        void beginIteration() { iterationStart = pros::micros(); }
+
+        /**
+         * @brief Mark the end of an iteration. Must be called from the profiled task
+         */
+        void endIteration() {
+            const uint32_t duration = pros::micros() - iterationStart;
+            windowRuns.fetch_add(1, std::memory_order_relaxed);
+            if (duration > worst.load(std::memory_order_relaxed)) worst.store(duration, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Get the name of the task
+         *
+         * @return const char*
+         */
+        const char* getName() const { return name; }
+
+        /**
+         * @brief Get the share of the CPU the task used in the last report interval
+         *
+         * Measured from the kernel's run time counter, so it counts all of the task's work, whether it marks
+         * iterations or not.
+         *
+         * @return float percentage, from 0 to 100, or -1 before the first full report interval, or if the task no
+         * longer exists
+         */
+        float getCpuPercent() const { return cpuPercent.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Get the number of iterations in the last report interval
+         *
+         * @return uint32_t
+         */
+        uint32_t getRunCount() const { return runCount.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Get the total number of iterations
+         *
+         * @return uint32_t
+         */
+        uint32_t getTotalRunCount() const { return totalRuns.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Get the longest iteration since the task was tracked, or since the last reset
+         *
+         * @return uint32_t time in microseconds
+         */
+        uint32_t getWorstIteration() const { return worst.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Get the least amount of stack the task has had left
+         *
+         * @return uint32_t free stack in bytes, or UINT32_MAX if it can't be measured, or the task no longer exists
+         */
+        uint32_t getStackHighWaterMark() const { return stackFree.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Reset the worst iteration time
+         */
+        void resetWorstIteration() { worst.store(0, std::memory_order_relaxed); }
+    private:
+        friend class TaskProfiler;
+
+        const char* name = nullptr;
+        pros::task_t task = nullptr;
+        /** the name the task was created with, to find it in the kernel's task lists */
+        char kernelName[TASK_NAME_MAX_LEN] = {};
+
+        /** the task's run time at the last report, only used by the profiler's task */
+        uint32_t lastRunTime = 0;
+        bool hasRunTime = false;
+
+        uint32_t iterationStart = 0;
+        std::atomic<uint32_t> windowRuns = 0;
+        std::atomic<uint32_t> worst = 0;
+
+        std::atomic<float> cpuPercent = -1;
+        std::atomic<uint32_t> runCount = 0;
+        std::atomic<uint32_t> totalRuns = 0;
+        std::atomic<uint32_t> stackFree = UINT32_MAX;
+};
+
+/**
+ * @brief Marks one iteration of a profiled loop for as long as it is in scope
+ *
+ * @b Example
+ * @code {.cpp}
+ * lemlib::TaskProfile* profile = lemlib::taskProfiler().track("opcontrol");
+ * while (true) {
+ *     {
+ *         lemlib::ProfiledIteration iteration(profile);
+ *         // read the controller, move motors...
+ *     }
+ *     pros::delay(10);
+ * }
+ * @endcode
+ */
+class ProfiledIteration {
+    public:
+        /**
+         * @brief Begin an iteration
+         *
+         * @param profile the profile of the current task. Nothing is measured if nullptr
+         */
+        explicit ProfiledIteration(TaskProfile* profile)
+            : profile(profile) {
+            if (profile != nullptr) profile->beginIteration();
+        }
+
+        /**
+         * @brief End the iteration
+         */
+        ~ProfiledIteration() {
+            if (profile != nullptr) profile->endIteration();
+        }
+
+        ProfiledIteration(const ProfiledIteration&) = delete;
+        ProfiledIteration& operator=(const ProfiledIteration&) = delete;
+    private:
+        TaskProfile* profile;
+};
+
+/**
+ * @brief Per task CPU usage, loop timing and stack usage profiler
+ *
+ * Tasks are tracked by handle. A low priority task updates every profile once per report interval:
+ * - CPU percentage, from the kernel's run time counters (uxTaskGetSystemState). This works for any task, including
+ *   ones that are not instrumented, like LemLib's odometry task
+ * - run count and worst case iteration time, from the iterations the task marks
+ * - stack high-water mark, from FreeRTOS's uxTaskGetStackHighWaterMark. This works for any task, including ones that
+ *   are not instrumented
+ *
+ * Before reading a task's stack, the profiler looks the task up in the kernel's task lists by the name it was created
+ * with, and checks that it hasn't been deleted, so a handle to a task that has ended is never read. Such a task keeps
+ * its profile, without a stack high-water mark, until a task with its name is tracked again. Tracked tasks need names
+ * no other task has, or they can't be told apart.
+ *
+ * The report can be printed to the brain screen and sent as telemetry channels (see ChannelRegistry). Reporting once
+ * per second scans only the unused part of each stack, so the profiler uses well under 1% of the CPU.
+ */
+class TaskProfiler {
+    public:
+        /** maximum number of tracked tasks */
+        static constexpr size_t MAX_TASKS = 12;
+
+        /**
+         * @brief Construct a new Task Profiler
+         *
+         * @param reportInterval how often the profiles are updated, in milliseconds
+         */
+        TaskProfiler(uint32_t reportInterval = 1000);
+
+        /**
+         * @brief Destroy the Task Profiler object
+         *
+         */
+        ~TaskProfiler();
+
+        TaskProfiler(const TaskProfiler&) = delete;
+        TaskProfiler& operator=(const TaskProfiler&) = delete;
+
+        /**
+         * @brief Track a task
+         *
+         * Tracking a task with the same name as a tracked task replaces it and keeps its profile, so tasks that are
+         * created again, like opcontrol, can be tracked every time they start.
+         *
+         * @param name name to report the task as. Must outlive the profiler
+         * @param task the task to track, which must exist. Defaults to the current task
+         * @return TaskProfile* the task's profile, or nullptr if too many tasks are tracked
+         */
+        TaskProfile* track(const char* name, pros::task_t task = pros::c::task_get_current());
+
+        /**
+         * @brief Track a task by the name it was created with
+         *
+         * Useful for tasks created by libraries, like LemLib's odometry task.
+         *
+         * @param name the name of the task. Must outlive the profiler
+         * @return TaskProfile* the task's profile, or nullptr if there is no such task
+         */
+        TaskProfile* trackByName(const char* name);
+
+        /**
+         * @brief Print the report to the brain screen
+         *
+         * @param firstLine the line of the first task, or -1 to stop printing
+         */
+        void printToScreen(int firstLine);
+
+        /**
+         * @brief Send every tracked task's profile as a telemetry channel group named after the task
+         *
+         * Tasks tracked after this call are also sent.
+         */
+        void sendTelemetry();
+    private:
+        /**
+         * @brief Point a profile at a task
+         */
+        void setTask(TaskProfile& profile, pros::task_t task);
+
+        /**
+         * @brief Register the telemetry channels of a profile
+         */
+        void registerChannels(TaskProfile& profile);
+
+        /**
+         * @brief Update every profile and print the report
+         */
+        void report();
+
+        /**
+         * @brief The function that will be run inside of the profiler's task.
+         *
+         */
+        void taskLoop();
+
+        const uint32_t reportInterval;
+        std::array<TaskProfile, MAX_TASKS> profiles {};
+        std::atomic<size_t> profileCount = 0;
+        std::atomic<int> screenLine = -1;
+        std::atomic<bool> telemetry = false;
+        uint32_t lastTotalRunTime = 0;
+
+        pros::Mutex mutex;
+        pros::Task task;
+};
+
+/**
+ * @brief Get the task profiler
+ *
+ * @return TaskProfiler&
+ */
+TaskProfiler& taskProfiler();
+} // namespace lemlib
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "pros/rtos.hpp"
+
+extern "C" {
+/**
+ * @brief Create a task with a stack and control block provided by the caller
+ *
+ * Part of the PROS kernel API. The kernel uses it for its own tasks, but it isn't declared in the user headers.
+ */
+pros::task_t task_create_static(pros::task_fn_t function, void* parameters, uint32_t priority, size_t stackDepth,
+                                const char* name, uint32_t* stack, void* controlBlock);
+}
+
+namespace lemlib {
+/**
+ * @brief Space reserved for a task's control block
+ *
+ * The kernel's control block includes newlib's reentrancy struct, which is most of its size. This leaves room to
+ * spare, so it doesn't depend on the exact kernel version.
+ */
+constexpr size_t TASK_CONTROL_BLOCK_SIZE = 1536;
+
+/**
+ * @brief A task whose stack, control block and function are stored in the object itself
+ *
+ * pros::Task allocates its stack, control block and a std::function on the heap when the task is created. A
+ * StaticTask defined at namespace scope instead takes its memory from .bss, so starting it can't fail and its size
+ * shows up in the link map. The function is stored as is, without a std::function.
+ *
+ * @tparam StackDepth the size of the stack, in words
+ * @tparam Function the type of the function the task runs
+ *
+ * @b Example
+ * @code {.cpp}
+ * // 16 KB of stack, in .bss
+ * lemlib::StaticTask<0x1000, void (*)()> intakeTask([] {
+ *     while (true) {
+ *         // control the intake
+ *         pros::delay(10);
+ *     }
+ * });
+ *
+ * void initialize() { intakeTask.start(TASK_PRIORITY_DEFAULT, "Intake"); }
+ * @endcode
+ */
+template <size_t StackDepth, typename Function> class StaticTask {
+    public:
+        /**
+         * @brief Construct a new Static Task. The task doesn't start until start() is called
+         *
+         * @param function the function the task runs
+         */
+        explicit StaticTask(Function function)
+            : function(std::move(function)) {}
+
+        StaticTask(const StaticTask&) = delete;
+        StaticTask& operator=(const StaticTask&) = delete;
+
+        /**
+         * @brief Start the task. Does nothing if it was already started
+         *
+         * The task must never return, since its memory can't be reused while it exists.
+         *
+         * @param priority the priority of the task
+         * @param name the name of the task. Must outlive the task
+         * @return pros::task_t the handle of the task
+         */
+        pros::task_t start(uint32_t priority = TASK_PRIORITY_DEFAULT, const char* name = "") {
+            if (handle == nullptr) {
+                handle = task_create_static(&StaticTask::run, this, priority, StackDepth, name, stack, controlBlock);
+            }
+            return handle;
+        }
+
+        /**
+         * @brief Get the handle of the task
+         *
+         * @return pros::task_t the handle, or nullptr if the task hasn't been started
+         */
+        pros::task_t getHandle() const { return handle; }
+
+        /**
+         * @brief Get the size of the task's stack
+         *
+         * @return size_t the size of the stack, in words
+         */
+        static constexpr size_t getStackDepth() { return StackDepth; }
+    private:
+        static void run(void* self) { static_cast<StaticTask*>(self)->function(); }
+
+        Function function;
+        pros::task_t handle = nullptr;
+        // left uninitialized, so a task at namespace scope is initialized at run time and stays in .bss instead of
+        // taking up space in .data
+        alignas(8) uint32_t stack[StackDepth];
+        alignas(8) uint8_t controlBlock[TASK_CONTROL_BLOCK_SIZE];
+};
+} // namespace lemlib
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+
+#include "pros/rtos.hpp"
+
+namespace lemlib {
+/**
+ * @brief State of a task, as reported by uxTaskGetSystemState
+ *
+ * Has the layout of FreeRTOS's TaskStatus_t on the brain, since that is what the kernel fills in.
+ */
+struct TaskStatus {
+        pros::task_t handle;
+        const char* name;
+        unsigned long number;
+        pros::task_state_e_t state;
+        unsigned long currentPriority;
+        unsigned long basePriority;
+        /** time the task has spent running since the kernel started, in the units of the run time counter */
+        uint32_t runTime;
+        void* stackBase;
+        /** least amount of stack the task has had left, in words */
+        uint16_t stackHighWaterMark;
+};
+} // namespace lemlib
+
+extern "C" {
+/**
+ * @brief Get the state of every task, including how long each one has run
+ *
+ * Part of FreeRTOS, which the PROS kernel is built with, but it isn't declared in the user headers. Run times are
+ * counted by the kernel for every task, so they include everything a task does, and the share of the CPU a task used
+ * is the change in its run time over the change in the total run time.
+ *
+ * @param statuses array to fill in
+ * @param size size of the array. If there are more tasks than this, nothing is filled in
+ * @param totalRunTime set to the time since the kernel started, in the units of the run time counter
+ * @return unsigned long number of tasks filled in
+ */
+unsigned long uxTaskGetSystemState(lemlib::TaskStatus* statuses, unsigned long size, uint32_t* totalRunTime);
+}
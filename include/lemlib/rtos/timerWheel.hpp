@@ -0,0 +1,210 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "pros/rtos.hpp"
+
+namespace lemlib {
+/**
+ * @brief Links of a timer in its slot's list. The slot itself is the head of the list, so a timer can always unlink
+ * itself through its previous link
+ */
+struct TimerLink {
+        TimerLink* previous = nullptr;
+        TimerLink* next = nullptr;
+};
+
+/**
+ * @brief A timer that can be armed on a TimerWheel
+ *
+ * Timers are intrusive: all the memory the wheel needs for a timer is in the timer itself, so arming one never
+ * allocates, and any number of timers can be armed at once. A timer must not be destroyed while it is armed.
+ */
+class WheelTimer : TimerLink {
+    public:
+        using Callback = void (*)(void* context);
+
+        /**
+         * @brief Construct a new Wheel Timer
+         *
+         * @param callback function called from the wheel's task when the timer expires
+         * @param context argument passed to the callback
+         */
+        WheelTimer(Callback callback, void* context = nullptr)
+            : callback(callback),
+              context(context) {}
+
+        WheelTimer(const WheelTimer&) = delete;
+        WheelTimer& operator=(const WheelTimer&) = delete;
+
+        /**
+         * @brief Whether the timer is armed
+         *
+         * @return true if it is waiting to expire
+         */
+        bool isArmed() const { return slot != NO_SLOT; }
+    private:
+        friend class TimerWheel;
+
+        static constexpr uint16_t NO_SLOT = UINT16_MAX;
+
+        Callback callback;
+        void* context;
+        uint64_t expiry = 0;
+        uint32_t period = 0;
+        uint16_t slot = NO_SLOT;
+};
+
+/**
+ * @brief A WheelTimer that calls a function object, like a lambda
+ *
+ * @b Example
+ * @code {.cpp}
+ * lemlib::FunctionTimer retractWing([] { wing.retract(); });
+ *
+ * // retract the wing in 500 ms
+ * lemlib::timerWheel().arm(retractWing, 500000);
+ * @endcode
+ */
+template <typename Function> class FunctionTimer : public WheelTimer {
+    public:
+        explicit FunctionTimer(Function function)
+            : WheelTimer(&FunctionTimer::call, this),
+              function(std::move(function)) {}
+    private:
+        static void call(void* self) { static_cast<FunctionTimer*>(self)->function(); }
+
+        Function function;
+};
+
+/**
+ * @brief Hierarchical timer wheel with microsecond resolution
+ *
+ * Timers are sorted into 4 levels of 256 slots. Level 0 has a slot for each microsecond, and each level above has
+ * slots 256 times longer, so the wheel covers about 71 minutes. Arming and cancelling a timer link or unlink it from a
+ * slot in constant time. A timer in a higher level moves down a level when its slot comes up, until it expires from
+ * level 0. Bitmaps of the slots in use let the wheel skip straight to the next slot with something in it.
+ *
+ * One task fires every callback. It sleeps until the next slot with a timer in it, so callbacks run within a
+ * millisecond, the resolution of the scheduler, of their expiry. Callbacks should be short, since they delay every
+ * other timer.
+ */
+class TimerWheel {
+    public:
+        /** number of levels */
+        static constexpr size_t LEVELS = 4;
+        /** number of bits of time each level covers */
+        static constexpr size_t LEVEL_BITS = 8;
+        /** number of slots in each level */
+        static constexpr size_t SLOTS = 1 << LEVEL_BITS;
+
+        /**
+         * @brief Construct a new Timer Wheel
+         *
+         */
+        TimerWheel();
+
+        /**
+         * @brief Destroy the Timer Wheel object
+         *
+         */
+        ~TimerWheel();
+
+        TimerWheel(const TimerWheel&) = delete;
+        TimerWheel& operator=(const TimerWheel&) = delete;
+
+        /**
+         * @brief Arm a timer. If it is already armed, it is moved to the new expiry
+         *
+         * @param timer the timer
+         * @param delay time until it expires, in microseconds
+         * @param period time between expiries of a periodic timer, in microseconds, or 0 to only expire once
+         */
+        void arm(WheelTimer& timer, uint32_t delay, uint32_t period = 0);
+
+        /**
+         * @brief Cancel a timer
+         *
+         * If the timer's callback is running, it isn't waited for, but a periodic timer won't be armed again.
+         *
+         * @param timer the timer
+         * @return true if the timer was armed
+         */
+        bool cancel(WheelTimer& timer);
+
+        /**
+         * @brief Get the number of callbacks that have been called
+         *
+         * @return uint32_t
+         */
+        uint32_t getFiredCount() const { return fired; }
+    private:
+        /**
+         * @brief Link a timer into the slot for its expiry. Must be called with the mutex locked
+         */
+        void insert(WheelTimer& timer);
+
+        /**
+         * @brief Unlink a timer from its slot. Must be called with the mutex locked
+         */
+        void unlink(WheelTimer& timer);
+
+        /**
+         * @brief Get how far the next slot in use is in a level, going around the level
+         *
+         * @return size_t number of slots from index to the slot in use, or SLOTS if the level is empty
+         */
+        size_t distanceToUsed(size_t level, size_t index) const;
+
+        /**
+         * @brief Get the earliest time at which a slot in use comes up. Must be called with the mutex locked
+         *
+         * @return uint64_t the time, or UINT64_MAX if no timer is armed
+         */
+        uint64_t nextEvent() const;
+
+        /**
+         * @brief Move the timers in the slots of higher levels that start at current time down. Must be called with
+         * the mutex locked
+         */
+        void cascade();
+
+        /**
+         * @brief Fire every timer that expired up to a time
+         *
+         * @return uint64_t the time the next slot in use comes up
+         */
+        uint64_t advance(uint64_t now);
+
+        /**
+         * @brief The function that will be run inside of the wheel's task.
+         *
+         */
+        void taskLoop();
+
+        // slot (level * SLOTS + index). The list of a slot ends with nullptr
+        std::array<TimerLink, LEVELS * SLOTS> slots {};
+        std::array<uint32_t, LEVELS * SLOTS / 32> used {};
+        // the next microsecond whose slot hasn't been processed
+        uint64_t current;
+        // when the task will next wake up
+        uint64_t wakeTime = UINT64_MAX;
+        WheelTimer* firing = nullptr;
+        bool firingCancelled = false;
+        std::atomic<uint32_t> fired = 0;
+
+        pros::Mutex mutex;
+        pros::Task task;
+};
+
+/**
+ * @brief Get the timer wheel
+ *
+ * @return TimerWheel&
+ */
+TimerWheel& timerWheel();
+} // namespace lemlib
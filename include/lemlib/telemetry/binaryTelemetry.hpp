@@ -0,0 +1,288 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "pros/rtos.hpp"
+#include "lemlib/telemetry/cobs.hpp"
+
+namespace lemlib {
+/**
+ * @brief Type of a field in a telemetry record or deferred log message
+ *
+ * The numeric values are part of the wire format, so they must not be changed. Types after F32 are only used by
+ * deferred log messages.
+ */
+enum class FieldType : uint8_t {
+    U8 = 1,
+    I8 = 2,
+    U16 = 3,
+    I16 = 4,
+    U32 = 5,
+    I32 = 6,
+    F32 = 7,
+    U64 = 8,
+    I64 = 9,
+    F64 = 10,
+    BOOL = 11,
+    CHAR = 12,
+    STRING = 13 /**< 1 byte length followed by the characters, without a null terminator */
+};
+
+/**
+ * @brief Get the field type of a C++ type
+ *
+ * @tparam T type of the field
+ * @return constexpr FieldType
+ */
+template <typename T> constexpr FieldType fieldTypeOf() {
+    if constexpr (std::is_same_v<T, float>) return FieldType::F32;
+    else if constexpr (std::is_same_v<T, uint8_t> || std::is_same_v<T, bool>) return FieldType::U8;
+    else if constexpr (std::is_same_v<T, int8_t>) return FieldType::I8;
+    else if constexpr (std::is_same_v<T, uint16_t>) return FieldType::U16;
+    else if constexpr (std::is_same_v<T, int16_t>) return FieldType::I16;
+    else if constexpr (std::is_same_v<T, uint32_t>) return FieldType::U32;
+    else if constexpr (std::is_same_v<T, int32_t>) return FieldType::I32;
+    else static_assert(!sizeof(T), "unsupported telemetry field type");
+}
+
+/**
+ * @brief Binary telemetry channel
+ *
+ * Sends typed records over the link as compact binary frames, instead of formatting them as text. Each record type is
+ * registered once with a schema (record name, field names and field types), and the schema is sent periodically so a
+ * host tool can decode the stream even if it connects late.
+ *
+ * Every frame has the following layout before it is COBS encoded and surrounded by 0x00 delimiters:
+ * - record id (1 byte). Id 0 is reserved for schema frames
+ * - time the record was sent, in milliseconds (4 bytes)
+ * - field values, little endian, in the order they were registered
+ * - CRC-16/CCITT-FALSE of everything above (2 bytes)
+ *
+ * ChannelRegistry frames (BinaryTelemetry::CHANNEL_RECORD) leave out the time, since they are sent every tick and
+ * carry their own.
+ *
+ * Sending a record does not allocate memory. Bytes that are not part of a valid frame (like text printed to stdout)
+ * are skipped by the decoder.
+ */
+class BinaryTelemetry {
+    public:
+        /** maximum number of record types that can be registered */
+        static constexpr uint8_t MAX_RECORDS = 32;
+        /** maximum size of the field values of a single record, in bytes */
+        static constexpr size_t MAX_PAYLOAD = 96;
+        /** maximum size of an encoded schema, in bytes */
+        static constexpr size_t MAX_SCHEMA = 240;
+        /** record id used for schema frames */
+        static constexpr uint8_t SCHEMA_RECORD = 0;
+        /** record id used for deferred log messages */
+        static constexpr uint8_t LOG_RECORD = 0xFF;
+        /** record id used for ChannelRegistry frames */
+        static constexpr uint8_t CHANNEL_RECORD = 0xFE;
+        /** record id used for ChannelRegistry group schemas */
+        static constexpr uint8_t CHANNEL_SCHEMA_RECORD = 0xFD;
+
+        /**
+         * @brief Function used to send a complete frame over the link
+         */
+        using WriteFunction = void (*)(const uint8_t* data, size_t size);
+
+        /**
+         * @brief Construct a new Binary Telemetry channel
+         *
+         * @param writeFunc function used to send frames. Writes to stdout if nullptr
+         */
+        BinaryTelemetry(WriteFunction writeFunc = nullptr);
+
+        BinaryTelemetry(const BinaryTelemetry&) = delete;
+        BinaryTelemetry& operator=(const BinaryTelemetry&) = delete;
+
+        /**
+         * @brief Register a record type
+         *
+         * The name and field arrays are not copied, so they must outlive the channel.
+         *
+         * @param name name of the record
+         * @param fieldNames names of each field
+         * @param fieldTypes types of each field
+         * @param fieldCount number of fields
+         * @return uint8_t the id of the record, or 0 if it could not be registered
+         */
+        uint8_t registerRecord(const char* name, const char* const* fieldNames, const FieldType* fieldTypes,
+                               uint8_t fieldCount);
+
+        /**
+         * @brief Send a record
+         *
+         * @param id the id of the record, as returned by registerRecord
+         * @param data the packed field values
+         * @param size size of the field values, in bytes
+         * @return true the record was sent
+         * @return false the record was not registered or is too large
+         */
+        bool sendRecord(uint8_t id, const uint8_t* data, size_t size);
+
+        /**
+         * @brief Send a frame with a reserved record id
+         *
+         * Used for frames that describe themselves, like deferred log messages, so they don't need a schema.
+         *
+         * @param id the reserved record id
+         * @param time the time to send with the frame, in milliseconds
+         * @param data the payload
+         * @param size size of the payload, in bytes
+         * @return true the frame was sent
+         * @return false the payload is too large
+         */
+        bool sendRaw(uint8_t id, uint32_t time, const uint8_t* data, size_t size);
+
+        /**
+         * @brief Send a frame with a reserved record id and no time
+         *
+         * Used for frames that are sent so often that 4 bytes of time would be a large part of them, and that carry
+         * their own timing instead, like ChannelRegistry frames.
+         *
+         * @param id the reserved record id
+         * @param data the payload
+         * @param size size of the payload, in bytes
+         * @return true the frame was sent
+         * @return false the payload is too large
+         */
+        bool sendUntimed(uint8_t id, const uint8_t* data, size_t size);
+
+        /**
+         * @brief Send the schemas of all registered records
+         */
+        void sendSchemas();
+
+        /**
+         * @brief Set how often the schema of each record is resent
+         *
+         * @param interval interval in milliseconds. 0 to only send each schema once
+         */
+        void setSchemaInterval(uint32_t interval);
+
+        /**
+         * @brief Get the total number of bytes sent, including framing
+         *
+         * @return uint32_t
+         */
+        uint32_t getBytesSent() const;
+
+        /**
+         * @brief Get the total number of frames sent, including schema frames
+         *
+         * @return uint32_t
+         */
+        uint32_t getFramesSent() const;
+    private:
+        struct Schema {
+                const char* name = nullptr;
+                const char* const* fieldNames = nullptr;
+                const FieldType* fieldTypes = nullptr;
+                uint8_t fieldCount = 0;
+                size_t payloadSize = 0;
+                bool sent = false;
+                uint32_t lastSent = 0;
+        };
+
+        /**
+         * @brief Frame a payload and send it. The mutex must be held
+         *
+         * @param payload payload, with room for the 2 byte checksum after it
+         * @param size size of the payload without the checksum
+         */
+        void sendFrame(uint8_t* payload, size_t size);
+
+        /**
+         * @brief Send the schema of a record. The mutex must be held
+         *
+         * @param id the id of the record
+         */
+        void sendSchema(uint8_t id);
+
+        WriteFunction writeFunc;
+        std::array<Schema, MAX_RECORDS> schemas {};
+        uint8_t recordCount = 0;
+        uint32_t schemaInterval = 2000;
+
+        uint32_t bytesSent = 0;
+        uint32_t framesSent = 0;
+
+        pros::Mutex mutex;
+};
+
+/**
+ * @brief Get the binary telemetry channel
+ *
+ * @return BinaryTelemetry&
+ */
+BinaryTelemetry& binaryTelemetry();
+
+/**
+ * @brief A typed telemetry record
+ *
+ * Registers its schema on construction and packs values into a fixed size buffer on the stack when written.
+ *
+ * @tparam T the types of the fields. Must be float or a fixed width integer
+ *
+ * @b Example
+ * @code {.cpp}
+ * // register a record with 3 float fields
+ * lemlib::TelemetryRecord<float, float, float> poseRecord("pose", {"x", "y", "theta"});
+ *
+ * void opcontrol() {
+ *     while (true) {
+ *         const lemlib::Pose pose = chassis.getPose();
+ *         poseRecord.write(pose.x, pose.y, pose.theta); // 22 bytes on the link
+ *         pros::delay(10);
+ *     }
+ * }
+ * @endcode
+ */
+template <typename... T> class TelemetryRecord {
+    public:
+        /** size of the packed field values, in bytes */
+        static constexpr size_t PAYLOAD_SIZE = (sizeof(T) + ... + 0);
+        static_assert(PAYLOAD_SIZE <= BinaryTelemetry::MAX_PAYLOAD, "telemetry record is too large");
+
+        /**
+         * @brief Construct a new Telemetry Record
+         *
+         * @param name name of the record. Must outlive the record
+         * @param fieldNames names of each field. Must outlive the record
+         * @param telemetry the channel to send the record on
+         */
+        TelemetryRecord(const char* name, std::array<const char*, sizeof...(T)> fieldNames,
+                        BinaryTelemetry& telemetry = binaryTelemetry())
+            : fieldNames(fieldNames),
+              telemetry(telemetry) {
+            id = telemetry.registerRecord(name, this->fieldNames.data(), fieldTypes.data(), sizeof...(T));
+        }
+
+        TelemetryRecord(const TelemetryRecord&) = delete;
+        TelemetryRecord& operator=(const TelemetryRecord&) = delete;
+
+        /**
+         * @brief Send the record
+         *
+         * @param values the value of each field
+         * @return true the record was sent
+         * @return false the record could not be registered
+         */
+        bool write(T... values) {
+            uint8_t payload[PAYLOAD_SIZE + 1]; // +1 so an empty record still has a valid buffer
+            size_t offset = 0;
+            ((std::memcpy(payload + offset, &values, sizeof(T)), offset += sizeof(T)), ...);
+            return telemetry.sendRecord(id, payload, offset);
+        }
+    private:
+        static constexpr std::array<FieldType, sizeof...(T)> fieldTypes {fieldTypeOf<T>()...};
+        const std::array<const char*, sizeof...(T)> fieldNames;
+        BinaryTelemetry& telemetry;
+        uint8_t id = 0;
+};
+} // namespace lemlib
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace lemlib {
+/**
+ * @brief Writes values of any bit width into a byte buffer, least significant bit first
+ */
+class BitWriter {
+    public:
+        /**
+         * @brief Construct a new Bit Writer
+         *
+         * @param data the buffer to write to
+         * @param capacity size of the buffer, in bytes
+         */
+        BitWriter(uint8_t* data, size_t capacity)
+            : data(data),
+              capacity(capacity) {}
+
+        /**
+         * @brief Write the lowest bits of a value
+         *
+         * @param value the value to write
+         * @param bits number of bits to write, up to 32
+         * @return true the value fit in the buffer
+         */
+        bool write(uint32_t value, uint8_t bits) {
+            if (bit + bits > capacity * 8) {
+                overflowed = true;
+                return false;
+            }
+            for (uint8_t i = 0; i < bits; i++, bit++) {
+                const uint8_t mask = 1 << (bit % 8);
+                if (bit % 8 == 0) data[bit / 8] = 0;
+                if ((value >> i) & 1) data[bit / 8] |= mask;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Get the number of bytes written, including the last partial byte
+         */
+        size_t size() const { return (bit + 7) / 8; }
+
+        /**
+         * @brief Check whether every write fit in the buffer
+         */
+        bool ok() const { return !overflowed; }
+    private:
+        uint8_t* data;
+        size_t capacity;
+        size_t bit = 0;
+        bool overflowed = false;
+};
+
+/**
+ * @brief Reads values written by a BitWriter
+ */
+class BitReader {
+    public:
+        /**
+         * @brief Construct a new Bit Reader
+         *
+         * @param data the buffer to read from
+         * @param size size of the buffer, in bytes
+         */
+        BitReader(const uint8_t* data, size_t size)
+            : data(data),
+              size(size) {}
+
+        /**
+         * @brief Read a value
+         *
+         * @param bits number of bits to read, up to 32
+         * @return uint32_t the value, or 0 if the buffer ended
+         */
+        uint32_t read(uint8_t bits) {
+            if (bit + bits > size * 8) {
+                overflowed = true;
+                return 0;
+            }
+            uint32_t value = 0;
+            for (uint8_t i = 0; i < bits; i++, bit++) value |= uint32_t((data[bit / 8] >> (bit % 8)) & 1) << i;
+            return value;
+        }
+
+        /**
+         * @brief Check whether every read was inside the buffer
+         */
+        bool ok() const { return !overflowed; }
+    private:
+        const uint8_t* data;
+        size_t size;
+        size_t bit = 0;
+        bool overflowed = false;
+};
+
+/**
+ * @brief Map signed integers to unsigned ones so values close to 0 are small: 0, -1, 1, -2, 2...
+ */
+constexpr uint32_t zigzagEncode(int32_t value) { return (uint32_t(value) << 1) ^ uint32_t(value >> 31); }
+
+/**
+ * @brief Inverse of zigzagEncode
+ */
+constexpr int32_t zigzagDecode(uint32_t value) { return int32_t(value >> 1) ^ -int32_t(value & 1); }
+
+/**
+ * @brief Write a signed integer with a variable length code
+ *
+ * A 2 bit prefix selects whether the zigzag encoded value is stored in 4, 8, 16 or 32 bits, so small changes only take
+ * 6 bits.
+ *
+ * @return true the value fit in the buffer
+ */
+inline bool writeVarInt(BitWriter& writer, int32_t value) {
+    const uint32_t encoded = zigzagEncode(value);
+    if (encoded < (1u << 4)) return writer.write(0, 2) && writer.write(encoded, 4);
+    if (encoded < (1u << 8)) return writer.write(1, 2) && writer.write(encoded, 8);
+    if (encoded < (1u << 16)) return writer.write(2, 2) && writer.write(encoded, 16);
+    return writer.write(3, 2) && writer.write(encoded, 32);
+}
+
+/**
+ * @brief Read a signed integer written by writeVarInt
+ */
+inline int32_t readVarInt(BitReader& reader) {
+    constexpr uint8_t WIDTHS[] = {4, 8, 16, 32};
+    return zigzagDecode(reader.read(WIDTHS[reader.read(2)]));
+}
+} // namespace lemlib
@@ -0,0 +1,227 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+
+#include "pros/rtos.hpp"
+#include "lemlib/telemetry/binaryTelemetry.hpp"
+
+namespace lemlib {
+/**
+ * @brief How the value of a telemetry channel is interpreted
+ *
+ * The numeric values are part of the wire format, so they must not be changed.
+ */
+enum class ChannelType : uint8_t {
+    FLOAT = 1, /**< quantized to a multiple of the channel's resolution */
+    INT = 2, /**< rounded to the nearest integer */
+    BOOL = 3 /**< 0 is false, anything else is true */
+};
+
+/**
+ * @brief Description of a telemetry channel
+ */
+struct ChannelInfo {
+        /** name of the channel. Must outlive the registry */
+        const char* name;
+        /** unit of the channel, like "in" or "deg". Must outlive the registry */
+        const char* unit = "";
+        /** smallest change that is sent, for FLOAT channels */
+        float resolution = 0.01;
+        /** how the value is interpreted */
+        ChannelType type = ChannelType::FLOAT;
+};
+
+/**
+ * @brief Registry of telemetry channels, sampled by a single task
+ *
+ * Subsystems declare groups of channels that are sampled together at a fixed rate, instead of writing their own
+ * telemetry loops. A sampler task runs every tick, samples the groups that are due, and sends a single frame on the
+ * binary telemetry link with what changed:
+ * - every value is quantized to an integer, so noise below the channel's resolution doesn't count as a change
+ * - each sampled channel takes 1 bit if it didn't change. Changed values are sent as a delta from the last sent value,
+ *   with a variable length code (6 bits for small changes)
+ * - if nothing changed, no frame is sent at all
+ *
+ * A keyframe with the absolute value of every channel is sent periodically, so a decoder can start in the middle of a
+ * stream or recover from a corrupt frame. tools/telemetryDecode.cpp reconstructs every group at its full sample rate
+ * and writes one CSV file per group. In degraded mode (see inDegradedMode()) deltas aren't sampled or sent, so the
+ * sequence number skips one and the decoder leaves out the values until the next keyframe, which is sent as soon as
+ * degraded mode ends.
+ *
+ * Frames are sent without BinaryTelemetry's time, so a frame of a tick where a few values changed is about 7 bytes
+ * plus the values. Frame layout (record id BinaryTelemetry::CHANNEL_RECORD):
+ * - header (1 byte): bit 7 is set for keyframes, bit 6 is set if a tick delta follows, and bits 0-5 are the sequence
+ *   number, incremented with every frame so the decoder can detect lost frames
+ * - keyframes only: number of groups (1 byte), so the decoder knows whether it has the schema of every group, the
+ *   tick (4 bytes) and the time, in milliseconds (4 bytes)
+ * - deltas only, if bit 6 is set: ticks since the last frame (1 byte). Otherwise the last frame was on the tick before
+ * - bit-packed values, see bitPacking.hpp
+ *
+ * @b Example
+ * @code {.cpp}
+ * void initialize() {
+ *     // the pose is read once per sample, and each field is sent only when it changes by more than its resolution
+ *     lemlib::channelRegistry().addGroup("pose", 100, {{"x", "in"}, {"y", "in"}, {"theta", "deg"}},
+ *                                        [](float* values) {
+ *                                            const lemlib::Pose pose = chassis.getPose();
+ *                                            values[0] = pose.x;
+ *                                            values[1] = pose.y;
+ *                                            values[2] = pose.theta;
+ *                                        });
+ *     lemlib::channelRegistry().addChannel("battery", "%", 1, [] { return pros::battery::get_capacity(); }, 1);
+ * }
+ * @endcode
+ */
+class ChannelRegistry {
+    public:
+        /** maximum number of channels in all groups */
+        static constexpr uint8_t MAX_CHANNELS = 48;
+        /** maximum number of groups */
+        static constexpr uint8_t MAX_GROUPS = 16;
+        /** maximum number of channels in a single group */
+        static constexpr uint8_t MAX_GROUP_CHANNELS = 16;
+
+        /**
+         * @brief Function that samples every channel of a group
+         *
+         * The values array has one element per channel, in the order they were declared.
+         */
+        using Sampler = std::function<void(float* values)>;
+
+        /**
+         * @brief Construct a new Channel Registry
+         *
+         * @param tickPeriod period of the sampler task, in milliseconds. Groups are sampled at multiples of it
+         * @param telemetry the channel to send frames on
+         */
+        ChannelRegistry(uint32_t tickPeriod = 10, BinaryTelemetry& telemetry = binaryTelemetry());
+
+        /**
+         * @brief Destroy the Channel Registry object
+         *
+         */
+        ~ChannelRegistry();
+
+        ChannelRegistry(const ChannelRegistry&) = delete;
+        ChannelRegistry& operator=(const ChannelRegistry&) = delete;
+
+        /**
+         * @brief Add a group of channels that are sampled together
+         *
+         * @param name name of the group. Must outlive the registry
+         * @param rate sample rate, in Hz. Rounded to a whole number of ticks
+         * @param channels the channels of the group
+         * @param sampler function that samples the channels
+         * @return true the group was added
+         * @return false there are too many groups or channels
+         */
+        bool addGroup(const char* name, float rate, std::initializer_list<ChannelInfo> channels, Sampler sampler);
+
+        /**
+         * @brief Add a group with a single channel
+         *
+         * @param name name of the group and the channel. Must outlive the registry
+         * @param unit unit of the channel. Must outlive the registry
+         * @param rate sample rate, in Hz. Rounded to a whole number of ticks
+         * @param getter function that returns the value of the channel
+         * @param resolution smallest change that is sent, for FLOAT channels
+         * @param type how the value is interpreted
+         * @return true the channel was added
+         * @return false there are too many groups or channels
+         */
+        bool addChannel(const char* name, const char* unit, float rate, std::function<float()> getter,
+                        float resolution = 0.01, ChannelType type = ChannelType::FLOAT);
+
+        /**
+         * @brief Set how often a keyframe is sent
+         *
+         * @param interval interval in milliseconds
+         */
+        void setKeyframeInterval(uint32_t interval);
+
+        /**
+         * @brief Set how often the schema of every group is resent
+         *
+         * @param interval interval in milliseconds
+         */
+        void setSchemaInterval(uint32_t interval);
+
+        /**
+         * @brief Get the number of frames sent, including keyframes
+         *
+         * @return uint32_t
+         */
+        uint32_t getFramesSent() const;
+    private:
+        struct Channel {
+                ChannelInfo info {nullptr};
+                /** last value that was sent */
+                int32_t last = 0;
+        };
+
+        struct Group {
+                const char* name = nullptr;
+                uint32_t periodTicks = 1;
+                uint8_t firstChannel = 0;
+                uint8_t channelCount = 0;
+                Sampler sampler;
+        };
+
+        /**
+         * @brief Sample a group and quantize its values
+         */
+        void sample(const Group& group, int32_t* values);
+
+        /**
+         * @brief Send the schema of every group. The mutex must be held
+         */
+        void sendSchemas();
+
+        /**
+         * @brief Sample due groups and send a frame. The mutex must be held
+         *
+         * @param keyframe whether to send every channel's absolute value
+         */
+        void sendFrame(bool keyframe);
+
+        /**
+         * @brief The function that will be run inside of the sampler task.
+         *
+         */
+        void taskLoop();
+
+        const uint32_t tickPeriod;
+        BinaryTelemetry& telemetry;
+
+        std::array<Channel, MAX_CHANNELS> channels {};
+        std::array<Group, MAX_GROUPS> groups {};
+        uint8_t channelCount = 0;
+        uint8_t groupCount = 0;
+
+        uint32_t tick = 0;
+        /** tick of the last frame */
+        uint32_t lastFrameTick = 0;
+        uint8_t sequence = 0;
+        /** whether delta frames were skipped in degraded mode since the last frame */
+        bool deltasSkipped = false;
+        uint32_t keyframeInterval = 1000;
+        uint32_t schemaInterval = 2000;
+        uint32_t lastKeyframe = 0;
+        uint32_t lastSchema = 0;
+        bool changed = false;
+        uint32_t framesSent = 0;
+
+        pros::Mutex mutex;
+        pros::Task task;
+};
+
+/**
+ * @brief Get the channel registry
+ *
+ * @return ChannelRegistry&
+ */
+ChannelRegistry& channelRegistry();
+} // namespace lemlib
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace lemlib {
+/**
+ * @brief Get the largest size a COBS encoded frame can be
+ *
+ * COBS adds one overhead byte per 254 bytes of input, plus one leading code byte. The trailing 0x00 delimiter is
+ * not included.
+ *
+ * @param length length of the unencoded data, in bytes
+ * @return constexpr size_t maximum encoded length, in bytes
+ */
+constexpr size_t cobsMaxEncodedSize(size_t length) { return length + length / 254 + 1; }
+
+/**
+ * @brief Encode data with Consistent Overhead Byte Stuffing
+ *
+ * The output contains no 0x00 bytes, so 0x00 can be used as a frame delimiter on the link.
+ *
+ * @param input data to encode
+ * @param length length of the input, in bytes
+ * @param output buffer to write to. Must be at least cobsMaxEncodedSize(length) bytes long
+ * @return size_t number of bytes written to the output
+ *
+ * @b Example
+ * @code {.cpp}
+ * const uint8_t data[] = {0x11, 0x00, 0x22};
+ * uint8_t encoded[cobsMaxEncodedSize(sizeof(data))];
+ * size_t size = cobsEncode(data, sizeof(data), encoded); // encoded = {0x02, 0x11, 0x02, 0x22}
+ * @endcode
+ */
+size_t cobsEncode(const uint8_t* input, size_t length, uint8_t* output);
+
+/**
+ * @brief Decode a COBS frame
+ *
+ * @param input encoded data, without the 0x00 delimiter
+ * @param length length of the encoded data, in bytes
+ * @param output buffer to write to. Must be at least length bytes long
+ * @return size_t number of bytes written to the output, or 0 if the frame is malformed
+ */
+size_t cobsDecode(const uint8_t* input, size_t length, uint8_t* output);
+
+/**
+ * @brief Calculate the CRC-16/CCITT-FALSE checksum of some data
+ *
+ * @param data data to checksum
+ * @param length length of the data, in bytes
+ * @param crc initial value. Can be used to checksum data in several chunks
+ * @return uint16_t checksum
+ */
+uint16_t crc16(const uint8_t* data, size_t length, uint16_t crc = 0xFFFF);
+} // namespace lemlib
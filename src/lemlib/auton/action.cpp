@@ -0,0 +1,63 @@
+#include "lemlib/auton/action.hpp"
+
+namespace lemlib {
+ScheduledAwaiter::~ScheduledAwaiter() {
+    if (waiting) scheduler().remove(this);
+}
+
+void ScheduledAwaiter::await_suspend(std::coroutine_handle<> awaiting) {
+    handle = awaiting;
+    scheduler().add(this);
+}
+
+Scheduler::Scheduler(uint32_t tickPeriod)
+    : tickPeriod(tickPeriod) {}
+
+void Scheduler::run(Action action) {
+    while (head != nullptr) remove(head);
+    // a moved from action has nothing to run
+    if (action.done()) return;
+    action.start(nullptr);
+    uint32_t now = pros::millis();
+    while (!action.done()) {
+        pros::Task::delay_until(&now, tickPeriod);
+        update();
+    }
+}
+
+void Scheduler::update() {
+    // resuming an action can add and remove any awaiter, including the next one, so start over after each resume
+    ScheduledAwaiter* awaiter = head;
+    while (awaiter != nullptr) {
+        if (!awaiter->ready()) {
+            awaiter = awaiter->next;
+            continue;
+        }
+        remove(awaiter);
+        awaiter->handle.resume();
+        awaiter = head;
+    }
+}
+
+void Scheduler::add(ScheduledAwaiter* awaiter) {
+    awaiter->waiting = true;
+    awaiter->previous = tail;
+    awaiter->next = nullptr;
+    if (tail != nullptr) tail->next = awaiter;
+    else head = awaiter;
+    tail = awaiter;
+}
+
+void Scheduler::remove(ScheduledAwaiter* awaiter) {
+    awaiter->waiting = false;
+    if (awaiter->previous != nullptr) awaiter->previous->next = awaiter->next;
+    else head = awaiter->next;
+    if (awaiter->next != nullptr) awaiter->next->previous = awaiter->previous;
+    else tail = awaiter->previous;
+}
+
+Scheduler& scheduler() {
+    static Scheduler scheduler;
+    return scheduler;
+}
+} // namespace lemlib
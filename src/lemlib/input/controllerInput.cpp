@@ -0,0 +1,118 @@
+#include <cstring>
+#include <mutex>
+
+#include "lemlib/input/controllerInput.hpp"
+
+namespace lemlib {
+ControllerInput::ControllerInput(pros::controller_id_e_t id, uint32_t pollPeriod)
+    : controller(id),
+      pollPeriod(pollPeriod == 0 ? 1 : pollPeriod),
+      task([this]() { taskLoop(); }, TASK_PRIORITY_DEFAULT + 2, TASK_STACK_DEPTH_DEFAULT, "Controller Input") {}
+
+ControllerInput::~ControllerInput() {
+    std::lock_guard lock(mutex);
+    task.remove();
+}
+
+ControllerFrame ControllerInput::waitForFrame(uint32_t timeout) {
+    const uint32_t start = pros::millis();
+    while (true) {
+        {
+            std::lock_guard lock(mutex);
+            bool added = false;
+            Subscriber* subscriber = subscribe(added);
+            if (subscriber == nullptr) return frame;
+            if (added || subscriber->lastSequence != frame.sequence) {
+                ControllerFrame result = frame;
+                result.newPresses = subscriber->newPresses;
+                subscriber->newPresses = 0;
+                subscriber->lastSequence = frame.sequence;
+                return result;
+            }
+        }
+        // notifications may be left over from earlier frames, or sent by someone else, so check the sequence again
+        // after waking up
+        const uint32_t elapsed = pros::millis() - start;
+        if (timeout != TIMEOUT_MAX && elapsed >= timeout) break;
+        pros::c::task_notify_take(true, timeout == TIMEOUT_MAX ? TIMEOUT_MAX : timeout - elapsed);
+    }
+    std::lock_guard lock(mutex);
+    ControllerFrame result = frame;
+    result.newPresses = 0;
+    return result;
+}
+
+ControllerFrame ControllerInput::latest() {
+    std::lock_guard lock(mutex);
+    return frame;
+}
+
+void ControllerInput::markApplied(const ControllerFrame& frame) { latency.record(pros::micros() - frame.time); }
+
+ControllerFrame ControllerInput::read() {
+    ControllerFrame next;
+    next.leftX = controller.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_X);
+    next.leftY = controller.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_Y);
+    next.rightX = controller.get_analog(pros::E_CONTROLLER_ANALOG_RIGHT_X);
+    next.rightY = controller.get_analog(pros::E_CONTROLLER_ANALOG_RIGHT_Y);
+    for (int button = pros::E_CONTROLLER_DIGITAL_L1; button <= pros::E_CONTROLLER_DIGITAL_A; button++) {
+        const auto digital = static_cast<pros::controller_digital_e_t>(button);
+        if (controller.get_digital(digital)) next.buttons |= ControllerFrame::bit(digital);
+    }
+    return next;
+}
+
+ControllerInput::Subscriber* ControllerInput::subscribe(bool& added) {
+    const pros::task_t current = pros::c::task_get_current();
+    Subscriber* free = nullptr;
+    for (Subscriber& subscriber : subscribers) {
+        if (subscriber.task == current) return &subscriber;
+        if (subscriber.task == nullptr && free == nullptr) free = &subscriber;
+    }
+    if (free == nullptr) return nullptr;
+    *free = {};
+    free->task = current;
+    std::strncpy(free->name, pros::c::task_get_name(current), sizeof(free->name) - 1);
+    added = true;
+    return free;
+}
+
+bool ControllerInput::alive(const Subscriber& subscriber) {
+    // the kernel only finds tasks whose memory hasn't been freed, so a match means the handle is still safe to notify
+    return pros::c::task_get_by_name(subscriber.name) == subscriber.task;
+}
+
+void ControllerInput::taskLoop() {
+    uint32_t now = pros::millis();
+    while (true) {
+        const ControllerFrame next = read();
+        {
+            std::lock_guard lock(mutex);
+            if (next.leftX != frame.leftX || next.leftY != frame.leftY || next.rightX != frame.rightX ||
+                next.rightY != frame.rightY || next.buttons != frame.buttons) {
+                const uint16_t newPresses = next.buttons & ~frame.buttons;
+                const uint32_t sequence = frame.sequence + 1;
+                frame = next;
+                frame.newPresses = newPresses;
+                frame.time = pros::micros();
+                frame.sequence = sequence;
+                for (Subscriber& subscriber : subscribers) {
+                    if (subscriber.task == nullptr) continue;
+                    if (!alive(subscriber)) {
+                        subscriber = {};
+                        continue;
+                    }
+                    subscriber.newPresses |= newPresses;
+                    pros::c::task_notify(subscriber.task);
+                }
+            }
+        }
+        pros::Task::delay_until(&now, pollPeriod);
+    }
+}
+
+ControllerInput& controllerInput() {
+    static ControllerInput input;
+    return input;
+}
+} // namespace lemlib
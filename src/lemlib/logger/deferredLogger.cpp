@@ -0,0 +1,38 @@
+#include "lemlib/logger/deferredLogger.hpp"
+
+extern "C" const char lemlib_deferred_format_anchor[] = "";
+
+namespace lemlib {
+DeferredLogger::DeferredLogger(size_t slotCount, BinaryTelemetry& telemetry)
+    : telemetry(telemetry),
+      buffer(slotCount, MAX_MESSAGE, OverflowPolicy::DROP_NEWEST),
+      task([this]() { taskLoop(); }, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT, "Deferred Logger") {}
+
+DeferredLogger::~DeferredLogger() { task.remove(); }
+
+void DeferredLogger::setLowestLevel(Level level) { lowestLevel = level; }
+
+uint32_t DeferredLogger::getDropped() const {
+    return buffer.getDropped() + overflowed.load(std::memory_order_relaxed);
+}
+
+void DeferredLogger::taskLoop() {
+    char message[MAX_MESSAGE];
+    while (true) {
+        // send everything that was logged since the last iteration
+        size_t size;
+        while (buffer.pop(message, &size)) {
+            uint32_t time;
+            std::memcpy(&time, message, sizeof(time));
+            telemetry.sendRaw(BinaryTelemetry::LOG_RECORD, time, reinterpret_cast<const uint8_t*>(message) + 4,
+                              size - 4);
+        }
+        pros::delay(10);
+    }
+}
+
+DeferredLogger& deferredLogger() {
+    static DeferredLogger logger;
+    return logger;
+}
+} // namespace lemlib
@@ -0,0 +1,42 @@
+#include <cstdio>
+
+#include "lemlib/logger/lockFreeBuffer.hpp"
+
+namespace lemlib {
+LockFreeBuffer::LockFreeBuffer(std::function<void(std::string_view)> bufferFunc, size_t slotCount, size_t slotSize,
+                               OverflowPolicy policy)
+    : bufferFunc(std::move(bufferFunc)),
+      buffer(slotCount, slotSize, policy),
+      message(new char[buffer.getSlotSize()]),
+      task([=, this]() { taskLoop(); }) {}
+
+LockFreeBuffer::~LockFreeBuffer() { task.remove(); }
+
+bool LockFreeBuffer::pushToBuffer(std::string_view bufferData) { return buffer.push(bufferData); }
+
+void LockFreeBuffer::setRate(uint32_t rate) { this->rate.store(rate, std::memory_order_relaxed); }
+
+void LockFreeBuffer::setPolicy(OverflowPolicy policy) { buffer.setPolicy(policy); }
+
+bool LockFreeBuffer::buffersEmpty() { return buffer.empty(); }
+
+uint32_t LockFreeBuffer::getDropped() const { return buffer.getDropped(); }
+
+uint32_t LockFreeBuffer::getTruncated() const { return buffer.getTruncated(); }
+
+void LockFreeBuffer::taskLoop() {
+    while (true) {
+        size_t size;
+        if (buffer.pop(message.get(), &size)) bufferFunc(std::string_view(message.get(), size));
+        pros::delay(rate.load(std::memory_order_relaxed));
+    }
+}
+
+RingBufferedStdout::RingBufferedStdout()
+    : LockFreeBuffer([](std::string_view string) { fwrite(string.data(), 1, string.size(), stdout); }) {}
+
+RingBufferedStdout& ringBufferedStdout() {
+    static RingBufferedStdout bufferedStdout;
+    return bufferedStdout;
+}
+} // namespace lemlib
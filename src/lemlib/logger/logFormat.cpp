@@ -0,0 +1,143 @@
+#include <array>
+#include <cstring>
+#include <iterator>
+
+#define FMT_HEADER_ONLY
+#include "fmt/core.h"
+
+#include "lemlib/logger/logFormat.hpp"
+
+namespace lemlib {
+// number of formats that can be cached
+constexpr size_t MAX_CACHED_FORMATS = 8;
+// number of tasks that can have their own scratch buffers
+constexpr size_t MAX_SCRATCH_TASKS = 16;
+
+/**
+ * @brief Name of a level, as formatted by format_as(Level)
+ */
+static std::string_view levelName(Level level) {
+    switch (level) {
+        case Level::INFO: return "INFO";
+        case Level::DEBUG: return "DEBUG";
+        case Level::WARN: return "WARN";
+        case Level::ERROR: return "ERROR";
+        case Level::FATAL: return "FATAL";
+    }
+    return "";
+}
+
+LogFormat::LogFormat(std::string_view format) {
+    if (format.size() > MAX_LENGTH) {
+        dynamic = true;
+        return;
+    }
+    std::memcpy(this->format, format.data(), format.size());
+    length = format.size();
+
+    const auto addSegment = [this](Field field, size_t start, size_t length) {
+        if (field == Field::LITERAL && length == 0) return;
+        if (segmentCount == MAX_SEGMENTS) {
+            dynamic = true;
+            return;
+        }
+        segments[segmentCount++] = {field, uint8_t(start), uint8_t(length)};
+    };
+
+    size_t literalStart = 0;
+    size_t i = 0;
+    while (i < length && !dynamic) {
+        const char c = format[i];
+        // escaped braces
+        if ((c == '{' || c == '}') && i + 1 < length && format[i + 1] == c) {
+            addSegment(Field::LITERAL, literalStart, i + 1 - literalStart);
+            i += 2;
+            literalStart = i;
+        } else if (c == '{') {
+            addSegment(Field::LITERAL, literalStart, i - literalStart);
+            const size_t end = format.find('}', i);
+            if (end == std::string_view::npos) {
+                dynamic = true;
+                break;
+            }
+            const std::string_view name = format.substr(i + 1, end - i - 1);
+            if (name == "time") addSegment(Field::TIME, 0, 0);
+            else if (name == "level") addSegment(Field::LEVEL, 0, 0);
+            else if (name == "message") addSegment(Field::MESSAGE, 0, 0);
+            // format specs and extra arguments need the full fmt implementation
+            else dynamic = true;
+            i = end + 1;
+            literalStart = i;
+        } else if (c == '}') {
+            // unmatched closing brace, let fmt report it
+            dynamic = true;
+        } else {
+            i++;
+        }
+    }
+    addSegment(Field::LITERAL, literalStart, length - literalStart);
+}
+
+const LogFormat* LogFormat::get(const std::string& format) {
+    enum State : uint8_t { EMPTY, PARSING, READY };
+    struct CachedFormat {
+            std::atomic<uint8_t> state = EMPTY;
+            std::string_view source;
+            char storage[MAX_LENGTH];
+            LogFormat parsed {""};
+    };
+    static std::array<CachedFormat, MAX_CACHED_FORMATS> cache;
+
+    if (format.size() > MAX_LENGTH) return nullptr;
+    for (CachedFormat& entry : cache) {
+        const uint8_t state = entry.state.load(std::memory_order_acquire);
+        if (state == READY && entry.source == format) {
+            return entry.parsed.isDynamic() ? nullptr : &entry.parsed;
+        }
+        if (state == EMPTY) {
+            // claim the entry, then parse the format into it
+            uint8_t expected = EMPTY;
+            if (!entry.state.compare_exchange_strong(expected, PARSING, std::memory_order_acquire)) continue;
+            std::memcpy(entry.storage, format.data(), format.size());
+            entry.source = std::string_view(entry.storage, format.size());
+            entry.parsed = LogFormat(format);
+            entry.state.store(READY, std::memory_order_release);
+            return entry.parsed.isDynamic() ? nullptr : &entry.parsed;
+        }
+    }
+    // the cache is full
+    return nullptr;
+}
+
+bool LogFormat::isDynamic() const { return dynamic; }
+
+void LogFormat::formatTo(std::string& out, uint32_t time, Level level, std::string_view message) const {
+    for (size_t i = 0; i < segmentCount; i++) {
+        const Segment& segment = segments[i];
+        switch (segment.field) {
+            case Field::LITERAL: out.append(format + segment.start, segment.length); break;
+            case Field::TIME: fmt::format_to(std::back_inserter(out), "{}", time); break;
+            case Field::LEVEL: out.append(levelName(level)); break;
+            case Field::MESSAGE: out.append(message); break;
+        }
+    }
+}
+
+LogScratch* LogScratch::get() {
+    static std::array<LogScratch, MAX_SCRATCH_TASKS> scratches;
+
+    const pros::task_t current = pros::c::task_get_current();
+    // threads that aren't tasks, on the host, would all match the same buffers
+    if (current == nullptr) return nullptr;
+    for (LogScratch& scratch : scratches) {
+        pros::task_t owner = scratch.owner.load(std::memory_order_acquire);
+        // claim the first unused buffers
+        if (owner == nullptr &&
+            scratch.owner.compare_exchange_strong(owner, current, std::memory_order_acq_rel)) {
+            owner = current;
+        }
+        if (owner == current) return scratch.inUse ? nullptr : &scratch;
+    }
+    return nullptr;
+}
+} // namespace lemlib
@@ -0,0 +1,120 @@
+#include <cstring>
+
+#include "pros/rtos.hpp"
+#include "lemlib/logger/ringBuffer.hpp"
+
+namespace lemlib {
+/**
+ * @brief Round a number up to the next power of 2
+ */
+static size_t ceilPowerOf2(size_t value) {
+    size_t result = 1;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+RingBuffer::RingBuffer(size_t slotCount, size_t slotSize, OverflowPolicy policy)
+    : slotCount(ceilPowerOf2(slotCount < 2 ? 2 : slotCount)),
+      mask(this->slotCount - 1),
+      slotSize(slotSize > UINT16_MAX ? UINT16_MAX : slotSize),
+      policy(policy),
+      slots(new Slot[this->slotCount]),
+      data(new char[this->slotCount * this->slotSize]) {
+    // a slot is free for the producer at position n when its sequence is n
+    for (size_t i = 0; i < this->slotCount; i++) slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+bool RingBuffer::push(std::string_view message) {
+    if (message.size() > slotSize) {
+        message = message.substr(0, slotSize);
+        truncated.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool waited = false;
+    bool stalled = false;
+    uint32_t pos = enqueuePos.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true) {
+        slot = &slots[pos & mask];
+        const int32_t diff = int32_t(slot->sequence.load(std::memory_order_acquire) - pos);
+        if (diff == 0) {
+            // the slot is free, try to claim it
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            // the buffer is full
+            switch (policy.load(std::memory_order_relaxed)) {
+                case OverflowPolicy::DROP_NEWEST: dropped.fetch_add(1, std::memory_order_relaxed); return false;
+                case OverflowPolicy::DROP_OLDEST:
+                    if (pop(nullptr)) {
+                        dropped.fetch_add(1, std::memory_order_relaxed);
+                    } else if (stalled) {
+                        // the oldest message is still being written, maybe by a producer this task preempted, so
+                        // waiting for it to be published could spin forever. Drop this message instead
+                        dropped.fetch_add(1, std::memory_order_relaxed);
+                        return false;
+                    } else {
+                        // a consumer may have just made room, so look once more
+                        stalled = true;
+                    }
+                    break;
+                case OverflowPolicy::BLOCK:
+                    if (!waited) blocked.fetch_add(1, std::memory_order_relaxed);
+                    waited = true;
+                    pros::delay(1);
+                    break;
+            }
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        } else {
+            // another producer claimed the slot first
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    std::memcpy(slotData(pos), message.data(), message.size());
+    slot->size = message.size();
+    // publish the message to consumers
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool RingBuffer::pop(char* out, size_t* size) {
+    uint32_t pos = dequeuePos.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true) {
+        slot = &slots[pos & mask];
+        const int32_t diff = int32_t(slot->sequence.load(std::memory_order_acquire) - (pos + 1));
+        if (diff == 0) {
+            // the slot holds a published message, try to claim it
+            if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            // the buffer is empty
+            return false;
+        } else {
+            // another consumer claimed the slot first
+            pos = dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    if (out != nullptr) std::memcpy(out, slotData(pos), slot->size);
+    if (size != nullptr) *size = slot->size;
+    // hand the slot back to producers, one lap later
+    slot->sequence.store(pos + slotCount, std::memory_order_release);
+    return true;
+}
+
+bool RingBuffer::empty() const {
+    return dequeuePos.load(std::memory_order_acquire) == enqueuePos.load(std::memory_order_acquire);
+}
+
+size_t RingBuffer::getSlotSize() const { return slotSize; }
+
+void RingBuffer::setPolicy(OverflowPolicy policy) { this->policy.store(policy, std::memory_order_relaxed); }
+
+uint32_t RingBuffer::getDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+uint32_t RingBuffer::getTruncated() const { return truncated.load(std::memory_order_relaxed); }
+
+uint32_t RingBuffer::getBlocked() const { return blocked.load(std::memory_order_relaxed); }
+
+char* RingBuffer::slotData(uint32_t index) const { return data.get() + (index & mask) * slotSize; }
+} // namespace lemlib
@@ -0,0 +1,201 @@
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+#include "lemlib/logger/sdSink.hpp"
+#include "lemlib/profiling/scopeTimer.hpp"
+
+namespace lemlib {
+constexpr uint32_t OFFSET_BITS = 24;
+constexpr uint32_t OFFSET_MASK = (1 << OFFSET_BITS) - 1;
+
+// a sealed buffer is written early if nothing has been written for this long, in milliseconds
+constexpr uint32_t FLUSH_INTERVAL = 1000;
+
+SdSink::SdSink(std::string prefix, size_t bufferSize, size_t bufferCount, size_t maxFileSize)
+    : prefix(std::move(prefix)),
+      bufferSize(std::clamp<size_t>((bufferSize + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE, BLOCK_SIZE,
+                                    OFFSET_MASK / BLOCK_SIZE * BLOCK_SIZE)),
+      maxFileSize(maxFileSize),
+      // one extra block, so the buffers can be aligned
+      storage(new char[this->bufferSize * std::clamp<size_t>(bufferCount, 2, 255) + BLOCK_SIZE]),
+      buffers(new Buffer[std::clamp<size_t>(bufferCount, 2, 255)]),
+      bufferCount(std::clamp<size_t>(bufferCount, 2, 255)),
+      current(0),
+      task([this]() { taskLoop(); }, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT, "SD Sink") {
+    const uintptr_t address = reinterpret_cast<uintptr_t>(storage.get());
+    char* aligned = storage.get() + (BLOCK_SIZE - address % BLOCK_SIZE) % BLOCK_SIZE;
+    for (size_t i = 0; i < this->bufferCount; i++) buffers[i].data = aligned + i * this->bufferSize;
+    // buffer 0 is filled first
+    buffers[0].state = BufferState::FILLING;
+    setFormat("[{time}] {level}: {message}");
+}
+
+SdSink::~SdSink() {
+    std::lock_guard lock(writeMutex);
+    task.remove();
+    seal();
+    writeSealed();
+    if (file != nullptr) fclose(file);
+}
+
+void SdSink::flush() { flushRequested = true; }
+
+uint32_t SdSink::getBytesWritten() const { return bytesWritten; }
+
+float SdSink::getThroughput() const {
+    const uint32_t time = writeTime;
+    return time == 0 ? 0 : bytesWritten * 1e6f / time;
+}
+
+uint32_t SdSink::getDropped() const { return dropped; }
+
+uint32_t SdSink::getBuffersDropped() const { return buffersDropped; }
+
+void SdSink::sendMessage(const Message& message) {
+    LEMLIB_PROFILE_SCOPE("SdSink::sendMessage");
+    const size_t size = std::min<size_t>(message.message.size(), bufferSize - 1);
+    // append the message and its newline in one reservation, so lines from different tasks can't be interleaved
+    char line[256];
+    if (size < sizeof(line)) {
+        std::memcpy(line, message.message.data(), size);
+        line[size] = '\n';
+        if (!append(line, size + 1)) dropped++;
+    } else {
+        std::string longLine(message.message, 0, size);
+        longLine += '\n';
+        if (!append(longLine.data(), longLine.size())) dropped++;
+    }
+}
+
+bool SdSink::append(const char* data, uint32_t size) {
+    uint32_t state = current.load(std::memory_order_relaxed);
+    while (true) {
+        const uint32_t index = state >> OFFSET_BITS;
+        const uint32_t offset = state & OFFSET_MASK;
+
+        if (offset + size <= bufferSize) {
+            // reserve space in the current buffer
+            if (!current.compare_exchange_weak(state, state + size, std::memory_order_acquire,
+                                               std::memory_order_relaxed)) {
+                continue;
+            }
+            std::memcpy(buffers[index].data + offset, data, size);
+            buffers[index].committed.fetch_add(size, std::memory_order_release);
+            return true;
+        }
+
+        // the current buffer is full. Switch to a free one and reserve the start of it
+        const int next = claimFreeBuffer();
+        if (next < 0) return false;
+        if (!current.compare_exchange_strong(state, (uint32_t(next) << OFFSET_BITS) | size, std::memory_order_acq_rel,
+                                             std::memory_order_relaxed)) {
+            // another task switched buffers first
+            buffers[next].state.store(BufferState::FREE, std::memory_order_release);
+            continue;
+        }
+        buffers[index].next = next;
+        buffers[index].length.store(offset, std::memory_order_release);
+        std::memcpy(buffers[next].data, data, size);
+        buffers[next].committed.fetch_add(size, std::memory_order_release);
+        return true;
+    }
+}
+
+bool SdSink::seal() {
+    uint32_t state = current.load(std::memory_order_relaxed);
+    while (true) {
+        const uint32_t index = state >> OFFSET_BITS;
+        const uint32_t offset = state & OFFSET_MASK;
+        if (offset == 0) return false;
+        const int next = claimFreeBuffer();
+        if (next < 0) return false;
+        if (!current.compare_exchange_strong(state, uint32_t(next) << OFFSET_BITS, std::memory_order_acq_rel,
+                                             std::memory_order_relaxed)) {
+            buffers[next].state.store(BufferState::FREE, std::memory_order_release);
+            continue;
+        }
+        buffers[index].next = next;
+        buffers[index].length.store(offset, std::memory_order_release);
+        return true;
+    }
+}
+
+int SdSink::claimFreeBuffer() {
+    for (size_t i = 0; i < bufferCount; i++) {
+        BufferState expected = BufferState::FREE;
+        if (buffers[i].state.compare_exchange_strong(expected, BufferState::FILLING, std::memory_order_acquire)) {
+            buffers[i].committed.store(0, std::memory_order_relaxed);
+            buffers[i].length.store(UNSEALED, std::memory_order_relaxed);
+            return i;
+        }
+    }
+    return -1;
+}
+
+void SdSink::writeBuffer(Buffer& buffer, uint32_t length) {
+    // start a new file if this buffer would make the current one too large
+    if (file != nullptr && fileSize + length > maxFileSize) {
+        fclose(file);
+        file = nullptr;
+    }
+    if (file == nullptr) {
+        char path[256];
+        snprintf(path, sizeof(path), "%s_%03u.txt", prefix.c_str(), static_cast<unsigned>(fileNumber++));
+        file = fopen(path, "w");
+        // write whole buffers straight to the card, instead of splitting them into stdio's small buffer
+        if (file != nullptr) setvbuf(file, nullptr, _IONBF, 0);
+        fileSize = 0;
+    }
+    if (file == nullptr) {
+        buffersDropped++;
+        return;
+    }
+
+    const uint64_t start = pros::micros();
+    const size_t written = fwrite(buffer.data, 1, length, file);
+    fflush(file);
+    writeTime += pros::micros() - start;
+    bytesWritten += written;
+    fileSize += written;
+    if (written != length) {
+        // the card was removed or is full. Try a new file next time
+        buffersDropped++;
+        fclose(file);
+        file = nullptr;
+    }
+}
+
+bool SdSink::writeSealed() {
+    bool wrote = false;
+    while (true) {
+        Buffer& buffer = buffers[writeIndex];
+        const uint32_t length = buffer.length.load(std::memory_order_acquire);
+        if (length == UNSEALED) return wrote;
+        // wait for producers that reserved space before the buffer was sealed to finish copying
+        if (buffer.committed.load(std::memory_order_acquire) != length) return wrote;
+
+        buffer.state.store(BufferState::WRITING, std::memory_order_relaxed);
+        writeBuffer(buffer, length);
+        writeIndex = buffer.next;
+        buffer.state.store(BufferState::FREE, std::memory_order_release);
+        wrote = true;
+    }
+}
+
+void SdSink::taskLoop() {
+    uint32_t lastWrite = pros::millis();
+    while (true) {
+        const uint32_t now = pros::millis();
+        if (flushRequested.exchange(false) || now - lastWrite >= FLUSH_INTERVAL) {
+            seal();
+            lastWrite = now;
+        }
+        {
+            std::lock_guard lock(writeMutex);
+            if (writeSealed()) lastWrite = now;
+        }
+        pros::delay(10);
+    }
+}
+} // namespace lemlib
@@ -0,0 +1,93 @@
+#include <cstring>
+
+#include "lemlib/math/fastMath.hpp"
+
+namespace {
+// 4 floats, which GCC compiles to NEON on the brain, and to whatever the host has elsewhere
+using Floats = float __attribute__((vector_size(16)));
+constexpr size_t LANES = sizeof(Floats) / sizeof(float);
+
+Floats load(const float* values) {
+    Floats vector;
+    std::memcpy(&vector, values, sizeof(vector));
+    return vector;
+}
+
+void store(float* values, Floats vector) { std::memcpy(values, &vector, sizeof(vector)); }
+
+// the last values that don't fill a vector go through a padded copy, so they're computed the same way as the rest
+Floats loadPartial(const float* values, size_t count) {
+    float padded[LANES] = {};
+    std::memcpy(padded, values, count * sizeof(float));
+    return load(padded);
+}
+
+void storePartial(float* values, Floats vector, size_t count) {
+    float padded[LANES];
+    store(padded, vector);
+    std::memcpy(values, padded, count * sizeof(float));
+}
+
+// apply a kernel with 1 output to each group of values from 2 inputs
+template <typename Kernel> void apply2(const float* a, const float* b, float* out, size_t count, Kernel kernel) {
+    size_t i = 0;
+    for (; i + LANES <= count; i += LANES) store(out + i, kernel(load(a + i), load(b + i)));
+    if (i < count) {
+        storePartial(out + i, kernel(loadPartial(a + i, count - i), loadPartial(b + i, count - i)), count - i);
+    }
+}
+} // namespace
+
+namespace lemlib::fast {
+void sin(const float* angles, float* sines, size_t count) {
+    size_t i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        Floats sin, cos;
+        kernel::sincos(load(angles + i), sin, cos);
+        store(sines + i, sin);
+    }
+    if (i < count) {
+        Floats sin, cos;
+        kernel::sincos(loadPartial(angles + i, count - i), sin, cos);
+        storePartial(sines + i, sin, count - i);
+    }
+}
+
+void cos(const float* angles, float* cosines, size_t count) {
+    size_t i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        Floats sin, cos;
+        kernel::sincos(load(angles + i), sin, cos);
+        store(cosines + i, cos);
+    }
+    if (i < count) {
+        Floats sin, cos;
+        kernel::sincos(loadPartial(angles + i, count - i), sin, cos);
+        storePartial(cosines + i, cos, count - i);
+    }
+}
+
+void sincos(const float* angles, float* sines, float* cosines, size_t count) {
+    size_t i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        Floats sin, cos;
+        kernel::sincos(load(angles + i), sin, cos);
+        store(sines + i, sin);
+        store(cosines + i, cos);
+    }
+    if (i < count) {
+        Floats sin, cos;
+        kernel::sincos(loadPartial(angles + i, count - i), sin, cos);
+        storePartial(sines + i, sin, count - i);
+        storePartial(cosines + i, cos, count - i);
+    }
+}
+
+void atan2(const float* y, const float* x, float* angles, size_t count) {
+    apply2(y, x, angles, count, [](Floats y, Floats x) { return kernel::atan2(y, x); });
+}
+
+void hypot(const float* x, const float* y, float* lengths, size_t count) {
+    apply2(x, y, lengths, count, [](Floats x, Floats y) { return kernel::hypot(x, y); });
+}
+} // namespace lemlib::fast
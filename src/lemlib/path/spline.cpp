@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+#include <utility>
+
+#include "lemlib/path/spline.hpp"
+
+namespace {
+// a spline's segments, built from waypoints or control points
+template <typename Write> std::vector<lemlib::SplineSegment> build(Write write) {
+    std::vector<lemlib::SplineSegment> segments;
+    write(std::back_inserter(segments));
+    return segments;
+}
+} // namespace
+
+namespace lemlib {
+Spline::Spline(std::vector<SplineSegment> segments, float resolution) : segments(std::move(segments)) {
+    // an empty spline is a point, at the origin
+    if (this->segments.empty()) this->segments.emplace_back();
+    lengths.resize(this->segments.size() * spline::SUBDIVISIONS + 1);
+    spline::tabulate(this->segments, lengths);
+    totalLength = lengths.back();
+    // the inverse table, from arc length to parameter, with entries spaced evenly over the whole spline
+    const size_t count = std::max<size_t>(2, std::ceil(totalLength / resolution) + 1);
+    step = totalLength / (count - 1);
+    parameters.reserve(count);
+    size_t entry = 0;
+    for (size_t i = 0; i < count; i++) {
+        parameters.push_back(spline::parameter(this->segments, lengths, i * step, entry));
+    }
+}
+
+Pose Spline::sample(float distance) const {
+    float t;
+    const SplineSegment& segment = spline::locate(segments, parameter(distance), t);
+    const SplineSegment::Vector position = segment.position(t);
+    return Pose(position.x, position.y, segment.heading(t));
+}
+
+float Spline::curvature(float distance) const {
+    float t;
+    return spline::locate(segments, parameter(distance), t).curvature(t);
+}
+
+float Spline::heading(float distance) const {
+    float t;
+    return spline::locate(segments, parameter(distance), t).heading(t);
+}
+
+std::vector<Pose> Spline::generate(const PathSettings& settings) const {
+    const int count = std::max(1, int(std::ceil(totalLength / settings.spacing)));
+    const float spacing = totalLength / count;
+    std::vector<Pose> points;
+    std::vector<float> curvatures;
+    points.reserve(count + 1);
+    curvatures.reserve(count + 1);
+    for (int i = 0; i <= count; i++) {
+        points.push_back(sample(i * spacing));
+        curvatures.push_back(curvature(i * spacing));
+    }
+    std::vector<float> speeds(points.size());
+    spline::profile(curvatures, speeds, spacing, settings);
+    for (size_t i = 0; i < points.size(); i++) points[i].theta = speeds[i];
+    return points;
+}
+
+float Spline::parameter(float distance) const {
+    if (step == 0) return 0;
+    const float position = std::clamp(distance, 0.0f, totalLength) / step;
+    const size_t i = std::min(size_t(position), parameters.size() - 2);
+    return parameters[i] + (parameters[i + 1] - parameters[i]) * (position - i);
+}
+
+CubicHermite::CubicHermite(const std::vector<Pose>& waypoints, float tension, float resolution)
+    : Spline(build([&](auto out) { spline::hermite(waypoints, tension, false, out); }), resolution) {}
+
+QuinticHermite::QuinticHermite(const std::vector<Pose>& waypoints, float tension, float resolution)
+    : Spline(build([&](auto out) { spline::hermite(waypoints, tension, true, out); }), resolution) {}
+
+CubicBezier::CubicBezier(const std::vector<Pose>& controlPoints, float resolution)
+    : Spline(build([&](auto out) { spline::bezier(controlPoints, out); }), resolution) {}
+
+PathAsset::PathAsset(const std::vector<Pose>& points) {
+    for (const Pose& point : points) {
+        char line[64];
+        const int length = std::snprintf(line, sizeof(line), "%.3f, %.3f, %.3f\n", point.x, point.y, point.theta);
+        text.insert(text.end(), line, line + length);
+    }
+    constexpr char END[] = "endData\n";
+    text.insert(text.end(), END, END + sizeof(END) - 1);
+    file = {reinterpret_cast<uint8_t*>(text.data()), text.size()};
+}
+} // namespace lemlib
@@ -0,0 +1,139 @@
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+#include "lemlib/logger/deferredLogger.hpp"
+#include "lemlib/profiling/deadlineMonitor.hpp"
+
+namespace lemlib {
+// not part of the monitor, so checking it doesn't start the watchdog
+static std::atomic<bool> degraded = false;
+
+bool inDegradedMode() { return degraded.load(std::memory_order_relaxed); }
+
+void Deadline::beginCycle() {
+    const uint32_t now = pros::micros();
+    if (started && period != 0) {
+        const uint32_t interval = now - cycleStart;
+        // half a period of jitter is allowed
+        if (interval > period * 1500) miss(DeadlineMissType::LATE, interval - period * 1000);
+    }
+    cycleStart = now;
+    started = true;
+}
+
+void Deadline::endCycle() { endCycle(budget); }
+
+void Deadline::endCycle(uint32_t cycleBudget) {
+    const uint32_t duration = pros::micros() - cycleStart;
+    if (duration > cycleBudget) miss(DeadlineMissType::OVER_BUDGET, duration - cycleBudget);
+}
+
+void Deadline::miss(DeadlineMissType type, uint32_t amount) {
+    (type == DeadlineMissType::LATE ? late : overBudget).fetch_add(1, std::memory_order_relaxed);
+    const uint32_t time = pros::millis();
+    lastMiss.store(time, std::memory_order_relaxed);
+    deadlineMonitor().record({.name = name, .time = time, .amount = amount, .type = type});
+    // misses happen in control loops, so they are logged without formatting them on the brain
+    LEMLIB_DEFERRED_LOG(Level::WARN, "{} missed its deadline: {} by {} us", name,
+                        type == DeadlineMissType::LATE ? "late" : "over budget", amount);
+}
+
+DeadlineMonitor::DeadlineMonitor(uint32_t checkInterval)
+    : checkInterval(checkInterval == 0 ? 1 : checkInterval),
+      task([this]() { taskLoop(); }, TASK_PRIORITY_MAX - 2, TASK_STACK_DEPTH_DEFAULT, "Deadline Monitor") {}
+
+DeadlineMonitor::~DeadlineMonitor() {
+    std::lock_guard lock(mutex);
+    task.remove();
+}
+
+Deadline* DeadlineMonitor::add(const char* name, uint32_t period, uint32_t budget) {
+    std::lock_guard lock(mutex);
+    const size_t count = deadlineCount.load();
+    for (size_t i = 0; i < count; i++) {
+        if (std::strcmp(deadlines[i].name, name) != 0) continue;
+        // the task was created again, so the time since its last cycle doesn't count
+        deadlines[i].started = false;
+        return &deadlines[i];
+    }
+    if (count >= MAX_DEADLINES) return nullptr;
+    Deadline& deadline = deadlines[count];
+    deadline.name = name;
+    deadline.period = period;
+    deadline.budget = budget;
+    deadlineCount.store(count + 1);
+    return &deadline;
+}
+
+void DeadlineMonitor::setDegradePolicy(uint32_t misses, uint32_t window, uint32_t recovery) {
+    // misses are counted from the recent misses, so no more than that many can be required
+    degradeMisses = misses == 0 ? 1 : (misses > RECENT_MISSES ? RECENT_MISSES : misses);
+    degradeWindow = window;
+    recoveryTime = recovery;
+}
+
+void DeadlineMonitor::record(const DeadlineMiss& miss) {
+    // deadlines are missed by tasks of any priority, so this can't lock. A miss being read while it is written can be
+    // torn, which only affects the report
+    const uint32_t index = missCount.fetch_add(1, std::memory_order_relaxed);
+    recent[index % RECENT_MISSES] = miss;
+}
+
+size_t DeadlineMonitor::getRecentMisses(DeadlineMiss* misses, size_t size) const {
+    const uint32_t count = missCount.load(std::memory_order_relaxed);
+    size_t copied = 0;
+    while (copied < size && copied < RECENT_MISSES && copied < count) {
+        misses[copied] = recent[(count - 1 - copied) % RECENT_MISSES];
+        copied++;
+    }
+    return copied;
+}
+
+void DeadlineMonitor::printReport() const {
+    printf("%-16s %8s %8s %8s\n", "deadline", "late", "budget", "last ms");
+    for (size_t i = 0; i < deadlineCount; i++) {
+        const Deadline& deadline = deadlines[i];
+        printf("%-16s %8lu %8lu %8lu\n", deadline.name, static_cast<unsigned long>(deadline.getLateCount()),
+               static_cast<unsigned long>(deadline.getOverBudgetCount()),
+               static_cast<unsigned long>(deadline.getLastMissTime()));
+    }
+    DeadlineMiss misses[RECENT_MISSES];
+    const size_t count = getRecentMisses(misses, RECENT_MISSES);
+    for (size_t i = 0; i < count; i++) {
+        printf("%8lu ms %-16s %s by %lu us\n", static_cast<unsigned long>(misses[i].time), misses[i].name,
+               misses[i].type == DeadlineMissType::LATE ? "late" : "over budget",
+               static_cast<unsigned long>(misses[i].amount));
+    }
+    if (degradedCount != 0) printf("degraded %lu times\n", static_cast<unsigned long>(degradedCount.load()));
+}
+
+void DeadlineMonitor::taskLoop() {
+    uint32_t now = pros::millis();
+    while (true) {
+        pros::Task::delay_until(&now, checkInterval);
+        DeadlineMiss misses[RECENT_MISSES];
+        const size_t count = getRecentMisses(misses, RECENT_MISSES);
+        const uint32_t time = pros::millis();
+        if (!degraded) {
+            // count the misses within the window. They are newest first, so stop at the first one outside it
+            uint32_t inWindow = 0;
+            while (inWindow < count && time - misses[inWindow].time < degradeWindow) inWindow++;
+            if (inWindow >= degradeMisses) {
+                degraded = true;
+                degradedCount.fetch_add(1, std::memory_order_relaxed);
+                LEMLIB_DEFERRED_LOG(Level::ERROR, "degraded mode: {} deadlines missed in {} ms", inWindow,
+                                    degradeWindow.load());
+            }
+        } else if (count == 0 || time - misses[0].time >= recoveryTime) {
+            degraded = false;
+            LEMLIB_DEFERRED_LOG(Level::INFO, "left degraded mode");
+        }
+    }
+}
+
+DeadlineMonitor& deadlineMonitor() {
+    static DeadlineMonitor monitor;
+    return monitor;
+}
+} // namespace lemlib
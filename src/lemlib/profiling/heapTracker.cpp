@@ -0,0 +1,335 @@
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "pros/rtos.hpp"
+#include "lemlib/profiling/heapTracker.hpp"
+
+namespace lemlib {
+// tag 0 is for untagged allocations
+constexpr size_t MAX_TAGS = 16;
+// tasks that can have a tag or zone active at the same time
+constexpr size_t MAX_CONTEXTS = 16;
+
+/**
+ * @brief Counters of the whole program or a single tag
+ */
+struct HeapCounters {
+        std::atomic<uint32_t> allocations = 0;
+        std::atomic<uint32_t> frees = 0;
+        std::atomic<uint32_t> totalBytes = 0;
+        std::atomic<uint32_t> liveBytes = 0;
+        std::atomic<uint32_t> peakBytes = 0;
+
+        void allocate(uint32_t size) {
+            allocations.fetch_add(1, std::memory_order_relaxed);
+            totalBytes.fetch_add(size, std::memory_order_relaxed);
+            const uint32_t live = liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+            uint32_t peak = peakBytes.load(std::memory_order_relaxed);
+            while (live > peak && !peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+        }
+
+        void free(uint32_t size) {
+            frees.fetch_add(1, std::memory_order_relaxed);
+            liveBytes.fetch_sub(size, std::memory_order_relaxed);
+        }
+
+        HeapStats stats() const {
+            return {.allocations = allocations.load(std::memory_order_relaxed),
+                    .frees = frees.load(std::memory_order_relaxed),
+                    .totalBytes = totalBytes.load(std::memory_order_relaxed),
+                    .liveBytes = liveBytes.load(std::memory_order_relaxed),
+                    .peakBytes = peakBytes.load(std::memory_order_relaxed)};
+        }
+};
+
+/**
+ * @brief The tag and zone of a task. Only held while one of them is active
+ */
+struct HeapContext {
+        std::atomic<pros::task_t> owner = nullptr;
+        uint8_t tag = 0;
+        const char* zone = nullptr;
+};
+
+// these are only touched by code that can't allocate, and are constant initialized, so they can be used by
+// allocations made before main
+static HeapCounters totalCounters;
+static std::array<HeapCounters, MAX_TAGS> tagCounters;
+static std::array<std::atomic<const char*>, MAX_TAGS> tagNames;
+static std::array<HeapContext, MAX_CONTEXTS> contexts;
+static std::atomic<uint32_t> violations = 0;
+static std::atomic<const char*> lastViolation = nullptr;
+static std::atomic<bool> abortOnViolation = false;
+// blocks freed through operator delete that operator new didn't allocate
+static std::atomic<uint32_t> foreignFrees = 0;
+
+/**
+ * @brief Find the context of the current task
+ *
+ * @param claim whether to claim a context if the task doesn't have one
+ * @return HeapContext* the context, or nullptr if there is none, or this isn't a task
+ */
+static HeapContext* currentContext(bool claim) {
+    const pros::task_t current = pros::c::task_get_current();
+    // threads that aren't tasks, on the host, would all match the unclaimed contexts
+    if (current == nullptr) return nullptr;
+    for (HeapContext& context : contexts) {
+        if (context.owner.load(std::memory_order_acquire) == current) return &context;
+    }
+    if (!claim) return nullptr;
+    for (HeapContext& context : contexts) {
+        pros::task_t expected = nullptr;
+        if (context.owner.compare_exchange_strong(expected, current, std::memory_order_acq_rel)) return &context;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Release the context of the current task once it has no tag or zone
+ */
+static void releaseContext(HeapContext* context) {
+    if (context->tag == 0 && context->zone == nullptr) context->owner.store(nullptr, std::memory_order_release);
+}
+
+/**
+ * @brief Find or add a tag
+ *
+ * @return uint8_t the index of the tag, or 0 if there are too many tags
+ */
+static uint8_t findTag(const char* name) {
+    for (uint8_t i = 1; i < MAX_TAGS; i++) {
+        const char* tagName = tagNames[i].load(std::memory_order_acquire);
+        if (tagName == nullptr) {
+            if (tagNames[i].compare_exchange_strong(tagName, name, std::memory_order_acq_rel)) return i;
+        }
+        if (tagName == name || std::strcmp(tagName, name) == 0) return i;
+    }
+    return 0;
+}
+
+HeapTag::HeapTag(const char* name) {
+    if constexpr (!LEMLIB_HEAP_TRACKING) return;
+    HeapContext* context = currentContext(true);
+    if (context == nullptr) return;
+    previous = context->tag;
+    context->tag = findTag(name);
+}
+
+HeapTag::~HeapTag() {
+    if constexpr (!LEMLIB_HEAP_TRACKING) return;
+    HeapContext* context = currentContext(false);
+    if (context == nullptr) return;
+    context->tag = previous;
+    releaseContext(context);
+}
+
+NoAllocZone::NoAllocZone(const char* name) {
+    if constexpr (!LEMLIB_HEAP_TRACKING) return;
+    HeapContext* context = currentContext(true);
+    if (context == nullptr) return;
+    previous = context->zone;
+    context->zone = name;
+}
+
+NoAllocZone::~NoAllocZone() {
+    if constexpr (!LEMLIB_HEAP_TRACKING) return;
+    HeapContext* context = currentContext(false);
+    if (context == nullptr) return;
+    context->zone = previous;
+    releaseContext(context);
+}
+
+HeapStats heapStats() { return totalCounters.stats(); }
+
+HeapStats heapStats(const char* name) {
+    if (name == nullptr) return tagCounters[0].stats();
+    for (uint8_t i = 1; i < MAX_TAGS; i++) {
+        const char* tagName = tagNames[i].load(std::memory_order_acquire);
+        if (tagName != nullptr && std::strcmp(tagName, name) == 0) return tagCounters[i].stats();
+    }
+    return {};
+}
+
+uint32_t noAllocViolations() { return violations; }
+
+const char* lastNoAllocViolation() { return lastViolation; }
+
+void setNoAllocAbort(bool abort) { abortOnViolation = abort; }
+
+void printHeapReport() {
+    const auto printStats = [](const char* name, const HeapStats& stats) {
+        printf("%-16s %8lu %8lu %10lu %8lu %8lu\n", name, static_cast<unsigned long>(stats.allocations),
+               static_cast<unsigned long>(stats.frees), static_cast<unsigned long>(stats.totalBytes),
+               static_cast<unsigned long>(stats.liveBytes), static_cast<unsigned long>(stats.peakBytes));
+    };
+    printf("%-16s %8s %8s %10s %8s %8s\n", "tag", "allocs", "frees", "bytes", "live", "peak");
+    printStats("total", heapStats());
+    printStats("untagged", tagCounters[0].stats());
+    for (uint8_t i = 1; i < MAX_TAGS; i++) {
+        const char* name = tagNames[i].load(std::memory_order_acquire);
+        if (name != nullptr) printStats(name, tagCounters[i].stats());
+    }
+    if (violations != 0) {
+        printf("%lu allocations in a NoAllocZone, last in %s\n", static_cast<unsigned long>(violations.load()),
+               lastViolation.load());
+    }
+    if (foreignFrees != 0) {
+        printf("%lu untracked blocks freed, from code that doesn't use the tracking operator new\n",
+               static_cast<unsigned long>(foreignFrees.load()));
+    }
+}
+
+#if LEMLIB_HEAP_TRACKING
+/**
+ * @brief Stored before every allocation
+ *
+ * Padded to the alignment malloc guarantees, so the memory after it is aligned the same way.
+ */
+struct alignas(alignof(std::max_align_t)) BlockHeader {
+        /** BLOCK_MAGIC mixed with the block's address, so a block that wasn't allocated here is told apart */
+        uint32_t magic;
+        uint32_t size;
+        uint8_t tag;
+        /** whether the block was allocated with an alignment larger than malloc's */
+        bool aligned;
+};
+
+constexpr uint32_t BLOCK_MAGIC = 0x4c454d48;
+
+/**
+ * @brief The magic word of a block
+ */
+static uint32_t blockMagic(const void* pointer) { return BLOCK_MAGIC ^ uint32_t(reinterpret_cast<uintptr_t>(pointer)); }
+
+/**
+ * @brief Count an allocation and check that the current task is allowed to allocate
+ *
+ * @return uint8_t the tag the allocation belongs to
+ */
+static uint8_t recordAllocation(size_t size) {
+    uint8_t tag = 0;
+    if (HeapContext* context = currentContext(false)) {
+        tag = context->tag;
+        if (context->zone != nullptr) {
+            violations.fetch_add(1, std::memory_order_relaxed);
+            lastViolation.store(context->zone, std::memory_order_relaxed);
+            if (abortOnViolation) {
+                fprintf(stderr, "lemlib: allocated %lu bytes in NoAllocZone \"%s\"\n",
+                        static_cast<unsigned long>(size), context->zone);
+                std::abort();
+            }
+        }
+    }
+    totalCounters.allocate(size);
+    tagCounters[tag].allocate(size);
+    return tag;
+}
+
+[[noreturn]] static void allocationFailed() {
+#if __cpp_exceptions
+    throw std::bad_alloc();
+#else
+    std::abort();
+#endif
+}
+
+static void* trackedAllocate(size_t size, size_t alignment, bool nothrow) {
+    if (size == 0) size = 1;
+    const bool aligned = alignment > alignof(std::max_align_t);
+    // aligned blocks also store the pointer malloc returned, just before the header
+    const size_t overhead = aligned ? sizeof(BlockHeader) + sizeof(void*) + alignment : sizeof(BlockHeader);
+    void* raw = std::malloc(size + overhead);
+    if (raw == nullptr) {
+        if (nothrow) return nullptr;
+        allocationFailed();
+    }
+
+    uintptr_t data = reinterpret_cast<uintptr_t>(raw) + sizeof(BlockHeader);
+    if (aligned) {
+        data = (data + sizeof(void*) + alignment - 1) / alignment * alignment;
+        reinterpret_cast<void**>(data - sizeof(BlockHeader))[-1] = raw;
+    }
+    BlockHeader* header = reinterpret_cast<BlockHeader*>(data) - 1;
+    header->magic = blockMagic(header + 1);
+    header->size = size;
+    header->aligned = aligned;
+    header->tag = recordAllocation(size);
+    return reinterpret_cast<void*>(data);
+}
+
+static void trackedFree(void* pointer) {
+    if (pointer == nullptr) return;
+    BlockHeader* header = static_cast<BlockHeader*>(pointer) - 1;
+    // memory from the standard operator new, like that of code linked without these replacements, has no header
+    if (header->magic != blockMagic(pointer)) {
+        foreignFrees.fetch_add(1, std::memory_order_relaxed);
+        return std::free(pointer);
+    }
+    // cleared, so a block from the standard operator new that malloc later puts at the same address isn't mistaken for
+    // this one
+    header->magic = 0;
+    totalCounters.free(header->size);
+    tagCounters[header->tag].free(header->size);
+    std::free(header->aligned ? reinterpret_cast<void**>(header)[-1] : header);
+}
+#endif
+} // namespace lemlib
+
+#if LEMLIB_HEAP_TRACKING
+void* operator new(size_t size) { return lemlib::trackedAllocate(size, 0, false); }
+
+void* operator new[](size_t size) { return lemlib::trackedAllocate(size, 0, false); }
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return lemlib::trackedAllocate(size, 0, true); }
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return lemlib::trackedAllocate(size, 0, true); }
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    return lemlib::trackedAllocate(size, size_t(alignment), false);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return lemlib::trackedAllocate(size, size_t(alignment), false);
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return lemlib::trackedAllocate(size, size_t(alignment), true);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return lemlib::trackedAllocate(size, size_t(alignment), true);
+}
+
+void operator delete(void* pointer) noexcept { lemlib::trackedFree(pointer); }
+
+void operator delete[](void* pointer) noexcept { lemlib::trackedFree(pointer); }
+
+void operator delete(void* pointer, size_t) noexcept { lemlib::trackedFree(pointer); }
+
+void operator delete[](void* pointer, size_t) noexcept { lemlib::trackedFree(pointer); }
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { lemlib::trackedFree(pointer); }
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { lemlib::trackedFree(pointer); }
+
+void operator delete(void* pointer, std::align_val_t) noexcept { lemlib::trackedFree(pointer); }
+
+void operator delete[](void* pointer, std::align_val_t) noexcept { lemlib::trackedFree(pointer); }
+
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept { lemlib::trackedFree(pointer); }
+
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept { lemlib::trackedFree(pointer); }
+
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    lemlib::trackedFree(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    lemlib::trackedFree(pointer);
+}
+#endif
@@ -0,0 +1,50 @@
+#include <algorithm>
+
+#include "lemlib/profiling/deadlineMonitor.hpp"
+#include "lemlib/profiling/monitoredChassis.hpp"
+
+namespace lemlib {
+// the period of the template's motion loops, in milliseconds
+static constexpr int LOOP_PERIOD = 10;
+
+template <typename Motion> void MonitoredChassis::monitor(const char* name, int timeout, bool async, Motion motion) {
+    if (async) return motion();
+    // waiting for an earlier async motion to finish isn't part of this one
+    waitUntilDone();
+    Deadline* deadline = deadlineMonitor().add(name, 0, 0);
+    if (deadline != nullptr) deadline->beginCycle();
+    motion();
+    if (deadline != nullptr) deadline->endCycle(uint32_t(std::max(timeout, 0) + 2 * LOOP_PERIOD) * 1000);
+}
+
+void MonitoredChassis::turnToPoint(float x, float y, int timeout, TurnToPointParams params, bool async) {
+    monitor("turnToPoint", timeout, async, [&] { Chassis::turnToPoint(x, y, timeout, params, async); });
+}
+
+void MonitoredChassis::turnToHeading(float theta, int timeout, TurnToHeadingParams params, bool async) {
+    monitor("turnToHeading", timeout, async, [&] { Chassis::turnToHeading(theta, timeout, params, async); });
+}
+
+void MonitoredChassis::swingToHeading(float theta, DriveSide lockedSide, int timeout, SwingToHeadingParams params,
+                                      bool async) {
+    monitor("swingToHeading", timeout, async,
+            [&] { Chassis::swingToHeading(theta, lockedSide, timeout, params, async); });
+}
+
+void MonitoredChassis::swingToPoint(float x, float y, DriveSide lockedSide, int timeout, SwingToPointParams params,
+                                    bool async) {
+    monitor("swingToPoint", timeout, async, [&] { Chassis::swingToPoint(x, y, lockedSide, timeout, params, async); });
+}
+
+void MonitoredChassis::moveToPose(float x, float y, float theta, int timeout, MoveToPoseParams params, bool async) {
+    monitor("moveToPose", timeout, async, [&] { Chassis::moveToPose(x, y, theta, timeout, params, async); });
+}
+
+void MonitoredChassis::moveToPoint(float x, float y, int timeout, MoveToPointParams params, bool async) {
+    monitor("moveToPoint", timeout, async, [&] { Chassis::moveToPoint(x, y, timeout, params, async); });
+}
+
+void MonitoredChassis::follow(const asset& path, float lookahead, int timeout, bool forwards, bool async) {
+    monitor("follow", timeout, async, [&] { Chassis::follow(path, lookahead, timeout, forwards, async); });
+}
+} // namespace lemlib
@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include "pros/rtos.hpp"
+#include "lemlib/profiling/scopeTimer.hpp"
+
+namespace lemlib {
+LatencyHistogram::LatencyHistogram(const char* name)
+    : name(name) {
+    // push onto the global list
+    LatencyHistogram* previous = head.load(std::memory_order_relaxed);
+    do { next = previous; } while (!head.compare_exchange_weak(previous, this, std::memory_order_release));
+}
+
+uint32_t LatencyHistogram::percentile(float fraction) const {
+    uint32_t counts[BUCKETS] = {};
+    addCounts(counts);
+    return percentile(counts, getMax(), fraction);
+}
+
+void LatencyHistogram::addCounts(uint32_t* counts) const {
+    for (size_t i = 0; i < BUCKETS; i++) counts[i] += buckets[i].load(std::memory_order_relaxed);
+}
+
+uint32_t LatencyHistogram::percentile(const uint32_t* counts, uint32_t max, float fraction) {
+    uint32_t total = 0;
+    for (size_t i = 0; i < BUCKETS; i++) total += counts[i];
+    if (total == 0) return 0;
+    // the rank of the value, rounded up so the 100th percentile is the last value
+    const uint32_t rank = std::max<uint32_t>(1, std::ceil(fraction * total));
+    uint32_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; i++) {
+        seen += counts[i];
+        // the maximum is exact, and the bucket's bound may be larger
+        if (seen >= rank) return std::min(bucketUpperBound(i), max);
+    }
+    return max;
+}
+
+void LatencyHistogram::reset() {
+    for (std::atomic<uint32_t>& bucket : buckets) bucket.store(0, std::memory_order_relaxed);
+    count.store(0, std::memory_order_relaxed);
+    max.store(0, std::memory_order_relaxed);
+}
+
+void dumpHistograms(bool reset) {
+    printf("%-24s %8s %8s %8s %8s\n", "scope", "count", "p50 us", "p99 us", "max us");
+    for (LatencyHistogram* histogram = LatencyHistogram::first(); histogram != nullptr;
+         histogram = histogram->getNext()) {
+        // histograms with the same name are printed together, when the first one is reached
+        bool printed = false;
+        for (LatencyHistogram* other = LatencyHistogram::first(); other != histogram; other = other->getNext()) {
+            printed |= std::strcmp(other->getName(), histogram->getName()) == 0;
+        }
+        if (printed) continue;
+
+        uint32_t counts[LatencyHistogram::BUCKETS] = {};
+        uint32_t count = 0;
+        uint32_t max = 0;
+        for (LatencyHistogram* other = histogram; other != nullptr; other = other->getNext()) {
+            if (std::strcmp(other->getName(), histogram->getName()) != 0) continue;
+            other->addCounts(counts);
+            count += other->getCount();
+            max = std::max(max, other->getMax());
+        }
+        printf("%-24s %8lu %8lu %8lu %8lu\n", histogram->getName(), static_cast<unsigned long>(count),
+               static_cast<unsigned long>(LatencyHistogram::percentile(counts, max, 0.5)),
+               static_cast<unsigned long>(LatencyHistogram::percentile(counts, max, 0.99)),
+               static_cast<unsigned long>(max));
+    }
+    if (reset) {
+        for (LatencyHistogram* histogram = LatencyHistogram::first(); histogram != nullptr;
+             histogram = histogram->getNext()) {
+            histogram->reset();
+        }
+    }
+}
+
+void startHistogramDumps(uint32_t interval, bool reset) {
+    if constexpr (!LEMLIB_PROFILE) return;
+    static std::atomic<bool> started = false;
+    if (started.exchange(true)) return;
+    pros::Task task(
+        [=]() {
+            uint32_t now = pros::millis();
+            while (true) {
+                pros::Task::delay_until(&now, interval);
+                dumpHistograms(reset);
+            }
+        },
+        TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT, "Histogram Dumps");
+}
+} // namespace lemlib
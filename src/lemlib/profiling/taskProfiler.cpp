@@ -0,0 +1,187 @@
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+
+#include "pros/llemu.h"
+#include "pros/llemu.hpp"
+#include "lemlib/profiling/deadlineMonitor.hpp"
+#include "lemlib/profiling/taskProfiler.hpp"
+#include "lemlib/rtos/taskStatus.hpp"
+#include "lemlib/telemetry/channelRegistry.hpp"
+
+#if defined(__arm__)
+extern "C" {
+/**
+ * @brief Get the least amount of stack a task has had left, in words
+ *
+ * Part of FreeRTOS, which the PROS kernel is built with, but it isn't declared in the user headers.
+ */
+unsigned long uxTaskGetStackHighWaterMark(pros::task_t task);
+}
+#endif
+
+namespace lemlib {
+/**
+ * @brief The state of every task, filled in by each report
+ *
+ * Only used by the profiler's task, so it doesn't take up the task's stack. Has room for the kernel's own tasks as well
+ * as the program's.
+ */
+static TaskStatus statuses[48];
+
+/**
+ * @brief Check that a tracked task still exists
+ *
+ * The handle isn't read. The task is looked up in the kernel's task lists by the name it was created with instead,
+ * so a handle to a task whose memory has been freed is never used. Deleted tasks are freed by the idle task, which
+ * can't run while the profiler's higher priority task is ready, so a task found here stays valid until the report
+ * ends.
+ */
+static bool exists(pros::task_t task, const char* kernelName) {
+    if (task == nullptr || pros::c::task_get_by_name(kernelName) != task) return false;
+    const pros::task_state_e_t state = pros::c::task_get_state(task);
+    return state != pros::E_TASK_STATE_DELETED && state != pros::E_TASK_STATE_INVALID;
+}
+
+/**
+ * @brief Measure the least amount of stack a task has had left
+ *
+ * @return uint32_t free stack in bytes, or UINT32_MAX if it can't be measured
+ */
+static uint32_t stackHighWaterMark(pros::task_t task) {
+#if defined(__arm__)
+    return uxTaskGetStackHighWaterMark(task) * sizeof(uint32_t);
+#else
+    (void)task;
+    return UINT32_MAX;
+#endif
+}
+
+TaskProfiler::TaskProfiler(uint32_t reportInterval)
+    : reportInterval(reportInterval == 0 ? 1 : reportInterval),
+      task([this]() { taskLoop(); }, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT, "Task Profiler") {}
+
+TaskProfiler::~TaskProfiler() {
+    std::lock_guard lock(mutex);
+    task.remove();
+}
+
+TaskProfile* TaskProfiler::track(const char* name, pros::task_t task) {
+    std::lock_guard lock(mutex);
+    const size_t count = profileCount.load();
+    // tasks like opcontrol are created again every time their mode starts, so reuse their profile
+    for (size_t i = 0; i < count; i++) {
+        if (std::strcmp(profiles[i].name, name) != 0) continue;
+        setTask(profiles[i], task);
+        return &profiles[i];
+    }
+    if (count >= MAX_TASKS) return nullptr;
+    TaskProfile& profile = profiles[count];
+    profile.name = name;
+    setTask(profile, task);
+    // publish the profile only once it is set up
+    profileCount.store(count + 1);
+    if (telemetry) registerChannels(profile);
+    return &profile;
+}
+
+TaskProfile* TaskProfiler::trackByName(const char* name) {
+    const pros::task_t task = pros::c::task_get_by_name(name);
+    if (task == nullptr) return nullptr;
+    return track(name, task);
+}
+
+void TaskProfiler::setTask(TaskProfile& profile, pros::task_t task) {
+    profile.task = task;
+    // the run time counter of a different task can't be compared with the last one
+    profile.hasRunTime = false;
+    // the task exists now, so its name can be read
+    const char* kernelName = task == nullptr ? "" : pros::c::task_get_name(task);
+    std::strncpy(profile.kernelName, kernelName, sizeof(profile.kernelName) - 1);
+}
+
+void TaskProfiler::printToScreen(int firstLine) { screenLine = firstLine; }
+
+void TaskProfiler::sendTelemetry() {
+    std::lock_guard lock(mutex);
+    if (telemetry.exchange(true)) return;
+    for (size_t i = 0; i < profileCount; i++) registerChannels(profiles[i]);
+}
+
+void TaskProfiler::registerChannels(TaskProfile& profile) {
+    channelRegistry().addGroup(profile.name, 1000.0f / reportInterval,
+                               {{"cpu", "%", 0.1},
+                                {"runs", "", 1, ChannelType::INT},
+                                {"worstIteration", "us", 1, ChannelType::INT},
+                                {"stackFree", "B", 1, ChannelType::INT}},
+                               [&profile](float* values) {
+                                   values[0] = profile.getCpuPercent();
+                                   values[1] = profile.getRunCount();
+                                   values[2] = profile.getWorstIteration();
+                                   const uint32_t stackFree = profile.getStackHighWaterMark();
+                                   values[3] = stackFree == UINT32_MAX ? -1 : float(stackFree);
+                               });
+}
+
+void TaskProfiler::report() {
+    uint32_t totalRunTime = 0;
+    const size_t statusCount = uxTaskGetSystemState(statuses, std::size(statuses), &totalRunTime);
+    const uint32_t window = totalRunTime - lastTotalRunTime;
+    lastTotalRunTime = totalRunTime;
+
+    const size_t count = profileCount.load();
+    // the screen isn't updated while control loops are missing their deadlines
+    const int line = inDegradedMode() ? -1 : screenLine.load();
+    if (line >= 0) pros::lcd::print(line, "%-12s %6s %5s %7s %6s", "task", "cpu%", "runs", "worstus", "stackB");
+    for (size_t i = 0; i < count; i++) {
+        TaskProfile& profile = profiles[i];
+        const uint32_t runs = profile.windowRuns.exchange(0, std::memory_order_relaxed);
+        profile.totalRuns.fetch_add(runs, std::memory_order_relaxed);
+        profile.runCount.store(runs, std::memory_order_relaxed);
+        // forget tasks that have ended, so their handles aren't used again
+        if (profile.task != nullptr && !exists(profile.task, profile.kernelName)) profile.task = nullptr;
+        profile.stackFree.store(profile.task == nullptr ? UINT32_MAX : stackHighWaterMark(profile.task),
+                                std::memory_order_relaxed);
+
+        // the task's share of the CPU is how much its run time grew compared to the total
+        const TaskStatus* status = nullptr;
+        for (size_t j = 0; j < statusCount && profile.task != nullptr; j++) {
+            if (statuses[j].handle == profile.task) status = &statuses[j];
+        }
+        float cpuPercent = -1;
+        if (status != nullptr && profile.hasRunTime && window != 0) {
+            cpuPercent = 100.0f * (status->runTime - profile.lastRunTime) / window;
+        }
+        if (status != nullptr) profile.lastRunTime = status->runTime;
+        profile.hasRunTime = status != nullptr;
+        profile.cpuPercent.store(cpuPercent, std::memory_order_relaxed);
+        const bool measured = cpuPercent >= 0;
+
+        if (line >= 0) {
+            // values that aren't measured are shown as "-"
+            char cpu[12] = "-";
+            char stack[12] = "-";
+            if (measured) std::snprintf(cpu, sizeof(cpu), "%.1f", profile.getCpuPercent());
+            const uint32_t stackFree = profile.getStackHighWaterMark();
+            if (stackFree != UINT32_MAX) std::snprintf(stack, sizeof(stack), "%u", static_cast<unsigned>(stackFree));
+            pros::lcd::print(line + 1 + i, "%-12.12s %6s %5u %7u %6s", profile.name, cpu, static_cast<unsigned>(runs),
+                             static_cast<unsigned>(profile.getWorstIteration()), stack);
+        }
+    }
+}
+
+void TaskProfiler::taskLoop() {
+    uint32_t now = pros::millis();
+    while (true) {
+        pros::Task::delay_until(&now, reportInterval);
+        std::lock_guard lock(mutex);
+        report();
+    }
+}
+
+TaskProfiler& taskProfiler() {
+    static TaskProfiler profiler;
+    return profiler;
+}
+} // namespace lemlib
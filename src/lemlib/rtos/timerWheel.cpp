@@ -0,0 +1,165 @@
+#include <algorithm>
+#include <mutex>
+
+#include "lemlib/rtos/timerWheel.hpp"
+
+namespace lemlib {
+TimerWheel::TimerWheel()
+    : current(pros::micros()),
+      task([this]() { taskLoop(); }, TASK_PRIORITY_DEFAULT + 3, TASK_STACK_DEPTH_DEFAULT, "Timer Wheel") {}
+
+TimerWheel::~TimerWheel() {
+    std::lock_guard lock(mutex);
+    task.remove();
+}
+
+void TimerWheel::arm(WheelTimer& timer, uint32_t delay, uint32_t period) {
+    std::lock_guard lock(mutex);
+    if (timer.isArmed()) unlink(timer);
+    timer.expiry = pros::micros() + delay;
+    timer.period = period;
+    insert(timer);
+    // wake the task up early if it would sleep past this timer
+    if (timer.expiry < wakeTime) task.notify();
+}
+
+bool TimerWheel::cancel(WheelTimer& timer) {
+    std::lock_guard lock(mutex);
+    if (firing == &timer) firingCancelled = true;
+    if (!timer.isArmed()) return false;
+    unlink(timer);
+    return true;
+}
+
+void TimerWheel::insert(WheelTimer& timer) {
+    // timers that expired while the task was busy go in the slot being processed
+    uint64_t expiry = std::max(timer.expiry, current);
+    // the top level covers as much time as the whole wheel. Timers further away than that are put in the last slot
+    // that is still in range, and placed again when it comes up
+    constexpr uint64_t RANGE = uint64_t(1) << (LEVEL_BITS * LEVELS);
+    if (expiry - current >= RANGE) expiry = current + RANGE - 1;
+    // use the lowest level whose slots can tell the expiry apart from the current time
+    const uint64_t delta = expiry - current;
+    size_t level = 0;
+    while (level < LEVELS - 1 && delta >> (LEVEL_BITS * (level + 1)) != 0) level++;
+    const size_t slot = level * SLOTS + ((expiry >> (LEVEL_BITS * level)) & (SLOTS - 1));
+
+    TimerLink& head = slots[slot];
+    timer.previous = &head;
+    timer.next = head.next;
+    if (head.next != nullptr) head.next->previous = &timer;
+    head.next = &timer;
+    timer.slot = slot;
+    used[slot / 32] |= 1u << (slot % 32);
+}
+
+void TimerWheel::unlink(WheelTimer& timer) {
+    timer.previous->next = timer.next;
+    if (timer.next != nullptr) timer.next->previous = timer.previous;
+    if (slots[timer.slot].next == nullptr) used[timer.slot / 32] &= ~(1u << (timer.slot % 32));
+    timer.slot = WheelTimer::NO_SLOT;
+}
+
+size_t TimerWheel::distanceToUsed(size_t level, size_t index) const {
+    const uint32_t* words = &used[level * SLOTS / 32];
+    // check each word starting with the one index is in, and that word again at the end for the slots before index
+    for (size_t i = 0; i <= SLOTS / 32; i++) {
+        const size_t word = (index / 32 + i) % (SLOTS / 32);
+        uint32_t bits = words[word];
+        if (i == 0) bits &= UINT32_MAX << (index % 32);
+        if (i == SLOTS / 32) bits &= ~(UINT32_MAX << (index % 32));
+        if (bits == 0) continue;
+        const size_t slot = word * 32 + __builtin_ctz(bits);
+        return (slot - index) & (SLOTS - 1);
+    }
+    return SLOTS;
+}
+
+uint64_t TimerWheel::nextEvent() const {
+    uint64_t next = UINT64_MAX;
+    for (size_t level = 0; level < LEVELS; level++) {
+        const size_t shift = LEVEL_BITS * level;
+        // the first slot of this level that starts at or after the current time
+        const uint64_t first = (current + (uint64_t(1) << shift) - 1) >> shift;
+        const size_t distance = distanceToUsed(level, first & (SLOTS - 1));
+        if (distance != SLOTS) next = std::min(next, (first + distance) << shift);
+    }
+    return next;
+}
+
+void TimerWheel::cascade() {
+    for (size_t level = 1; level < LEVELS; level++) {
+        const size_t index = (current >> (LEVEL_BITS * level)) & (SLOTS - 1);
+        const size_t slot = level * SLOTS + index;
+        // detach the whole list first, since timers can be placed in the same slot again
+        TimerLink* link = slots[slot].next;
+        slots[slot].next = nullptr;
+        used[slot / 32] &= ~(1u << (slot % 32));
+        while (link != nullptr) {
+            WheelTimer& timer = static_cast<WheelTimer&>(*link);
+            link = link->next;
+            insert(timer);
+        }
+        // the level above only has a slot starting now if this level wrapped around
+        if (index != 0) break;
+    }
+}
+
+uint64_t TimerWheel::advance(uint64_t now) {
+    while (true) {
+        const uint64_t next = nextEvent();
+        if (next > now) {
+            // nothing happens until then, so there is no need to visit the slots in between
+            current = std::max(current, now + 1);
+            return next;
+        }
+        current = next;
+        if ((current & (SLOTS - 1)) == 0) cascade();
+
+        TimerLink& head = slots[current & (SLOTS - 1)];
+        while (head.next != nullptr) {
+            WheelTimer& timer = static_cast<WheelTimer&>(*head.next);
+            unlink(timer);
+            if (timer.expiry > current) {
+                // placed in the last slot in range, it isn't due yet
+                insert(timer);
+                continue;
+            }
+            firing = &timer;
+            firingCancelled = false;
+            mutex.unlock();
+            timer.callback(timer.context);
+            mutex.lock();
+            fired.fetch_add(1, std::memory_order_relaxed);
+            firing = nullptr;
+            if (timer.period == 0 || firingCancelled || timer.isArmed()) continue;
+            // skip the expiries that were missed while the task was busy
+            timer.expiry += timer.period;
+            if (timer.expiry <= current) timer.expiry += (current - timer.expiry) / timer.period * timer.period;
+            if (timer.expiry <= current) timer.expiry += timer.period;
+            insert(timer);
+        }
+        current++;
+    }
+}
+
+void TimerWheel::taskLoop() {
+    while (true) {
+        uint64_t next;
+        {
+            std::lock_guard lock(mutex);
+            next = advance(pros::micros());
+            wakeTime = next;
+        }
+        // sleep until the millisecond the next slot comes up in, or until a timer is armed earlier than that
+        const uint64_t now = pros::micros();
+        if (next <= now) continue;
+        pros::c::task_notify_take(true, next == UINT64_MAX ? TIMEOUT_MAX : (next - now + 999) / 1000);
+    }
+}
+
+TimerWheel& timerWheel() {
+    static TimerWheel wheel;
+    return wheel;
+}
+} // namespace lemlib
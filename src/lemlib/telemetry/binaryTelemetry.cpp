@@ -0,0 +1,166 @@
+#include <cstdio>
+#include <mutex>
+
+#include "lemlib/telemetry/binaryTelemetry.hpp"
+
+namespace lemlib {
+// id + time + checksum
+constexpr size_t FRAME_OVERHEAD = 1 + 4 + 2;
+
+/**
+ * @brief Size of a field type, in bytes. 0 if the type has a variable size
+ */
+static size_t fieldSize(FieldType type) {
+    switch (type) {
+        case FieldType::U8:
+        case FieldType::I8:
+        case FieldType::BOOL:
+        case FieldType::CHAR: return 1;
+        case FieldType::U16:
+        case FieldType::I16: return 2;
+        case FieldType::U32:
+        case FieldType::I32:
+        case FieldType::F32: return 4;
+        case FieldType::U64:
+        case FieldType::I64:
+        case FieldType::F64: return 8;
+        default: return 0;
+    }
+}
+
+static void stdoutWrite(const uint8_t* data, size_t size) {
+    fwrite(data, 1, size, stdout);
+    fflush(stdout);
+}
+
+BinaryTelemetry::BinaryTelemetry(WriteFunction writeFunc)
+    : writeFunc(writeFunc == nullptr ? stdoutWrite : writeFunc) {}
+
+uint8_t BinaryTelemetry::registerRecord(const char* name, const char* const* fieldNames, const FieldType* fieldTypes,
+                                        uint8_t fieldCount) {
+    // make sure the schema fits in a single frame
+    size_t schemaSize = 3 + fieldCount + strlen(name) + 1;
+    size_t payloadSize = 0;
+    for (uint8_t i = 0; i < fieldCount; i++) {
+        // records need a fixed size
+        if (fieldSize(fieldTypes[i]) == 0) return 0;
+        schemaSize += strlen(fieldNames[i]) + 1;
+        payloadSize += fieldSize(fieldTypes[i]);
+    }
+    if (schemaSize > MAX_SCHEMA || payloadSize > MAX_PAYLOAD) return 0;
+
+    std::lock_guard lock(mutex);
+    // id 0 is reserved for schemas, and ids from MAX_RECORDS up are reserved for self describing frames
+    if (recordCount + 1 >= MAX_RECORDS) return 0;
+    const uint8_t id = ++recordCount;
+    schemas[id] = {.name = name,
+                   .fieldNames = fieldNames,
+                   .fieldTypes = fieldTypes,
+                   .fieldCount = fieldCount,
+                   .payloadSize = payloadSize};
+    return id;
+}
+
+bool BinaryTelemetry::sendRecord(uint8_t id, const uint8_t* data, size_t size) {
+    if (id == SCHEMA_RECORD || size > MAX_PAYLOAD) return false;
+
+    const uint32_t now = pros::millis();
+    uint8_t payload[MAX_PAYLOAD + FRAME_OVERHEAD];
+    payload[0] = id;
+    std::memcpy(payload + 1, &now, sizeof(now));
+    std::memcpy(payload + 5, data, size);
+
+    std::lock_guard lock(mutex);
+    // registerRecord() writes the schemas under the mutex too
+    if (id > recordCount || schemas[id].payloadSize != size) return false;
+    // (re)send the schema first, so the decoder knows how to read this record
+    Schema& schema = schemas[id];
+    if (!schema.sent || (schemaInterval != 0 && now - schema.lastSent >= schemaInterval)) sendSchema(id);
+    sendFrame(payload, size + 5);
+    return true;
+}
+
+bool BinaryTelemetry::sendRaw(uint8_t id, uint32_t time, const uint8_t* data, size_t size) {
+    if (size > MAX_SCHEMA) return false;
+
+    uint8_t payload[MAX_SCHEMA + FRAME_OVERHEAD];
+    payload[0] = id;
+    std::memcpy(payload + 1, &time, sizeof(time));
+    std::memcpy(payload + 5, data, size);
+
+    std::lock_guard lock(mutex);
+    sendFrame(payload, size + 5);
+    return true;
+}
+
+bool BinaryTelemetry::sendUntimed(uint8_t id, const uint8_t* data, size_t size) {
+    if (size > MAX_SCHEMA) return false;
+
+    uint8_t payload[MAX_SCHEMA + FRAME_OVERHEAD];
+    payload[0] = id;
+    std::memcpy(payload + 1, data, size);
+
+    std::lock_guard lock(mutex);
+    sendFrame(payload, size + 1);
+    return true;
+}
+
+void BinaryTelemetry::sendSchemas() {
+    std::lock_guard lock(mutex);
+    for (uint8_t id = 1; id <= recordCount; id++) sendSchema(id);
+}
+
+void BinaryTelemetry::setSchemaInterval(uint32_t interval) { schemaInterval = interval; }
+
+uint32_t BinaryTelemetry::getBytesSent() const { return bytesSent; }
+
+uint32_t BinaryTelemetry::getFramesSent() const { return framesSent; }
+
+void BinaryTelemetry::sendFrame(uint8_t* payload, size_t size) {
+    // append the checksum
+    const uint16_t crc = crc16(payload, size);
+    std::memcpy(payload + size, &crc, sizeof(crc));
+    size += sizeof(crc);
+
+    // delimit the frame on both sides, so anything else printed to the link before it can't corrupt it
+    uint8_t frame[cobsMaxEncodedSize(MAX_SCHEMA + FRAME_OVERHEAD) + 2];
+    frame[0] = 0;
+    size_t frameSize = cobsEncode(payload, size, frame + 1) + 1;
+    frame[frameSize++] = 0;
+
+    writeFunc(frame, frameSize);
+    bytesSent += frameSize;
+    framesSent++;
+}
+
+void BinaryTelemetry::sendSchema(uint8_t id) {
+    Schema& schema = schemas[id];
+    const uint32_t now = pros::millis();
+
+    // schema layout: id, field count, field types, then the record name and field names, null terminated
+    uint8_t payload[MAX_SCHEMA + FRAME_OVERHEAD];
+    size_t size = 0;
+    payload[size++] = SCHEMA_RECORD;
+    std::memcpy(payload + size, &now, sizeof(now));
+    size += sizeof(now);
+    payload[size++] = id;
+    payload[size++] = schema.fieldCount;
+    for (uint8_t i = 0; i < schema.fieldCount; i++) payload[size++] = uint8_t(schema.fieldTypes[i]);
+    const auto appendString = [&](const char* string) {
+        const size_t length = strlen(string) + 1;
+        std::memcpy(payload + size, string, length);
+        size += length;
+    };
+    appendString(schema.name);
+    for (uint8_t i = 0; i < schema.fieldCount; i++) appendString(schema.fieldNames[i]);
+
+    sendFrame(payload, size);
+    schema.sent = true;
+    schema.lastSent = now;
+}
+
+BinaryTelemetry& binaryTelemetry() {
+    static BinaryTelemetry telemetry;
+    return telemetry;
+}
+} // namespace lemlib
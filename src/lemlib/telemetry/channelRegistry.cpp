@@ -0,0 +1,212 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+
+#include "lemlib/telemetry/channelRegistry.hpp"
+#include "lemlib/telemetry/bitPacking.hpp"
+#include "lemlib/profiling/deadlineMonitor.hpp"
+#include "lemlib/profiling/scopeTimer.hpp"
+
+namespace lemlib {
+// bits of the first byte of a frame
+constexpr uint8_t KEYFRAME = 0x80;
+constexpr uint8_t TICK_DELTA = 0x40;
+constexpr uint8_t SEQUENCE_MASK = 0x3F;
+
+/**
+ * @brief Quantize a sampled value to an integer
+ */
+static int32_t quantize(float value, const ChannelInfo& info) {
+    if (info.type == ChannelType::BOOL) return value != 0;
+    const float scaled = info.type == ChannelType::FLOAT ? value / info.resolution : value;
+    // NaN is sent as 0
+    if (!(scaled == scaled)) return 0;
+    if (scaled >= 2147483520.0f) return INT32_MAX;
+    if (scaled <= -2147483520.0f) return INT32_MIN;
+    return int32_t(std::lround(scaled));
+}
+
+ChannelRegistry::ChannelRegistry(uint32_t tickPeriod, BinaryTelemetry& telemetry)
+    : tickPeriod(tickPeriod == 0 ? 1 : tickPeriod),
+      telemetry(telemetry),
+      task([this]() { taskLoop(); }, TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT, "Telemetry Sampler") {}
+
+ChannelRegistry::~ChannelRegistry() {
+    std::lock_guard lock(mutex);
+    task.remove();
+}
+
+bool ChannelRegistry::addGroup(const char* name, float rate, std::initializer_list<ChannelInfo> channels,
+                               Sampler sampler) {
+    if (channels.size() == 0 || channels.size() > MAX_GROUP_CHANNELS || !(rate > 0)) return false;
+
+    // make sure the schema fits in a single frame
+    size_t schemaSize = 6 + channels.size() * 5 + strlen(name) + 1;
+    for (const ChannelInfo& channel : channels) {
+        if (channel.type == ChannelType::FLOAT && !(channel.resolution > 0)) return false;
+        schemaSize += strlen(channel.name) + strlen(channel.unit) + 2;
+    }
+    if (schemaSize > BinaryTelemetry::MAX_SCHEMA) return false;
+
+    std::lock_guard lock(mutex);
+    if (groupCount >= MAX_GROUPS || channelCount + channels.size() > MAX_CHANNELS) return false;
+    Group& group = groups[groupCount++];
+    group.name = name;
+    group.periodTicks = std::max<uint32_t>(1, std::lround(1000 / (rate * tickPeriod)));
+    group.firstChannel = channelCount;
+    group.channelCount = channels.size();
+    group.sampler = std::move(sampler);
+    for (const ChannelInfo& channel : channels) this->channels[channelCount++] = {.info = channel};
+    // send the new schema and a keyframe on the next tick
+    changed = true;
+    return true;
+}
+
+bool ChannelRegistry::addChannel(const char* name, const char* unit, float rate, std::function<float()> getter,
+                                 float resolution, ChannelType type) {
+    return addGroup(name, rate, {{.name = name, .unit = unit, .resolution = resolution, .type = type}},
+                    [getter = std::move(getter)](float* values) { values[0] = getter(); });
+}
+
+void ChannelRegistry::setKeyframeInterval(uint32_t interval) { keyframeInterval = interval; }
+
+void ChannelRegistry::setSchemaInterval(uint32_t interval) { schemaInterval = interval; }
+
+uint32_t ChannelRegistry::getFramesSent() const { return framesSent; }
+
+void ChannelRegistry::sample(const Group& group, int32_t* values) {
+    float samples[MAX_GROUP_CHANNELS] = {};
+    group.sampler(samples);
+    for (uint8_t i = 0; i < group.channelCount; i++) {
+        values[i] = quantize(samples[i], channels[group.firstChannel + i].info);
+    }
+}
+
+void ChannelRegistry::sendSchemas() {
+    // schema layout: group index, period in ticks, tick period, channel count, type and resolution of each channel,
+    // then the group name and the name and unit of each channel, null terminated
+    uint8_t payload[BinaryTelemetry::MAX_SCHEMA];
+    for (uint8_t i = 0; i < groupCount; i++) {
+        const Group& group = groups[i];
+        size_t size = 0;
+        payload[size++] = i;
+        const uint16_t periodTicks = std::min<uint32_t>(group.periodTicks, UINT16_MAX);
+        std::memcpy(payload + size, &periodTicks, sizeof(periodTicks));
+        size += sizeof(periodTicks);
+        const uint16_t period = std::min<uint32_t>(tickPeriod, UINT16_MAX);
+        std::memcpy(payload + size, &period, sizeof(period));
+        size += sizeof(period);
+        payload[size++] = group.channelCount;
+        for (uint8_t j = 0; j < group.channelCount; j++) {
+            const ChannelInfo& info = channels[group.firstChannel + j].info;
+            payload[size++] = uint8_t(info.type);
+            std::memcpy(payload + size, &info.resolution, sizeof(info.resolution));
+            size += sizeof(info.resolution);
+        }
+        const auto appendString = [&](const char* string) {
+            const size_t length = strlen(string) + 1;
+            std::memcpy(payload + size, string, length);
+            size += length;
+        };
+        appendString(group.name);
+        for (uint8_t j = 0; j < group.channelCount; j++) {
+            appendString(channels[group.firstChannel + j].info.name);
+            appendString(channels[group.firstChannel + j].info.unit);
+        }
+        telemetry.sendRaw(BinaryTelemetry::CHANNEL_SCHEMA_RECORD, pros::millis(), payload, size);
+    }
+}
+
+void ChannelRegistry::sendFrame(bool keyframe) {
+    LEMLIB_PROFILE_SCOPE("ChannelRegistry::sendFrame");
+    uint8_t payload[BinaryTelemetry::MAX_SCHEMA];
+    size_t size = 1;
+    const uint32_t tickDelta = tick - lastFrameTick;
+    payload[0] = sequence & SEQUENCE_MASK;
+    if (keyframe) {
+        payload[0] |= KEYFRAME;
+        payload[size++] = groupCount;
+        std::memcpy(payload + size, &tick, sizeof(tick));
+        size += sizeof(tick);
+        const uint32_t now = pros::millis();
+        std::memcpy(payload + size, &now, sizeof(now));
+        size += sizeof(now);
+    } else if (tickDelta != 1) {
+        // taskLoop() sends a keyframe instead if the delta doesn't fit
+        payload[0] |= TICK_DELTA;
+        payload[size++] = tickDelta;
+    }
+    BitWriter writer(payload + size, sizeof(payload) - size);
+
+    bool anyChanged = false;
+    for (uint8_t i = 0; i < groupCount; i++) {
+        const Group& group = groups[i];
+        // keyframes include every group, whether or not it is due
+        if (!keyframe && tick % group.periodTicks != 0) continue;
+        int32_t values[MAX_GROUP_CHANNELS];
+        sample(group, values);
+        for (uint8_t j = 0; j < group.channelCount; j++) {
+            Channel& channel = channels[group.firstChannel + j];
+            const int32_t value = values[j];
+            if (keyframe) {
+                writeVarInt(writer, value);
+            } else {
+                const bool valueChanged = value != channel.last;
+                writer.write(valueChanged, 1);
+                // a change of a bool can only be a toggle
+                if (valueChanged && channel.info.type != ChannelType::BOOL) {
+                    writeVarInt(writer, int32_t(uint32_t(value) - uint32_t(channel.last)));
+                }
+                anyChanged |= valueChanged;
+            }
+            channel.last = value;
+        }
+    }
+
+    if (!keyframe && !anyChanged) return;
+    telemetry.sendUntimed(BinaryTelemetry::CHANNEL_RECORD, payload, size + writer.size());
+    lastFrameTick = tick;
+    sequence++;
+    framesSent++;
+}
+
+void ChannelRegistry::taskLoop() {
+    uint32_t now = pros::millis();
+    while (true) {
+        {
+            std::lock_guard lock(mutex);
+            if (groupCount != 0) {
+                const uint32_t time = pros::millis();
+                if (changed || time - lastSchema >= schemaInterval) {
+                    sendSchemas();
+                    lastSchema = time;
+                }
+                const bool degraded = inDegradedMode();
+                // a delta frame can only be up to 255 ticks after the last frame, and deltas can't follow skipped ones
+                const bool keyframe = changed || time - lastKeyframe >= keyframeInterval ||
+                                      tick - lastFrameTick > UINT8_MAX || (deltasSkipped && !degraded);
+                if (keyframe) lastKeyframe = time;
+                // only keyframes are sent while control loops are missing their deadlines
+                if (keyframe || !degraded) {
+                    sendFrame(keyframe);
+                    deltasSkipped = false;
+                } else if (!deltasSkipped) {
+                    // leave a gap in the sequence, so the decoder drops the values until the next keyframe instead of
+                    // repeating the last ones. Only once, since a gap of 64 frames would look like none
+                    sequence++;
+                    deltasSkipped = true;
+                }
+                changed = false;
+            }
+            tick++;
+        }
+        pros::Task::delay_until(&now, tickPeriod);
+    }
+}
+
+ChannelRegistry& channelRegistry() {
+    static ChannelRegistry registry;
+    return registry;
+}
+} // namespace lemlib
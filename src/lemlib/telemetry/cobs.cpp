@@ -0,0 +1,50 @@
+#include "lemlib/telemetry/cobs.hpp"
+
+namespace lemlib {
+size_t cobsEncode(const uint8_t* input, size_t length, uint8_t* output) {
+    size_t codeIndex = 0; // where the code byte of the current block goes
+    size_t outIndex = 1;
+    uint8_t code = 1; // distance to the next zero, including the code byte itself
+
+    for (size_t i = 0; i < length; i++) {
+        if (input[i] != 0) {
+            output[outIndex++] = input[i];
+            code++;
+        }
+        // close the block when a zero is found or the block is full
+        if (input[i] == 0 || code == 0xFF) {
+            output[codeIndex] = code;
+            codeIndex = outIndex++;
+            code = 1;
+        }
+    }
+    output[codeIndex] = code;
+    return outIndex;
+}
+
+size_t cobsDecode(const uint8_t* input, size_t length, uint8_t* output) {
+    size_t inIndex = 0;
+    size_t outIndex = 0;
+
+    while (inIndex < length) {
+        const uint8_t code = input[inIndex++];
+        // a zero can't appear inside a frame, and a block can't run past the end
+        if (code == 0 || inIndex + code - 1 > length) return 0;
+        for (uint8_t i = 1; i < code; i++) {
+            if (input[inIndex] == 0) return 0;
+            output[outIndex++] = input[inIndex++];
+        }
+        // every block except full ones and the last one ends with an implicit zero
+        if (code != 0xFF && inIndex != length) output[outIndex++] = 0;
+    }
+    return outIndex;
+}
+
+uint16_t crc16(const uint8_t* data, size_t length, uint16_t crc) {
+    for (size_t i = 0; i < length; i++) {
+        crc ^= uint16_t(data[i]) << 8;
+        for (int bit = 0; bit < 8; bit++) crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    return crc;
+}
+} // namespace lemlib
@@ -1,12 +1,18 @@
 #include "main.h"
 #include "lemlib/api.hpp" // IWYU pragma: keep
-#include <sys/_intsup.h>
+#include "lemlib/input/controllerInput.hpp"
+#include "lemlib/logger/deferredLogger.hpp"
+#include "lemlib/profiling/deadlineMonitor.hpp"
+#include "lemlib/profiling/heapTracker.hpp"
+#include "lemlib/profiling/monitoredChassis.hpp"
+#include "lemlib/profiling/scopeTimer.hpp"
+#include "lemlib/profiling/taskProfiler.hpp"
+#include "lemlib/rtos/staticTask.hpp"
+#include "lemlib/telemetry/channelRegistry.hpp"
 // tongue mechanism on ADI port D, default retracted
 pros::adi::Pneumatics toungeMech('E', false);
 // wing mechanism on ADI port C, default retracted
 pros::adi::Pneumatics wing('B', false);
-// controller
-pros::Controller controller(pros::E_CONTROLLER_MASTER);
 // motor groups
 pros::MotorGroup leftMotors({-1, -2, -7},
                             pros::MotorGearset::blue); // left motor group - ports 3 (reversed), 4, 5 (reversed)
@@ -77,8 +83,28 @@ lemlib::ExpoDriveCurve steerCurve(3, // joystick deadband out of 127
                                   1.019 // expo curve gain
 );
  
-// create the chassis
-lemlib::Chassis chassis(drivetrain, linearController, angularController, sensors, &throttleCurve, &steerCurve);
+// create the chassis. Blocking motions are watched by the deadline monitor
+lemlib::MonitoredChassis chassis(drivetrain, linearController, angularController, sensors, &throttleCurve, &steerCurve);
+ 
+// thread for the brain screen. Its stack is in .bss, so starting it can't fail
+lemlib::StaticTask<TASK_STACK_DEPTH_DEFAULT, void (*)()> screenTask([] {
+    lemlib::TaskProfile* profile = lemlib::taskProfiler().track("screen");
+    while (true) {
+        {
+            lemlib::ProfiledIteration iteration(profile);
+            LEMLIB_PROFILE_SCOPE("screen");
+            // print robot location to the brain screen, unless control loops are missing their deadlines
+            if (!lemlib::inDegradedMode()) {
+                const lemlib::Pose pose = chassis.getPose();
+                pros::lcd::print(0, "X: %f", pose.x); // x
+                pros::lcd::print(1, "Y: %f", pose.y); // y
+                pros::lcd::print(2, "Theta: %f", pose.theta); // heading
+            }
+        }
+        // delay to save resources
+        pros::delay(50);
+    }
+});
  
 /**
  * Runs initialization code. This occurs as soon as the program is started.
@@ -98,19 +124,39 @@ void initialize() {
     // for more information on how the formatting for the loggers
     // works, refer to the fmtlib docs
  
-    // thread to for brain screen and position logging
-    pros::Task screenTask([&]() {
-        while (true) {
-            // print robot location to the brain screen
-            pros::lcd::print(0, "X: %f", chassis.getPose().x); // x
-            pros::lcd::print(1, "Y: %f", chassis.getPose().y); // y
-            pros::lcd::print(2, "Theta: %f", chassis.getPose().theta); // heading
-            // log position telemetry
-            lemlib::telemetrySink()->info("Chassis pose: {}", chassis.getPose());
-            // delay to save resources
-            pros::delay(50);
-        }
+    // telemetry channels, sampled by lemlib's telemetry task. Decode them on a computer with tools/telemetryDecode.cpp
+    // their memory is reported as "telemetry" when built with -DLEMLIB_HEAP_TRACKING=1
+    lemlib::HeapTag telemetryTag("telemetry");
+    // pose and wheel velocities at 100 Hz, with schemas every 5 seconds, peak at about 1.2 KB/s while the robot moves,
+    // less than the 1.4 KB/s of the text pose log this replaced
+    lemlib::channelRegistry().setSchemaInterval(5000);
+    lemlib::channelRegistry().addGroup("pose", 100, {{"x", "in"}, {"y", "in"}, {"theta", "deg"}}, [](float* values) {
+        const lemlib::Pose pose = chassis.getPose();
+        values[0] = pose.x;
+        values[1] = pose.y;
+        values[2] = pose.theta;
     });
+    lemlib::channelRegistry().addGroup("wheelVelocity", 100, {{"left", "rpm", 1}, {"right", "rpm", 1}},
+                                       [](float* values) {
+                                           values[0] = leftMotors.get_actual_velocity();
+                                           values[1] = rightMotors.get_actual_velocity();
+                                       });
+    lemlib::channelRegistry().addChannel("battery", "%", 1, [] { return pros::battery::get_capacity(); }, 1,
+                                         lemlib::ChannelType::INT);
+
+    // missed deadlines are logged with LEMLIB_DEFERRED_LOG. Start its task now rather than on the first miss
+    lemlib::deferredLogger().setLowestLevel(lemlib::Level::INFO);
+
+    // profile CPU and stack usage of our tasks, shown below the pose and sent as telemetry
+    lemlib::taskProfiler().printToScreen(3);
+    lemlib::taskProfiler().sendTelemetry();
+    // tasks that don't mark their iterations still get their CPU share from the kernel's run time counters
+    lemlib::taskProfiler().trackByName("Telemetry Sampler");
+    // print scope timer histograms every 5 seconds when built with -DLEMLIB_PROFILE=1
+    lemlib::startHistogramDumps();
+
+    // start the brain screen thread
+    screenTask.start(TASK_PRIORITY_DEFAULT, "Screen");
 }
  void compAuton(){
   // chassis.setPose(-46.5,0,180);
@@ -317,38 +363,44 @@ skillsAuton();
  * Runs in driver control
  */
 void opcontrol() {
-    // controller
-    // loop to continuously update motors
+    lemlib::TaskProfile* profile = lemlib::taskProfiler().track("opcontrol");
+    // each cycle of the driver loop should take at most 2 ms
+    lemlib::Deadline* deadline = lemlib::deadlineMonitor().add("opcontrol", 0, 2000);
+    // loop to update motors each time the controller changes
     while (true) {
-        // get joystick positions
-        int leftY = controller.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_Y);
-        int rightX = controller.get_analog(pros::E_CONTROLLER_ANALOG_RIGHT_X);
+        // wait for new joystick positions and buttons
+        const lemlib::ControllerFrame frame = lemlib::controllerInput().waitForFrame();
+        // the driver loop must not allocate. Counted when built with -DLEMLIB_HEAP_TRACKING=1
+        lemlib::NoAllocZone zone("opcontrol");
+        if (profile != nullptr) profile->beginIteration();
+        if (deadline != nullptr) deadline->beginCycle();
         // move the chassis with curvature drive
-        chassis.arcade(leftY, rightX);
+        chassis.arcade(frame.leftY, frame.rightX);
  
         // R2 extends/retracts wing
-        if (controller.get_digital(pros::E_CONTROLLER_DIGITAL_R2)) {
+        if (frame.held(pros::E_CONTROLLER_DIGITAL_R2)) {
             wing.extend();
         } else {
             wing.retract();
         }
  
         // L2 toggles tongue mechanism
-        if (controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_L2)) {
+        if (frame.newPress(pros::E_CONTROLLER_DIGITAL_L2)) {
             toungeMech.toggle();
         }
  
         // intake control
         // R1 = forward, L1 = reverse
-        if (controller.get_digital(pros::E_CONTROLLER_DIGITAL_R1)) {
+        if (frame.held(pros::E_CONTROLLER_DIGITAL_R1)) {
             intake.move_velocity(600);
-        } else if (controller.get_digital(pros::E_CONTROLLER_DIGITAL_L1)) {
+        } else if (frame.held(pros::E_CONTROLLER_DIGITAL_L1)) {
             intake.move_velocity(-600);
         } else {
             intake.move_velocity(0);
         }
- 
-        // delay to save resources
-        pros::delay(10);
+        // record the time from the controller changing to the motors being commanded
+        lemlib::controllerInput().markApplied(frame);
+        if (deadline != nullptr) deadline->endCycle();
+        if (profile != nullptr) profile->endIteration();
     }
-}
\ No newline at end of file
+}
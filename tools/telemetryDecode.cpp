@@ -0,0 +1,579 @@
+/**
+ * @file telemetryDecode.cpp
+ * @brief Host tool that decodes a binary telemetry stream into CSV files
+ *
+ * Reads a raw capture of the brain's output (for example from the serial port, with PROS's own framing disabled)
+ * and writes one CSV file per record type to the output directory. Bytes that are not part of a valid frame are
+ * skipped, so text printed to stdout can be mixed into the stream.
+ *
+ * ChannelRegistry groups are reconstructed at their full sample rate from the delta frames, and written to one CSV file
+ * per group.
+ *
+ * Deferred log messages (LEMLIB_DEFERRED_LOG) are formatted with the format strings read from the program's ELF file,
+ * printed, and written to log.txt in the output directory.
+ *
+ * Build:
+ *     g++ -std=c++20 -O2 -Iinclude tools/telemetryDecode.cpp src/lemlib/telemetry/cobs.cpp -o telemetry-decode
+ * Usage:
+ *     telemetry-decode [-e bin/hot.package.elf] <capture file, or - for stdin> [output directory]
+ */
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#define FMT_HEADER_ONLY
+#include "fmt/args.h"
+#include "fmt/core.h"
+
+#include "lemlib/telemetry/bitPacking.hpp"
+#include "lemlib/telemetry/cobs.hpp"
+
+namespace {
+enum FieldType : uint8_t {
+    U8 = 1,
+    I8 = 2,
+    U16 = 3,
+    I16 = 4,
+    U32 = 5,
+    I32 = 6,
+    F32 = 7,
+    U64 = 8,
+    I64 = 9,
+    F64 = 10,
+    BOOL = 11,
+    CHAR = 12,
+    STRING = 13
+};
+
+constexpr uint8_t SCHEMA_RECORD = 0;
+constexpr uint8_t LOG_RECORD = 0xFF;
+constexpr uint8_t CHANNEL_RECORD = 0xFE;
+constexpr uint8_t CHANNEL_SCHEMA_RECORD = 0xFD;
+
+constexpr uint8_t CHANNEL_BOOL = 3;
+// bits of the first byte of a channel frame
+constexpr uint8_t CHANNEL_KEYFRAME = 0x80;
+constexpr uint8_t CHANNEL_TICK_DELTA = 0x40;
+constexpr uint8_t CHANNEL_SEQUENCE_MASK = 0x3F;
+
+constexpr const char* LEVEL_NAMES[] = {"INFO", "DEBUG", "WARN", "ERROR", "FATAL"};
+
+struct Schema {
+        std::string name;
+        std::vector<uint8_t> types;
+        std::vector<std::string> fieldNames;
+        size_t payloadSize = 0;
+        std::ofstream file;
+};
+
+struct ChannelGroup {
+        std::string name;
+        uint16_t periodTicks = 1;
+        uint16_t tickPeriod = 1;
+        std::vector<uint8_t> types;
+        std::vector<float> resolutions;
+        std::vector<std::string> channelNames;
+        std::vector<int32_t> values;
+        /** whether values are known, after a keyframe and without lost frames since */
+        bool valid = false;
+        std::ofstream file;
+};
+
+struct Stats {
+        size_t frames = 0;
+        size_t badFrames = 0;
+        size_t unknownRecords = 0;
+        size_t logMessages = 0;
+        size_t channelFrames = 0;
+        size_t channelSamples = 0;
+        size_t lostChannelFrames = 0;
+};
+
+size_t fieldSize(uint8_t type) {
+    switch (type) {
+        case U8:
+        case I8:
+        case BOOL:
+        case CHAR: return 1;
+        case U16:
+        case I16: return 2;
+        case U32:
+        case I32:
+        case F32: return 4;
+        case U64:
+        case I64:
+        case F64: return 8;
+        default: return 0;
+    }
+}
+
+template <typename T> T read(const uint8_t* data) {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+void writeField(std::ostream& out, uint8_t type, const uint8_t* data) {
+    switch (type) {
+        case U8: out << unsigned(read<uint8_t>(data)); break;
+        case I8: out << int(read<int8_t>(data)); break;
+        case U16: out << read<uint16_t>(data); break;
+        case I16: out << read<int16_t>(data); break;
+        case U32: out << read<uint32_t>(data); break;
+        case I32: out << read<int32_t>(data); break;
+        case F32: out << read<float>(data); break;
+    }
+}
+
+/**
+ * @brief Read the deferred log format strings from an ELF file
+ *
+ * Format strings are static variables named lemlibDeferredFormat, and their id is their address relative to the
+ * lemlib_deferred_format_anchor symbol. Supports 32 and 64 bit little endian ELF files, so host builds can be decoded
+ * too. The ELF file must not be stripped.
+ */
+bool readFormatStrings(const char* path, std::map<uint32_t, std::string>& formats) {
+    std::ifstream file(path, std::ios::binary);
+    const std::vector<uint8_t> elf((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (elf.size() < 0x40 || std::memcmp(elf.data(), "\x7f" "ELF", 4) != 0) return false;
+
+    const bool is64 = elf[4] == 2;
+    const uint64_t shoff = is64 ? read<uint64_t>(&elf[0x28]) : read<uint32_t>(&elf[0x20]);
+    const uint16_t shentsize = read<uint16_t>(&elf[is64 ? 0x3A : 0x2E]);
+    const uint16_t shnum = read<uint16_t>(&elf[is64 ? 0x3C : 0x30]);
+    if (shoff + uint64_t(shnum) * shentsize > elf.size()) return false;
+
+    struct Section {
+            uint32_t type;
+            uint64_t addr;
+            uint64_t offset;
+            uint64_t size;
+            uint32_t link;
+    };
+    std::vector<Section> sections(shnum);
+    for (uint16_t i = 0; i < shnum; i++) {
+        const uint8_t* header = &elf[shoff + uint64_t(i) * shentsize];
+        Section& section = sections[i];
+        section.type = read<uint32_t>(header + 4);
+        section.addr = is64 ? read<uint64_t>(header + 0x10) : read<uint32_t>(header + 0x0C);
+        section.offset = is64 ? read<uint64_t>(header + 0x18) : read<uint32_t>(header + 0x10);
+        section.size = is64 ? read<uint64_t>(header + 0x20) : read<uint32_t>(header + 0x14);
+        section.link = read<uint32_t>(header + (is64 ? 0x28 : 0x18));
+        if (section.type != 8 /* SHT_NOBITS */ && section.offset + section.size > elf.size()) return false;
+    }
+
+    struct Symbol {
+            std::string name;
+            uint64_t value;
+            uint64_t size;
+            uint16_t section;
+    };
+    std::vector<Symbol> symbols;
+    for (const Section& symtab : sections) {
+        if (symtab.type != 2 /* SHT_SYMTAB */ || symtab.link >= shnum) continue;
+        const Section& names = sections[symtab.link];
+        const size_t entrySize = is64 ? 24 : 16;
+        for (uint64_t offset = 0; offset + entrySize <= symtab.size; offset += entrySize) {
+            const uint8_t* entry = &elf[symtab.offset + offset];
+            const uint32_t name = read<uint32_t>(entry);
+            if (name >= names.size) continue;
+            Symbol symbol;
+            symbol.name = reinterpret_cast<const char*>(&elf[names.offset + name]);
+            symbol.value = is64 ? read<uint64_t>(entry + 8) : read<uint32_t>(entry + 4);
+            symbol.size = is64 ? read<uint64_t>(entry + 16) : read<uint32_t>(entry + 8);
+            symbol.section = read<uint16_t>(entry + (is64 ? 6 : 14));
+            symbols.push_back(std::move(symbol));
+        }
+    }
+
+    uint64_t anchor = 0;
+    bool foundAnchor = false;
+    for (const Symbol& symbol : symbols) {
+        if (symbol.name != "lemlib_deferred_format_anchor") continue;
+        anchor = symbol.value;
+        foundAnchor = true;
+    }
+    if (!foundAnchor) return false;
+
+    for (const Symbol& symbol : symbols) {
+        if (symbol.name.find("lemlibDeferredFormat") == std::string::npos || symbol.section >= shnum) continue;
+        const Section& section = sections[symbol.section];
+        if (symbol.value < section.addr || symbol.value - section.addr + symbol.size > section.size) continue;
+        const char* string = reinterpret_cast<const char*>(&elf[section.offset + symbol.value - section.addr]);
+        formats[uint32_t(symbol.value - anchor)] = std::string(string, strnlen(string, symbol.size));
+    }
+    return true;
+}
+
+class Decoder {
+    public:
+        Decoder(std::string outDir, std::map<uint32_t, std::string> formats)
+            : outDir(std::move(outDir)),
+              formats(std::move(formats)) {}
+
+        void handleFrame(const std::vector<uint8_t>& encoded) {
+            if (encoded.empty()) return;
+            std::vector<uint8_t> frame(encoded.size());
+            const size_t size = lemlib::cobsDecode(encoded.data(), encoded.size(), frame.data());
+            // id + checksum, and the time if the frame has one
+            const bool timed = size != 0 && frame[0] != CHANNEL_RECORD;
+            if (size < (timed ? 7u : 3u)) {
+                stats.badFrames++;
+                return;
+            }
+            if (lemlib::crc16(frame.data(), size - 2) != read<uint16_t>(frame.data() + size - 2)) {
+                stats.badFrames++;
+                return;
+            }
+            stats.frames++;
+
+            const uint8_t id = frame[0];
+            if (!timed) {
+                handleChannelFrame(frame.data() + 1, size - 3);
+                return;
+            }
+            const uint32_t time = read<uint32_t>(frame.data() + 1);
+            const uint8_t* payload = frame.data() + 5;
+            const size_t payloadSize = size - 7;
+            if (id == SCHEMA_RECORD) handleSchema(payload, payloadSize);
+            else if (id == LOG_RECORD) handleLog(time, payload, payloadSize);
+            else if (id == CHANNEL_SCHEMA_RECORD) handleChannelSchema(payload, payloadSize);
+            else handleRecord(id, time, payload, payloadSize);
+        }
+
+        const Stats& getStats() const { return stats; }
+    private:
+        void handleSchema(const uint8_t* payload, size_t size) {
+            if (size < 2) return;
+            const uint8_t id = payload[0];
+            const uint8_t fieldCount = payload[1];
+            if (size < 2u + fieldCount) return;
+
+            Schema schema;
+            schema.types.assign(payload + 2, payload + 2 + fieldCount);
+            // the rest of the schema is null terminated strings
+            size_t offset = 2 + fieldCount;
+            const auto readString = [&](std::string& out) {
+                if (offset >= size || std::memchr(payload + offset, 0, size - offset) == nullptr) return false;
+                out.assign(reinterpret_cast<const char*>(payload + offset));
+                offset += out.size() + 1;
+                return true;
+            };
+            if (!readString(schema.name)) return;
+            schema.fieldNames.resize(fieldCount);
+            for (std::string& fieldName : schema.fieldNames) {
+                if (!readString(fieldName)) return;
+            }
+            for (uint8_t type : schema.types) schema.payloadSize += fieldSize(type);
+
+            // schemas are resent periodically, only start a new file when the schema changes
+            auto it = schemas.find(id);
+            if (it != schemas.end() && it->second.name == schema.name && it->second.types == schema.types) return;
+
+            schema.file.open(outDir + "/" + schema.name + ".csv");
+            schema.file << "time";
+            for (const std::string& fieldName : schema.fieldNames) schema.file << ',' << fieldName;
+            schema.file << '\n';
+            schemas[id] = std::move(schema);
+        }
+
+        void handleRecord(uint8_t id, uint32_t time, const uint8_t* payload, size_t size) {
+            auto it = schemas.find(id);
+            if (it == schemas.end() || it->second.payloadSize != size) {
+                stats.unknownRecords++;
+                return;
+            }
+            Schema& schema = it->second;
+            schema.file << time;
+            for (uint8_t type : schema.types) {
+                schema.file << ',';
+                writeField(schema.file, type, payload);
+                payload += fieldSize(type);
+            }
+            schema.file << '\n';
+        }
+
+        void handleLog(uint32_t time, const uint8_t* payload, size_t size) {
+            // level, format id, argument count
+            if (size < 6) return;
+            const uint8_t level = payload[0];
+            const uint32_t id = read<uint32_t>(payload + 1);
+            const uint8_t argCount = payload[5];
+            size_t offset = 6;
+
+            std::string message;
+            const auto format = formats.find(id);
+            if (format == formats.end()) {
+                message = fmt::format("<unknown format {:#x}, is the ELF file from this program?>", id);
+            } else {
+                fmt::dynamic_format_arg_store<fmt::format_context> args;
+                bool valid = true;
+                for (uint8_t i = 0; i < argCount && valid; i++) {
+                    if (offset >= size) {
+                        valid = false;
+                        break;
+                    }
+                    const uint8_t type = payload[offset++];
+                    // strings start with their length
+                    size_t argSize = fieldSize(type);
+                    if (type == STRING) argSize = offset < size ? payload[offset] + 1 : size;
+                    if (argSize == 0 || offset + argSize > size) {
+                        valid = false;
+                        break;
+                    }
+                    const uint8_t* data = payload + offset;
+                    switch (type) {
+                        case I32: args.push_back(read<int32_t>(data)); break;
+                        case U32: args.push_back(read<uint32_t>(data)); break;
+                        case I64: args.push_back(read<int64_t>(data)); break;
+                        case U64: args.push_back(read<uint64_t>(data)); break;
+                        case F32: args.push_back(read<float>(data)); break;
+                        case F64: args.push_back(read<double>(data)); break;
+                        case BOOL: args.push_back(data[0] != 0); break;
+                        case CHAR: args.push_back(char(data[0])); break;
+                        case STRING:
+                            args.push_back(std::string(reinterpret_cast<const char*>(data + 1), data[0]));
+                            break;
+                        default: valid = false;
+                    }
+                    offset += argSize;
+                }
+                try {
+                    message = valid ? fmt::vformat(format->second, args)
+                                    : fmt::format("<corrupt arguments for \"{}\">", format->second);
+                } catch (const fmt::format_error& error) {
+                    message = fmt::format("<{} while formatting \"{}\">", error.what(), format->second);
+                }
+            }
+
+            if (!logFile.is_open()) logFile.open(outDir + "/log.txt");
+            const char* levelName = level < std::size(LEVEL_NAMES) ? LEVEL_NAMES[level] : "?";
+            const std::string line = fmt::format("[{}] {}: {}\n", time, levelName, message);
+            std::cout << line;
+            logFile << line;
+            stats.logMessages++;
+        }
+
+        void handleChannelSchema(const uint8_t* payload, size_t size) {
+            // group index, period in ticks, tick period, channel count
+            if (size < 6) return;
+            const uint8_t index = payload[0];
+            ChannelGroup group;
+            group.periodTicks = std::max<uint16_t>(1, read<uint16_t>(payload + 1));
+            group.tickPeriod = read<uint16_t>(payload + 3);
+            const uint8_t channelCount = payload[5];
+            size_t offset = 6;
+            if (size < offset + channelCount * 5u) return;
+            for (uint8_t i = 0; i < channelCount; i++) {
+                group.types.push_back(payload[offset]);
+                group.resolutions.push_back(read<float>(payload + offset + 1));
+                offset += 5;
+            }
+            const auto readString = [&](std::string& out) {
+                if (offset >= size || std::memchr(payload + offset, 0, size - offset) == nullptr) return false;
+                out.assign(reinterpret_cast<const char*>(payload + offset));
+                offset += out.size() + 1;
+                return true;
+            };
+            if (!readString(group.name)) return;
+            std::vector<std::string> units(channelCount);
+            group.channelNames.resize(channelCount);
+            for (uint8_t i = 0; i < channelCount; i++) {
+                if (!readString(group.channelNames[i]) || !readString(units[i])) return;
+            }
+
+            // schemas are resent periodically, only start a new file when the schema changes
+            auto it = channelGroups.find(index);
+            if (it != channelGroups.end() && it->second.name == group.name && it->second.types == group.types &&
+                it->second.periodTicks == group.periodTicks) {
+                return;
+            }
+
+            group.values.assign(channelCount, 0);
+            group.file.open(outDir + "/" + group.name + ".csv");
+            group.file << "time";
+            for (uint8_t i = 0; i < channelCount; i++) {
+                group.file << ',' << group.channelNames[i];
+                if (!units[i].empty()) group.file << " (" << units[i] << ')';
+            }
+            group.file << '\n';
+            channelGroups[index] = std::move(group);
+        }
+
+        void writeChannelRow(ChannelGroup& group, uint32_t time) {
+            group.file << time;
+            for (size_t i = 0; i < group.values.size(); i++) {
+                group.file << ',';
+                if (group.types[i] == CHANNEL_BOOL || group.resolutions[i] == 1) group.file << group.values[i];
+                else group.file << group.values[i] * group.resolutions[i];
+            }
+            group.file << '\n';
+            stats.channelSamples++;
+        }
+
+        /**
+         * @brief Time of a tick, from the tick and time of the last keyframe
+         */
+        uint32_t channelTime(const ChannelGroup& group, uint32_t tick) const {
+            return keyframeTime + int32_t(tick - keyframeTick) * group.tickPeriod;
+        }
+
+        void handleChannelFrame(const uint8_t* payload, size_t size) {
+            // header, then the group count, tick and time of keyframes, or the tick delta of deltas
+            if (size < 1) return;
+            const bool keyframe = payload[0] & CHANNEL_KEYFRAME;
+            const uint8_t sequence = payload[0] & CHANNEL_SEQUENCE_MASK;
+            size_t offset = 1;
+            uint32_t tick;
+            if (keyframe) {
+                if (size < 10) return;
+                channelGroupCount = payload[1];
+                tick = read<uint32_t>(payload + 2);
+                keyframeTick = tick;
+                keyframeTime = read<uint32_t>(payload + 6);
+                offset = 10;
+            } else {
+                uint8_t tickDelta = 1;
+                if (payload[0] & CHANNEL_TICK_DELTA) {
+                    if (size < 2) return;
+                    tickDelta = payload[1];
+                    offset = 2;
+                }
+                tick = lastChannelTick + tickDelta;
+            }
+            stats.channelFrames++;
+            const uint8_t groupCount = channelGroupCount;
+
+            // a delta's tick is only known from the frames before it, back to a keyframe
+            if (!keyframe && !haveChannelTick) return;
+
+            // every group has to be known to find where each group's values are
+            bool complete = true;
+            for (uint8_t i = 0; i < groupCount; i++) complete &= channelGroups.count(i) != 0;
+            if (!complete) {
+                for (auto& [index, group] : channelGroups) group.valid = false;
+                haveChannelTick = false;
+                stats.unknownRecords++;
+                return;
+            }
+
+            // frames are only sent when something changed, so the values of the ticks in between are the same as the
+            // last frame's. A gap in the sequence means a frame was lost and the values can't be trusted until the
+            // next keyframe, and neither can the tick of a delta
+            if (haveChannelTick && sequence != ((lastChannelSequence + 1) & CHANNEL_SEQUENCE_MASK)) {
+                stats.lostChannelFrames += (sequence - lastChannelSequence - 1) & CHANNEL_SEQUENCE_MASK;
+                for (auto& [index, group] : channelGroups) group.valid = false;
+                if (!keyframe) {
+                    haveChannelTick = false;
+                    return;
+                }
+            }
+            if (haveChannelTick && tick > lastChannelTick) {
+                const uint32_t first = std::max(lastChannelTick + 1, tick > 100000 ? tick - 100000 : 0);
+                for (uint32_t t = first; t < tick; t++) {
+                    for (uint8_t i = 0; i < groupCount; i++) {
+                        ChannelGroup& group = channelGroups[i];
+                        if (!group.valid || t % group.periodTicks != 0) continue;
+                        writeChannelRow(group, channelTime(group, t));
+                    }
+                }
+            }
+            haveChannelTick = true;
+            lastChannelTick = tick;
+            lastChannelSequence = sequence;
+
+            lemlib::BitReader reader(payload + offset, size - offset);
+            for (uint8_t i = 0; i < groupCount; i++) {
+                ChannelGroup& group = channelGroups[i];
+                const bool due = tick % group.periodTicks == 0;
+                if (keyframe) {
+                    for (int32_t& value : group.values) value = lemlib::readVarInt(reader);
+                    group.valid = true;
+                } else if (due) {
+                    for (size_t j = 0; j < group.values.size(); j++) {
+                        if (reader.read(1) == 0) continue;
+                        int32_t& value = group.values[j];
+                        if (group.types[j] == CHANNEL_BOOL) value = !value;
+                        else value = int32_t(uint32_t(value) + uint32_t(lemlib::readVarInt(reader)));
+                    }
+                }
+                if (!reader.ok()) {
+                    for (auto& [index, group] : channelGroups) group.valid = false;
+                    stats.badFrames++;
+                    return;
+                }
+            }
+            for (uint8_t i = 0; i < groupCount; i++) {
+                ChannelGroup& group = channelGroups[i];
+                if (group.valid && tick % group.periodTicks == 0) writeChannelRow(group, channelTime(group, tick));
+            }
+        }
+
+        std::string outDir;
+        std::map<uint32_t, std::string> formats;
+        std::ofstream logFile;
+        std::map<uint8_t, Schema> schemas;
+        std::map<uint8_t, ChannelGroup> channelGroups;
+        /** whether the tick of the last channel frame is known */
+        bool haveChannelTick = false;
+        uint32_t lastChannelTick = 0;
+        uint8_t lastChannelSequence = 0;
+        /** number of groups, tick and time of the last keyframe */
+        uint8_t channelGroupCount = 0;
+        uint32_t keyframeTick = 0;
+        uint32_t keyframeTime = 0;
+        Stats stats;
+};
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* elfPath = nullptr;
+    std::vector<const char*> positional;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "-e") == 0 && i + 1 < argc) elfPath = argv[++i];
+        else positional.push_back(argv[i]);
+    }
+    if (positional.empty()) {
+        std::cerr << "usage: " << argv[0]
+                  << " [-e bin/hot.package.elf] <capture file, or - for stdin> [output directory]\n";
+        return 1;
+    }
+
+    std::map<uint32_t, std::string> formats;
+    if (elfPath != nullptr && !readFormatStrings(elfPath, formats)) {
+        std::cerr << elfPath << ": no deferred log format strings found\n";
+    }
+
+    FILE* input = std::strcmp(positional[0], "-") == 0 ? stdin : std::fopen(positional[0], "rb");
+    if (input == nullptr) {
+        std::perror(positional[0]);
+        return 1;
+    }
+
+    Decoder decoder(positional.size() > 1 ? positional[1] : ".", std::move(formats));
+    std::vector<uint8_t> frame;
+    int byte;
+    while ((byte = std::fgetc(input)) != EOF) {
+        if (byte == 0) {
+            decoder.handleFrame(frame);
+            frame.clear();
+        } else {
+            frame.push_back(uint8_t(byte));
+        }
+    }
+    if (input != stdin) std::fclose(input);
+
+    const Stats& stats = decoder.getStats();
+    std::cerr << stats.frames << " frames decoded, " << stats.badFrames << " corrupt frames skipped, "
+              << stats.unknownRecords << " records without a schema, " << stats.logMessages << " log messages\n";
+    if (stats.channelFrames != 0) {
+        std::cerr << stats.channelFrames << " channel frames reconstructed into " << stats.channelSamples
+                  << " samples, " << stats.lostChannelFrames << " channel frames lost\n";
+    }
+    return 0;
+}